@@ -0,0 +1,180 @@
+/**
+ * @file burstCapture.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the member functions of the class BurstCapture.
+ * @details This file defines the member functions of the class BurstCapture, which decides at which time steps the snapshots of a simulation are written, depending on the bursts of plastic activity, and keeps the snapshots preceding a burst in memory.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "burstCapture.h"
+
+// Constructors
+/**
+ * @brief Default constructor. Snapshots are taken at every step during bursts and BURSTCAPTURE_DEFAULT_RING_SIZE snapshots are kept before a burst.
+ */
+BurstCapture::BurstCapture ()
+{
+    this->nBaseline = 0;
+    this->nBurst = 0;
+    this->nPreTrigger = 0;
+    this->ringSize = -1;
+    this->configure(1, BURSTCAPTURE_DEFAULT_RING_SIZE);
+}
+
+// Assignment functions
+/**
+ * @brief Sets the dense cadence and the size of the ring. The snapshots in the ring are discarded if its size changes.
+ * @param denseInterval Number of time steps between two snapshots during bursts and in the ring.
+ * @param ringSize Number of snapshots kept before a burst. Zero disables the ring.
+ */
+void BurstCapture::configure (int denseInterval, int ringSize)
+{
+    this->denseInterval = (denseInterval > 0) ? denseInterval : 1;
+    if (ringSize < 0) {
+        ringSize = 0;
+    }
+
+    if (ringSize != this->ringSize) {
+        this->ringSize = ringSize;
+        this->ring.clear();
+        this->first = 0;
+        this->count = 0;
+        this->stepsSinceDense = 0;
+    }
+}
+
+// Operations
+/**
+ * @brief Decides what is to be done with the snapshot of the present time step.
+ * @details This function must be called once per time step.
+ * @param baselineDue True if a snapshot is due at the baseline cadence.
+ * @param burst True if a burst is under way.
+ * @param burstStart True if the burst started at the present time step. The snapshots of the ring must then be written, from BurstCapture::release, before that of the present step.
+ * @return The action for the snapshot of the present step.
+ */
+CaptureAction BurstCapture::step (bool baselineDue, bool burst, bool burstStart)
+{
+    this->stepsSinceDense++;
+
+    if (burst) {
+        // Dense cadence, counted from the start of the burst
+        if (burstStart || this->stepsSinceDense >= this->denseInterval) {
+            this->stepsSinceDense = 0;
+            this->nBurst++;
+            return (CAPTURE_WRITE);
+        }
+        return (CAPTURE_SKIP);
+    }
+
+    if (baselineDue) {
+        // The snapshots of the ring are older than this one
+        this->first = 0;
+        this->count = 0;
+        this->stepsSinceDense = 0;
+        this->nBaseline++;
+        return (CAPTURE_WRITE);
+    }
+
+    if (this->ringSize > 0 && this->stepsSinceDense >= this->denseInterval) {
+        this->stepsSinceDense = 0;
+        return (CAPTURE_KEEP);
+    }
+
+    return (CAPTURE_SKIP);
+}
+
+/**
+ * @brief Keeps a snapshot in the ring.
+ * @param t Time of the snapshot.
+ * @param data The snapshot.
+ */
+void BurstCapture::keep (double t, const std::string& data)
+{
+    int i;
+
+    if (this->ringSize == 0) {
+        return;
+    }
+
+    if ((int) this->ring.size() < this->ringSize) {
+        this->ring.resize(this->ringSize);
+    }
+
+    if (this->count < this->ringSize) {
+        i = (this->first + this->count) % this->ringSize;
+        this->count++;
+    }
+    else {
+        // The ring is full: the oldest snapshot is overwritten
+        i = this->first;
+        this->first = (this->first + 1) % this->ringSize;
+    }
+
+    this->ring[i].time = t;
+    this->ring[i].data = data;
+}
+
+/**
+ * @brief Takes the snapshots out of the ring.
+ * @return The snapshots of the ring, the oldest first.
+ */
+std::vector<CapturedSnapshot> BurstCapture::release ()
+{
+    std::vector<CapturedSnapshot> snapshots;
+    int i;
+
+    for (i=0; i<this->count; i++) {
+        snapshots.push_back(this->ring[(this->first + i) % this->ringSize]);
+    }
+
+    this->nPreTrigger += this->count;
+    this->first = 0;
+    this->count = 0;
+
+    return (snapshots);
+}
+
+// Access functions
+/**
+ * @brief Get the number of snapshots in the ring.
+ * @return The number of snapshots.
+ */
+int BurstCapture::getNumKept () const
+{
+    return (this->count);
+}
+
+/**
+ * @brief Get the numbers of snapshots written.
+ * @param nBaseline Pointer to the variable receiving the number of snapshots written at the baseline cadence.
+ * @param nBurst Pointer to the variable receiving the number of snapshots written during bursts.
+ * @param nPreTrigger Pointer to the variable receiving the number of snapshots written from the ring.
+ */
+void BurstCapture::getNumWritten (int* nBaseline, int* nBurst, int* nPreTrigger) const
+{
+    *nBaseline = this->nBaseline;
+    *nBurst = this->nBurst;
+    *nPreTrigger = this->nPreTrigger;
+}
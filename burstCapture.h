@@ -0,0 +1,181 @@
+/**
+ * @file burstCapture.h
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the class BurstCapture.
+ * @details This file defines the class BurstCapture, which decides at which time steps the snapshots of a simulation are written, depending on the bursts of plastic activity, and keeps the snapshots preceding a burst in memory.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BURSTCAPTURE_H
+#define BURSTCAPTURE_H
+
+#include <string>
+#include <vector>
+
+#ifndef BURSTCAPTURE_DEFAULT_QUIET_STEPS
+/**
+ * @brief Default number of consecutive quiet time steps that ends a burst.
+ */
+#define BURSTCAPTURE_DEFAULT_QUIET_STEPS 10
+#endif
+
+#ifndef BURSTCAPTURE_DEFAULT_RING_SIZE
+/**
+ * @brief Default number of snapshots preceding a burst that are kept in memory.
+ */
+#define BURSTCAPTURE_DEFAULT_RING_SIZE 8
+#endif
+
+/**
+ * @brief Enumerated type indicating what is to be done with the snapshot of a time step.
+ */
+enum CaptureAction {
+    /**
+     * @brief No snapshot is taken.
+     */
+    CAPTURE_SKIP = 0,
+    /**
+     * @brief The snapshot is kept in memory, in case a burst follows.
+     */
+    CAPTURE_KEEP,
+    /**
+     * @brief The snapshot is written.
+     */
+    CAPTURE_WRITE
+};
+
+/**
+ * @brief The CapturedSnapshot struct holds a snapshot kept in memory.
+ */
+struct CapturedSnapshot
+{
+    /**
+     * @brief Time of the snapshot.
+     */
+    double time;
+    /**
+     * @brief The snapshot, as it is written.
+     */
+    std::string data;
+};
+
+/**
+ * @brief The BurstCapture class decides at which time steps the snapshots are written, with a sparse cadence during quiet periods and a dense cadence during the bursts of plastic activity.
+ * @details Outside the bursts, snapshots are written at the baseline cadence, which is that of a statistic. Between them, snapshots are taken at the dense cadence and kept in a ring of a few snapshots in memory, which is emptied whenever a snapshot is written. When a burst starts, the snapshots of the ring are written first, so that the steps leading to the burst are preserved, and snapshots are then written at the dense cadence until the burst ends. The bursts themselves are detected by the OutputScheduler. The class does not know what a snapshot is: the caller produces it when the action is not CAPTURE_SKIP.
+ */
+class BurstCapture
+{
+protected:
+    /**
+     * @brief Number of time steps between two snapshots at the dense cadence. A value of one takes a snapshot at every step.
+     */
+    int denseInterval;
+    /**
+     * @brief Number of time steps since the last snapshot at the dense cadence.
+     */
+    int stepsSinceDense;
+    /**
+     * @brief Largest number of snapshots kept in memory.
+     */
+    int ringSize;
+    /**
+     * @brief The snapshots kept in memory. Once the ring is full, the oldest one is overwritten.
+     */
+    std::vector<CapturedSnapshot> ring;
+    /**
+     * @brief Index in the ring of the oldest snapshot.
+     */
+    int first;
+    /**
+     * @brief Number of snapshots in the ring.
+     */
+    int count;
+    /**
+     * @brief Number of snapshots written at the baseline cadence, during bursts and from the ring.
+     */
+    int nBaseline, nBurst, nPreTrigger;
+
+public:
+    // Constructors
+    /**
+     * @brief Default constructor. Snapshots are taken at every step during bursts and BURSTCAPTURE_DEFAULT_RING_SIZE snapshots are kept before a burst.
+     */
+    BurstCapture ();
+
+    // Destructor
+    /**
+     * @brief Destructor for the class BurstCapture.
+     */
+    virtual ~BurstCapture ()
+    {
+
+    }
+
+    // Assignment functions
+    /**
+     * @brief Sets the dense cadence and the size of the ring. The snapshots in the ring are discarded if its size changes.
+     * @param denseInterval Number of time steps between two snapshots during bursts and in the ring.
+     * @param ringSize Number of snapshots kept before a burst. Zero disables the ring.
+     */
+    void configure (int denseInterval, int ringSize);
+
+    // Operations
+    /**
+     * @brief Decides what is to be done with the snapshot of the present time step.
+     * @details This function must be called once per time step.
+     * @param baselineDue True if a snapshot is due at the baseline cadence.
+     * @param burst True if a burst is under way.
+     * @param burstStart True if the burst started at the present time step. The snapshots of the ring must then be written, from BurstCapture::release, before that of the present step.
+     * @return The action for the snapshot of the present step.
+     */
+    CaptureAction step (bool baselineDue, bool burst, bool burstStart);
+    /**
+     * @brief Keeps a snapshot in the ring.
+     * @param t Time of the snapshot.
+     * @param data The snapshot.
+     */
+    void keep (double t, const std::string& data);
+    /**
+     * @brief Takes the snapshots out of the ring.
+     * @return The snapshots of the ring, the oldest first.
+     */
+    std::vector<CapturedSnapshot> release ();
+
+    // Access functions
+    /**
+     * @brief Get the number of snapshots in the ring.
+     * @return The number of snapshots.
+     */
+    int getNumKept () const;
+    /**
+     * @brief Get the numbers of snapshots written.
+     * @param nBaseline Pointer to the variable receiving the number of snapshots written at the baseline cadence.
+     * @param nBurst Pointer to the variable receiving the number of snapshots written during bursts.
+     * @param nPreTrigger Pointer to the variable receiving the number of snapshots written from the ring.
+     */
+    void getNumWritten (int* nBaseline, int* nBurst, int* nPreTrigger) const;
+};
+
+#endif // BURSTCAPTURE_H
@@ -0,0 +1,494 @@
+/**
+ * @file cellList.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the member functions of the class CellList.
+ * @details This file defines the member functions of the class CellList used to evaluate the stress field of the dislocations of a grain with a cut-off radius and a coarse-grained far field.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cellList.h"
+
+// Constructors
+/**
+ * @brief Default constructor. The cut-off radius is zero, which disables the cell list.
+ */
+CellList::CellList ()
+{
+    this->cutoff = 0.0;
+    this->skin = 0.0;
+    this->xMin = 0.0;
+    this->yMin = 0.0;
+    this->cellSize = 0.0;
+    this->nx = 0;
+    this->ny = 0;
+    this->nBuilds = 0;
+}
+
+// Assignment functions
+/**
+ * @brief Sets the cut-off radius and the skin distance.
+ * @details A cut-off radius that is zero or negative disables the cell list. A negative skin distance is replaced by CELLLIST_DEFAULT_SKIN_FRACTION times the cut-off radius. The grid is rebuilt at the next update.
+ * @param cutoff The cut-off radius.
+ * @param skin The skin distance.
+ */
+void CellList::setCutoff (double cutoff, double skin)
+{
+    if (cutoff <= 0.0) {
+        this->cutoff = 0.0;
+        this->skin = 0.0;
+    }
+    else {
+        this->cutoff = cutoff;
+        if (skin < 0.0) {
+            this->skin = CELLLIST_DEFAULT_SKIN_FRACTION * cutoff;
+        }
+        else {
+            this->skin = skin;
+        }
+    }
+
+    // Force a new grid
+    this->sources.clear();
+    this->cells.clear();
+    this->occupiedCells.clear();
+    this->exactSources.clear();
+    this->nBuilds = 0;
+}
+
+// Access functions
+/**
+ * @brief Indicates whether the cell list is used.
+ * @return True if the cut-off radius is positive.
+ */
+bool CellList::isEnabled () const
+{
+    return (this->cutoff > 0.0);
+}
+
+/**
+ * @brief Get the cut-off radius.
+ * @return The cut-off radius.
+ */
+double CellList::getCutoff () const
+{
+    return (this->cutoff);
+}
+
+/**
+ * @brief Get the skin distance.
+ * @return The skin distance.
+ */
+double CellList::getSkin () const
+{
+    return (this->skin);
+}
+
+/**
+ * @brief Get the number of times the grid has been built.
+ * @return The number of builds.
+ */
+int CellList::getNumBuilds () const
+{
+    return (this->nBuilds);
+}
+
+// Operations
+/**
+ * @brief Refreshes the dislocation data after the dislocations have moved.
+ * @details The positions and Burgers vectors of all dislocations of the slip systems are collected. The grid is rebuilt if one of them has moved by more than half the skin distance since it was binned, or if a new dislocation lies outside the grid. The net Burgers vectors of the cells are always recalculated.
+ * @param slipSystems The slip systems of the grain.
+ * @param grainSystem Pointer to the grain co-ordinate system.
+ * @param viewAxis The viewing axis, expressed in the grain co-ordinate system.
+ */
+void CellList::update (std::vector<SlipSystem*> slipSystems, CoordinateSystem* grainSystem, Vector3d viewAxis)
+{
+    bool rebuild = (this->nBuilds == 0);
+    int i, k;
+
+    // Frame of the grid: two in-plane axes and the viewing axis
+    Vector3d l = viewAxis * (1.0 / viewAxis.magnitude());
+    if (rebuild || this->frame.getBase() != grainSystem || fabs((l * this->frame.getAxis(2)) - 1.0) > CELLLIST_PARALLEL_TOLERANCE) {
+        // The first in-plane axis is built from the grain axis that is the most nearly perpendicular to the viewing axis
+        k = 0;
+        for (i=1; i<3; i++) {
+            if (fabs(l.getValue(i)) < fabs(l.getValue(k))) {
+                k = i;
+            }
+        }
+        Vector3d axes[3];
+        axes[0] = Vector3d::unitVector(k) - (l * l.getValue(k));
+        axes[0] = axes[0] * (1.0 / axes[0].magnitude());
+        axes[1] = l ^ axes[0];
+        axes[2] = l;
+        this->frame = CoordinateSystem(axes, Vector3d::zeros(), grainSystem);
+        this->frame.calculateRotationMatrix();
+        rebuild = true;
+    }
+
+    // Collect the dislocations
+    std::vector<CellSource> current;
+    current.reserve(this->sources.size());
+    this->exactSources.clear();
+
+    std::vector<SlipSystem*>::iterator ss_it;
+    SlipSystem* ss;
+    CoordinateSystem* ssSystem;
+    std::vector<SlipPlane*> slipPlanes;
+    std::vector<SlipPlane*>::iterator sp_it;
+    CoordinateSystem* spSystem;
+    std::vector<Dislocation*> dislocations;
+    std::vector<Dislocation*>::iterator d_it;
+    Dislocation* d;
+    CoordinateSystem* dSystem;
+
+    Vector3d line, edge, b, position;
+    Vector3d bLocal;
+    double cosine;
+    CellSource source;
+    CellExactSource exact;
+
+    for (ss_it=slipSystems.begin(); ss_it!=slipSystems.end(); ss_it++) {
+        ss = *ss_it;
+        ssSystem = ss->getCoordinateSystem();
+        slipPlanes = ss->getSlipPlanes();
+        for (sp_it=slipPlanes.begin(); sp_it!=slipPlanes.end(); sp_it++) {
+            spSystem = (*sp_it)->getCoordinateSystem();
+            dislocations = (*sp_it)->getDislocationList();
+            for (d_it=dislocations.begin(); d_it!=dislocations.end(); d_it++) {
+                d = *d_it;
+                dSystem = d->getCoordinateSystem();
+
+                // Line vector in the grain co-ordinate system
+                line = ssSystem->vector_LocalToBase_noTranslate(spSystem->vector_LocalToBase_noTranslate(dSystem->getAxis(2)));
+                cosine = line * l;
+                if (fabs(fabs(cosine) - 1.0) > CELLLIST_PARALLEL_TOLERANCE) {
+                    // Not parallel to the viewing axis
+                    exact.dislocation = d;
+                    exact.slipPlane = *sp_it;
+                    exact.slipSystem = ss;
+                    this->exactSources.push_back(exact);
+                    continue;
+                }
+
+                // Burgers vector in the grain co-ordinate system, with the same components as those used for the stress field of the dislocation
+                edge = ssSystem->vector_LocalToBase_noTranslate(spSystem->vector_LocalToBase_noTranslate(dSystem->getAxis(0)));
+                bLocal = d->getBurgerLocal();
+                b = ( (edge * bLocal.getValue(0)) + (line * bLocal.getValue(2)) ) * d->getBurgersMagnitude();
+                if (cosine < 0.0) {
+                    // Same dislocation, described with the line vector along the viewing axis
+                    b = b * (-1.0);
+                }
+                b = this->frame.vector_BaseToLocal_noTranslate(b);
+
+                position = this->frame.vector_BaseToLocal(ssSystem->vector_LocalToBase(spSystem->vector_LocalToBase(d->getPosition())));
+
+                source.x = position.getValue(0);
+                source.y = position.getValue(1);
+                source.x0 = source.x;
+                source.y0 = source.y;
+                source.bx = b.getValue(0);
+                source.by = b.getValue(1);
+                source.bz = b.getValue(2);
+                source.cell = -1;
+                source.dislocation = d;
+                current.push_back(source);
+            }
+        }
+    }
+
+    // Verlet criterion
+    if (!rebuild) {
+        std::map<Dislocation*, int> previous;
+        std::map<Dislocation*, int>::iterator previous_it;
+        for (i=0; i<this->sources.size(); i++) {
+            previous[this->sources[i].dislocation] = i;
+        }
+
+        double limit = 0.25 * this->skin * this->skin;
+        double dx, dy;
+        int ci, cj;
+        for (i=0; i<current.size() && !rebuild; i++) {
+            previous_it = previous.find(current[i].dislocation);
+            if (previous_it != previous.end()) {
+                // Keep the cell in which the dislocation was binned
+                current[i].x0 = this->sources[previous_it->second].x0;
+                current[i].y0 = this->sources[previous_it->second].y0;
+                current[i].cell = this->sources[previous_it->second].cell;
+                dx = current[i].x - current[i].x0;
+                dy = current[i].y - current[i].y0;
+                rebuild = ( ((dx*dx) + (dy*dy)) > limit );
+            }
+            else if (this->inside(current[i].x, current[i].y)) {
+                // New dislocation within the grid
+                this->locate(current[i].x, current[i].y, ci, cj);
+                current[i].cell = ci + (this->nx * cj);
+            }
+            else {
+                rebuild = true;
+            }
+        }
+    }
+
+    this->sources = current;
+
+    if (rebuild) {
+        this->build();
+    }
+    else {
+        this->fillCells();
+    }
+
+    this->coarsen();
+}
+
+/**
+ * @brief Bins the dislocations into a new grid.
+ * @details The grid covers the dislocations with a margin of one skin distance. The cells are squares whose size is the cut-off radius plus the skin distance, unless this would require more than CELLLIST_MAX_CELLS_PER_AXIS cells along one of the axes.
+ */
+void CellList::build ()
+{
+    int i, j, k;
+    int nSources = this->sources.size();
+
+    double xMax, yMax;
+    if (nSources == 0) {
+        this->xMin = 0.0;
+        this->yMin = 0.0;
+        xMax = 0.0;
+        yMax = 0.0;
+    }
+    else {
+        this->xMin = xMax = this->sources[0].x;
+        this->yMin = yMax = this->sources[0].y;
+        for (k=1; k<nSources; k++) {
+            this->xMin = std::min(this->xMin, this->sources[k].x);
+            this->yMin = std::min(this->yMin, this->sources[k].y);
+            xMax = std::max(xMax, this->sources[k].x);
+            yMax = std::max(yMax, this->sources[k].y);
+        }
+    }
+    this->xMin -= this->skin;
+    this->yMin -= this->skin;
+    xMax += this->skin;
+    yMax += this->skin;
+
+    double width = xMax - this->xMin;
+    double height = yMax - this->yMin;
+    this->cellSize = std::max(this->cutoff + this->skin, std::max(width, height) / CELLLIST_MAX_CELLS_PER_AXIS);
+    this->nx = std::max(1, (int) ceil(width / this->cellSize));
+    this->ny = std::max(1, (int) ceil(height / this->cellSize));
+
+    for (k=0; k<nSources; k++) {
+        this->sources[k].x0 = this->sources[k].x;
+        this->sources[k].y0 = this->sources[k].y;
+        this->locate(this->sources[k].x, this->sources[k].y, i, j);
+        this->sources[k].cell = i + (this->nx * j);
+    }
+
+    this->fillCells();
+    this->nBuilds++;
+}
+
+/**
+ * @brief Fills the lists of dislocations of the cells from the cell indices of the dislocations.
+ */
+void CellList::fillCells ()
+{
+    int k;
+
+    this->cells.assign(this->nx * this->ny, std::vector<int>());
+    for (k=0; k<this->sources.size(); k++) {
+        this->cells[this->sources[k].cell].push_back(k);
+    }
+}
+
+/**
+ * @brief Indicates whether the point (x, y) lies within the grid.
+ * @param x First co-ordinate of the point in the plane of the grid.
+ * @param y Second co-ordinate of the point in the plane of the grid.
+ * @return True if the point lies within the grid.
+ */
+bool CellList::inside (double x, double y) const
+{
+    return ( x >= this->xMin && x <= this->xMin + (this->nx * this->cellSize)
+          && y >= this->yMin && y <= this->yMin + (this->ny * this->cellSize) );
+}
+
+/**
+ * @brief Calculates the net Burgers vector and the centroid of each cell.
+ * @details The current positions of the dislocations are used, even if they have moved away from the cell in which they were binned.
+ */
+void CellList::coarsen ()
+{
+    int nCells = this->cells.size();
+    int c, m, k;
+    double n;
+
+    this->cellBurgers.assign(3 * nCells, 0.0);
+    this->cellCentroid.assign(2 * nCells, 0.0);
+    this->occupiedCells.clear();
+
+    for (c=0; c<nCells; c++) {
+        if (this->cells[c].empty()) {
+            continue;
+        }
+        for (m=0; m<this->cells[c].size(); m++) {
+            k = this->cells[c][m];
+            this->cellBurgers[3*c]   += this->sources[k].bx;
+            this->cellBurgers[3*c+1] += this->sources[k].by;
+            this->cellBurgers[3*c+2] += this->sources[k].bz;
+            this->cellCentroid[2*c]   += this->sources[k].x;
+            this->cellCentroid[2*c+1] += this->sources[k].y;
+        }
+        n = (double) this->cells[c].size();
+        this->cellCentroid[2*c]   /= n;
+        this->cellCentroid[2*c+1] /= n;
+        this->occupiedCells.push_back(c);
+    }
+}
+
+/**
+ * @brief Returns the index of the cell containing the point (x, y). Points outside the grid are assigned to the nearest cell.
+ * @param x First co-ordinate of the point in the plane of the grid.
+ * @param y Second co-ordinate of the point in the plane of the grid.
+ * @param i Reference to the variable receiving the index of the cell along the first axis.
+ * @param j Reference to the variable receiving the index of the cell along the second axis.
+ */
+void CellList::locate (double x, double y, int& i, int& j) const
+{
+    i = (int) floor((x - this->xMin) / this->cellSize);
+    j = (int) floor((y - this->yMin) / this->cellSize);
+
+    i = std::max(0, std::min(this->nx - 1, i));
+    j = std::max(0, std::min(this->ny - 1, j));
+}
+
+/**
+ * @brief Adds the stress field of a straight dislocation parallel to the viewing axis.
+ * @details The stress field is the superposition of the fields of two edge dislocations, with Burgers vectors along the two axes of the grid, and of a screw dislocation. It is expressed in the frame of the cell list. The edge dislocation with its Burgers vector along the second axis is evaluated in a frame rotated by 90 degrees about the viewing axis, and its stress field is rotated back.
+ * @param x First co-ordinate of the field point relative to the dislocation.
+ * @param y Second co-ordinate of the field point relative to the dislocation.
+ * @param bx Burgers vector component along the first axis.
+ * @param by Burgers vector component along the second axis.
+ * @param bz Burgers vector component along the viewing axis.
+ * @param mu Shear modulus (Pa).
+ * @param nu Poisson's ratio.
+ * @param s Array with the six stress components xx, yy, zz, xy, xz, yz, to which the field is added.
+ */
+void CellList::addLineStressField (double x, double y, double bx, double by, double bz, double mu, double nu, double *s)
+{
+    double r2 = (x*x) + (y*y);
+    if (r2 == 0.0) {
+        return;
+    }
+
+    double denominator = r2 * r2;
+    double D, sxx, syy;
+
+    // Edge component along the first axis
+    if (bx != 0.0) {
+        D = ( mu * bx ) / ( 2.0 * PI * ( 1.0 - nu ) );
+        sxx = D * y * ( (x*x) - (y*y) ) / denominator;
+        syy = -1.0 * D * y * ( (3.0*x*x) + (y*y) ) / denominator;
+        s[0] += sxx;
+        s[1] += syy;
+        s[2] += nu * ( sxx + syy );
+        s[3] += -1.0 * D * x * ( (x*x) - (y*y) ) / denominator;
+    }
+
+    // Edge component along the second axis: in the rotated frame x' = y and y' = -x
+    if (by != 0.0) {
+        D = ( mu * by ) / ( 2.0 * PI * ( 1.0 - nu ) );
+        sxx = D * (-x) * ( (y*y) - (x*x) ) / denominator;
+        syy = -1.0 * D * (-x) * ( (3.0*y*y) + (x*x) ) / denominator;
+        s[0] += syy;
+        s[1] += sxx;
+        s[2] += nu * ( sxx + syy );
+        s[3] += D * y * ( (y*y) - (x*x) ) / denominator;
+    }
+
+    // Screw component
+    if (bz != 0.0) {
+        D = ( mu * bz ) / ( 2.0 * PI );
+        s[4] += D * (y / r2);
+        s[5] += -1.0 * D * (x / r2);
+    }
+}
+
+/**
+ * @brief Calculates the stress field at the point p due to all dislocations.
+ * @details The dislocations in the cell containing the point and in the eight cells around it are treated exactly, the other cells through their net Burgers vector. CellList::update must have been called after the dislocations last moved.
+ * @param p Position vector of the point, in the grain co-ordinate system.
+ * @param mu Shear modulus (Pa).
+ * @param nu Poisson's ratio.
+ * @return The stress field, in the grain co-ordinate system.
+ */
+Stress CellList::stressField (Vector3d p, double mu, double nu) const
+{
+    double s[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+    Vector3d pFrame = this->frame.vector_BaseToLocal(p);
+    double x = pFrame.getValue(0);
+    double y = pFrame.getValue(1);
+
+    int i, j;
+    this->locate(x, y, i, j);
+
+    std::vector<int>::const_iterator c_it;
+    std::vector<int>::const_iterator k_it;
+    int c;
+    const CellSource* source;
+    const double* b;
+
+    for (c_it=this->occupiedCells.begin(); c_it!=this->occupiedCells.end(); c_it++) {
+        c = *c_it;
+        if ( abs((c % this->nx) - i) <= 1 && abs((c / this->nx) - j) <= 1 ) {
+            // Near field
+            for (k_it=this->cells[c].begin(); k_it!=this->cells[c].end(); k_it++) {
+                source = &(this->sources[*k_it]);
+                addLineStressField(x - source->x, y - source->y, source->bx, source->by, source->bz, mu, nu, s);
+            }
+        }
+        else {
+            // Far field
+            b = &(this->cellBurgers[3*c]);
+            addLineStressField(x - this->cellCentroid[2*c], y - this->cellCentroid[2*c+1], b[0], b[1], b[2], mu, nu, s);
+        }
+    }
+
+    Stress total = this->frame.stress_LocalToBase(Stress(s, s+3));
+
+    // Dislocations that are not parallel to the viewing axis
+    std::vector<CellExactSource>::const_iterator e_it;
+    CoordinateSystem* ssSystem;
+    CoordinateSystem* spSystem;
+    for (e_it=this->exactSources.begin(); e_it!=this->exactSources.end(); e_it++) {
+        ssSystem = e_it->slipSystem->getCoordinateSystem();
+        spSystem = e_it->slipPlane->getCoordinateSystem();
+        total += ssSystem->stress_LocalToBase(spSystem->stress_LocalToBase(e_it->dislocation->stressField(spSystem->vector_BaseToLocal(ssSystem->vector_BaseToLocal(p)), mu, nu)));
+    }
+
+    return (total);
+}
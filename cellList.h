@@ -0,0 +1,278 @@
+/**
+ * @file cellList.h
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the class CellList.
+ * @details This file defines the class CellList used to evaluate the stress field of the dislocations of a grain with a cut-off radius and a coarse-grained far field.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CELLLIST_H
+#define CELLLIST_H
+
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <math.h>
+#include <stdlib.h>
+
+#include "slipsystem.h"
+
+#ifndef CELLLIST_DEFAULT_SKIN_FRACTION
+/**
+ * @brief Default value of the skin distance, as a fraction of the cut-off radius.
+ */
+#define CELLLIST_DEFAULT_SKIN_FRACTION 0.2
+#endif
+
+#ifndef CELLLIST_MAX_CELLS_PER_AXIS
+/**
+ * @brief Largest number of cells along each axis of the grid. Larger cells are used if the cut-off radius would require more.
+ */
+#define CELLLIST_MAX_CELLS_PER_AXIS 256
+#endif
+
+#ifndef CELLLIST_PARALLEL_TOLERANCE
+/**
+ * @brief Tolerance on the cosine of the angle between a dislocation line and the viewing axis for the dislocation to be binned. Other dislocations are always treated exactly.
+ */
+#define CELLLIST_PARALLEL_TOLERANCE 1.0e-06
+#endif
+
+/**
+ * @brief The CellSource struct holds the data of a dislocation binned in the cell list.
+ */
+struct CellSource
+{
+  /**
+   * @brief Co-ordinates of the dislocation in the plane of the cell grid.
+   */
+  double x, y;
+  /**
+   * @brief Co-ordinates of the dislocation at the time the cell list was last built.
+   */
+  double x0, y0;
+  /**
+   * @brief Components of the Burgers vector (multiplied by its magnitude) along the two in-plane axes and along the viewing axis.
+   * @details The components refer to a line direction along the viewing axis. Dislocations whose line vector is opposite to the viewing axis have their Burgers vector reversed.
+   */
+  double bx, by, bz;
+  /**
+   * @brief Index of the cell in which the dislocation was binned.
+   */
+  int cell;
+  /**
+   * @brief Pointer to the dislocation.
+   */
+  Dislocation *dislocation;
+};
+
+/**
+ * @brief The CellExactSource struct holds a dislocation that is not binned in the cell list, along with the objects that define its frame of reference.
+ */
+struct CellExactSource
+{
+  /**
+   * @brief Pointer to the dislocation.
+   */
+  Dislocation *dislocation;
+  /**
+   * @brief Pointer to the slip plane on which the dislocation lies.
+   */
+  SlipPlane *slipPlane;
+  /**
+   * @brief Pointer to the slip system to which the slip plane belongs.
+   */
+  SlipSystem *slipSystem;
+};
+
+/**
+ * @brief The CellList class evaluates the stress field of the dislocations of a grain with a cut-off radius.
+ * @details The dislocations are binned into a uniform grid of square cells lying in the plane perpendicular to the viewing axis, which is the direction of the dislocation lines in two dimensions. The cells are at least as large as the cut-off radius plus the skin distance, so that all dislocations closer than the cut-off radius to a point lie in the cell containing the point or in the eight cells around it. The stress field due to the dislocations in these cells is calculated exactly. Every other cell contributes through its net Burgers vector, placed at the centroid of its dislocations, so that the far field costs one evaluation per cell. The grid is only rebuilt when a dislocation has moved by more than half the skin distance since it was binned, in the manner of Verlet lists. Dislocations that disappear are simply dropped, and new dislocations are binned into the existing grid as long as they lie within it. Dislocations whose line is not parallel to the viewing axis are not binned and their stress field is always calculated exactly.
+ */
+class CellList
+{
+protected:
+  /**
+   * @brief The cut-off radius.
+   */
+  double cutoff;
+  /**
+   * @brief The skin distance.
+   */
+  double skin;
+  /**
+   * @brief Co-ordinate system spanned by the two axes of the cell grid and the viewing axis, expressed in the grain co-ordinate system.
+   */
+  CoordinateSystem frame;
+  /**
+   * @brief Co-ordinates of the lower corner of the grid.
+   */
+  double xMin, yMin;
+  /**
+   * @brief Size of the cells.
+   */
+  double cellSize;
+  /**
+   * @brief Number of cells along the two axes of the grid.
+   */
+  int nx, ny;
+  /**
+   * @brief The binned dislocations.
+   */
+  std::vector<CellSource> sources;
+  /**
+   * @brief Indices of the dislocations contained in each cell.
+   */
+  std::vector< std::vector<int> > cells;
+  /**
+   * @brief Net Burgers vector of each cell, three components per cell.
+   */
+  std::vector<double> cellBurgers;
+  /**
+   * @brief Centroid of the dislocations of each cell, two co-ordinates per cell.
+   */
+  std::vector<double> cellCentroid;
+  /**
+   * @brief Indices of the cells that contain dislocations.
+   */
+  std::vector<int> occupiedCells;
+  /**
+   * @brief Dislocations whose stress field is always calculated exactly.
+   */
+  std::vector<CellExactSource> exactSources;
+  /**
+   * @brief Number of times the grid has been built.
+   */
+  int nBuilds;
+
+  /**
+   * @brief Bins the dislocations into a new grid.
+   */
+  void build ();
+  /**
+   * @brief Fills the lists of dislocations of the cells from the cell indices of the dislocations.
+   */
+  void fillCells ();
+  /**
+   * @brief Indicates whether the point (x, y) lies within the grid.
+   * @param x First co-ordinate of the point in the plane of the grid.
+   * @param y Second co-ordinate of the point in the plane of the grid.
+   * @return True if the point lies within the grid.
+   */
+  bool inside (double x, double y) const;
+  /**
+   * @brief Calculates the net Burgers vector and the centroid of each cell.
+   */
+  void coarsen ();
+  /**
+   * @brief Returns the index of the cell containing the point (x, y). Points outside the grid are assigned to the nearest cell.
+   * @param x First co-ordinate of the point in the plane of the grid.
+   * @param y Second co-ordinate of the point in the plane of the grid.
+   * @param i Reference to the variable receiving the index of the cell along the first axis.
+   * @param j Reference to the variable receiving the index of the cell along the second axis.
+   */
+  void locate (double x, double y, int& i, int& j) const;
+  /**
+   * @brief Adds the stress field of a straight dislocation parallel to the viewing axis.
+   * @details The stress field is the superposition of the fields of two edge dislocations, with Burgers vectors along the two axes of the grid, and of a screw dislocation. It is expressed in the frame of the cell list.
+   * @param x First co-ordinate of the field point relative to the dislocation.
+   * @param y Second co-ordinate of the field point relative to the dislocation.
+   * @param bx Burgers vector component along the first axis.
+   * @param by Burgers vector component along the second axis.
+   * @param bz Burgers vector component along the viewing axis.
+   * @param mu Shear modulus (Pa).
+   * @param nu Poisson's ratio.
+   * @param s Array with the six stress components xx, yy, zz, xy, xz, yz, to which the field is added.
+   */
+  static void addLineStressField (double x, double y, double bx, double by, double bz, double mu, double nu, double *s);
+
+public:
+  // Constructors
+  /**
+   * @brief Default constructor. The cut-off radius is zero, which disables the cell list.
+   */
+  CellList ();
+
+  // Destructor
+  /**
+   * @brief Destructor for the class CellList.
+   */
+  virtual ~CellList ()
+  {
+
+  }
+
+  // Assignment functions
+  /**
+   * @brief Sets the cut-off radius and the skin distance.
+   * @details A cut-off radius that is zero or negative disables the cell list. A negative skin distance is replaced by CELLLIST_DEFAULT_SKIN_FRACTION times the cut-off radius. The grid is rebuilt at the next update.
+   * @param cutoff The cut-off radius.
+   * @param skin The skin distance.
+   */
+  void setCutoff (double cutoff, double skin);
+
+  // Access functions
+  /**
+   * @brief Indicates whether the cell list is used.
+   * @return True if the cut-off radius is positive.
+   */
+  bool isEnabled () const;
+  /**
+   * @brief Get the cut-off radius.
+   * @return The cut-off radius.
+   */
+  double getCutoff () const;
+  /**
+   * @brief Get the skin distance.
+   * @return The skin distance.
+   */
+  double getSkin () const;
+  /**
+   * @brief Get the number of times the grid has been built.
+   * @return The number of builds.
+   */
+  int getNumBuilds () const;
+
+  // Operations
+  /**
+   * @brief Refreshes the dislocation data after the dislocations have moved.
+   * @details The positions and Burgers vectors of all dislocations of the slip systems are collected. The grid is rebuilt if one of them has moved by more than half the skin distance since it was binned, or if a new dislocation lies outside the grid. The net Burgers vectors of the cells are always recalculated.
+   * @param slipSystems The slip systems of the grain.
+   * @param grainSystem Pointer to the grain co-ordinate system.
+   * @param viewAxis The viewing axis, expressed in the grain co-ordinate system.
+   */
+  void update (std::vector<SlipSystem*> slipSystems, CoordinateSystem* grainSystem, Vector3d viewAxis);
+  /**
+   * @brief Calculates the stress field at the point p due to all dislocations.
+   * @details CellList::update must have been called after the dislocations last moved.
+   * @param p Position vector of the point, in the grain co-ordinate system.
+   * @param mu Shear modulus (Pa).
+   * @param nu Poisson's ratio.
+   * @return The stress field, in the grain co-ordinate system.
+   */
+  Stress stressField (Vector3d p, double mu, double nu) const;
+};
+
+#endif // CELLLIST_H
@@ -41,6 +41,8 @@ CoordinateSystem::CoordinateSystem()
     this->o = Vector3d();
     // Base
     this->base = NULL;
+
+    this->classifyRotation();
 }
 
 /**
@@ -53,6 +55,8 @@ CoordinateSystem::CoordinateSystem(Vector3d* axes)
     this->setAxes(axes);
     this->setOrigin(Vector3d());
     this->base = NULL;
+
+    this->classifyRotation();
 }
 
 /**
@@ -103,6 +107,8 @@ CoordinateSystem::CoordinateSystem(double* p)
     ax = NULL;
 
     this->base = NULL;
+
+    this->classifyRotation();
 }
 
 /**
@@ -116,6 +122,8 @@ CoordinateSystem::CoordinateSystem(Vector3d* axes, Vector3d origin)
     this->setAxes(axes);
     this->setOrigin(origin);
     this->base = NULL;
+
+    this->classifyRotation();
 }
 
 /**
@@ -167,6 +175,8 @@ CoordinateSystem::CoordinateSystem(double* p, Vector3d origin)
     ax = NULL;
 
     this->base = NULL;
+
+    this->classifyRotation();
 }
 
 /**
@@ -180,6 +190,8 @@ CoordinateSystem::CoordinateSystem(Vector3d* axes, Vector3d origin, CoordinateSy
     this->setAxes(axes);
     this->setOrigin(origin);
     this->setBase(b);
+
+    this->classifyRotation();
 }
 
 /**
@@ -232,6 +244,8 @@ CoordinateSystem::CoordinateSystem(double* p, Vector3d origin, CoordinateSystem*
     ax = NULL;
 
     this->base = b;
+
+    this->classifyRotation();
 }
 
 // Assignment functions
@@ -379,6 +393,193 @@ void CoordinateSystem::calculateRotationMatrix()
         // The rotation matrix will be a unit matrix
         this->rotationMatrix = RotationMatrix(Matrix33::unitMatrix());
     }
+
+    this->classifyRotation();
+}
+
+/**
+ * @brief Checks if the rotation matrix is a planar rotation and caches its in-plane block.
+ * @details The rotation is planar if there is a row i and a column j of the rotation matrix such that the entry (i,j) is +1 or -1 and all other entries of the row and column are zero, to within PLANAR_ROTATION_TOLERANCE. The local axis i is then the base axis j up to its sign, and the remaining entries form an orthogonal 2x2 block. The z-axis is tried first so that rotations about the viewing axis keep the natural x-y block.
+ */
+void CoordinateSystem::classifyRotation()
+{
+    int i, j, k;
+    int n;
+    bool found = false;
+
+    this->planarRotation = false;
+
+    for (i=2; i>=0 && !found; i--) {
+        for (j=2; j>=0 && !found; j--) {
+            if (fabs(fabs(this->rotationMatrix.getValue(i, j)) - 1.0) > PLANAR_ROTATION_TOLERANCE) {
+                continue;
+            }
+
+            found = true;
+            for (k=0; k<3; k++) {
+                if (k != j && fabs(this->rotationMatrix.getValue(i, k)) > PLANAR_ROTATION_TOLERANCE) {
+                    found = false;
+                }
+                if (k != i && fabs(this->rotationMatrix.getValue(k, j)) > PLANAR_ROTATION_TOLERANCE) {
+                    found = false;
+                }
+            }
+
+            if (found) {
+                this->planarNormal[0] = i;
+                this->planarNormal[1] = j;
+            }
+        }
+    }
+
+    if (!found) {
+        return;
+    }
+
+    // In-plane axes in ascending order
+    n = 0;
+    for (k=0; k<3; k++) {
+        if (k != this->planarNormal[0]) {
+            this->planarAxes[n++] = k;
+        }
+    }
+    for (k=0; k<3; k++) {
+        if (k != this->planarNormal[1]) {
+            this->planarAxes[n++] = k;
+        }
+    }
+
+    if (this->rotationMatrix.getValue(this->planarNormal[0], this->planarNormal[1]) > 0.0) {
+        this->planarSign = 1.0;
+    }
+    else {
+        this->planarSign = -1.0;
+    }
+
+    this->planarBlock[0] = this->rotationMatrix.getValue(this->planarAxes[0], this->planarAxes[2]);
+    this->planarBlock[1] = this->rotationMatrix.getValue(this->planarAxes[0], this->planarAxes[3]);
+    this->planarBlock[2] = this->rotationMatrix.getValue(this->planarAxes[1], this->planarAxes[2]);
+    this->planarBlock[3] = this->rotationMatrix.getValue(this->planarAxes[1], this->planarAxes[3]);
+
+    this->planarRotation = true;
+}
+
+/**
+ * @brief Indicates whether the rotation from the base to the local system is planar.
+ * @details A planar rotation leaves one axis unchanged up to its sign, so that the vector and tensor transformations use the specialized in-plane path.
+ * @return True if the rotation is planar.
+ */
+bool CoordinateSystem::isPlanarRotation() const
+{
+    return (this->planarRotation);
+}
+
+/**
+ * @brief Rotates a vector using the planar rotation.
+ * @details This function must only be called if planarRotation is true. The common axis is copied with its sign and the in-plane components are transformed by the 2x2 block, or by its transpose for the inverse rotation.
+ * @param v The vector to be rotated.
+ * @param toLocal True for rotation from the base to the local system, false for the inverse.
+ * @return The rotated vector.
+ */
+Vector3d CoordinateSystem::vector_planarRotate(const Vector3d& v, bool toLocal) const
+{
+    // Indices in the source (from) and destination (to) systems
+    int nFrom, nTo;
+    int pFrom, qFrom, pTo, qTo;
+    double a, b, c, d;
+
+    if (toLocal) {
+        nFrom = this->planarNormal[1];  nTo = this->planarNormal[0];
+        pFrom = this->planarAxes[2];    qFrom = this->planarAxes[3];
+        pTo   = this->planarAxes[0];    qTo   = this->planarAxes[1];
+        a = this->planarBlock[0];       b = this->planarBlock[1];
+        c = this->planarBlock[2];       d = this->planarBlock[3];
+    }
+    else {
+        nFrom = this->planarNormal[0];  nTo = this->planarNormal[1];
+        pFrom = this->planarAxes[0];    qFrom = this->planarAxes[1];
+        pTo   = this->planarAxes[2];    qTo   = this->planarAxes[3];
+        a = this->planarBlock[0];       b = this->planarBlock[2];
+        c = this->planarBlock[1];       d = this->planarBlock[3];
+    }
+
+    double vp = v.getValue(pFrom);
+    double vq = v.getValue(qFrom);
+
+    Vector3d r;
+    r.setValue(nTo, this->planarSign * v.getValue(nFrom));
+    r.setValue(pTo, (a * vp) + (b * vq));
+    r.setValue(qTo, (c * vp) + (d * vq));
+
+    return (r);
+}
+
+/**
+ * @brief Rotates a symmetric tensor using the planar rotation.
+ * @details This function must only be called if planarRotation is true. With the in-plane block (a, b; c, d) and the sign e of the common axis n, the in-plane components need twelve products, the two out-of-plane shear components four, and the normal component along n is unchanged. The products are grouped as in the general product R*(S*R^T) so that both paths agree when the rotation is exactly planar.
+ * @param s The tensor to be rotated.
+ * @param toLocal True for rotation from the base to the local system, false for the inverse.
+ * @return The rotated tensor.
+ */
+template <class T>
+T CoordinateSystem::tensor_planarRotate(const T& s, bool toLocal) const
+{
+    // Indices in the source (from) and destination (to) systems
+    int nFrom, nTo;
+    int pFrom, qFrom, pTo, qTo;
+    double a, b, c, d;
+    double e = this->planarSign;
+
+    if (toLocal) {
+        nFrom = this->planarNormal[1];  nTo = this->planarNormal[0];
+        pFrom = this->planarAxes[2];    qFrom = this->planarAxes[3];
+        pTo   = this->planarAxes[0];    qTo   = this->planarAxes[1];
+        a = this->planarBlock[0];       b = this->planarBlock[1];
+        c = this->planarBlock[2];       d = this->planarBlock[3];
+    }
+    else {
+        nFrom = this->planarNormal[0];  nTo = this->planarNormal[1];
+        pFrom = this->planarAxes[0];    qFrom = this->planarAxes[1];
+        pTo   = this->planarAxes[2];    qTo   = this->planarAxes[3];
+        a = this->planarBlock[0];       b = this->planarBlock[2];
+        c = this->planarBlock[1];       d = this->planarBlock[3];
+    }
+
+    double spp = s.getValue(pFrom, pFrom);
+    double sqq = s.getValue(qFrom, qFrom);
+    double spq = s.getValue(pFrom, qFrom);
+    double snp = s.getValue(nFrom, pFrom);
+    double snq = s.getValue(nFrom, qFrom);
+
+    // Products of the tensor with the transposed block
+    double tpp = (spp * a) + (spq * b);
+    double tqp = (spq * a) + (sqq * b);
+    double tpq = (spp * c) + (spq * d);
+    double tqq = (spq * c) + (sqq * d);
+
+    double m[3][3];
+    m[nTo][nTo] = s.getValue(nFrom, nFrom);
+    m[pTo][pTo] = (a * tpp) + (b * tqp);
+    m[qTo][qTo] = (c * tpq) + (d * tqq);
+    m[pTo][qTo] = (a * tpq) + (b * tqq);
+    m[qTo][pTo] = m[pTo][qTo];
+    m[nTo][pTo] = e * ((snp * a) + (snq * b));
+    m[pTo][nTo] = m[nTo][pTo];
+    m[nTo][qTo] = e * ((snp * c) + (snq * d));
+    m[qTo][nTo] = m[nTo][qTo];
+
+    double principal[3];
+    double shear[3];
+    int i;
+
+    for (i=0; i<3; i++) {
+        principal[i] = m[i][i];
+    }
+    shear[0] = m[0][1];
+    shear[1] = m[0][2];
+    shear[2] = m[1][2];
+
+    return (T(principal, shear));
 }
 
 /**
@@ -391,7 +592,13 @@ Vector3d CoordinateSystem::vector_BaseToLocal(Vector3d vBase) const
     // Translation
     Vector3d vTranslated = vBase - this->o;
     // Rotation
-    Vector3d vLocal = this->rotationMatrix * vTranslated;
+    Vector3d vLocal;
+    if (this->planarRotation) {
+        vLocal = this->vector_planarRotate(vTranslated, true);
+    }
+    else {
+        vLocal = this->rotationMatrix * vTranslated;
+    }
 
     return(vLocal);
 }
@@ -423,7 +630,13 @@ std::vector<Vector3d> CoordinateSystem::vector_BaseToLocal(std::vector<Vector3d>
 Vector3d CoordinateSystem::vector_LocalToBase(Vector3d vLocal) const
 {
     // Rotation
-    Vector3d vRotated = this->rotationMatrix.transpose() * vLocal;
+    Vector3d vRotated;
+    if (this->planarRotation) {
+        vRotated = this->vector_planarRotate(vLocal, false);
+    }
+    else {
+        vRotated = this->rotationMatrix.transpose() * vLocal;
+    }
     // Translation
     Vector3d vBase = vRotated + this->o;
 
@@ -457,6 +670,10 @@ std::vector<Vector3d> CoordinateSystem::vector_LocalToBase(std::vector<Vector3d>
  */
 Vector3d CoordinateSystem::vector_BaseToLocal_noTranslate(Vector3d vBase) const
 {
+    if (this->planarRotation) {
+        return (this->vector_planarRotate(vBase, true));
+    }
+
     Vector3d vLocal = this->rotationMatrix * vBase;
     return(vLocal);
 }
@@ -489,6 +706,10 @@ std::vector<Vector3d> CoordinateSystem::vector_BaseToLocal_noTranslate(std::vect
  */
 Vector3d CoordinateSystem::vector_LocalToBase_noTranslate(Vector3d vLocal) const
 {
+    if (this->planarRotation) {
+        return (this->vector_planarRotate(vLocal, false));
+    }
+
     Vector3d vBase = this->rotationMatrix.transpose() * vLocal;
     return(vBase);
 }
@@ -520,6 +741,10 @@ std::vector<Vector3d> CoordinateSystem::vector_LocalToBase_noTranslate(std::vect
  */
 Stress CoordinateSystem::stress_BaseToLocal(Stress s) const
 {
+    if (this->planarRotation) {
+        return (this->tensor_planarRotate<Stress>(s, true));
+    }
+
     return (s.rotate(this->rotationMatrix));
 }
 
@@ -530,6 +755,10 @@ Stress CoordinateSystem::stress_BaseToLocal(Stress s) const
  */
 Stress CoordinateSystem::stress_LocalToBase(Stress s) const
 {
+    if (this->planarRotation) {
+        return (this->tensor_planarRotate<Stress>(s, false));
+    }
+
     return (s.rotate(this->rotationMatrix.transpose()));
 }
 
@@ -540,6 +769,10 @@ Stress CoordinateSystem::stress_LocalToBase(Stress s) const
  */
 Strain CoordinateSystem::strain_BaseToLocal(Strain s) const
 {
+    if (this->planarRotation) {
+        return (this->tensor_planarRotate<Strain>(s, true));
+    }
+
     return (s.rotate(this->rotationMatrix));
 }
 
@@ -550,5 +783,9 @@ Strain CoordinateSystem::strain_BaseToLocal(Strain s) const
  */
 Strain CoordinateSystem::strain_LocalToBase(Strain s) const
 {
+    if (this->planarRotation) {
+        return (this->tensor_planarRotate<Strain>(s, false));
+    }
+
     return (s.rotate(this->rotationMatrix.transpose()));
 }
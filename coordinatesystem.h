@@ -38,6 +38,10 @@
 #include "stress.h"
 #include "strain.h"
 
+#ifndef PLANAR_ROTATION_TOLERANCE
+#define PLANAR_ROTATION_TOLERANCE 1.0e-12
+#endif
+
 /**
  * @brief The CoordinateSystem class.
  * @details The CoordinateSystem class represents a co-ordinate system of an entity. It also includes a pointer to the instance of the same class representing the base on which it is expressed.
@@ -67,6 +71,59 @@ protected:
      * @brief An instance of the class RotationMatrix to express the system's rotation matrix for rotation from the base to the local system.
      */
     RotationMatrix rotationMatrix;
+
+    /**
+     * @brief Flag indicating that the rotation matrix is a planar rotation.
+     * @details The rotation is planar if one local axis coincides (up to its sign) with one axis of the base system. This is the case for rotations about the viewing z-axis, as well as for axis permutations and flips such as those of dislocation frames. The transformations then reduce to a 2x2 block and a sign, which is much cheaper than the general 3x3 product.
+     */
+    bool planarRotation;
+
+    /**
+     * @brief Indices of the axis that is common to the local and base systems.
+     * @details The first entry is the index of the axis in the local system and the second one its index in the base system.
+     */
+    int planarNormal[2];
+
+    /**
+     * @brief Indices of the in-plane axes.
+     * @details The first two entries are the in-plane axes of the local system, the last two those of the base system, both in ascending order.
+     */
+    int planarAxes[4];
+
+    /**
+     * @brief Sign relating the common axis of the local system to that of the base system.
+     */
+    double planarSign;
+
+    /**
+     * @brief The 2x2 in-plane block of the rotation matrix, stored row-wise.
+     * @details For a proper rotation by an angle about the common axis this is (cos, sin, -sin, cos). Flips appear as changes of sign of a row.
+     */
+    double planarBlock[4];
+
+    /**
+     * @brief Checks if the rotation matrix is a planar rotation and caches its in-plane block.
+     */
+    void classifyRotation();
+
+    /**
+     * @brief Rotates a symmetric tensor using the planar rotation.
+     * @details The tensor class must provide getValue(i,j) and a constructor taking the arrays of principal and shear components. This function must only be called if planarRotation is true.
+     * @param s The tensor to be rotated.
+     * @param toLocal True for rotation from the base to the local system, false for the inverse.
+     * @return The rotated tensor.
+     */
+    template <class T>
+    T tensor_planarRotate(const T& s, bool toLocal) const;
+
+    /**
+     * @brief Rotates a vector using the planar rotation.
+     * @details This function must only be called if planarRotation is true.
+     * @param v The vector to be rotated.
+     * @param toLocal True for rotation from the base to the local system, false for the inverse.
+     * @return The rotated vector.
+     */
+    Vector3d vector_planarRotate(const Vector3d& v, bool toLocal) const;
 public:
     // Constructors
     /**
@@ -173,6 +230,12 @@ public:
      * @return The rotation matrix.
      */
     RotationMatrix getRotationMatrix() const;
+    /**
+     * @brief Indicates whether the rotation from the base to the local system is planar.
+     * @details A planar rotation leaves one axis unchanged up to its sign, so that the vector and tensor transformations use the specialized in-plane path.
+     * @return True if the rotation is planar.
+     */
+    bool isPlanarRotation() const;
 
     // Operations
     /**
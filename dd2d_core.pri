@@ -0,0 +1,98 @@
+# Sources shared by the program (dd2d_matryoshka.pro) and the library (dd2d_library.pro)
+
+LIBS += -L/usr/lib -lgsl -lgslcblas -lm
+
+# POSIX shared memory of the live snapshots
+LIBS += -lrt
+
+QMAKE_CXXFLAGS += -fopenmp
+LIBS += -fopenmp
+
+SOURCES += \
+    vector3d.cpp \
+    tools.cpp \
+    stress.cpp \
+    strain.cpp \
+    statistics.cpp \
+    slipPlaneStatistics.cpp \
+    slipPlane.cpp \
+    simulateSingleSlipPlane.cpp \
+    rotationMatrix.cpp \
+    parameter.cpp \
+    matrix33.cpp \
+    dislocationSource.cpp \
+    dislocation.cpp \
+    defect.cpp \
+    standardSlipSystem.cpp \
+    coordinatesystem.cpp \
+    grainboundary.cpp \
+    freesurface.cpp \
+    slipPlaneLocalReactions.cpp \
+    slipsystem.cpp \
+    readFromFile.cpp \
+    simulateSingleSlipSystem.cpp \
+    slipSystemStatistics.cpp \
+    uniqueid.cpp \
+    grain.cpp \
+    simulateGrain.cpp \
+    grainStatistics.cpp \
+    tess2d.cpp \
+    kernelTable.cpp \
+    cellList.cpp \
+    stressProbes.cpp \
+    sweep.cpp \
+    simulation.cpp \
+    stepGenerator.cpp \
+    snapshotRing.cpp \
+    outputScheduler.cpp \
+    timeSeriesArchive.cpp \
+    textWriter.cpp \
+    vtkWriter.cpp \
+    burstCapture.cpp \
+    engineTuner.cpp
+
+HEADERS += \
+    vector3d.h \
+    tools.h \
+    stress.h \
+    strain.h \
+    statistics.h \
+    slipPlaneDefaults.h \
+    slipPlane.h \
+    simulateSingleSlipPlane.h \
+    rotationMatrix.h \
+    parameter.h \
+    matrix33.h \
+    dislocationSourceDefaults.h \
+    dislocationSource.h \
+    dislocationDefaults.h \
+    dislocation.h \
+    defect.h \
+    defectType.h \
+    standardSlipSystem.h \
+    constants.h \
+    coordinatesystem.h \
+    grainboundary.h \
+    freesurface.h \
+    slipsystem.h \
+    readFromFile.h \
+    simulateSingleSlipSystem.h \
+    uniqueid.h \
+    grain.h \
+    simulateGrain.h \
+    tess2d.h \
+    kernelTable.h \
+    dislocationCharacter.h \
+    cellList.h \
+    stressProbes.h \
+    sweep.h \
+    simulation.h \
+    stepGenerator.h \
+    snapshotRing.h \
+    outputScheduler.h \
+    timeSeriesArchive.h \
+    textWriter.h \
+    vtkWriter.h \
+    burstCapture.h \
+    engineTuner.h
+
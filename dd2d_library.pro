@@ -0,0 +1,9 @@
+# Static library with the simulation classes, for programs that drive the
+# simulation through the class Simulation instead of the parameter files.
+# Remove staticlib from CONFIG to build a shared library.
+TEMPLATE = lib
+TARGET = dd2d
+CONFIG += staticlib
+CONFIG -= qt
+
+include(dd2d_core.pri)
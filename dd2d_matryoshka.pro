@@ -3,66 +3,6 @@ CONFIG += console
 CONFIG -= app_bundle
 CONFIG -= qt
 
-LIBS += -L/usr/lib -lgsl -lgslcblas -lm
-
-SOURCES += main.cpp \
-    vector3d.cpp \
-    tools.cpp \
-    stress.cpp \
-    strain.cpp \
-    statistics.cpp \
-    slipPlaneStatistics.cpp \
-    slipPlane.cpp \
-    simulateSingleSlipPlane.cpp \
-    rotationMatrix.cpp \
-    parameter.cpp \
-    matrix33.cpp \
-    dislocationSource.cpp \
-    dislocation.cpp \
-    defect.cpp \
-    standardSlipSystem.cpp \
-    coordinatesystem.cpp \
-    grainboundary.cpp \
-    freesurface.cpp \
-    slipPlaneLocalReactions.cpp \
-    slipsystem.cpp \
-    readFromFile.cpp \
-    simulateSingleSlipSystem.cpp \
-    slipSystemStatistics.cpp \
-    uniqueid.cpp \
-    grain.cpp \
-    simulateGrain.cpp \
-    grainStatistics.cpp \
-    tess2d.cpp
-
-HEADERS += \
-    vector3d.h \
-    tools.h \
-    stress.h \
-    strain.h \
-    statistics.h \
-    slipPlaneDefaults.h \
-    slipPlane.h \
-    simulateSingleSlipPlane.h \
-    rotationMatrix.h \
-    parameter.h \
-    matrix33.h \
-    dislocationSourceDefaults.h \
-    dislocationSource.h \
-    dislocationDefaults.h \
-    dislocation.h \
-    defect.h \
-    defectType.h \
-    standardSlipSystem.h \
-    constants.h \
-    coordinatesystem.h \
-    grainboundary.h \
-    freesurface.h \
-    slipsystem.h \
-    readFromFile.h \
-    simulateSingleSlipSystem.h \
-    uniqueid.h \
-    grain.h \
-    simulateGrain.h \
-    tess2d.h
+include(dd2d_core.pri)
 
+SOURCES += main.cpp
@@ -47,6 +47,7 @@ Dislocation::Dislocation ()
     this->setLineVector ( Vector3d ( DEFAULT_LINEVECTOR_0, DEFAULT_LINEVECTOR_1, DEFAULT_LINEVECTOR_2) );
     this->bmag = DEFAULT_BURGERS_MAGNITUDE;
     this->mobile = true;
+    this->character = DEFAULT_DISLOCATION_CHARACTER;
 
     this->coordinateSystem.setDefaultVectors();
     this->coordinateSystem.setBase(NULL);
@@ -70,6 +71,7 @@ Dislocation::Dislocation (Vector3d burgers, Vector3d line, Vector3d position,  d
     this->lvec   = line;
     this->mobile = m;
     this->bmag   = bm;
+    this->character = DEFAULT_DISLOCATION_CHARACTER;
 
     /* The y-axis of the dislocation will be the slip plane normal.
      * In the slip plane's co-ordinate system, this will be [001].
@@ -112,6 +114,7 @@ Dislocation::Dislocation (Vector3d burgers, Vector3d line, Vector3d position, Co
     this->bvec = burgers;
     this->bmag = bm;
     this->mobile = m;
+    this->character = DEFAULT_DISLOCATION_CHARACTER;
 
     this->setParametersUniquesList();
 }
@@ -131,6 +134,28 @@ void Dislocation::setBurgers (Vector3d burgers)
 void Dislocation::calculateBurgersLocal ()
 {
     this->burgersLocal = this->coordinateSystem.vector_BaseToLocal_noTranslate(this->bvec);
+    this->classifyCharacter();
+}
+
+/**
+ * @brief Classifies the dislocation as pure edge, pure screw or mixed, depending on the components of the local Burgers vector.
+ * @details A component is considered to be zero if it is smaller than SMALL_NUMBER times the magnitude of the local Burgers vector. This function is called by Dislocation::calculateBurgersLocal.
+ */
+void Dislocation::classifyCharacter ()
+{
+    double limit = SMALL_NUMBER * this->burgersLocal.magnitude();
+    bool hasEdge  = ( fabs(this->burgersLocal.getValue(0)) > limit );
+    bool hasScrew = ( fabs(this->burgersLocal.getValue(2)) > limit );
+
+    if (hasEdge && !hasScrew) {
+        this->character = EDGE;
+    }
+    else if (hasScrew && !hasEdge) {
+        this->character = SCREW;
+    }
+    else {
+        this->character = MIXED;
+    }
 }
 
 /**
@@ -217,6 +242,15 @@ double Dislocation::getBurgersMagnitude () const
     return ( this->bmag );
 }
 
+/**
+ * @brief Gets the character of the dislocation.
+ * @return The character of the dislocation: EDGE, SCREW or MIXED.
+ */
+DislocationCharacter Dislocation::getCharacter () const
+{
+    return ( this->character );
+}
+
 /**
  * @brief Gets the line vector of the dislocation.
  * @return Line vector in a variable of type Vector3d.
@@ -327,21 +361,52 @@ Stress Dislocation::stressField (Vector3d p, double mu, double nu)
  * @return Stress tensor, expressed in the dislocation's local co-ordinate system.
  */
 Stress Dislocation::stressFieldLocal (Vector3d p, double mu, double nu) const
-{    
-    return ( this->stressFieldLocal_edge(p, mu, nu) + this->stressFieldLocal_screw(p, mu) );
+{
+    switch (this->character) {
+    case EDGE:
+        return ( this->stressFieldLocal_character<EDGE>(p, mu, nu) );
+    case SCREW:
+        return ( this->stressFieldLocal_character<SCREW>(p, mu, nu) );
+    default:
+        return ( this->stressFieldLocal_character<MIXED>(p, mu, nu) );
+    }
 }
 
 /**
- * @brief Calculates the stress field due to the screw component of the dislocation in the local co-ordinate system.
- * @details The stress field due to the screw component of the dislocation is calculated at the position indicated by the argument. The stress tensor is expressed in the dislocation's local co-ordinate system.
+ * @brief Calculates the stress field due to the dislocation in the local co-ordinate system, for the dislocation character C.
+ * @details Only the terms that are non-zero for the character C are evaluated. The selection is made at compile time. The components are those of Dislocation::edgeStressField and Dislocation::screwStressField, which also fill the kernel tables.
  * @param p Position vector of the point where the stress field is to be calculated. This position vector is calculated in the local co-ordinate system, taking the dislocation as the origin.
  * @param mu Shear modulus in Pascals.
- * @return Stress tensor due to the dislocations screw component, expressed in the dislocation's local co-ordinate system.
+ * @param nu Poisson's ratio.
+ * @return Stress tensor, expressed in the dislocation's local co-ordinate system.
  */
-Stress Dislocation::stressFieldLocal_screw (Vector3d p, double mu) const
+template <DislocationCharacter C>
+Stress Dislocation::stressFieldLocal_character (Vector3d p, double mu, double nu) const
 {
-    double D = ( mu * this->bmag * this->burgersLocal.getValue(2) ) / ( 2.0 * PI );	// Constant for all components of the stress tensor
+    Stress s;
 
+    if (C != SCREW) {
+        // Edge component
+        s = Dislocation::edgeStressField(p, ( mu * this->bmag * this->burgersLocal.getValue(0) ) / ( 2.0 * PI * ( 1.0 - nu ) ), nu);
+    }
+
+    if (C != EDGE) {
+        // Screw component
+        s += Dislocation::screwStressField(p, ( mu * this->bmag * this->burgersLocal.getValue(2) ) / ( 2.0 * PI ));
+    }
+
+    return (s);
+}
+
+/**
+ * @brief Calculates the stress field of a screw dislocation in its local co-ordinate system.
+ * @details The stress field is calculated for the prefactor D, which is the product of the shear modulus with the screw component of the Burgers vector, divided by 2*pi. The function does not depend on the state of a Dislocation object and can be used for tabulating the stress field.
+ * @param p Position vector of the point where the stress field is to be calculated, in the local co-ordinate system of the dislocation.
+ * @param D Prefactor of the stress field.
+ * @return Stress tensor, expressed in the dislocation's local co-ordinate system.
+ */
+Stress Dislocation::screwStressField (Vector3d p, double D)
+{
     double x, y, denominator;	// Terms that appear repeatedly in the stress tensor
 
     x = p.getValue (0);
@@ -366,17 +431,15 @@ Stress Dislocation::stressFieldLocal_screw (Vector3d p, double mu) const
 }
 
 /**
- * @brief Calculates the stress field due to the edge component of the dislocation in the local co-ordinate system.
- * @details The stress field due to the edge component of the dislocation is calculated at the position indicated by the argument. The stress tensor is expressed in the dislocation's local co-ordinate system.
- * @param p Position vector of the point where the stress field is to be calculated. This position vector is calculated in the local co-ordinate system, taking the dislocation as the origin.
- * @param mu Shear modulus in Pascals.
+ * @brief Calculates the stress field of an edge dislocation in its local co-ordinate system.
+ * @details The stress field is calculated for the prefactor D, which is the product of the shear modulus with the edge component of the Burgers vector, divided by 2*pi*(1-nu). The function does not depend on the state of a Dislocation object and can be used for tabulating the stress field.
+ * @param p Position vector of the point where the stress field is to be calculated, in the local co-ordinate system of the dislocation.
+ * @param D Prefactor of the stress field.
  * @param nu Poisson's ratio.
- * @return Stress tensor due to the dislocations edge component, expressed in the dislocation's local co-ordinate system.
+ * @return Stress tensor, expressed in the dislocation's local co-ordinate system.
  */
-Stress Dislocation::stressFieldLocal_edge (Vector3d p, double mu, double nu) const
+Stress Dislocation::edgeStressField (Vector3d p, double D, double nu)
 {
-    double D = ( mu * this->bmag * this->burgersLocal.getValue(0) ) / ( 2.0 * PI * ( 1.0 - nu ) );	// Constant for all components of the stress tensor
-
     double x, y, denominator;	// Terms that appear repeatedly in the stress tensor
 
     x = p.getValue (0);
@@ -414,9 +477,18 @@ Vector3d Dislocation::forcePeachKoehler (Stress sigma) const
     //Vector3d burgersLocal = this->coordinateSystem.vector_BaseToLocal_noTranslate(this->bvec);
 
     // Forces
-    Vector3d f_edge  = Vector3d(-1.0*sigmaLocal.getValue(0,1), sigmaLocal.getValue(0,0), 0.0) * this->burgersLocal.getValue(0);
-    Vector3d f_screw = Vector3d(-1.0*sigmaLocal.getValue(1,2), sigmaLocal.getValue(0,2), 0.0) * this->burgersLocal.getValue(2);
-    Vector3d force = f_edge + f_screw;
+    Vector3d force;
+    switch (this->character) {
+    case EDGE:
+        force = this->forcePeachKoehler_character<EDGE>(sigmaLocal);
+        break;
+    case SCREW:
+        force = this->forcePeachKoehler_character<SCREW>(sigmaLocal);
+        break;
+    default:
+        force = this->forcePeachKoehler_character<MIXED>(sigmaLocal);
+        break;
+    }
 
     // Rotate to base system
     Vector3d force_base = this->coordinateSystem.vector_LocalToBase_noTranslate(force);
@@ -424,6 +496,63 @@ Vector3d Dislocation::forcePeachKoehler (Stress sigma) const
     return (force_base);
 }
 
+/**
+ * @brief Calculates the image force exerted on the dislocation by a free surface.
+ * @details The free surface is replaced by an image dislocation of opposite Burgers vector, placed symmetrically with respect to the surface point on the line of the slip plane. Since the image has the same line vector, its stress field at the dislocation is the negative of the field of the present dislocation at twice the distance to the surface, and the force follows from the kernels of the dislocation character without creating the image.
+ * @param surfacePosition Position vector of the free surface, in the base co-ordinate system.
+ * @param mu Shear modulus in Pascals.
+ * @param nu Poisson's ratio.
+ * @return The image force, expressed in the base co-ordinate system.
+ */
+Vector3d Dislocation::imageForce (Vector3d surfacePosition, double mu, double nu) const
+{
+    // Position of the dislocation relative to its image, in the local co-ordinate system
+    Vector3d r = this->coordinateSystem.vector_BaseToLocal_noTranslate((this->getPosition() - surfacePosition) * 2.0);
+
+    // The force is linear in the Burgers vector of the image, which is opposite to that of the dislocation
+    Vector3d force;
+    switch (this->character) {
+    case EDGE:
+        force = this->forcePeachKoehler_character<EDGE>(this->stressFieldLocal_character<EDGE>(r, mu, nu)) * (-1.0);
+        break;
+    case SCREW:
+        force = this->forcePeachKoehler_character<SCREW>(this->stressFieldLocal_character<SCREW>(r, mu, nu)) * (-1.0);
+        break;
+    default:
+        force = this->forcePeachKoehler_character<MIXED>(this->stressFieldLocal_character<MIXED>(r, mu, nu)) * (-1.0);
+        break;
+    }
+
+    // Rotate to base system
+    return (this->coordinateSystem.vector_LocalToBase_noTranslate(force));
+}
+
+/**
+ * @brief Calculates the Peach-Koehler force in the local co-ordinate system, for the dislocation character C.
+ * @details Only the terms that are non-zero for the character C are evaluated. The selection is made at compile time.
+ * @param sigmaLocal The stress tensor, expressed in the local co-ordinate system.
+ * @return The Peach-Koehler force on the dislocation, expressed in the local co-ordinate system.
+ */
+template <DislocationCharacter C>
+Vector3d Dislocation::forcePeachKoehler_character (const Stress& sigmaLocal) const
+{
+    double f[3] = {0.0, 0.0, 0.0};
+
+    if (C != SCREW) {
+        // Edge component
+        f[0] += -1.0 * sigmaLocal.getValue(0,1) * this->burgersLocal.getValue(0);
+        f[1] += sigmaLocal.getValue(0,0) * this->burgersLocal.getValue(0);
+    }
+
+    if (C != EDGE) {
+        // Screw component
+        f[0] += -1.0 * sigmaLocal.getValue(1,2) * this->burgersLocal.getValue(2);
+        f[1] += sigmaLocal.getValue(0,2) * this->burgersLocal.getValue(2);
+    }
+
+    return (Vector3d(f));
+}
+
 /**
  * @brief Returns the ideal time increment for the dislocation.
  * @details A dislocation is not allowed to approach another defect beyond a certain distance, specified by the argument minDistance. This function calculates the ideal time increment for this dislocation to not collide with the defect.
@@ -37,6 +37,7 @@
 
 #include "defect.h"
 #include "dislocationDefaults.h"
+#include "dislocationCharacter.h"
 #include "constants.h"
 
 /**
@@ -55,6 +56,12 @@ protected:
    * @brief Burgers vector of the dislocation, in the dislocation co-ordinate system.
    */
   Vector3d burgersLocal;
+
+  /**
+   * @brief Character of the dislocation, determined from the local Burgers vector.
+   * @details The character is updated each time the local Burgers vector is calculated. It decides which of the specialized stress field and force kernels is used.
+   */
+  DislocationCharacter character;
   
   /**
    * @brief Line vector of the dislocation, in the slip-plane co-ordinate system.
@@ -96,6 +103,26 @@ protected:
    * @details The velocity of the dislocation is stored into this vector in each iteration. The time stamps are stored at the global level by a similar vector that stores the time. The data in this vector may be useful for calculating average velocities over a given time period.
    */
   std::vector<Vector3d> velocities;
+
+  /**
+   * @brief Calculates the stress field due to the dislocation in the local co-ordinate system, for the dislocation character C.
+   * @details Only the terms that are non-zero for the character C are evaluated. The selection is made at compile time. The components are those of Dislocation::edgeStressField and Dislocation::screwStressField, which also fill the kernel tables.
+   * @param p Position vector of the point where the stress field is to be calculated. This position vector is calculated in the local co-ordinate system, taking the dislocation as the origin.
+   * @param mu Shear modulus in Pascals.
+   * @param nu Poisson's ratio.
+   * @return Stress tensor, expressed in the dislocation's local co-ordinate system.
+   */
+  template <DislocationCharacter C>
+  Stress stressFieldLocal_character (Vector3d p, double mu, double nu) const;
+
+  /**
+   * @brief Calculates the Peach-Koehler force in the local co-ordinate system, for the dislocation character C.
+   * @details Only the terms that are non-zero for the character C are evaluated. The selection is made at compile time.
+   * @param sigmaLocal The stress tensor, expressed in the local co-ordinate system.
+   * @return The Peach-Koehler force on the dislocation, expressed in the local co-ordinate system.
+   */
+  template <DislocationCharacter C>
+  Vector3d forcePeachKoehler_character (const Stress& sigmaLocal) const;
   
 public:
   // Constructors
@@ -150,6 +177,11 @@ public:
    * @brief Calculates the private variable burgersLocal representing the Burgers vector in the dislocation's co-ordinate system.
    */
   void calculateBurgersLocal ();
+  /**
+   * @brief Classifies the dislocation as pure edge, pure screw or mixed, depending on the components of the local Burgers vector.
+   * @details A component is considered to be zero if it is smaller than SMALL_NUMBER times the magnitude of the local Burgers vector. This function is called by Dislocation::calculateBurgersLocal.
+   */
+  void classifyCharacter ();
   /**
    * @brief Sets the magnitude of the Burgers vector of the dislocation.
    * @param b Magnitude of the Burgers vector of the dislocation.
@@ -217,6 +249,11 @@ public:
    * @return Magnitude of the Burgers vector.
    */
   double getBurgersMagnitude () const;
+  /**
+   * @brief Gets the character of the dislocation.
+   * @return The character of the dislocation: EDGE, SCREW or MIXED.
+   */
+  DislocationCharacter getCharacter () const;
   /**
    * @brief Gets the line vector of the dislocation.
    * @return Line vector in a variable of type Vector3d.
@@ -278,23 +315,23 @@ public:
   Stress stressFieldLocal (Vector3d p, double mu, double nu) const;
 
   /**
-   * @brief Calculates the stress field due to the screw component of the dislocation in the local co-ordinate system.
-   * @details The stress field due to the screw component of the dislocation is calculated at the position indicated by the argument. The stress tensor is expressed in the dislocation's local co-ordinate system.
-   * @param p Position vector of the point where the stress field is to be calculated. This position vector is calculated in the local co-ordinate system, taking the dislocation as the origin.
-   * @param mu Shear modulus in Pascals.
-   * @return Stress tensor due to the dislocations screw component, expressed in the dislocation's local co-ordinate system.
+   * @brief Calculates the stress field of a screw dislocation in its local co-ordinate system.
+   * @details The stress field is calculated for the prefactor D, which is the product of the shear modulus with the screw component of the Burgers vector, divided by 2*pi. The function does not depend on the state of a Dislocation object and can be used for tabulating the stress field.
+   * @param p Position vector of the point where the stress field is to be calculated, in the local co-ordinate system of the dislocation.
+   * @param D Prefactor of the stress field.
+   * @return Stress tensor, expressed in the dislocation's local co-ordinate system.
    */
-  Stress stressFieldLocal_screw (Vector3d p, double mu) const;
+  static Stress screwStressField (Vector3d p, double D);
 
   /**
-   * @brief Calculates the stress field due to the edge component of the dislocation in the local co-ordinate system.
-   * @details The stress field due to the edge component of the dislocation is calculated at the position indicated by the argument. The stress tensor is expressed in the dislocation's local co-ordinate system.
-   * @param p Position vector of the point where the stress field is to be calculated. This position vector is calculated in the local co-ordinate system, taking the dislocation as the origin.
-   * @param mu Shear modulus in Pascals.
+   * @brief Calculates the stress field of an edge dislocation in its local co-ordinate system.
+   * @details The stress field is calculated for the prefactor D, which is the product of the shear modulus with the edge component of the Burgers vector, divided by 2*pi*(1-nu). The function does not depend on the state of a Dislocation object and can be used for tabulating the stress field.
+   * @param p Position vector of the point where the stress field is to be calculated, in the local co-ordinate system of the dislocation.
+   * @param D Prefactor of the stress field.
    * @param nu Poisson's ratio.
-   * @return Stress tensor due to the dislocations edge component, expressed in the dislocation's local co-ordinate system.
+   * @return Stress tensor, expressed in the dislocation's local co-ordinate system.
    */
-  Stress stressFieldLocal_edge (Vector3d p, double mu, double nu) const;
+  static Stress edgeStressField (Vector3d p, double D, double nu);
   
   // Force
   /**
@@ -305,6 +342,16 @@ public:
    */
   Vector3d forcePeachKoehler (Stress sigma) const;
 
+  /**
+   * @brief Calculates the image force exerted on the dislocation by a free surface.
+   * @details The free surface is replaced by an image dislocation of opposite Burgers vector, placed symmetrically with respect to the surface point on the line of the slip plane. Since the image has the same line vector, its stress field at the dislocation is the negative of the field of the present dislocation at twice the distance to the surface, and the force follows from the kernels of the dislocation character without creating the image.
+   * @param surfacePosition Position vector of the free surface, in the base co-ordinate system.
+   * @param mu Shear modulus in Pascals.
+   * @param nu Poisson's ratio.
+   * @return The image force, expressed in the base co-ordinate system.
+   */
+  Vector3d imageForce (Vector3d surfacePosition, double mu, double nu) const;
+
   /**
    * @brief Returns the ideal time increment for the dislocation.
    * @details A dislocation is not allowed to approach another defect beyond a certain distance, specified by the argument minDistance. This function calculates the ideal time increment for this dislocation to not collide with the defect.
@@ -0,0 +1,51 @@
+/**
+ * @file dislocationCharacter.h
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the enumerated type DislocationCharacter.
+ * @details This file defines the enumerated type DislocationCharacter indicating whether a dislocation has a pure edge, pure screw or mixed character.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISLOCATIONCHARACTER_H
+#define DISLOCATIONCHARACTER_H
+
+/**
+ * @brief Enumerated type indicating the character of a dislocation.
+ * @details The character is determined from the Burgers vector expressed in the dislocation co-ordinate system: the edge component is along the local x-axis and the screw component along the line vector, the local z-axis. It is used for choosing the stress field and force kernels that only evaluate the non-zero terms.
+ */
+enum DislocationCharacter {
+    EDGE = 0,
+    SCREW,
+    MIXED
+};
+
+/**
+  * @brief The default dislocation character. Both components are evaluated for this character.
+  **/
+#ifndef DEFAULT_DISLOCATION_CHARACTER
+#define DEFAULT_DISLOCATION_CHARACTER MIXED
+#endif
+
+#endif // DISLOCATIONCHARACTER_H
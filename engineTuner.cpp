@@ -0,0 +1,441 @@
+/**
+ * @file engineTuner.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the member functions of the class EngineTuner.
+ * @details This file defines the member functions of the class EngineTuner, which times the methods available for calculating the stresses on the defects of a grain on the present configuration and selects the fastest one for each slip plane within an accuracy budget.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "engineTuner.h"
+
+// Constructors
+/**
+ * @brief Default constructor. The tuning is disabled.
+ */
+EngineTuner::EngineTuner ()
+{
+    this->nSteps = 0;
+    this->nTunings = 0;
+    this->useCellList = false;
+    this->configure(false, ENGINETUNER_DEFAULT_ACCURACY, ENGINETUNER_DEFAULT_INTERVAL, 0.0, -1.0, KERNELTABLE_DEFAULT_TOLERANCE, false, "");
+}
+
+// Assignment functions
+/**
+ * @brief Sets the parameters of the tuning. The methods are tuned again at the next time step.
+ * @param enabled Flag indicating whether the methods are tuned.
+ * @param accuracy Largest deviation allowed, relative to the largest component of the exact stress field on a slip plane.
+ * @param interval Number of time steps between two tunings. Zero only tunes at the first time step.
+ * @param cutoff Cut-off radius of the cell list. The cell list is not a candidate if it is zero or negative.
+ * @param skin Skin distance of the cell list.
+ * @param kernelTolerance Maximum interpolation error of the kernel tables, relative to the peak value of each kernel.
+ * @param singlePrecision Flag indicating whether the kernel tables are interpolated in single precision.
+ * @param logFileName Name of the log file. No log is written if it is empty.
+ */
+void EngineTuner::configure (bool enabled, double accuracy, int interval, double cutoff, double skin, double kernelTolerance, bool singlePrecision, std::string logFileName)
+{
+    this->enabled = enabled;
+    this->accuracy = accuracy;
+    this->interval = (interval > 0) ? interval : 0;
+    this->cutoff = (cutoff > 0.0) ? cutoff : 0.0;
+    this->skin = skin;
+    this->kernelTolerance = kernelTolerance;
+    this->singlePrecision = singlePrecision;
+    this->logFileName = logFileName;
+
+    this->cellList.setCutoff(this->cutoff, this->skin);
+    // Tune at the next time step
+    this->stepsSinceTuning = -1;
+}
+
+// Access functions
+/**
+ * @brief Indicates whether the methods are tuned.
+ * @return True if the tuning is enabled.
+ */
+bool EngineTuner::isEnabled () const
+{
+    return (this->enabled);
+}
+
+/**
+ * @brief Indicates whether the cell list was selected at the last tuning.
+ * @return True if the cell list was selected.
+ */
+bool EngineTuner::usesCellList () const
+{
+    return (this->useCellList);
+}
+
+/**
+ * @brief Get the cut-off radius of the cell list.
+ * @return The cut-off radius.
+ */
+double EngineTuner::getCutoff () const
+{
+    return (this->cutoff);
+}
+
+/**
+ * @brief Get the skin distance of the cell list.
+ * @return The skin distance.
+ */
+double EngineTuner::getSkin () const
+{
+    return (this->skin);
+}
+
+/**
+ * @brief Get the number of tunings carried out.
+ * @return The number of tunings.
+ */
+int EngineTuner::getNumTunings () const
+{
+    return (this->nTunings);
+}
+
+/**
+ * @brief Get the measurements and decisions of the last tuning.
+ * @return Reference to the vector holding them, one entry per slip plane.
+ */
+const std::vector<EngineTiming>& EngineTuner::getTimings () const
+{
+    return (this->timings);
+}
+
+/**
+ * @brief Describes the decisions of the last tuning in a few words.
+ * @return The description.
+ */
+std::string EngineTuner::getDecision () const
+{
+    if (this->nTunings == 0) {
+        return ("");
+    }
+
+    if (this->useCellList) {
+        return ("cell list");
+    }
+
+    int nTabulated = 0;
+    std::vector<EngineTiming>::const_iterator t_it;
+    for (t_it=this->timings.begin(); t_it!=this->timings.end(); t_it++) {
+        if (t_it->engine == ENGINE_TABULATED) {
+            nTabulated++;
+        }
+    }
+
+    return ("kernel tables on " + intToString(nTabulated) + " of " + intToString(this->timings.size()) + " slip planes");
+}
+
+// Operations
+/**
+ * @brief Counts a time step and indicates whether the methods are to be tuned at this step.
+ * @return True at the first time step and then every EngineTuner::interval time steps, if the tuning is enabled.
+ */
+bool EngineTuner::step ()
+{
+    if (!this->enabled) {
+        return (false);
+    }
+
+    this->nSteps++;
+    if (this->stepsSinceTuning < 0) {
+        return (true);
+    }
+
+    this->stepsSinceTuning++;
+    return (this->interval > 0 && this->stepsSinceTuning >= this->interval);
+}
+
+/**
+ * @brief Times the methods on the present configuration and selects them.
+ * @details The selection of the kernel tables is applied to the slip systems with SlipSystem::setKernelTables and SlipSystem::setTabulatedSlipPlanes. The selection of the cell list is returned, to be applied by the grain.
+ * @param slipSystems The slip systems of the grain.
+ * @param grainSystem Pointer to the grain co-ordinate system.
+ * @param mu Shear modulus (Pa).
+ * @param nu Poisson's ratio.
+ * @return True if the cell list is selected.
+ */
+bool EngineTuner::tune (std::vector<SlipSystem*> slipSystems, CoordinateSystem* grainSystem, double mu, double nu)
+{
+    int nSystems = slipSystems.size();
+    std::vector<double> tPrepare (nSystems, 0.0);
+    std::vector<SlipPlane*> slipPlanes;
+    double t0;
+    int d, i, k;
+
+    this->slipSystems = slipSystems;
+    this->timings.clear();
+
+    // The kernel tables of all slip systems: the first refreshment builds the missing tables, the second one is timed
+    for (d=0; d<nSystems; d++) {
+        this->slipSystems[d]->setKernelTables(true, this->kernelTolerance, this->singlePrecision);
+        this->slipSystems[d]->prepareKernelTables(mu, nu);
+        t0 = EngineTuner::wallTime();
+        this->slipSystems[d]->prepareKernelTables(mu, nu);
+        tPrepare[d] = EngineTuner::wallTime() - t0;
+    }
+
+    // The cell list: the first update bins the dislocations, the second one is timed
+    double tCellList = 0.0;
+    bool cellListCandidate = (this->cutoff > 0.0);
+    if (cellListCandidate) {
+        Vector3d viewAxis = grainSystem->vector_BaseToLocal_noTranslate(Vector3d::unitVector(2));
+        this->cellList.update(this->slipSystems, grainSystem, viewAxis);
+        t0 = EngineTuner::wallTime();
+        this->cellList.update(this->slipSystems, grainSystem, viewAxis);
+        tCellList = EngineTuner::wallTime() - t0;
+    }
+
+    // Time the methods on each slip plane
+    std::vector<Stress> own, others, tabulated, cells, exact;
+    EngineTiming timing;
+    double magnitude;
+    int j;
+
+    for (d=0; d<nSystems; d++) {
+        slipPlanes = this->slipSystems[d]->getSlipPlanes();
+        for (i=0; i<slipPlanes.size(); i++) {
+            this->receivers = slipPlanes[i]->getStressReceivers();
+            this->positions = this->slipSystems[d]->getCoordinateSystem()->vector_LocalToBase(slipPlanes[i]->getStressReceiverPositions_base(this->receivers));
+
+            timing.slipSystem = d;
+            timing.slipPlane = i;
+            timing.nReceivers = this->receivers.size();
+            timing.tDirect = this->evaluate(ENGINE_DIRECT, d, i, false, mu, nu, &own);
+            timing.tOtherSystems = this->evaluate(ENGINE_DIRECT, d, i, true, mu, nu, &others);
+            timing.tTabulated = this->evaluate(ENGINE_TABULATED, d, i, false, mu, nu, &tabulated);
+            timing.tCellList = 0.0;
+            timing.tabulatedError = 0.0;
+            timing.cellListError = 0.0;
+
+            // Exact stress field of all slip systems
+            exact = own;
+            magnitude = 0.0;
+            for (k=0; k<exact.size(); k++) {
+                exact[k] += others[k];
+                for (j=0; j<9; j++) {
+                    magnitude = std::max(magnitude, fabs(exact[k].getValue(j/3, j%3)));
+                }
+            }
+
+            if (magnitude > 0.0) {
+                timing.tabulatedError = EngineTuner::deviation(tabulated, own) / magnitude;
+            }
+
+            if (cellListCandidate) {
+                timing.tCellList = this->evaluate(ENGINE_CELLLIST, d, i, false, mu, nu, &cells);
+                tCellList += timing.tCellList;
+                if (magnitude > 0.0) {
+                    timing.cellListError = EngineTuner::deviation(cells, exact) / magnitude;
+                }
+                if (timing.cellListError > this->accuracy) {
+                    cellListCandidate = false;
+                }
+            }
+
+            if (timing.tabulatedError <= this->accuracy && timing.tTabulated < timing.tDirect) {
+                timing.engine = ENGINE_TABULATED;
+            }
+            else {
+                timing.engine = ENGINE_DIRECT;
+            }
+            this->timings.push_back(timing);
+        }
+    }
+
+    // The kernel tables are kept on a slip system if the time they save covers the refreshment of their data
+    std::vector<double> saving (nSystems, 0.0);
+    std::vector<EngineTiming>::iterator t_it;
+    for (t_it=this->timings.begin(); t_it!=this->timings.end(); t_it++) {
+        if (t_it->engine == ENGINE_TABULATED) {
+            saving[t_it->slipSystem] += t_it->tDirect - t_it->tTabulated;
+        }
+    }
+
+    double tSlipSystems = 0.0;
+    for (t_it=this->timings.begin(); t_it!=this->timings.end(); t_it++) {
+        if (t_it->engine == ENGINE_TABULATED && saving[t_it->slipSystem] <= tPrepare[t_it->slipSystem]) {
+            t_it->engine = ENGINE_DIRECT;
+        }
+        tSlipSystems += t_it->tOtherSystems + ((t_it->engine == ENGINE_TABULATED) ? t_it->tTabulated : t_it->tDirect);
+    }
+
+    // Apply the selection of the kernel tables
+    std::vector<bool> selected;
+    bool anyTabulated;
+    t_it = this->timings.begin();
+    for (d=0; d<nSystems; d++) {
+        slipPlanes = this->slipSystems[d]->getSlipPlanes();
+        selected.assign(slipPlanes.size(), false);
+        anyTabulated = false;
+        for (i=0; i<slipPlanes.size(); i++, t_it++) {
+            selected[i] = (t_it->engine == ENGINE_TABULATED);
+            anyTabulated = (anyTabulated || selected[i]);
+        }
+        if (anyTabulated) {
+            tSlipSystems += tPrepare[d];
+            this->slipSystems[d]->setTabulatedSlipPlanes(selected);
+        }
+        else {
+            this->slipSystems[d]->setKernelTables(false, this->kernelTolerance, this->singlePrecision);
+        }
+    }
+
+    // The cell list replaces the methods of all slip planes
+    this->useCellList = (cellListCandidate && tCellList < tSlipSystems);
+    if (this->useCellList) {
+        for (t_it=this->timings.begin(); t_it!=this->timings.end(); t_it++) {
+            t_it->engine = ENGINE_CELLLIST;
+        }
+    }
+
+    this->stepsSinceTuning = 0;
+    this->nTunings++;
+    this->writeLog();
+
+    this->receivers.clear();
+    this->positions.clear();
+    this->slipSystems.clear();
+
+    return (this->useCellList);
+}
+
+/**
+ * @brief Calculates the stress at the defects of the slip plane being timed with one method, repeating the calculation until ENGINETUNER_MIN_SAMPLE_TIME has elapsed or ENGINETUNER_MAX_REPETITIONS is reached.
+ * @param engine The method. ENGINE_DIRECT and ENGINE_TABULATED only include the stress field of the slip system d, or of the other slip systems if otherSystems is true, and ENGINE_CELLLIST includes all slip systems.
+ * @param d Index of the slip system.
+ * @param i Index of the slip plane in the slip system.
+ * @param otherSystems Flag indicating whether the stress field of the other slip systems is calculated instead, exactly.
+ * @param mu Shear modulus (Pa).
+ * @param nu Poisson's ratio.
+ * @param result Pointer to the vector receiving the stresses, in the grain co-ordinate system.
+ * @return The time taken by one calculation, in seconds.
+ */
+double EngineTuner::evaluate (StressEngine engine, int d, int i, bool otherSystems, double mu, double nu, std::vector<Stress>* result)
+{
+    int nReceivers = this->receivers.size();
+    int nSystems = this->slipSystems.size();
+    SlipSystem* slipSystem = this->slipSystems[d];
+    Stress s;
+    int k, n;
+
+    result->assign(nReceivers, Stress());
+    if (nReceivers == 0) {
+        return (0.0);
+    }
+
+    int repetitions = 0;
+    double t0 = EngineTuner::wallTime();
+    double elapsed;
+
+    do {
+        for (k=0; k<nReceivers; k++) {
+            switch (engine) {
+            case ENGINE_TABULATED:
+                s = slipSystem->getCoordinateSystem()->stress_LocalToBase(slipSystem->slipSystemStressField_tabulated(i, this->receivers[k]->getPosition(), mu, nu));
+                break;
+            case ENGINE_CELLLIST:
+                s = this->cellList.stressField(this->positions[k], mu, nu);
+                break;
+            default:
+                if (otherSystems) {
+                    s = Stress();
+                    for (n=0; n<nSystems; n++) {
+                        if (n != d) {
+                            s += this->slipSystems[n]->slipSystemStressField(this->positions[k], mu, nu);
+                        }
+                    }
+                }
+                else {
+                    s = slipSystem->slipSystemStressField(this->positions[k], mu, nu);
+                }
+                break;
+            }
+            (*result)[k] = s;
+        }
+        repetitions++;
+        elapsed = EngineTuner::wallTime() - t0;
+    } while (elapsed < ENGINETUNER_MIN_SAMPLE_TIME && repetitions < ENGINETUNER_MAX_REPETITIONS);
+
+    return (elapsed / (double) repetitions);
+}
+
+/**
+ * @brief Writes the measurements and decisions of the last tuning to the log file.
+ * @details Each line holds, for one slip plane, the number of time steps counted, the indices of the slip system and of the slip plane, the number of defects receiving the stress, the method selected (the value of StressEngine), the times taken by the exact calculation and by the kernel tables for the stress field of the slip system, by the exact calculation for the other slip systems and by the cell list for all slip systems, and the deviations of the kernel tables and of the cell list. The cell list is not timed on the slip planes following one on which it exceeds the accuracy budget, and its values are then zero. The file is opened in append mode.
+ */
+void EngineTuner::writeLog ()
+{
+    if (this->logFileName.empty()) {
+        return;
+    }
+
+    TextWriter* fp = TextWriter::get(this->logFileName);
+    if (fp == NULL) {
+        return;
+    }
+
+    std::vector<EngineTiming>::iterator t_it;
+    for (t_it=this->timings.begin(); t_it!=this->timings.end(); t_it++) {
+        *fp << this->nSteps << ' ' << t_it->slipSystem << ' ' << t_it->slipPlane << ' ' << t_it->nReceivers << ' ' << (int) t_it->engine
+            << ' ' << t_it->tDirect << ' ' << t_it->tTabulated << ' ' << t_it->tOtherSystems << ' ' << t_it->tCellList
+            << ' ' << t_it->tabulatedError << ' ' << t_it->cellListError;
+        fp->endLine();
+    }
+}
+
+/**
+ * @brief Largest deviation between the components of two sets of stresses.
+ * @param a The first set.
+ * @param b The second set.
+ * @return The largest absolute difference of a component.
+ */
+double EngineTuner::deviation (const std::vector<Stress>& a, const std::vector<Stress>& b)
+{
+    double d = 0.0;
+    int k, j;
+
+    for (k=0; k<a.size() && k<b.size(); k++) {
+        for (j=0; j<9; j++) {
+            d = std::max(d, fabs(a[k].getValue(j/3, j%3) - b[k].getValue(j/3, j%3)));
+        }
+    }
+
+    return (d);
+}
+
+/**
+ * @brief Get the wall-clock time.
+ * @return The wall-clock time, in seconds.
+ */
+double EngineTuner::wallTime ()
+{
+    struct timeval now;
+
+    gettimeofday(&now, NULL);
+    return ( (double) now.tv_sec + 1.0e-06 * (double) now.tv_usec );
+}
@@ -0,0 +1,326 @@
+/**
+ * @file engineTuner.h
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the class EngineTuner.
+ * @details This file defines the class EngineTuner, which times the methods available for calculating the stresses on the defects of a grain on the present configuration and selects the fastest one for each slip plane within an accuracy budget.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ENGINETUNER_H
+#define ENGINETUNER_H
+
+#include <string>
+#include <vector>
+#include <math.h>
+#include <sys/time.h>
+
+#include "slipsystem.h"
+#include "cellList.h"
+#include "textWriter.h"
+
+#ifndef ENGINETUNER_DEFAULT_ACCURACY
+/**
+ * @brief Default accuracy budget: largest deviation of a stress component from the exact stress field on a slip plane, relative to the largest component of the exact stress field on that slip plane.
+ */
+#define ENGINETUNER_DEFAULT_ACCURACY 1.0e-04
+#endif
+
+#ifndef ENGINETUNER_DEFAULT_INTERVAL
+/**
+ * @brief Default number of time steps between two tunings.
+ */
+#define ENGINETUNER_DEFAULT_INTERVAL 1000
+#endif
+
+#ifndef ENGINETUNER_MIN_SAMPLE_TIME
+/**
+ * @brief Smallest duration, in seconds, over which a calculation is repeated to time it.
+ */
+#define ENGINETUNER_MIN_SAMPLE_TIME 1.0e-04
+#endif
+
+#ifndef ENGINETUNER_MAX_REPETITIONS
+/**
+ * @brief Largest number of repetitions of a calculation to time it.
+ */
+#define ENGINETUNER_MAX_REPETITIONS 64
+#endif
+
+/**
+ * @brief Enumerated type for the methods calculating the stresses on the defects.
+ */
+enum StressEngine {
+    /**
+     * @brief Exact sum over all dislocations.
+     */
+    ENGINE_DIRECT = 0,
+    /**
+     * @brief The contributions of the other slip planes of the same slip system are interpolated from kernel tables.
+     */
+    ENGINE_TABULATED,
+    /**
+     * @brief Exact near field and coarse-grained far field of a CellList, for the whole grain.
+     */
+    ENGINE_CELLLIST
+};
+
+/**
+ * @brief The EngineTiming struct holds the measurements made on a slip plane and the method selected for it.
+ */
+struct EngineTiming
+{
+    /**
+     * @brief Index of the slip system.
+     */
+    int slipSystem;
+    /**
+     * @brief Index of the slip plane in the slip system.
+     */
+    int slipPlane;
+    /**
+     * @brief Number of defects receiving the stress.
+     */
+    int nReceivers;
+    /**
+     * @brief Time, in seconds, of the exact calculation of the stress field of the slip system at the defects.
+     */
+    double tDirect;
+    /**
+     * @brief Time, in seconds, of the calculation of the stress field of the slip system at the defects with the kernel tables.
+     */
+    double tTabulated;
+    /**
+     * @brief Time, in seconds, of the exact calculation of the stress field of the other slip systems at the defects.
+     */
+    double tOtherSystems;
+    /**
+     * @brief Time, in seconds, of the calculation of the stress field of all slip systems at the defects with the cell list.
+     */
+    double tCellList;
+    /**
+     * @brief Deviation of the stress field calculated with the kernel tables, relative to the largest component of the exact stress field on the slip plane.
+     */
+    double tabulatedError;
+    /**
+     * @brief Deviation of the stress field calculated with the cell list, relative to the largest component of the exact stress field on the slip plane.
+     */
+    double cellListError;
+    /**
+     * @brief The method selected.
+     */
+    StressEngine engine;
+};
+
+/**
+ * @brief The EngineTuner class selects the methods used to calculate the stresses on the defects of a grain.
+ * @details On sample time steps, the stress at the defects of each slip plane is calculated with each available method on the present configuration of the dislocations, timed and compared with the exact calculation. The kernel tables are selected for a slip plane if they are faster and their deviation is within the accuracy budget, and for a slip system only if the time they save covers the refreshment of their data. The cell list, if a cut-off radius is given, is selected for the whole grain if it is faster than the selected methods of all slip planes and within the accuracy budget on each slip plane. The measurements and decisions are appended to a log file, one line per slip plane.
+ */
+class EngineTuner
+{
+protected:
+    /**
+     * @brief Flag indicating whether the methods are tuned.
+     */
+    bool enabled;
+    /**
+     * @brief Largest deviation allowed, relative to the largest component of the exact stress field on a slip plane.
+     */
+    double accuracy;
+    /**
+     * @brief Number of time steps between two tunings. Zero only tunes at the first time step.
+     */
+    int interval;
+    /**
+     * @brief Number of time steps counted since the last tuning.
+     */
+    int stepsSinceTuning;
+    /**
+     * @brief Number of time steps counted.
+     */
+    int nSteps;
+    /**
+     * @brief Number of tunings carried out.
+     */
+    int nTunings;
+    /**
+     * @brief Cut-off radius of the cell list. The cell list is not a candidate if it is zero.
+     */
+    double cutoff;
+    /**
+     * @brief Skin distance of the cell list.
+     */
+    double skin;
+    /**
+     * @brief Maximum interpolation error of the kernel tables, relative to the peak value of each kernel.
+     */
+    double kernelTolerance;
+    /**
+     * @brief Flag indicating whether the kernel tables are interpolated in single precision.
+     */
+    bool singlePrecision;
+    /**
+     * @brief Name of the log file. No log is written if it is empty.
+     */
+    std::string logFileName;
+    /**
+     * @brief Cell list used for the timings.
+     */
+    CellList cellList;
+    /**
+     * @brief Flag indicating whether the cell list was selected at the last tuning.
+     */
+    bool useCellList;
+    /**
+     * @brief Measurements and decisions of the last tuning, for each slip plane.
+     */
+    std::vector<EngineTiming> timings;
+    /**
+     * @brief The slip systems being tuned.
+     */
+    std::vector<SlipSystem*> slipSystems;
+    /**
+     * @brief The defects of the slip plane being timed.
+     */
+    std::vector<Defect*> receivers;
+    /**
+     * @brief Positions of the defects of the slip plane being timed, in the grain co-ordinate system.
+     */
+    std::vector<Vector3d> positions;
+
+    /**
+     * @brief Calculates the stress at the defects of the slip plane being timed with one method, repeating the calculation until ENGINETUNER_MIN_SAMPLE_TIME has elapsed or ENGINETUNER_MAX_REPETITIONS is reached.
+     * @param engine The method. ENGINE_DIRECT and ENGINE_TABULATED only include the stress field of the slip system d, or of the other slip systems if otherSystems is true, and ENGINE_CELLLIST includes all slip systems.
+     * @param d Index of the slip system.
+     * @param i Index of the slip plane in the slip system.
+     * @param otherSystems Flag indicating whether the stress field of the other slip systems is calculated instead, exactly.
+     * @param mu Shear modulus (Pa).
+     * @param nu Poisson's ratio.
+     * @param result Pointer to the vector receiving the stresses, in the grain co-ordinate system.
+     * @return The time taken by one calculation, in seconds.
+     */
+    double evaluate (StressEngine engine, int d, int i, bool otherSystems, double mu, double nu, std::vector<Stress>* result);
+    /**
+     * @brief Writes the measurements and decisions of the last tuning to the log file.
+     */
+    void writeLog ();
+    /**
+     * @brief Largest deviation between the components of two sets of stresses.
+     * @param a The first set.
+     * @param b The second set.
+     * @return The largest absolute difference of a component.
+     */
+    static double deviation (const std::vector<Stress>& a, const std::vector<Stress>& b);
+    /**
+     * @brief Get the wall-clock time.
+     * @return The wall-clock time, in seconds.
+     */
+    static double wallTime ();
+
+public:
+    // Constructors
+    /**
+     * @brief Default constructor. The tuning is disabled.
+     */
+    EngineTuner ();
+
+    // Destructor
+    /**
+     * @brief Destructor for the class EngineTuner.
+     */
+    virtual ~EngineTuner ()
+    {
+
+    }
+
+    // Assignment functions
+    /**
+     * @brief Sets the parameters of the tuning. The methods are tuned again at the next time step.
+     * @param enabled Flag indicating whether the methods are tuned.
+     * @param accuracy Largest deviation allowed, relative to the largest component of the exact stress field on a slip plane.
+     * @param interval Number of time steps between two tunings. Zero only tunes at the first time step.
+     * @param cutoff Cut-off radius of the cell list. The cell list is not a candidate if it is zero or negative.
+     * @param skin Skin distance of the cell list.
+     * @param kernelTolerance Maximum interpolation error of the kernel tables, relative to the peak value of each kernel.
+     * @param singlePrecision Flag indicating whether the kernel tables are interpolated in single precision.
+     * @param logFileName Name of the log file. No log is written if it is empty.
+     */
+    void configure (bool enabled, double accuracy, int interval, double cutoff, double skin, double kernelTolerance, bool singlePrecision, std::string logFileName);
+
+    // Access functions
+    /**
+     * @brief Indicates whether the methods are tuned.
+     * @return True if the tuning is enabled.
+     */
+    bool isEnabled () const;
+    /**
+     * @brief Indicates whether the cell list was selected at the last tuning.
+     * @return True if the cell list was selected.
+     */
+    bool usesCellList () const;
+    /**
+     * @brief Get the cut-off radius of the cell list.
+     * @return The cut-off radius.
+     */
+    double getCutoff () const;
+    /**
+     * @brief Get the skin distance of the cell list.
+     * @return The skin distance.
+     */
+    double getSkin () const;
+    /**
+     * @brief Get the number of tunings carried out.
+     * @return The number of tunings.
+     */
+    int getNumTunings () const;
+    /**
+     * @brief Get the measurements and decisions of the last tuning.
+     * @return Reference to the vector holding them, one entry per slip plane.
+     */
+    const std::vector<EngineTiming>& getTimings () const;
+    /**
+     * @brief Describes the decisions of the last tuning in a few words.
+     * @return The description.
+     */
+    std::string getDecision () const;
+
+    // Operations
+    /**
+     * @brief Counts a time step and indicates whether the methods are to be tuned at this step.
+     * @return True at the first time step and then every EngineTuner::interval time steps, if the tuning is enabled.
+     */
+    bool step ();
+    /**
+     * @brief Times the methods on the present configuration and selects them.
+     * @details The selection of the kernel tables is applied to the slip systems with SlipSystem::setKernelTables and SlipSystem::setTabulatedSlipPlanes. The selection of the cell list is returned, to be applied by the grain.
+     * @param slipSystems The slip systems of the grain.
+     * @param grainSystem Pointer to the grain co-ordinate system.
+     * @param mu Shear modulus (Pa).
+     * @param nu Poisson's ratio.
+     * @return True if the cell list is selected.
+     */
+    bool tune (std::vector<SlipSystem*> slipSystems, CoordinateSystem* grainSystem, double mu, double nu);
+};
+
+#endif // ENGINETUNER_H
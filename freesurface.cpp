@@ -53,31 +53,13 @@ FreeSurface::FreeSurface (CoordinateSystem *base, Vector3d p)
 
 /**
  * @brief Calculates the image force exerted by the free surface on a given dislocation.
- * @details The image force exerted by the free surface on a dislocation is calculated by creating an image dislocation as if it were on the same slip plane, and then calculating the Peach-Koehler force on the present dislocation due to this image dislocation.
+ * @details The image force exerted by the free surface on a dislocation is the Peach-Koehler force due to an image dislocation placed symmetrically with respect to the free surface on the same slip plane. It is calculated by Dislocation::imageForce, without creating the image dislocation.
  * @param disl Pointer to the dislocation on which the image force is to be calculated.
  * @param mu Shear modulus in Pa.
  * @param nu Poisson's ratio.
  * @return The vector containing the image force, expressed in the base co-ordinate system.
  */
-Vector3d FreeSurface::imageForce (Dislocation* disl, double mu, double nu)
+Vector3d FreeSurface::imageForce (Dislocation* disl, double mu, double nu) const
 {
-    // Calculate the position and Burgers vector of the image
-    Vector3d position = this->getPosition() + this->getPosition() - disl->getPosition();
-    Vector3d burgers_disl  = disl->getBurgers();
-    Vector3d burgers_image = burgers_disl * (-1.0);
-
-    // Create an immobile image dislocation
-    Dislocation* imageDislocation = new Dislocation(burgers_image,disl->getLineVector(),
-                                                    position,this->getCoordinateSystem(),
-                                                    disl->getBurgersMagnitude(),false);
-    // Stress field of the image dislocation at the present dislocation position
-    Stress s = imageDislocation->stressField(disl->getPosition(),mu,nu);
-    // The resulting Peach-Koehler force
-    Vector3d force = disl->forcePeachKoehler(s);
-
-    // Clear memory
-    delete (imageDislocation);
-    imageDislocation = NULL;
-
-    return (force);
+    return (disl->imageForce(this->getPosition(), mu, nu));
 }
@@ -67,13 +67,13 @@ public:
 
     /**
      * @brief Calculates the image force exerted by the free surface on a given dislocation.
-     * @details The image force exerted by the free surface on a dislocation is calculated by creating an image dislocation as if it were on the same slip plane, and then calculating the Peach-Koehler force on the present dislocation due to this image dislocation.
+     * @details The image force exerted by the free surface on a dislocation is the Peach-Koehler force due to an image dislocation placed symmetrically with respect to the free surface on the same slip plane. It is calculated by Dislocation::imageForce, without creating the image dislocation.
      * @param disl Pointer to the dislocation on which the image force is to be calculated.
      * @param mu Shear modulus in Pa.
      * @param nu Poisson's ratio.
      * @return The vector containing the image force, expressed in the base co-ordinate system.
      */
-    Vector3d imageForce (Dislocation* disl, double mu, double nu);
+    Vector3d imageForce (Dislocation* disl, double mu, double nu) const;
 };
 
 #endif // FREESURFACE_H
@@ -217,6 +217,130 @@ void Grain::insertSlipSystem (SlipSystem* s)
     this->slipSystems.push_back(s);
 }
 
+/**
+ * @brief Set whether the stress field due to dislocations on other slip planes of the same slip system is to be interpolated from kernel tables.
+ * @param useTables Flag indicating whether the kernel tables are to be used.
+ * @param tolerance Maximum interpolation error, relative to the peak value of each kernel.
+ * @param singlePrecision Flag indicating whether the interpolation is to be carried out in single precision.
+ */
+void Grain::setKernelTables (bool useTables, double tolerance, bool singlePrecision)
+{
+    std::vector<SlipSystem*>::iterator s_it;
+    SlipSystem* s;
+
+    for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
+        s = *s_it;
+        s->setKernelTables(useTables, tolerance, singlePrecision);
+    }
+}
+
+/**
+ * @brief Set the cut-off radius for the interactions between dislocations.
+ * @details Dislocations closer than the cut-off radius interact exactly, the others through the net Burgers vectors of the cells of a CellList. A cut-off radius that is zero or negative restores the exact calculation of all interactions.
+ * @param cutoff The cut-off radius.
+ * @param skin The skin distance. The cell list is only rebuilt after a dislocation has moved by more than half of this distance. A negative value selects the default skin distance.
+ */
+void Grain::setInteractionCutoff (double cutoff, double skin)
+{
+    this->cellList.setCutoff(cutoff, skin);
+}
+
+/**
+ * @brief Set whether the methods used to calculate the stresses are selected by timing them on sample time steps.
+ * @details The candidates are the exact calculation, the kernel tables for each slip plane and, if a cut-off radius was set with Grain::setInteractionCutoff before this function is called, the cell list. The methods selected replace those set with Grain::setKernelTables and Grain::setInteractionCutoff.
+ * @param tune Flag indicating whether the methods are selected.
+ * @param accuracy Largest deviation allowed, relative to the largest component of the exact stress field on a slip plane.
+ * @param interval Number of time steps between two selections. Zero only selects at the first time step.
+ * @param kernelTolerance Maximum interpolation error of the kernel tables, relative to the peak value of each kernel.
+ * @param singlePrecision Flag indicating whether the kernel tables are interpolated in single precision.
+ * @param logFileName Name of the file to which the measurements and decisions are appended.
+ */
+void Grain::setStressEngineTuning (bool tune, double accuracy, int interval, double kernelTolerance, bool singlePrecision, std::string logFileName)
+{
+    this->engineTuner.configure(tune, accuracy, interval, this->cellList.getCutoff(), this->cellList.getSkin(), kernelTolerance, singlePrecision, logFileName);
+}
+
+/**
+ * @brief Set the minimum interval of time between two outputs of the stress field along the grain boundary.
+ * @param interval The interval of time. A value of zero writes every output that is requested.
+ */
+void Grain::setGrainBoundaryProbeInterval (double interval)
+{
+    this->gbProbes.setInterval(interval);
+}
+
+/**
+ * @brief Set whether the total stress is calculated on all defects of all slip planes, including the extremities and the pinned dislocations.
+ * @details This is needed by the outputs that write the stress on every defect, such as Grain::writeVTK.
+ * @param allDefects Flag indicating whether the total stress is calculated on all defects.
+ */
+void Grain::setStressOnAllDefects (bool allDefects)
+{
+    std::vector<SlipSystem*>::iterator s_it;
+    std::vector<SlipPlane*>::const_iterator sp_it;
+
+    for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
+        const std::vector<SlipPlane*>& slipPlanes = (*s_it)->getSlipPlanes();
+        for (sp_it=slipPlanes.begin(); sp_it!=slipPlanes.end(); sp_it++) {
+            (*sp_it)->setStressOnAllDefects(allDefects);
+        }
+    }
+}
+
+/**
+ * @brief Opens the archive receiving the outputs that would otherwise be written to one file per time step.
+ * @details Nothing is done if the archive is already open with this name. The records are appended if the archive exists.
+ * @param fileName Name of the archive.
+ * @return True if the archive is open.
+ */
+bool Grain::openArchive (std::string fileName)
+{
+    if (this->archive.isOpen() && this->archive.getFileName() == fileName) {
+        return (true);
+    }
+
+    return (this->archive.open(fileName));
+}
+
+/**
+ * @brief Sets the cadence of the frames written by Grain::writeBurstFrame during bursts and the number of frames kept before a burst.
+ * @param denseInterval Number of time steps between two frames during bursts and in the memory.
+ * @param ringSize Number of frames preceding a burst that are kept in memory.
+ */
+void Grain::setBurstCapture (int denseInterval, int ringSize)
+{
+    this->burstCapture.configure(denseInterval, ringSize);
+}
+
+/**
+ * @brief Closes the output files that the grain keeps open between outputs.
+ * @details The files are opened again, with the names given at that time, at the next output. This must be done before the output directory changes, or before the process is forked so that buffered data is not written twice. The shared memory of the live snapshots is closed as well, so that a forked process publishes its own snapshots, and so is the archive, whose index is written.
+ */
+void Grain::closeOutputFiles ()
+{
+    this->gbProbes.close();
+    this->liveSnapshots.close();
+    this->archive.close();
+    this->vtkWriter.close();
+}
+
+/**
+ * @brief Set whether the extremities of the slip planes are free surfaces.
+ * @details Free surfaces absorb the dislocations reaching them and exert image forces on the dislocations lying within the cut-off distance. Otherwise the extremities are grain boundaries.
+ * @param freeSurfaces Flag indicating whether the extremities are free surfaces.
+ * @param imageForceCutoff Distance from a free surface within which the image force acts on the dislocations. A value of zero or less disables the image forces.
+ */
+void Grain::setFreeSurfaces (bool freeSurfaces, double imageForceCutoff)
+{
+    std::vector<SlipSystem*>::iterator s_it;
+    SlipSystem* s;
+
+    for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
+        s = *s_it;
+        s->setFreeSurfaces(freeSurfaces, imageForceCutoff);
+    }
+}
+
 // Stress functions
 /**
  * @brief Calculate the externally applied stress in the grain co-ordinate system
@@ -244,7 +368,8 @@ void Grain::calculateSlipSystemAppliedStress()
 }
 
 /**
- * @brief Calculate the total stresses experienced by all defects on all the slip planes.
+ * @brief Calculate the total stresses experienced by the defects on all the slip planes.
+ * @details Only the defects returned by SlipPlane::getStressReceivers receive the stress.
  * @param mu Shear modulus of the material (Pa).
  * @param nu Poisson's ratio.
  */
@@ -268,43 +393,100 @@ void Grain::calculateAllStresses (double mu, double nu)
     Stress totalStress_slipPlane;
     Stress totalStress_defect;
 
+    std::vector<SlipPlane*> slipPlanes;
+    int i;
+
+    if (this->cellList.isEnabled()) {
+        // Bin the dislocations, the viewing axis being the polycrystal Z-axis
+        this->cellList.update(this->slipSystems, &(this->coordinateSystem), this->coordinateSystem.vector_BaseToLocal_noTranslate(Vector3d::unitVector(2)));
+    }
+    else {
+        // Refresh the dislocation data used with the kernel tables
+        for (sourceSlipSystem_it=this->slipSystems.begin(); sourceSlipSystem_it!=this->slipSystems.end(); sourceSlipSystem_it++) {
+            sourceSlipSystem = *sourceSlipSystem_it;
+            if (sourceSlipSystem->usesKernelTables()) {
+                sourceSlipSystem->prepareKernelTables(mu, nu);
+            }
+        }
+    }
+
     for (destinationSlipSystem_it=this->slipSystems.begin(); destinationSlipSystem_it!=this->slipSystems.end(); destinationSlipSystem_it++) {
         destinationSlipSystem = *destinationSlipSystem_it;
-        // Get all the defects and their position vectors
-        defects = destinationSlipSystem->getDefects();
-        defectPositions = destinationSlipSystem->getAllDefectPositions_base();
-        for (defectPositions_it=defectPositions.begin(), defects_it=defects.begin();
-             defectPositions_it!=defectPositions.end();
-             defectPositions_it++, defects_it++) {
-            // Set the total stress to the grain's local applied stress
-            totalStress = this->appliedStress_local;
-            defect = *defects_it;
-            for (sourceSlipSystem_it=this->slipSystems.begin(); sourceSlipSystem_it!=this->slipSystems.end(); sourceSlipSystem_it++) {
-                sourceSlipSystem = *sourceSlipSystem_it;
-                totalStress += sourceSlipSystem->slipSystemStressField(*defectPositions_it, mu, nu);
+        slipPlanes = destinationSlipSystem->getSlipPlanes();
+        for (i=0; i<slipPlanes.size(); i++) {
+            // Get the defects that use the stress and their position vectors
+            defects = slipPlanes[i]->getStressReceivers();
+            defectPositions = destinationSlipSystem->getCoordinateSystem()->vector_LocalToBase(slipPlanes[i]->getStressReceiverPositions_base(defects));
+            for (defectPositions_it=defectPositions.begin(), defects_it=defects.begin();
+                 defectPositions_it!=defectPositions.end();
+                 defectPositions_it++, defects_it++) {
+                // Set the total stress to the grain's local applied stress
+                totalStress = this->appliedStress_local;
+                defect = *defects_it;
+                if (this->cellList.isEnabled()) {
+                    // Exact near field and coarse-grained far field
+                    totalStress += this->cellList.stressField(*defectPositions_it, mu, nu);
+                }
+                else {
+                    for (sourceSlipSystem_it=this->slipSystems.begin(); sourceSlipSystem_it!=this->slipSystems.end(); sourceSlipSystem_it++) {
+                        sourceSlipSystem = *sourceSlipSystem_it;
+                        if (sourceSlipSystem==destinationSlipSystem && sourceSlipSystem->tabulatesSlipPlane(i)) {
+                            // The other slip planes of the same slip system are interpolated
+                            totalStress += sourceSlipSystem->getCoordinateSystem()->stress_LocalToBase(sourceSlipSystem->slipSystemStressField_tabulated(i, defect->getPosition(), mu, nu));
+                        }
+                        else {
+                            totalStress += sourceSlipSystem->slipSystemStressField(*defectPositions_it, mu, nu);
+                        }
+                    }
+                }
+                // The total stress is in the grain co-ordinate system
+                totalStress_slipSystem = destinationSlipSystem->getCoordinateSystem()->stress_BaseToLocal(totalStress);
+                totalStress_slipPlane  = defect->getCoordinateSystem()->getBase()->stress_BaseToLocal(totalStress_slipSystem);
+                totalStress_defect     = defect->getCoordinateSystem()->stress_BaseToLocal(totalStress_slipPlane);
+                defect->setTotalStress(totalStress_defect);
             }
-            // The total stress is in the grain co-ordinate system
-            defect = *defects_it;
-            totalStress_slipSystem = destinationSlipSystem->getCoordinateSystem()->stress_BaseToLocal(totalStress);
-            totalStress_slipPlane  = defect->getCoordinateSystem()->getBase()->stress_BaseToLocal(totalStress_slipSystem);
-            totalStress_defect     = defect->getCoordinateSystem()->stress_BaseToLocal(totalStress_slipPlane);
-            defect->setTotalStress(totalStress_defect);
         }
     }
 }
 
+/**
+ * @brief Selects the methods used to calculate the stresses if a selection is due at this time step.
+ * @details This function must be called at every time step, before Grain::calculateAllStresses. Changes of the selection are displayed.
+ * @param mu Shear modulus of the material (Pa).
+ * @param nu Poisson's ratio.
+ */
+void Grain::tuneStressEngines (double mu, double nu)
+{
+    if (!this->engineTuner.step()) {
+        return;
+    }
+
+    std::string decision = this->engineTuner.getDecision();
+    bool useCellList = this->engineTuner.tune(this->slipSystems, &(this->coordinateSystem), mu, nu);
+
+    if (useCellList != this->cellList.isEnabled()) {
+        this->cellList.setCutoff(useCellList ? this->engineTuner.getCutoff() : 0.0, this->engineTuner.getSkin());
+    }
+
+    if (this->engineTuner.getDecision() != decision) {
+        displayMessage("Stress calculation: " + this->engineTuner.getDecision());
+    }
+}
+
 /**
  * @brief Calculate the Peach-Koehler force on all dislocations and their resulting velocities.
  * @param B The drag coefficient.
+ * @param mu Shear modulus of the material (Pa).
+ * @param nu Poisson's ratio.
  */
-void Grain::calculateDislocationVelocities (double B)
+void Grain::calculateDislocationVelocities (double B, double mu, double nu)
 {
     std::vector<SlipSystem*>::iterator s_it;
     SlipSystem* s;
 
     for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
         s = *s_it;
-        s->calculateSlipPlaneDislocationForcesVelocities(B);
+        s->calculateSlipPlaneDislocationForcesVelocities(B, mu, nu);
     }
 }
 
@@ -410,6 +592,42 @@ void Grain::checkDislocationSources (double dt, double mu, double nu, double min
     }
 }
 
+/**
+ * @brief Changes the distribution of the critical stresses of all dislocation sources in the grain.
+ * @details The critical stresses were drawn from a Gaussian distribution with mean mean0 and standard deviation stdev0. Each of them is mapped to the distribution with mean mean and standard deviation stdev, so that every source keeps its rank in the population. If stdev0 is zero, the critical stresses are only shifted.
+ * @param mean0 Mean of the present distribution (Pa).
+ * @param stdev0 Standard deviation of the present distribution (Pa).
+ * @param mean Mean of the new distribution (Pa).
+ * @param stdev Standard deviation of the new distribution (Pa).
+ * @param timeTillEmit Amount of time of experiencing critical stress before a dipole is emitted.
+ */
+void Grain::rescaleDislocationSources (double mean0, double stdev0, double mean, double stdev, double timeTillEmit)
+{
+    std::vector<SlipSystem*>::iterator s_it;
+    std::vector<SlipPlane*> slipPlanes;
+    std::vector<SlipPlane*>::iterator sp_it;
+    std::vector<DislocationSource*> dSources;
+    std::vector<DislocationSource*>::iterator ds_it;
+    DislocationSource* dSource;
+
+    double scale = 1.0;
+    if (stdev0 > 0.0) {
+        scale = stdev / stdev0;
+    }
+
+    for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
+        slipPlanes = (*s_it)->getSlipPlanes();
+        for (sp_it=slipPlanes.begin(); sp_it!=slipPlanes.end(); sp_it++) {
+            dSources = (*sp_it)->getDislocationSourceList();
+            for (ds_it=dSources.begin(); ds_it!=dSources.end(); ds_it++) {
+                dSource = *ds_it;
+                dSource->setTauCritical(mean + (dSource->getTauCritical() - mean0) * scale);
+                dSource->setTimeTillDipoleEmission(timeTillEmit);
+            }
+        }
+    }
+}
+
 // Local reactions
 /**
  * @brief Check the local reactions between defects within the grain.
@@ -474,6 +692,16 @@ CoordinateSystem* Grain::getCoordinateSystem ()
     return (&(this->coordinateSystem));
 }
 
+/**
+ * @brief Get the vector container with pointers to the slip systems of the grain.
+ * @details The reference remains valid as long as the grain exists, so that the slip systems, their slip planes and their defects can be read without copying any data.
+ * @return Reference to the vector container with pointers to the slip systems.
+ */
+const std::vector<SlipSystem*>& Grain::getSlipSystems () const
+{
+    return (this->slipSystems);
+}
+
 /**
  * @brief Get the positions of all the defects in this grain, expressed in the base co-ordinate system.
  * @return Vector container with the positions of all the defects in this grain, expressed in the base co-ordinate system.
@@ -504,3 +732,96 @@ std::vector<Vector3d> Grain::getAllDefectPositions_local()
 
     return (defectPositions);
 }
+
+/**
+ * @brief Get the area of the grain.
+ * @details The area is that of the polygon formed by the grain boundary points, in the plane perpendicular to the viewing axis.
+ * @return The area of the grain.
+ */
+double Grain::getArea () const
+{
+    int n = this->gbPoints_base.size();
+    int i;
+    double area = 0.0;
+    Vector3d p0, p1;
+
+    for (i=0; i<n; i++) {
+        p0 = this->gbPoints_base[i];
+        p1 = this->gbPoints_base[(i+1)%n];
+        area += (p0.getValue(0) * p1.getValue(1)) - (p1.getValue(0) * p0.getValue(1));
+    }
+
+    return (fabs(0.5 * area));
+}
+
+/**
+ * @brief Get the total number of dislocations in the grain.
+ * @return The number of dislocations on all slip planes of all slip systems.
+ */
+int Grain::getNumDislocations ()
+{
+    std::vector<SlipSystem*>::iterator s_it;
+    std::vector<SlipPlane*> slipPlanes;
+    std::vector<SlipPlane*>::iterator sp_it;
+
+    int n = 0;
+    for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
+        slipPlanes = (*s_it)->getSlipPlanes();
+        for (sp_it=slipPlanes.begin(); sp_it!=slipPlanes.end(); sp_it++) {
+            n += (*sp_it)->getNumDislocations();
+        }
+    }
+
+    return (n);
+}
+
+/**
+ * @brief Get the number of dislocation dipoles emitted in the grain since the beginning of the simulation.
+ * @return The number of emissions on all slip planes of all slip systems.
+ */
+int Grain::getNumEmissions () const
+{
+    std::vector<SlipSystem*>::const_iterator s_it;
+
+    int n = 0;
+    for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
+        n += (*s_it)->getNumEmissions();
+    }
+
+    return (n);
+}
+
+/**
+ * @brief Get the number of pairs of dislocations annihilated in the grain since the beginning of the simulation.
+ * @return The number of annihilations on all slip planes of all slip systems.
+ */
+int Grain::getNumAnnihilations () const
+{
+    std::vector<SlipSystem*>::const_iterator s_it;
+
+    int n = 0;
+    for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
+        n += (*s_it)->getNumAnnihilations();
+    }
+
+    return (n);
+}
+
+/**
+ * @brief Get the plastic strain accumulated in the grain since the beginning of the simulation.
+ * @details The plastic slip of all slip systems, given by SlipSystem::getPlasticSlip, is rotated into the grain co-ordinate system, summed up and divided by the area of the grain.
+ * @return The plastic strain, expressed in the local co-ordinate system of the grain.
+ */
+Strain Grain::getPlasticStrain ()
+{
+    std::vector<SlipSystem*>::iterator s_it;
+    SlipSystem* s;
+
+    Strain slip;
+    for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
+        s = *s_it;
+        slip += s->getCoordinateSystem()->strain_LocalToBase(s->getPlasticSlip());
+    }
+
+    return (Strain(slip * (1.0/this->getArea())));
+}
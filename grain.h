@@ -32,6 +32,13 @@
 #define GRAIN_H
 
 #include "slipsystem.h"
+#include "cellList.h"
+#include "stressProbes.h"
+#include "snapshotRing.h"
+#include "timeSeriesArchive.h"
+#include "vtkWriter.h"
+#include "burstCapture.h"
+#include "engineTuner.h"
 
 #ifndef GRAIN_DEFAULTS
 #define GRAIN_DEFAULTS
@@ -100,6 +107,49 @@ protected:
      * @brief The externally applied stress, in the local co-ordinate system.
      */
     Stress appliedStress_local;
+    /**
+     * @brief Cell list used for evaluating the stress field with a cut-off radius.
+     * @details The cell list is only used if its cut-off radius is positive. Otherwise all interactions are calculated exactly.
+     */
+    CellList cellList;
+
+    /**
+     * @brief Probes sampling the stress field along the grain boundary.
+     */
+    StressProbes gbProbes;
+
+    /**
+     * @brief Ring of snapshots published in shared memory for live viewers.
+     */
+    SnapshotRing liveSnapshots;
+
+    /**
+     * @brief Archive receiving the outputs that would otherwise be written to one file per time step.
+     */
+    TimeSeriesArchive archive;
+
+    /**
+     * @brief Writer of the series of VTK files of the defects.
+     */
+    VtkWriter vtkWriter;
+
+    /**
+     * @brief Cadence of the frames written depending on the bursts of plastic activity, with the frames preceding a burst.
+     */
+    BurstCapture burstCapture;
+
+    /**
+     * @brief Selection of the methods used to calculate the stresses, timed on sample time steps.
+     */
+    EngineTuner engineTuner;
+
+    /**
+     * @brief Writes an output of one time step to the file fileName<t>.txt, or appends it as a record of that name to the archive if it is open.
+     * @param fileName Name of the file, to which the value of time is appended.
+     * @param t Value of time.
+     * @param data The output.
+     */
+    void writeStepOutput (std::string fileName, double t, const std::string& data);
 
 public:
     // Constructors
@@ -167,6 +217,76 @@ public:
      */
     void insertSlipSystem (SlipSystem* s);
 
+    /**
+     * @brief Set whether the stress field due to dislocations on other slip planes of the same slip system is to be interpolated from kernel tables.
+     * @param useTables Flag indicating whether the kernel tables are to be used.
+     * @param tolerance Maximum interpolation error, relative to the peak value of each kernel.
+     * @param singlePrecision Flag indicating whether the interpolation is to be carried out in single precision.
+     */
+    void setKernelTables (bool useTables, double tolerance, bool singlePrecision);
+
+    /**
+     * @brief Set the cut-off radius for the interactions between dislocations.
+     * @details Dislocations closer than the cut-off radius interact exactly, the others through the net Burgers vectors of the cells of a CellList. A cut-off radius that is zero or negative restores the exact calculation of all interactions.
+     * @param cutoff The cut-off radius.
+     * @param skin The skin distance. The cell list is only rebuilt after a dislocation has moved by more than half of this distance. A negative value selects the default skin distance.
+     */
+    void setInteractionCutoff (double cutoff, double skin);
+
+    /**
+     * @brief Set whether the methods used to calculate the stresses are selected by timing them on sample time steps.
+     * @details The candidates are the exact calculation, the kernel tables for each slip plane and, if a cut-off radius was set with Grain::setInteractionCutoff before this function is called, the cell list. The methods selected replace those set with Grain::setKernelTables and Grain::setInteractionCutoff.
+     * @param tune Flag indicating whether the methods are selected.
+     * @param accuracy Largest deviation allowed, relative to the largest component of the exact stress field on a slip plane.
+     * @param interval Number of time steps between two selections. Zero only selects at the first time step.
+     * @param kernelTolerance Maximum interpolation error of the kernel tables, relative to the peak value of each kernel.
+     * @param singlePrecision Flag indicating whether the kernel tables are interpolated in single precision.
+     * @param logFileName Name of the file to which the measurements and decisions are appended.
+     */
+    void setStressEngineTuning (bool tune, double accuracy, int interval, double kernelTolerance, bool singlePrecision, std::string logFileName);
+
+    /**
+     * @brief Set the minimum interval of time between two outputs of the stress field along the grain boundary.
+     * @param interval The interval of time. A value of zero writes every output that is requested.
+     */
+    void setGrainBoundaryProbeInterval (double interval);
+
+    /**
+     * @brief Set whether the total stress is calculated on all defects of all slip planes, including the extremities and the pinned dislocations.
+     * @details This is needed by the outputs that write the stress on every defect, such as Grain::writeVTK.
+     * @param allDefects Flag indicating whether the total stress is calculated on all defects.
+     */
+    void setStressOnAllDefects (bool allDefects);
+
+    /**
+     * @brief Opens the archive receiving the outputs that would otherwise be written to one file per time step.
+     * @details Nothing is done if the archive is already open with this name. The records are appended if the archive exists.
+     * @param fileName Name of the archive.
+     * @return True if the archive is open.
+     */
+    bool openArchive (std::string fileName);
+
+    /**
+     * @brief Sets the cadence of the frames written by Grain::writeBurstFrame during bursts and the number of frames kept before a burst.
+     * @param denseInterval Number of time steps between two frames during bursts and in the memory.
+     * @param ringSize Number of frames preceding a burst that are kept in memory.
+     */
+    void setBurstCapture (int denseInterval, int ringSize);
+
+    /**
+     * @brief Closes the output files that the grain keeps open between outputs.
+     * @details The files are opened again, with the names given at that time, at the next output. This must be done before the output directory changes, or before the process is forked so that buffered data is not written twice. The shared memory of the live snapshots is closed as well, so that a forked process publishes its own snapshots, and so is the archive, whose index is written.
+     */
+    void closeOutputFiles ();
+
+    /**
+     * @brief Set whether the extremities of the slip planes are free surfaces.
+     * @details Free surfaces absorb the dislocations reaching them and exert image forces on the dislocations lying within the cut-off distance. Otherwise the extremities are grain boundaries.
+     * @param freeSurfaces Flag indicating whether the extremities are free surfaces.
+     * @param imageForceCutoff Distance from a free surface within which the image force acts on the dislocations. A value of zero or less disables the image forces.
+     */
+    void setFreeSurfaces (bool freeSurfaces, double imageForceCutoff);
+
     // Stress functions
     /**
      * @brief Calculate the externally applied stress in the grain co-ordinate system
@@ -180,17 +300,28 @@ public:
     void calculateSlipSystemAppliedStress();
 
     /**
-     * @brief Calculate the total stresses experienced by all defects on all the slip planes.
+     * @brief Calculate the total stresses experienced by the defects on all the slip planes.
+     * @details Only the defects returned by SlipPlane::getStressReceivers receive the stress.
      * @param mu Shear modulus of the material (Pa).
      * @param nu Poisson's ratio.
      */
     void calculateAllStresses (double mu, double nu);
 
+    /**
+     * @brief Selects the methods used to calculate the stresses if a selection is due at this time step.
+     * @details This function must be called at every time step, before Grain::calculateAllStresses. Changes of the selection are displayed.
+     * @param mu Shear modulus of the material (Pa).
+     * @param nu Poisson's ratio.
+     */
+    void tuneStressEngines (double mu, double nu);
+
     /**
      * @brief Calculate the Peach-Koehler force on all dislocations and their resulting velocities.
      * @param B The drag coefficient.
+     * @param mu Shear modulus of the material (Pa).
+     * @param nu Poisson's ratio.
      */
-    void calculateDislocationVelocities (double B);
+    void calculateDislocationVelocities (double B, double mu, double nu);
 
     /**
      * @brief The total stress field due to all defects in the grain at the position p.
@@ -236,6 +367,17 @@ public:
      */
     void checkDislocationSources (double dt, double mu, double nu, double minDistance);
 
+    /**
+     * @brief Changes the distribution of the critical stresses of all dislocation sources in the grain.
+     * @details The critical stresses were drawn from a Gaussian distribution with mean mean0 and standard deviation stdev0. Each of them is mapped to the distribution with mean mean and standard deviation stdev, so that every source keeps its rank in the population. If stdev0 is zero, the critical stresses are only shifted.
+     * @param mean0 Mean of the present distribution (Pa).
+     * @param stdev0 Standard deviation of the present distribution (Pa).
+     * @param mean Mean of the new distribution (Pa).
+     * @param stdev Standard deviation of the new distribution (Pa).
+     * @param timeTillEmit Amount of time of experiencing critical stress before a dipole is emitted.
+     */
+    void rescaleDislocationSources (double mean0, double stdev0, double mean, double stdev, double timeTillEmit);
+
     // Local reactions
     /**
      * @brief Check the local reactions between defects within the grain.
@@ -274,6 +416,13 @@ public:
      */
     CoordinateSystem* getCoordinateSystem ();
 
+    /**
+     * @brief Get the vector container with pointers to the slip systems of the grain.
+     * @details The reference remains valid as long as the grain exists, so that the slip systems, their slip planes and their defects can be read without copying any data.
+     * @return Reference to the vector container with pointers to the slip systems.
+     */
+    const std::vector<SlipSystem*>& getSlipSystems () const;
+
     /**
      * @brief Get the positions of all the defects in this grain, expressed in the base co-ordinate system.
      * @return Vector container with the positions of all the defects in this grain, expressed in the base co-ordinate system.
@@ -286,6 +435,38 @@ public:
      */
     std::vector<Vector3d> getAllDefectPositions_local();
 
+    /**
+     * @brief Get the area of the grain.
+     * @details The area is that of the polygon formed by the grain boundary points, in the plane perpendicular to the viewing axis.
+     * @return The area of the grain.
+     */
+    double getArea () const;
+
+    /**
+     * @brief Get the total number of dislocations in the grain.
+     * @return The number of dislocations on all slip planes of all slip systems.
+     */
+    int getNumDislocations ();
+
+    /**
+     * @brief Get the number of dislocation dipoles emitted in the grain since the beginning of the simulation.
+     * @return The number of emissions on all slip planes of all slip systems.
+     */
+    int getNumEmissions () const;
+
+    /**
+     * @brief Get the number of pairs of dislocations annihilated in the grain since the beginning of the simulation.
+     * @return The number of annihilations on all slip planes of all slip systems.
+     */
+    int getNumAnnihilations () const;
+
+    /**
+     * @brief Get the plastic strain accumulated in the grain since the beginning of the simulation.
+     * @details The plastic slip of all slip systems, given by SlipSystem::getPlasticSlip, is rotated into the grain co-ordinate system, summed up and divided by the area of the grain.
+     * @return The plastic strain, expressed in the local co-ordinate system of the grain.
+     */
+    Strain getPlasticStrain ();
+
     // Statistics
     /**
      * @brief Writes out the current time and the positions of all defects on the slip planes that belong to all the slip systems within this grain.
@@ -295,8 +476,95 @@ public:
      */
     void writeAllDefects (std::string fileName, double t);
 
+    /**
+     * @brief Writes out the current time and the relative deviation of the stress field obtained with the kernel tables from the exact double precision stress field, for each slip system.
+     * @details The deviations are calculated by SlipSystem::checkKernelPrecision. The file is opened in append mode and a newline is inserted after each entry.
+     * @param fileName Name of the file into which the data is to be written.
+     * @param t Value of time.
+     * @param mu Shear modulus (Pa).
+     * @param nu Poisson's ratio.
+     */
+    void writeKernelPrecision (std::string fileName, double t, double mu, double nu);
+
+    /**
+     * @brief Writes out the current time, the applied stress, the dislocation density and the plastic strain of the grain, of each slip system and of each slip plane.
+     * @details The row starts with the time, the six components of the applied stress, the dislocation density and the six components of the plastic strain of the grain. The six components of the plastic strain carried by each slip system follow, and then those carried by each slip plane, in the order of the slip systems. Tensors are written in the order xx yy zz xy xz yz and are expressed in the base co-ordinate system. The file is opened in append mode and a newline is inserted after each entry.
+     * @param fileName Name of the file into which the data is to be written.
+     * @param t Value of time.
+     * @param appliedStress The applied stress, expressed in the base co-ordinate system.
+     */
+    void writePlasticStrain (std::string fileName, double t, Stress appliedStress);
+
+    /**
+     * @brief Writes out the current time and the line density of dislocations on each slip plane.
+     * @details The line density is the number of dislocations on the slip plane divided by its length. The slip planes are written in the order of the slip systems. The file is opened in append mode and a newline is inserted after each entry.
+     * @param fileName Name of the file into which the data is to be written.
+     * @param t Value of time.
+     */
+    void writeSlipPlaneDensities (std::string fileName, double t);
+
+    /**
+     * @brief Writes out the current time and the pile-ups against both extremities of each slip plane.
+     * @details For each slip plane, the number of dislocations and the length of the pile-ups against the first and the second extremity are written, as found by SlipPlane::findPileUp. The file is opened in append mode and a newline is inserted after each entry.
+     * @param fileName Name of the file into which the data is to be written.
+     * @param t Value of time.
+     */
+    void writePileUps (std::string fileName, double t);
+
+    /**
+     * @brief Writes out the map of the density of geometrically necessary dislocations.
+     * @details The bounding box of the grain is divided into resolution x resolution cells. In each cell the components \f$\alpha_{xz}, \alpha_{yz}, \alpha_{zz}\f$ of the Nye tensor are calculated as the sum of the Burgers vectors of the dislocations it contains, times the component of their line vector along the viewing axis, divided by the area of the cell. Each row of the file contains the co-ordinates of the centre of a cell and the three components, expressed in the base co-ordinate system. A new file is written for each value of time, or a record of the archive if it is open.
+     * @param fileName Name of the file into which the data is to be written. The value of time is appended to it.
+     * @param t Value of time.
+     * @param resolution Number of cells along each axis.
+     */
+    void writeGNDMap (std::string fileName, double t, int resolution);
+
+    /**
+     * @brief Writes out the current time and the numbers of emissions, annihilations and absorptions since the beginning of the simulation.
+     * @details The row contains the time, the totals for the grain and then the three numbers for each slip system. The file is opened in append mode and a newline is inserted after each entry.
+     * @param fileName Name of the file into which the data is to be written.
+     * @param t Value of time.
+     */
+    void writeDefectEvents (std::string fileName, double t);
+
+    /**
+     * @brief Writes out the complete state of the grain in the format of the grain file.
+     * @details The frame holds the time, the orientation, the grain boundary points and, for each slip system and slip plane, the dislocations and dislocation sources, so that it can be read again by readGrain. The data is written to the file fileName<t>.txt, or appended as a record of that name to the archive if it is open.
+     * @param fileName Name of the file into which the data is to be written. The value of time is appended to it.
+     * @param t Value of time.
+     */
+    void writeFrame (std::string fileName, double t);
+
+    /**
+     * @brief Writes out the complete state of the grain in the format of the grain file.
+     * @param fp The writer into which the data will be written.
+     * @param t Value of time.
+     */
+    void writeFrame (TextWriter& fp, double t);
+
+    /**
+     * @brief Writes out the frames of the grain with a cadence that depends on the bursts of plastic activity.
+     * @details Outside the bursts, a frame, as written by Grain::writeFrame, is written when the baseline output is due, and the frames in between are taken at the dense cadence and kept in memory. When a burst starts, the frames kept in memory are written, followed by a frame at the dense cadence until the burst ends. This function must be called at every time step.
+     * @param fileName Name of the files into which the frames are written. The value of time is appended to it.
+     * @param t Value of time.
+     * @param baselineDue True if a frame is due at the baseline cadence.
+     * @param burst True if a burst is under way.
+     * @param burstStart True if the burst started at the present time step.
+     */
+    void writeBurstFrame (std::string fileName, double t, bool baselineDue, bool burst, bool burstStart);
+
+    /**
+     * @brief Writes out the defects of the grain as a VTK file of a series that can be read by ParaView.
+     * @details The collection fileName.pvd is created at the first call, along with the grain boundary in fileName_boundary.vtu, and each call writes the file fileName_<n>.vtu with binary data. Each defect is a point, in the base co-ordinate system, carrying its type, the index of its slip plane, its Burgers vector multiplied by its magnitude and the total stress acting on it, both in the base co-ordinate system. The stress of the extremities and of the pinned dislocations is only calculated if Grain::setStressOnAllDefects has been enabled.
+     * @param fileName Name of the files, without the extension.
+     * @param t Value of time.
+     */
+    void writeVTK (std::string fileName, double t);
+
     /**
      * @brief Write the six unique components of the stress field tensor, expressed in the base co-ordinate system, along the line between p0 and p1 with a resolution that is specified.
+     * @details The data is written to the file fileName<t>.txt, or appended as a record of that name to the archive if it is open.
      * @param fileName Name of the file into which the data will be written.
      * @param t The current value of time in the simulation.
      * @param p0 Position vector, in the base co-ordinate system, of the starting point.
@@ -307,8 +575,20 @@ public:
      */
     void writeStressField (std::string fileName, double t, Vector3d p0, Vector3d p1, int resolution, double mu, double nu);
 
+    /**
+     * @brief Write the six unique components of the stress field tensor, expressed in the base co-ordinate system, along the line between p0 and p1 with a resolution that is specified.
+     * @param fp The writer into which the data will be written.
+     * @param p0 Position vector, in the base co-ordinate system, of the starting point.
+     * @param p1 Position vector, in the base co-ordinate system, of the ending point.
+     * @param resolution The number of points, starting from p0, at which the stress field will be calculated.
+     * @param mu Shear modulus (Pa).
+     * @param nu Poisson's ratio.
+     */
+    void writeStressField (TextWriter& fp, Vector3d p0, Vector3d p1, int resolution, double mu, double nu);
+
     /**
      * @brief Write the stress field along the grain boundary points of the grain.
+     * @details The stress field is sampled by StressProbes placed along the grain boundary, which are set at the first call and whenever the resolution changes. All probes are written as one row of the file fileName.txt, which contains the time and the six components of the stress tensor at each probe, in the base co-ordinate system. The positions of the probes are written to fileName_points.txt. Nothing is written if the interval set with Grain::setGrainBoundaryProbeInterval has not elapsed since the last output.
      * @param fileName The name of the file to which the  data is to be written.
      * @param t The value of he current time.
      * @param resolution The number of points along each grain boundary.
@@ -316,6 +596,16 @@ public:
      * @param nu Poisson's ratio.
      */
     void writeGrainBoundaryStressField (std::string fileName, double t, int resolution, double mu, double nu);
+
+    /**
+     * @brief Publishes a snapshot of the grain in shared memory.
+     * @details The shared memory is created by SnapshotRing::create at the first call. The snapshot holds the positions, in the base co-ordinate system, and the types of all defects, and for each slip plane the numbers of dislocations and dislocation sources, the number of emissions and the shear component of the plastic slip. Only the latest nSlots snapshots are kept.
+     * @param name Name of the shared memory, without the leading /.
+     * @param t The value of the current time.
+     * @param nSlots Number of snapshots kept.
+     * @param maxDefects Number of defects that a snapshot can hold.
+     */
+    void writeLiveSnapshot (std::string name, double t, int nSlots, int maxDefects);
 };
 
 #endif // GRAIN_H
@@ -38,28 +38,276 @@
  */
 void Grain::writeAllDefects (std::string fileName, double t)
 {
-    std::ofstream fp (fileName.c_str(), std::ios_base::app);
+    TextWriter* fp = TextWriter::get(fileName);
 
-    if (fp.is_open()) {
+    if (fp != NULL) {
         std::vector<Vector3d> defectPositions = this->getAllDefectPositions_base();
         std::vector<Vector3d>::iterator defectPositions_it;
         Vector3d defectPosition;
 
-        fp << t << " ";
+        *fp << t << " ";
         defectPositions_it = defectPositions.begin();
         while (defectPositions_it!=defectPositions.end()) {
             defectPosition = *defectPositions_it;
-            fp << defectPosition.getValue(0) << " " << defectPosition.getValue(1) << " "; // << defectPosition.getValue(2) << " ";
+            *fp << defectPosition.getValue(0) << " " << defectPosition.getValue(1) << " "; // << defectPosition.getValue(2) << " ";
             defectPositions_it++;
         }
 
-        fp << std::endl;
+        fp->endLine();
+    }
+}
+
+/**
+ * @brief Writes out the complete state of the grain in the format of the grain file.
+ * @details The frame holds the time, the orientation, the grain boundary points and, for each slip system and slip plane, the dislocations and dislocation sources, so that it can be read again by readGrain. The data is written to the file fileName<t>.txt, or appended as a record of that name to the archive if it is open.
+ * @param fileName Name of the file into which the data is to be written. The value of time is appended to it.
+ * @param t Value of time.
+ */
+void Grain::writeFrame (std::string fileName, double t)
+{
+    TextWriter data;
+
+    this->writeFrame(data, t);
+    this->writeStepOutput(fileName, t, data.str());
+}
+
+/**
+ * @brief Writes an output of one time step to the file fileName<t>.txt, or appends it as a record of that name to the archive if it is open.
+ * @param fileName Name of the file, to which the value of time is appended.
+ * @param t Value of time.
+ * @param data The output.
+ */
+void Grain::writeStepOutput (std::string fileName, double t, const std::string& data)
+{
+    std::string outFileName = fileName + doubleToString(t) + ".txt";
+
+    if (this->archive.isOpen()) {
+        this->archive.addRecord(TimeSeriesArchive::baseName(outFileName), t, data);
+        return;
+    }
+
+    TextWriter fp;
+    if (fp.open(outFileName, false)) {
+        fp << data;
         fp.close();
     }
 }
 
+/**
+ * @brief Writes out the complete state of the grain in the format of the grain file.
+ * @param fp The writer into which the data will be written.
+ * @param t Value of time.
+ */
+void Grain::writeFrame (TextWriter& fp, double t)
+{
+    std::vector<Vector3d> gbPoints = this->getGBPoints_base();
+    std::vector<SlipSystem*>::iterator s_it;
+    std::vector<SlipPlane*>::const_iterator sp_it;
+    std::vector<Dislocation*>::const_iterator d_it;
+    std::vector<DislocationSource*>::const_iterator ds_it;
+    Vector3d v;
+    int i, j;
+
+    // Time
+    fp << "# Current time\n" << t << "\n";
+
+    // Orientation, in degrees
+    fp << "# Orientation\n";
+    for (i=0; i<3; i++) {
+        fp << this->phi[i] * RAD2DEG << " ";
+    }
+    fp << "\n";
+
+    // Grain boundary points
+    fp << "# Number of grain boundary points\n" << (int) gbPoints.size() << "\n";
+    for (i=0; i<gbPoints.size(); i++) {
+        fp << gbPoints[i].getValue(0) << " " << gbPoints[i].getValue(1) << " " << gbPoints[i].getValue(2) << "\n";
+    }
+
+    // Slip systems
+    fp << "# Number of slip systems\n" << (int) this->slipSystems.size() << "\n";
+    for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
+        const std::vector<SlipPlane*>& slipPlanes = (*s_it)->getSlipPlanes();
+
+        fp << "# Slip system position\n";
+        v = (*s_it)->getPosition();
+        fp << v.getValue(0) << " " << v.getValue(1) << " " << v.getValue(2) << "\n";
+        fp << "# Slip system normal\n";
+        v = (*s_it)->getNormal();
+        fp << v.getValue(0) << " " << v.getValue(1) << " " << v.getValue(2) << "\n";
+
+        fp << "# Number of slip planes\n" << (int) slipPlanes.size() << "\n";
+        for (sp_it=slipPlanes.begin(); sp_it!=slipPlanes.end(); sp_it++) {
+            const std::vector<Dislocation*>& dislocations = (*sp_it)->getDislocationList();
+            const std::vector<DislocationSource*>& sources = (*sp_it)->getDislocationSourceList();
+
+            fp << "# Slip plane position\n";
+            v = (*sp_it)->getPosition();
+            fp << v.getValue(0) << " " << v.getValue(1) << " " << v.getValue(2) << "\n";
+
+            fp << "# Number of dislocations\n" << (int) dislocations.size() << "\n";
+            for (d_it=dislocations.begin(); d_it!=dislocations.end(); d_it++) {
+                v = (*d_it)->getPosition();
+                for (j=0; j<3; j++) {
+                    fp << v.getValue(j) << " ";
+                }
+                v = (*d_it)->getBurgers();
+                for (j=0; j<3; j++) {
+                    fp << v.getValue(j) << " ";
+                }
+                v = (*d_it)->getLineVector();
+                for (j=0; j<3; j++) {
+                    fp << v.getValue(j) << " ";
+                }
+                fp << (*d_it)->getBurgersMagnitude() << " " << (int) (*d_it)->isMobile() << "\n";
+            }
+
+            fp << "# Number of dislocation sources\n" << (int) sources.size() << "\n";
+            for (ds_it=sources.begin(); ds_it!=sources.end(); ds_it++) {
+                v = (*ds_it)->getPosition();
+                for (j=0; j<3; j++) {
+                    fp << v.getValue(j) << " ";
+                }
+                v = (*ds_it)->getBurgers();
+                for (j=0; j<3; j++) {
+                    fp << v.getValue(j) << " ";
+                }
+                v = (*ds_it)->getLineVector();
+                for (j=0; j<3; j++) {
+                    fp << v.getValue(j) << " ";
+                }
+                fp << (*ds_it)->getBurgersMag() << "\n";
+            }
+        }
+    }
+}
+
+/**
+ * @brief Writes out the frames of the grain with a cadence that depends on the bursts of plastic activity.
+ * @details Outside the bursts, a frame, as written by Grain::writeFrame, is written when the baseline output is due, and the frames in between are taken at the dense cadence and kept in memory. When a burst starts, the frames kept in memory are written, followed by a frame at the dense cadence until the burst ends. This function must be called at every time step.
+ * @param fileName Name of the files into which the frames are written. The value of time is appended to it.
+ * @param t Value of time.
+ * @param baselineDue True if a frame is due at the baseline cadence.
+ * @param burst True if a burst is under way.
+ * @param burstStart True if the burst started at the present time step.
+ */
+void Grain::writeBurstFrame (std::string fileName, double t, bool baselineDue, bool burst, bool burstStart)
+{
+    CaptureAction action = this->burstCapture.step(baselineDue, burst, burstStart);
+
+    if (action == CAPTURE_SKIP) {
+        return;
+    }
+
+    TextWriter data;
+    this->writeFrame(data, t);
+
+    if (action == CAPTURE_KEEP) {
+        this->burstCapture.keep(t, data.str());
+        return;
+    }
+
+    if (burstStart) {
+        // The frames leading to the burst
+        std::vector<CapturedSnapshot> before = this->burstCapture.release();
+        std::vector<CapturedSnapshot>::iterator b_it;
+        for (b_it=before.begin(); b_it!=before.end(); b_it++) {
+            this->writeStepOutput(fileName, b_it->time, b_it->data);
+        }
+    }
+
+    this->writeStepOutput(fileName, t, data.str());
+}
+
+/**
+ * @brief Writes out the defects of the grain as a VTK file of a series that can be read by ParaView.
+ * @details The collection fileName.pvd is created at the first call, along with the grain boundary in fileName_boundary.vtu, and each call writes the file fileName_<n>.vtu with binary data. Each defect is a point, in the base co-ordinate system, carrying its type, the index of its slip plane, its Burgers vector multiplied by its magnitude and the total stress acting on it, both in the base co-ordinate system. The stress of the extremities and of the pinned dislocations is only calculated if Grain::setStressOnAllDefects has been enabled.
+ * @param fileName Name of the files, without the extension.
+ * @param t Value of time.
+ */
+void Grain::writeVTK (std::string fileName, double t)
+{
+    if (!this->vtkWriter.isOpen()) {
+        if (!this->vtkWriter.open(fileName)) {
+            displayMessage("Error: Unable to create the file " + fileName + ".pvd");
+            return;
+        }
+        // The grain boundary does not change
+        this->vtkWriter.writeBoundary(this->gbPoints_base);
+    }
+
+    std::vector<SlipSystem*>::iterator s_it;
+    std::vector<SlipPlane*>::const_iterator sp_it;
+    std::vector<Defect*> defects;
+    std::vector<Vector3d> positions;
+    CoordinateSystem* ssSystem;
+    CoordinateSystem* spSystem;
+    Dislocation* d;
+    Vector3d b;
+    Stress s;
+    int nSlipPlanes = 0;
+    int j, k;
+
+    // Only the current output is held in memory
+    std::vector<double> points;
+    std::vector<int> types;
+    std::vector<int> planes;
+    std::vector<double> burgers;
+    std::vector<double> stress;
+
+    for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
+        ssSystem = (*s_it)->getCoordinateSystem();
+        const std::vector<SlipPlane*>& slipPlanes = (*s_it)->getSlipPlanes();
+        for (sp_it=slipPlanes.begin(); sp_it!=slipPlanes.end(); sp_it++, nSlipPlanes++) {
+            spSystem = (*sp_it)->getCoordinateSystem();
+
+            // Positions of the defects, from the slip plane to the base co-ordinate system
+            defects = (*sp_it)->getDefectList();
+            positions = (*sp_it)->getAllDefectPositions_base();
+            positions = ssSystem->vector_LocalToBase(positions);
+            positions = this->coordinateSystem.vector_LocalToBase(positions);
+
+            for (j=0; j<defects.size(); j++) {
+                for (k=0; k<3; k++) {
+                    points.push_back(positions[j].getValue(k));
+                }
+                types.push_back((int) defects[j]->getDefectType());
+                planes.push_back(nSlipPlanes);
+
+                // Burgers vector, from the slip plane to the base co-ordinate system
+                if (defects[j]->getDefectType() == DISLOCATION) {
+                    d = (Dislocation*) defects[j];
+                    b = d->getBurgers() * d->getBurgersMagnitude();
+                    b = this->coordinateSystem.vector_LocalToBase_noTranslate(ssSystem->vector_LocalToBase_noTranslate(spSystem->vector_LocalToBase_noTranslate(b)));
+                }
+                else {
+                    b = Vector3d();
+                }
+                for (k=0; k<3; k++) {
+                    burgers.push_back(b.getValue(k));
+                }
+
+                // Total stress, from the defect to the base co-ordinate system
+                s = defects[j]->getCoordinateSystem()->stress_LocalToBase(defects[j]->getTotalStress());
+                s = this->coordinateSystem.stress_LocalToBase(ssSystem->stress_LocalToBase(spSystem->stress_LocalToBase(s)));
+                for (k=0; k<3; k++) {
+                    stress.push_back(s.getPrincipalStress(k));
+                }
+                for (k=0; k<3; k++) {
+                    stress.push_back(s.getShearStress(k));
+                }
+            }
+        }
+    }
+
+    if (!this->vtkWriter.writeFrame(t, points, types, planes, burgers, stress)) {
+        displayMessage("Error: Unable to write the VTK output of the grain");
+    }
+}
+
 /**
  * @brief Write the six unique components of the stress field tensor, expressed in the base co-ordinate system, along the line between p0 and p1 with a resolution that is specified.
+ * @details The data is written to the file fileName<t>.txt, or appended as a record of that name to the archive if it is open.
  * @param fileName Name of the file into which the data will be written.
  * @param t The current value of time in the simulation.
  * @param p0 Position vector, in the base co-ordinate system, of the starting point.
@@ -76,28 +324,50 @@ void Grain::writeStressField (std::string fileName, double t, Vector3d p0, Vecto
     }
 
     std::string outFileName = fileName + doubleToString(t) + ".txt";
-    std::ofstream fp (outFileName.c_str(), std::ios_base::app);
-
-    if (fp.is_open()) {
-        Vector3d p = p0;
-        Vector3d r = (p1-p0)*(1.0/resolution);
-        Stress s;
 
-        int i=0;
-        while (i < resolution) {
-            p += r;
-            s = this->grainStressField(p, mu, nu);
+    TextWriter fp;
 
-            fp << p.getValue(0) << " " << p.getValue(1) << " " << s.getPrincipalStress(0) << " " << s.getPrincipalStress(1) << " " << s.getPrincipalStress(2) << " " << s.getShearStress(0) << " " << s.getShearStress(1) << " " << s.getShearStress(2) << std::endl;
-            i++;
-        }
+    if (this->archive.isOpen()) {
+        this->writeStressField(fp, p0, p1, resolution, mu, nu);
+        this->archive.addRecord(TimeSeriesArchive::baseName(outFileName), t, fp.str());
+        return;
+    }
 
+    if (fp.open(outFileName, true)) {
+        this->writeStressField(fp, p0, p1, resolution, mu, nu);
         fp.close();
     }
 }
 
+/**
+ * @brief Write the six unique components of the stress field tensor, expressed in the base co-ordinate system, along the line between p0 and p1 with a resolution that is specified.
+ * @param fp The writer into which the data will be written.
+ * @param p0 Position vector, in the base co-ordinate system, of the starting point.
+ * @param p1 Position vector, in the base co-ordinate system, of the ending point.
+ * @param resolution The number of points, starting from p0, at which the stress field will be calculated.
+ * @param mu Shear modulus (Pa).
+ * @param nu Poisson's ratio.
+ */
+void Grain::writeStressField (TextWriter& fp, Vector3d p0, Vector3d p1, int resolution, double mu, double nu)
+{
+    Vector3d p = p0;
+    Vector3d r = (p1-p0)*(1.0/resolution);
+    Stress s;
+
+    int i=0;
+    while (i < resolution) {
+        p += r;
+        s = this->grainStressField(p, mu, nu);
+
+        fp << p.getValue(0) << " " << p.getValue(1) << " " << s.getPrincipalStress(0) << " " << s.getPrincipalStress(1) << " " << s.getPrincipalStress(2) << " " << s.getShearStress(0) << " " << s.getShearStress(1) << " " << s.getShearStress(2);
+        fp.endLine();
+        i++;
+    }
+}
+
 /**
  * @brief Write the stress field along the grain boundary points of the grain.
+ * @details The stress field is sampled by StressProbes placed along the grain boundary, which are set at the first call and whenever the resolution changes. All probes are written as one row of the file fileName.txt, which contains the time and the six components of the stress tensor at each probe, in the base co-ordinate system. The positions of the probes are written to fileName_points.txt. Nothing is written if the interval set with Grain::setGrainBoundaryProbeInterval has not elapsed since the last output.
  * @param fileName The name of the file to which the  data is to be written.
  * @param t The value of he current time.
  * @param resolution The number of points along each grain boundary.
@@ -106,16 +376,352 @@ void Grain::writeStressField (std::string fileName, double t, Vector3d p0, Vecto
  */
 void Grain::writeGrainBoundaryStressField (std::string fileName, double t, int resolution, double mu, double nu)
 {
-    int s = this->gbPoints_base.size();
-    int i;
-    Vector3d p0, p1;
+    if (this->gbProbes.getResolution() != resolution || !this->gbProbes.isOpen()) {
+        // Set the probes and open the output file
+        this->gbProbes.setGrainBoundaryProbes(this->gbPoints_base, resolution, &(this->coordinateSystem), this->slipSystems);
+        if (!this->gbProbes.open(fileName)) {
+            return;
+        }
+    }
+
+    if (!this->gbProbes.ifWrite(t)) {
+        return;
+    }
+
+    if (this->cellList.isEnabled()) {
+        // The dislocations have moved since the cell list was last updated
+        this->cellList.update(this->slipSystems, &(this->coordinateSystem), this->coordinateSystem.vector_BaseToLocal_noTranslate(Vector3d::unitVector(2)));
+    }
+
+    this->gbProbes.write(t, this->slipSystems, &(this->coordinateSystem), &(this->cellList), mu, nu);
+}
+
+/**
+ * @brief Publishes a snapshot of the grain in shared memory.
+ * @details The shared memory is created by SnapshotRing::create at the first call. The snapshot holds the positions, in the base co-ordinate system, and the types of all defects, and for each slip plane the numbers of dislocations and dislocation sources, the number of emissions and the shear component of the plastic slip. Only the latest nSlots snapshots are kept.
+ * @param name Name of the shared memory, without the leading /.
+ * @param t The value of the current time.
+ * @param nSlots Number of snapshots kept.
+ * @param maxDefects Number of defects that a snapshot can hold.
+ */
+void Grain::writeLiveSnapshot (std::string name, double t, int nSlots, int maxDefects)
+{
+    std::vector<SlipSystem*>::iterator s_it;
+    std::vector<SlipPlane*> slipPlanes;
+    std::vector<SlipPlane*>::iterator sp_it;
+    std::vector<Defect*> defects;
+    std::vector<Vector3d> positions;
+    SlipPlane* sp;
+    SnapshotSlipPlane planeStats;
+    int nSlipPlanes = 0;
+    int i, j;
 
-    p0 = this->gbPoints_base.back();
-    i = 0;
-    while (i < s) {
-        p1 = this->gbPoints_base.at(i);
-        this->writeStressField(fileName, t, p0, p1, resolution, mu, nu);
-        p0 = p1;
-        i++;
+    if (!this->liveSnapshots.isOpen()) {
+        for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
+            nSlipPlanes += (*s_it)->getSlipPlanes().size();
+        }
+        if (!this->liveSnapshots.create(name, nSlots, maxDefects, nSlipPlanes)) {
+            displayMessage("Error: Unable to create the shared memory for the live snapshots /" + name);
+            return;
+        }
+        displayMessage("Publishing live snapshots in the shared memory " + this->liveSnapshots.getName());
+    }
+
+    this->liveSnapshots.beginSnapshot(t);
+
+    for (s_it=this->slipSystems.begin(), i=0; s_it!=this->slipSystems.end(); s_it++, i++) {
+        slipPlanes = (*s_it)->getSlipPlanes();
+        for (sp_it=slipPlanes.begin(); sp_it!=slipPlanes.end(); sp_it++) {
+            sp = *sp_it;
+
+            // Positions of the defects, from the slip plane to the base co-ordinate system
+            defects = sp->getDefectList();
+            positions = sp->getAllDefectPositions_base();
+            positions = (*s_it)->getCoordinateSystem()->vector_LocalToBase(positions);
+            positions = this->coordinateSystem.vector_LocalToBase(positions);
+            for (j=0; j<defects.size(); j++) {
+                this->liveSnapshots.addDefect(positions[j].getValue(0), positions[j].getValue(1), (int) defects[j]->getDefectType());
+            }
+
+            // Statistics of the slip plane
+            planeStats.slipSystem = i;
+            planeStats.nDislocations = sp->getNumDislocations();
+            planeStats.nDislocationSources = sp->getDislocationSourceList().size();
+            planeStats.nEmissions = sp->getNumEmissions();
+            planeStats.plasticSlip = sp->getPlasticSlip().getValue(0, 2);
+            this->liveSnapshots.addSlipPlane(planeStats);
+        }
+    }
+
+    this->liveSnapshots.endSnapshot();
+}
+
+/**
+ * @brief Writes out the current time and the relative deviation of the stress field obtained with the kernel tables from the exact double precision stress field, for each slip system.
+ * @details The deviations are calculated by SlipSystem::checkKernelPrecision. The file is opened in append mode and a newline is inserted after each entry.
+ * @param fileName Name of the file into which the data is to be written.
+ * @param t Value of time.
+ * @param mu Shear modulus (Pa).
+ * @param nu Poisson's ratio.
+ */
+void Grain::writeKernelPrecision (std::string fileName, double t, double mu, double nu)
+{
+    std::ofstream fp (fileName.c_str(), std::ios_base::app);
+
+    if (fp.is_open()) {
+        std::vector<SlipSystem*>::iterator s_it;
+        SlipSystem* s;
+
+        fp << t;
+        for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
+            s = *s_it;
+            s->prepareKernelTables(mu, nu);
+            fp << " " << s->checkKernelPrecision(mu, nu);
+        }
+        fp << std::endl;
+        fp.close();
+    }
+}
+
+/**
+ * @brief Writes out the current time, the applied stress, the dislocation density and the plastic strain of the grain, of each slip system and of each slip plane.
+ * @details The row starts with the time, the six components of the applied stress, the dislocation density and the six components of the plastic strain of the grain. The six components of the plastic strain carried by each slip system follow, and then those carried by each slip plane, in the order of the slip systems. Tensors are written in the order xx yy zz xy xz yz and are expressed in the base co-ordinate system. The file is opened in append mode and a newline is inserted after each entry.
+ * @param fileName Name of the file into which the data is to be written.
+ * @param t Value of time.
+ * @param appliedStress The applied stress, expressed in the base co-ordinate system.
+ */
+void Grain::writePlasticStrain (std::string fileName, double t, Stress appliedStress)
+{
+    std::ofstream fp (fileName.c_str(), std::ios_base::app);
+
+    if (fp.is_open()) {
+        std::vector<SlipSystem*>::iterator s_it;
+        SlipSystem* s;
+        CoordinateSystem* sSystem;
+        std::vector<SlipPlane*> slipPlanes;
+        std::vector<SlipPlane*>::iterator sp_it;
+        SlipPlane* sp;
+
+        double area = this->getArea();
+        std::vector<Strain> strains;
+        std::vector<Strain>::iterator e_it;
+        Strain e;
+
+        // Plastic slip of the grain, then of the slip systems, then of the slip planes
+        strains.push_back(Strain());
+        for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
+            s = *s_it;
+            e = this->coordinateSystem.strain_LocalToBase(s->getCoordinateSystem()->strain_LocalToBase(s->getPlasticSlip()));
+            strains.front() += e;
+            strains.push_back(e);
+        }
+        for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
+            s = *s_it;
+            sSystem = s->getCoordinateSystem();
+            slipPlanes = s->getSlipPlanes();
+            for (sp_it=slipPlanes.begin(); sp_it!=slipPlanes.end(); sp_it++) {
+                sp = *sp_it;
+                strains.push_back(this->coordinateSystem.strain_LocalToBase(sSystem->strain_LocalToBase(sp->getCoordinateSystem()->strain_LocalToBase(sp->getPlasticSlip()))));
+            }
+        }
+
+        fp << t;
+        fp << " " << appliedStress.getPrincipalStress(0) << " " << appliedStress.getPrincipalStress(1) << " " << appliedStress.getPrincipalStress(2);
+        fp << " " << appliedStress.getShearStress(0) << " " << appliedStress.getShearStress(1) << " " << appliedStress.getShearStress(2);
+        fp << " " << (this->getNumDislocations() / area);
+
+        for (e_it=strains.begin(); e_it!=strains.end(); e_it++) {
+            // Plastic strain
+            e = Strain((*e_it) * (1.0/area));
+            fp << " " << e.getPrincipalStrain(0) << " " << e.getPrincipalStrain(1) << " " << e.getPrincipalStrain(2);
+            fp << " " << e.getShearStrain(0) << " " << e.getShearStrain(1) << " " << e.getShearStrain(2);
+        }
+        fp << std::endl;
+        fp.close();
+    }
+}
+
+/**
+ * @brief Writes out the current time and the line density of dislocations on each slip plane.
+ * @details The line density is the number of dislocations on the slip plane divided by its length. The slip planes are written in the order of the slip systems. The file is opened in append mode and a newline is inserted after each entry.
+ * @param fileName Name of the file into which the data is to be written.
+ * @param t Value of time.
+ */
+void Grain::writeSlipPlaneDensities (std::string fileName, double t)
+{
+    std::ofstream fp (fileName.c_str(), std::ios_base::app);
+
+    if (fp.is_open()) {
+        std::vector<SlipSystem*>::iterator s_it;
+        std::vector<SlipPlane*> slipPlanes;
+        std::vector<SlipPlane*>::iterator sp_it;
+        SlipPlane* sp;
+
+        fp << t;
+        for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
+            slipPlanes = (*s_it)->getSlipPlanes();
+            for (sp_it=slipPlanes.begin(); sp_it!=slipPlanes.end(); sp_it++) {
+                sp = *sp_it;
+                fp << " " << (sp->getNumDislocations() / sp->getLength());
+            }
+        }
+        fp << std::endl;
+        fp.close();
+    }
+}
+
+/**
+ * @brief Writes out the current time and the pile-ups against both extremities of each slip plane.
+ * @details For each slip plane, the number of dislocations and the length of the pile-ups against the first and the second extremity are written, as found by SlipPlane::findPileUp. The file is opened in append mode and a newline is inserted after each entry.
+ * @param fileName Name of the file into which the data is to be written.
+ * @param t Value of time.
+ */
+void Grain::writePileUps (std::string fileName, double t)
+{
+    std::ofstream fp (fileName.c_str(), std::ios_base::app);
+
+    if (fp.is_open()) {
+        std::vector<SlipSystem*>::iterator s_it;
+        std::vector<SlipPlane*> slipPlanes;
+        std::vector<SlipPlane*>::iterator sp_it;
+        SlipPlane* sp;
+
+        int n;
+        double length;
+
+        fp << t;
+        for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
+            slipPlanes = (*s_it)->getSlipPlanes();
+            for (sp_it=slipPlanes.begin(); sp_it!=slipPlanes.end(); sp_it++) {
+                sp = *sp_it;
+                sp->findPileUp(0, n, length);
+                fp << " " << n << " " << length;
+                sp->findPileUp(1, n, length);
+                fp << " " << n << " " << length;
+            }
+        }
+        fp << std::endl;
+        fp.close();
+    }
+}
+
+/**
+ * @brief Writes out the map of the density of geometrically necessary dislocations.
+ * @details The bounding box of the grain is divided into resolution x resolution cells. In each cell the components \f$\alpha_{xz}, \alpha_{yz}, \alpha_{zz}\f$ of the Nye tensor are calculated as the sum of the Burgers vectors of the dislocations it contains, times the component of their line vector along the viewing axis, divided by the area of the cell. Each row of the file contains the co-ordinates of the centre of a cell and the three components, expressed in the base co-ordinate system. A new file is written for each value of time, or a record of the archive if it is open.
+ * @param fileName Name of the file into which the data is to be written. The value of time is appended to it.
+ * @param t Value of time.
+ * @param resolution Number of cells along each axis.
+ */
+void Grain::writeGNDMap (std::string fileName, double t, int resolution)
+{
+    if (resolution <= 0 || this->gbPoints_base.empty()) {
+        // Invalid resolution or grain
+        return;
+    }
+
+    int i, j;
+
+    // Bounding box of the grain
+    double xMin, xMax, yMin, yMax;
+    std::vector<Vector3d>::iterator gb_it;
+    xMin = xMax = this->gbPoints_base.front().getValue(0);
+    yMin = yMax = this->gbPoints_base.front().getValue(1);
+    for (gb_it=this->gbPoints_base.begin(); gb_it!=this->gbPoints_base.end(); gb_it++) {
+        xMin = std::min(xMin, gb_it->getValue(0));
+        xMax = std::max(xMax, gb_it->getValue(0));
+        yMin = std::min(yMin, gb_it->getValue(1));
+        yMax = std::max(yMax, gb_it->getValue(1));
+    }
+    double dx = (xMax - xMin) / resolution;
+    double dy = (yMax - yMin) / resolution;
+
+    // Components of the Nye tensor, three per cell
+    std::vector<double> alpha(3*resolution*resolution, 0.0);
+
+    std::vector<SlipSystem*>::iterator s_it;
+    CoordinateSystem* sSystem;
+    std::vector<SlipPlane*> slipPlanes;
+    std::vector<SlipPlane*>::iterator sp_it;
+    CoordinateSystem* spSystem;
+    std::vector<Dislocation*> dislocations;
+    std::vector<Dislocation*>::iterator d_it;
+    Dislocation* d;
+
+    Vector3d p, b, l;
+    for (s_it=this->slipSystems.begin(); s_it!=this->slipSystems.end(); s_it++) {
+        sSystem = (*s_it)->getCoordinateSystem();
+        slipPlanes = (*s_it)->getSlipPlanes();
+        for (sp_it=slipPlanes.begin(); sp_it!=slipPlanes.end(); sp_it++) {
+            spSystem = (*sp_it)->getCoordinateSystem();
+            dislocations = (*sp_it)->getDislocationList();
+            for (d_it=dislocations.begin(); d_it!=dislocations.end(); d_it++) {
+                d = *d_it;
+                // Position, Burgers vector and line vector in the base co-ordinate system
+                p = this->coordinateSystem.vector_LocalToBase(sSystem->vector_LocalToBase(spSystem->vector_LocalToBase(d->getPosition())));
+                b = this->coordinateSystem.vector_LocalToBase_noTranslate(sSystem->vector_LocalToBase_noTranslate(spSystem->vector_LocalToBase_noTranslate(d->getBurgers())));
+                l = this->coordinateSystem.vector_LocalToBase_noTranslate(sSystem->vector_LocalToBase_noTranslate(spSystem->vector_LocalToBase_noTranslate(d->getLineVector())));
+                i = std::min(std::max((int) floor((p.getValue(0) - xMin) / dx), 0), resolution-1);
+                j = std::min(std::max((int) floor((p.getValue(1) - yMin) / dy), 0), resolution-1);
+                b *= d->getBurgersMagnitude() * l.normalize().getValue(2);
+                alpha[3*(j*resolution+i)  ] += b.getValue(0);
+                alpha[3*(j*resolution+i)+1] += b.getValue(1);
+                alpha[3*(j*resolution+i)+2] += b.getValue(2);
+            }
+        }
+    }
+
+    // The map, written to its own file or to the archive
+    TextWriter fp;
+    double cellArea = dx * dy;
+    for (j=0; j<resolution; j++) {
+        for (i=0; i<resolution; i++) {
+            fp << xMin + ((i+0.5)*dx) << ' ' << yMin + ((j+0.5)*dy);
+            fp << ' ' << alpha[3*(j*resolution+i)] / cellArea << ' ' << alpha[3*(j*resolution+i)+1] / cellArea << ' ' << alpha[3*(j*resolution+i)+2] / cellArea;
+            fp.endLine();
+        }
+    }
+
+    this->writeStepOutput(fileName, t, fp.str());
+}
+
+/**
+ * @brief Writes out the current time and the numbers of emissions, annihilations and absorptions since the beginning of the simulation.
+ * @details The row contains the time, the totals for the grain and then the three numbers for each slip system. The file is opened in append mode and a newline is inserted after each entry.
+ * @param fileName Name of the file into which the data is to be written.
+ * @param t Value of time.
+ */
+void Grain::writeDefectEvents (std::string fileName, double t)
+{
+    std::ofstream fp (fileName.c_str(), std::ios_base::app);
+
+    if (fp.is_open()) {
+        std::vector<SlipSystem*>::iterator s_it;
+        std::vector<SlipPlane*> slipPlanes;
+        std::vector<SlipPlane*>::iterator sp_it;
+        SlipPlane* sp;
+
+        int nSystems = this->slipSystems.size();
+        std::vector<int> counts(3*(nSystems+1), 0);
+        int i, k;
+
+        for (s_it=this->slipSystems.begin(), i=1; s_it!=this->slipSystems.end(); s_it++, i++) {
+            slipPlanes = (*s_it)->getSlipPlanes();
+            for (sp_it=slipPlanes.begin(); sp_it!=slipPlanes.end(); sp_it++) {
+                sp = *sp_it;
+                counts[3*i  ] += sp->getNumEmissions();
+                counts[3*i+1] += sp->getNumAnnihilations();
+                counts[3*i+2] += sp->getNumAbsorptions();
+            }
+            for (k=0; k<3; k++) {
+                counts[k] += counts[3*i+k];
+            }
+        }
+
+        fp << t;
+        for (k=0; k<(int)counts.size(); k++) {
+            fp << " " << counts[k];
+        }
+        fp << std::endl;
+        fp.close();
     }
 }
@@ -0,0 +1,422 @@
+/**
+ * @file kernelTable.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the member functions of the classes KernelTable and KernelCache.
+ * @details This file defines the member functions of the classes KernelTable and KernelCache used to tabulate the interaction between dislocations lying on parallel slip planes of the same slip system.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "kernelTable.h"
+
+// Constructors
+/**
+ * @brief Default constructor. The table is empty and invalid.
+ */
+KernelTable::KernelTable ()
+{
+    this->uMin = 0.0;
+    this->uMax = 0.0;
+    this->du = 0.0;
+    this->n = 0;
+    this->valid = false;
+    this->validSingle = false;
+}
+
+/**
+ * @brief Constructor that builds the table.
+ * @param offset Offset between the destination and source slip plane origins, in the slip system co-ordinate system.
+ * @param rotation Rotation matrix of the source dislocations.
+ * @param uMin Smallest separation to be covered.
+ * @param uMax Largest separation to be covered.
+ * @param mu Shear modulus (Pa).
+ * @param nu Poisson's ratio.
+ * @param tolerance Maximum interpolation error, relative to the peak value of the kernel.
+ * @param singlePrecision Flag indicating whether a single precision copy of the table is to be built and checked as well.
+ */
+KernelTable::KernelTable (Vector3d offset, RotationMatrix rotation, double uMin, double uMax, double mu, double nu, double tolerance, bool singlePrecision)
+{
+    this->offset = offset;
+    this->rotation = rotation;
+    this->valid = false;
+    this->validSingle = false;
+    this->n = 0;
+    this->du = 0.0;
+
+    // Distance between the source dislocation line and the destination slip plane
+    double h = sqrt ( (offset.getValue(1)*offset.getValue(1)) + (offset.getValue(2)*offset.getValue(2)) );
+
+    // Pad the range by one spacing on each side
+    this->uMin = uMin - h;
+    this->uMax = uMax + h;
+
+    if ( h == 0.0 || this->uMax <= this->uMin ) {
+        // The kernel is singular on the slip plane itself
+        return;
+    }
+
+    double v[KERNELTABLE_NODE_SIZE];
+    double interpolated[6];
+    double peak[2] = {0.0, 0.0};
+    double error[2] = {0.0, 0.0};
+    double u;
+    int i, k, c;
+
+    double step = h / KERNELTABLE_NODES_PER_SPACING;
+
+    while ( !this->valid ) {
+        this->n = (int) ceil ( (this->uMax - this->uMin) / step ) + 1;
+        if ( this->n < 4 ) {
+            this->n = 4;
+        }
+        if ( this->n > KERNELTABLE_MAX_NODES ) {
+            // The tolerance cannot be reached
+            this->values.clear();
+            this->n = 0;
+            return;
+        }
+        this->du = (this->uMax - this->uMin) / (double) (this->n - 1);
+
+        // Fill the nodes
+        this->values.assign ( this->n * KERNELTABLE_NODE_SIZE, 0.0 );
+        peak[0] = peak[1] = 0.0;
+        for ( k=0; k<this->n; k++ ) {
+            this->exactKernel ( this->uMin + (k*this->du), mu, nu, &(this->values[k*KERNELTABLE_NODE_SIZE]) );
+            for ( c=0; c<6; c++ ) {
+                peak[0] = std::max ( peak[0], fabs ( this->values[(k*KERNELTABLE_NODE_SIZE)+c] ) );
+                peak[1] = std::max ( peak[1], fabs ( this->values[(k*KERNELTABLE_NODE_SIZE)+6+c] ) );
+            }
+        }
+
+        // Check the interpolation error at the midpoints of all intervals
+        this->valid = true;
+        error[0] = error[1] = 0.0;
+        for ( k=0; k<this->n-1; k++ ) {
+            u = this->uMin + ((k+0.5)*this->du);
+            this->exactKernel ( u, mu, nu, v );
+            for ( i=0; i<2; i++ ) {
+                for ( c=0; c<6; c++ ) {
+                    interpolated[c] = 0.0;
+                }
+                this->accumulate ( u, (double)(i==0), (double)(i==1), interpolated );
+                for ( c=0; c<6; c++ ) {
+                    error[i] = std::max ( error[i], fabs ( interpolated[c] - v[(6*i)+c] ) );
+                }
+            }
+        }
+
+        this->valid = ( error[0] <= tolerance*peak[0] && error[1] <= tolerance*peak[1] );
+        step *= 0.5;
+    }
+
+    if ( !singlePrecision ) {
+        return;
+    }
+
+    // Single precision copy, checked at the midpoints against the exact values
+    float interpolatedSingle[6], compensation[6];
+    double toleranceSingle = std::max ( tolerance, KERNELTABLE_SINGLE_TOLERANCE );
+
+    this->valuesSingle.assign ( this->values.begin(), this->values.end() );
+    error[0] = error[1] = 0.0;
+    for ( k=0; k<this->n-1; k++ ) {
+        u = this->uMin + ((k+0.5)*this->du);
+        this->exactKernel ( u, mu, nu, v );
+        for ( i=0; i<2; i++ ) {
+            for ( c=0; c<6; c++ ) {
+                interpolatedSingle[c] = 0.0f;
+                compensation[c] = 0.0f;
+            }
+            this->accumulate_single<MIXED> ( u, (float)(i==0), (float)(i==1), interpolatedSingle, compensation );
+            for ( c=0; c<6; c++ ) {
+                error[i] = std::max ( error[i], fabs ( (double) interpolatedSingle[c] - v[(6*i)+c] ) );
+            }
+        }
+    }
+
+    this->validSingle = ( error[0] <= toleranceSingle*peak[0] && error[1] <= toleranceSingle*peak[1] );
+    if ( !this->validSingle ) {
+        // The double precision values will be used
+        this->valuesSingle.clear();
+    }
+}
+
+/**
+ * @brief Calculates the exact unit kernels at the separation u.
+ * @param u Separation along the slip direction between the field point and the dislocation.
+ * @param mu Shear modulus (Pa).
+ * @param nu Poisson's ratio.
+ * @param v Array of size KERNELTABLE_NODE_SIZE into which the kernels are written.
+ */
+void KernelTable::exactKernel (double u, double mu, double nu, double *v) const
+{
+    // Position of the field point in the dislocation co-ordinate system
+    Vector3d r = this->offset + Vector3d ( u, 0.0, 0.0 );
+    Vector3d rLocal = this->rotation * r;
+    RotationMatrix rotationT ( this->rotation.transpose() );
+
+    Stress edge  = Dislocation::edgeStressField ( rLocal, mu / ( 2.0 * PI * ( 1.0 - nu ) ), nu ).rotate ( rotationT );
+    Stress screw = Dislocation::screwStressField ( rLocal, mu / ( 2.0 * PI ) ).rotate ( rotationT );
+
+    int c;
+    for ( c=0; c<3; c++ ) {
+        v[c]   = edge.getPrincipalStress(c);
+        v[c+3] = edge.getShearStress(c);
+        v[c+6] = screw.getPrincipalStress(c);
+        v[c+9] = screw.getShearStress(c);
+    }
+}
+
+// Access functions
+/**
+ * @brief Indicates whether the table matches the offset and rotation matrix provided.
+ * @param offset Offset between the destination and source slip plane origins.
+ * @param rotation Rotation matrix of the source dislocations.
+ * @return True if the table was built for this offset and rotation matrix.
+ */
+bool KernelTable::matches (Vector3d offset, RotationMatrix rotation) const
+{
+    int i;
+    double scale = this->offset.magnitude();
+
+    for ( i=0; i<3; i++ ) {
+        if ( fabs ( this->offset.getValue(i) - offset.getValue(i) ) > SMALL_NUMBER*SMALL_NUMBER*scale ) {
+            return (false);
+        }
+    }
+
+    return ( KernelTable::sameRotation ( this->rotation, rotation ) );
+}
+
+/**
+ * @brief Indicates whether the table covers the range of separations provided.
+ * @param uMin Smallest separation.
+ * @param uMax Largest separation.
+ * @return True if the range is covered.
+ */
+bool KernelTable::covers (double uMin, double uMax) const
+{
+    return ( uMin >= this->uMin && uMax <= this->uMax );
+}
+
+/**
+ * @brief Indicates whether the table reached the required tolerance.
+ * @return True if the table is usable.
+ */
+bool KernelTable::isValid () const
+{
+    return (this->valid);
+}
+
+/**
+ * @brief Indicates whether the single precision copy of the table reached the required tolerance.
+ * @return True if the single precision copy is usable.
+ */
+bool KernelTable::isValidSingle () const
+{
+    return (this->validSingle);
+}
+
+/**
+ * @brief Get the smallest separation covered by the table.
+ * @return The smallest separation covered by the table.
+ */
+double KernelTable::getMinimum () const
+{
+    return (this->uMin);
+}
+
+/**
+ * @brief Get the largest separation covered by the table.
+ * @return The largest separation covered by the table.
+ */
+double KernelTable::getMaximum () const
+{
+    return (this->uMax);
+}
+
+/**
+ * @brief Get the number of nodes in the table.
+ * @return Number of nodes in the table.
+ */
+int KernelTable::getNumNodes () const
+{
+    return (this->n);
+}
+
+// Evaluation
+/**
+ * @brief Adds the interpolated stress field of a dislocation to the array s.
+ * @details The stress is expressed in the slip system co-ordinate system, and the components are stored in the order xx, yy, zz, xy, xz, yz. If u lies outside the table, nothing is added.
+ * @param u Separation along the slip direction between the field point and the dislocation.
+ * @param bEdge Product of the Burgers vector magnitude with the edge component of the local Burgers vector.
+ * @param bScrew Product of the Burgers vector magnitude with the screw component of the local Burgers vector.
+ * @param s Array of six values to which the stress components are added.
+ * @return True if the contribution was added, false if the caller must evaluate the stress field itself.
+ */
+bool KernelTable::accumulate (double u, double bEdge, double bScrew, double *s) const
+{
+    return ( this->accumulate_character<MIXED> ( u, bEdge, bScrew, s ) );
+}
+
+/**
+ * @brief Compares two rotation matrices.
+ * @param a First rotation matrix.
+ * @param b Second rotation matrix.
+ * @return True if all the elements of the two matrices are equal, to within round-off errors.
+ */
+bool KernelTable::sameRotation (const RotationMatrix& a, const RotationMatrix& b)
+{
+    int i, j;
+
+    for ( i=0; i<3; i++ ) {
+        for ( j=0; j<3; j++ ) {
+            if ( fabs ( a.getValue(i,j) - b.getValue(i,j) ) > SMALL_NUMBER*SMALL_NUMBER ) {
+                return (false);
+            }
+        }
+    }
+
+    return (true);
+}
+
+/**
+ * @brief Default constructor.
+ */
+KernelCache::KernelCache ()
+{
+    this->mu = 0.0;
+    this->nu = 0.0;
+    this->tolerance = KERNELTABLE_DEFAULT_TOLERANCE;
+    this->singlePrecision = false;
+}
+
+/**
+ * @brief Set the tolerance for the interpolation error. Existing tables are discarded if the value changes.
+ * @param tolerance Maximum interpolation error, relative to the peak value of each kernel.
+ */
+void KernelCache::setTolerance (double tolerance)
+{
+    if ( tolerance != this->tolerance ) {
+        this->clear();
+    }
+    this->tolerance = tolerance;
+}
+
+/**
+ * @brief Get the tolerance for the interpolation error.
+ * @return Maximum interpolation error, relative to the peak value of each kernel.
+ */
+double KernelCache::getTolerance () const
+{
+    return (this->tolerance);
+}
+
+/**
+ * @brief Set whether single precision copies of the tables are to be built. Existing tables are discarded if the value changes.
+ * @param singlePrecision Flag indicating whether single precision copies of the tables are to be built.
+ */
+void KernelCache::setSinglePrecision (bool singlePrecision)
+{
+    if ( singlePrecision != this->singlePrecision ) {
+        this->clear();
+    }
+    this->singlePrecision = singlePrecision;
+}
+
+/**
+ * @brief Get whether single precision copies of the tables are built.
+ * @return True if single precision copies of the tables are built.
+ */
+bool KernelCache::getSinglePrecision () const
+{
+    return (this->singlePrecision);
+}
+
+/**
+ * @brief Find the table for the given offset and rotation matrix covering the range of separations provided. The table is built if it does not exist yet.
+ * @param offset Offset between the destination and source slip plane origins, in the slip system co-ordinate system.
+ * @param rotation Rotation matrix of the source dislocations.
+ * @param uMin Smallest separation to be covered.
+ * @param uMax Largest separation to be covered.
+ * @param mu Shear modulus (Pa).
+ * @param nu Poisson's ratio.
+ * @return Index of the table in the cache, -1 if no valid table could be built.
+ */
+int KernelCache::findTable (Vector3d offset, RotationMatrix rotation, double uMin, double uMax, double mu, double nu)
+{
+    if ( mu != this->mu || nu != this->nu ) {
+        // The tables are no longer valid
+        this->clear();
+        this->mu = mu;
+        this->nu = nu;
+    }
+
+    int i;
+    for ( i=0; i<this->tables.size(); i++ ) {
+        if ( this->tables[i].matches ( offset, rotation ) ) {
+            if ( !this->tables[i].covers ( uMin, uMax ) ) {
+                // Rebuild the table over the union of both ranges
+                this->tables[i] = KernelTable ( offset, rotation,
+                                                std::min ( uMin, this->tables[i].getMinimum() ),
+                                                std::max ( uMax, this->tables[i].getMaximum() ),
+                                                mu, nu, this->tolerance, this->singlePrecision );
+            }
+            return ( this->tables[i].isValid() ? i : -1 );
+        }
+    }
+
+    this->tables.push_back ( KernelTable ( offset, rotation, uMin, uMax, mu, nu, this->tolerance, this->singlePrecision ) );
+    return ( this->tables.back().isValid() ? (int) (this->tables.size()-1) : -1 );
+}
+
+/**
+ * @brief Get a pointer to the table at index i.
+ * @param i Index of the table.
+ * @return Pointer to the table, NULL if the index is invalid.
+ */
+const KernelTable* KernelCache::getTable (int i) const
+{
+    if ( i>=0 && i<this->tables.size() ) {
+        return ( &(this->tables[i]) );
+    }
+    return (NULL);
+}
+
+/**
+ * @brief Get the number of tables in the cache.
+ * @return Number of tables in the cache.
+ */
+int KernelCache::getNumTables () const
+{
+    return ( this->tables.size() );
+}
+
+/**
+ * @brief Discard all tables.
+ */
+void KernelCache::clear ()
+{
+    this->tables.clear();
+}
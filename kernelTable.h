@@ -0,0 +1,432 @@
+/**
+ * @file kernelTable.h
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the classes KernelTable and KernelCache.
+ * @details This file defines the classes KernelTable and KernelCache used to tabulate the interaction between dislocations lying on parallel slip planes of the same slip system.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef KERNELTABLE_H
+#define KERNELTABLE_H
+
+#include <vector>
+#include <algorithm>
+#include <math.h>
+
+#include "dislocation.h"
+
+#ifndef KERNELTABLE_DEFAULT_TOLERANCE
+/**
+ * @brief Default value of the maximum interpolation error, relative to the peak value of the tabulated kernel.
+ */
+#define KERNELTABLE_DEFAULT_TOLERANCE 1.0e-06
+#endif
+
+#ifndef KERNELTABLE_NODES_PER_SPACING
+/**
+ * @brief Number of interpolation nodes per slip plane spacing used for the first attempt at building a table.
+ */
+#define KERNELTABLE_NODES_PER_SPACING 16
+#endif
+
+#ifndef KERNELTABLE_MAX_NODES
+/**
+ * @brief Largest number of nodes allowed in a table. Tables that do not reach the tolerance with this many nodes are marked invalid.
+ */
+#define KERNELTABLE_MAX_NODES 65536
+#endif
+
+#ifndef KERNELTABLE_SINGLE_TOLERANCE
+/**
+ * @brief Smallest relative interpolation error that single precision tables are required to reach. The round-off of single precision arithmetic does not allow smaller values.
+ */
+#define KERNELTABLE_SINGLE_TOLERANCE 1.0e-06
+#endif
+
+/**
+ * @brief Number of values stored per node: the six stress components for the unit edge kernel followed by those for the unit screw kernel.
+ */
+#define KERNELTABLE_NODE_SIZE 12
+
+/**
+ * @brief The KernelTable class represents the tabulated stress field of a dislocation, as seen from a parallel slip plane.
+ * @details Within a slip system all slip planes are parallel, and their axes coincide with those of the slip system. The stress field at a point of slip plane j due to a dislocation on slip plane i is therefore only a function of the offset between the two slip plane origins, the rotation matrix of the dislocation, its Burgers vector and the separation u of the two points along the slip direction. The stress field is linear in the edge and screw components of the Burgers vector, so two unit kernels are tabulated as functions of u. Values are interpolated with cubic Lagrange polynomials on a uniform grid. The grid is refined until the interpolation error, checked at the midpoints of all intervals, is below the tolerance relative to the peak value of the kernel.
+ */
+class KernelTable
+{
+protected:
+  /**
+   * @brief Offset between the origin of the destination slip plane and that of the source slip plane, in the slip system co-ordinate system.
+   */
+  Vector3d offset;
+  /**
+   * @brief Rotation matrix of the source dislocations, relative to their slip plane.
+   */
+  RotationMatrix rotation;
+  /**
+   * @brief Smallest value of the separation u covered by the table.
+   */
+  double uMin;
+  /**
+   * @brief Largest value of the separation u covered by the table.
+   */
+  double uMax;
+  /**
+   * @brief Spacing between nodes.
+   */
+  double du;
+  /**
+   * @brief Number of nodes.
+   */
+  int n;
+  /**
+   * @brief Flag indicating whether the table reached the required tolerance.
+   */
+  bool valid;
+  /**
+   * @brief Tabulated values, KERNELTABLE_NODE_SIZE per node.
+   */
+  std::vector<double> values;
+  /**
+   * @brief Flag indicating whether the single precision copy of the table reached the required tolerance.
+   */
+  bool validSingle;
+  /**
+   * @brief Single precision copy of the tabulated values, filled only if the table was built for single precision use.
+   */
+  std::vector<float> valuesSingle;
+
+  /**
+   * @brief Calculates the exact unit kernels at the separation u.
+   * @param u Separation along the slip direction between the field point and the dislocation.
+   * @param mu Shear modulus (Pa).
+   * @param nu Poisson's ratio.
+   * @param v Array of size KERNELTABLE_NODE_SIZE into which the kernels are written.
+   */
+  void exactKernel (double u, double mu, double nu, double *v) const;
+
+public:
+  // Constructors
+  /**
+   * @brief Default constructor. The table is empty and invalid.
+   */
+  KernelTable ();
+  /**
+   * @brief Constructor that builds the table.
+   * @param offset Offset between the destination and source slip plane origins, in the slip system co-ordinate system.
+   * @param rotation Rotation matrix of the source dislocations.
+   * @param uMin Smallest separation to be covered.
+   * @param uMax Largest separation to be covered.
+   * @param mu Shear modulus (Pa).
+   * @param nu Poisson's ratio.
+   * @param tolerance Maximum interpolation error, relative to the peak value of the kernel.
+   * @param singlePrecision Flag indicating whether a single precision copy of the table is to be built and checked as well.
+   */
+  KernelTable (Vector3d offset, RotationMatrix rotation, double uMin, double uMax, double mu, double nu, double tolerance, bool singlePrecision);
+
+  // Access functions
+  /**
+   * @brief Indicates whether the table matches the offset and rotation matrix provided.
+   * @param offset Offset between the destination and source slip plane origins.
+   * @param rotation Rotation matrix of the source dislocations.
+   * @return True if the table was built for this offset and rotation matrix.
+   */
+  bool matches (Vector3d offset, RotationMatrix rotation) const;
+  /**
+   * @brief Indicates whether the table covers the range of separations provided.
+   * @param uMin Smallest separation.
+   * @param uMax Largest separation.
+   * @return True if the range is covered.
+   */
+  bool covers (double uMin, double uMax) const;
+  /**
+   * @brief Indicates whether the table reached the required tolerance.
+   * @return True if the table is usable.
+   */
+  bool isValid () const;
+  /**
+   * @brief Indicates whether the single precision copy of the table reached the required tolerance.
+   * @return True if the single precision copy is usable.
+   */
+  bool isValidSingle () const;
+  /**
+   * @brief Get the smallest separation covered by the table.
+   * @return The smallest separation covered by the table.
+   */
+  double getMinimum () const;
+  /**
+   * @brief Get the largest separation covered by the table.
+   * @return The largest separation covered by the table.
+   */
+  double getMaximum () const;
+  /**
+   * @brief Get the number of nodes in the table.
+   * @return Number of nodes in the table.
+   */
+  int getNumNodes () const;
+
+  // Evaluation
+  /**
+   * @brief Adds the interpolated stress field of a dislocation to the array s.
+   * @details The stress is expressed in the slip system co-ordinate system, and the components are stored in the order xx, yy, zz, xy, xz, yz. If u lies outside the table, nothing is added.
+   * @param u Separation along the slip direction between the field point and the dislocation.
+   * @param bEdge Product of the Burgers vector magnitude with the edge component of the local Burgers vector.
+   * @param bScrew Product of the Burgers vector magnitude with the screw component of the local Burgers vector.
+   * @param s Array of six values to which the stress components are added.
+   * @return True if the contribution was added, false if the caller must evaluate the stress field itself.
+   */
+  bool accumulate (double u, double bEdge, double bScrew, double *s) const;
+
+  /**
+   * @brief Adds the interpolated stress field of a dislocation of character C to the array s.
+   * @details Only the kernels that are non-zero for the character C are interpolated. The selection is made at compile time. See KernelTable::accumulate for the other details.
+   * @param u Separation along the slip direction between the field point and the dislocation.
+   * @param bEdge Product of the Burgers vector magnitude with the edge component of the local Burgers vector.
+   * @param bScrew Product of the Burgers vector magnitude with the screw component of the local Burgers vector.
+   * @param s Array of six values to which the stress components are added.
+   * @return True if the contribution was added, false if the caller must evaluate the stress field itself.
+   */
+  template <DislocationCharacter C>
+  bool accumulate_character (double u, double bEdge, double bScrew, double *s) const
+  {
+    if ( this->n < 4 || u < this->uMin || u > this->uMax ) {
+      return (false);
+    }
+
+    double t = (u - this->uMin) / this->du;
+    int k = (int) floor (t);
+    if ( k < 1 ) {
+      k = 1;
+    }
+    else if ( k > this->n-3 ) {
+      k = this->n-3;
+    }
+    double f = t - k;
+
+    // Cubic Lagrange weights for the nodes k-1, k, k+1, k+2
+    double w0 = -1.0 * f * (f-1.0) * (f-2.0) / 6.0;
+    double w1 = (f+1.0) * (f-1.0) * (f-2.0) / 2.0;
+    double w2 = -1.0 * (f+1.0) * f * (f-2.0) / 2.0;
+    double w3 = (f+1.0) * f * (f-1.0) / 6.0;
+
+    const double *v0 = &(this->values[(k-1)*KERNELTABLE_NODE_SIZE]);
+    const double *v1 = v0 + KERNELTABLE_NODE_SIZE;
+    const double *v2 = v1 + KERNELTABLE_NODE_SIZE;
+    const double *v3 = v2 + KERNELTABLE_NODE_SIZE;
+
+    int c;
+    for ( c=0; c<6; c++ ) {
+      if ( C != SCREW ) {
+        s[c] += bEdge  * ( (w0*v0[c])   + (w1*v1[c])   + (w2*v2[c])   + (w3*v3[c]) );
+      }
+      if ( C != EDGE ) {
+        s[c] += bScrew * ( (w0*v0[c+6]) + (w1*v1[c+6]) + (w2*v2[c+6]) + (w3*v3[c+6]) );
+      }
+    }
+
+    return (true);
+  }
+
+  /**
+   * @brief Adds the interpolated stress field of a dislocation of character C to the array s, using the single precision copy of the table.
+   * @details The interpolation is carried out in single precision. The sum is compensated (Kahan summation), the running compensation being kept in the array compensation, so that the round-off error does not grow with the number of dislocations. Only u is kept in double precision, since the positions are. See KernelTable::accumulate_character for the other details.
+   * @param u Separation along the slip direction between the field point and the dislocation.
+   * @param bEdge Product of the Burgers vector magnitude with the edge component of the local Burgers vector.
+   * @param bScrew Product of the Burgers vector magnitude with the screw component of the local Burgers vector.
+   * @param s Array of six values to which the stress components are added.
+   * @param compensation Array of six values holding the running compensation of the sums in s. It must be initialized to zero together with s.
+   * @return True if the contribution was added, false if the caller must evaluate the stress field itself.
+   */
+  template <DislocationCharacter C>
+  bool accumulate_single (double u, float bEdge, float bScrew, float *s, float *compensation) const
+  {
+    if ( this->valuesSingle.empty() || u < this->uMin || u > this->uMax ) {
+      return (false);
+    }
+
+    double t = (u - this->uMin) / this->du;
+    int k = (int) floor (t);
+    if ( k < 1 ) {
+      k = 1;
+    }
+    else if ( k > this->n-3 ) {
+      k = this->n-3;
+    }
+    float f = (float) (t - k);
+
+    // Cubic Lagrange weights for the nodes k-1, k, k+1, k+2
+    float w0 = -1.0f * f * (f-1.0f) * (f-2.0f) / 6.0f;
+    float w1 = (f+1.0f) * (f-1.0f) * (f-2.0f) / 2.0f;
+    float w2 = -1.0f * (f+1.0f) * f * (f-2.0f) / 2.0f;
+    float w3 = (f+1.0f) * f * (f-1.0f) / 6.0f;
+
+    const float *v0 = &(this->valuesSingle[(k-1)*KERNELTABLE_NODE_SIZE]);
+    const float *v1 = v0 + KERNELTABLE_NODE_SIZE;
+    const float *v2 = v1 + KERNELTABLE_NODE_SIZE;
+    const float *v3 = v2 + KERNELTABLE_NODE_SIZE;
+
+    float term, y, sum;
+    int c;
+    for ( c=0; c<6; c++ ) {
+      term = 0.0f;
+      if ( C != SCREW ) {
+        term += bEdge  * ( (w0*v0[c])   + (w1*v1[c])   + (w2*v2[c])   + (w3*v3[c]) );
+      }
+      if ( C != EDGE ) {
+        term += bScrew * ( (w0*v0[c+6]) + (w1*v1[c+6]) + (w2*v2[c+6]) + (w3*v3[c+6]) );
+      }
+      // Compensated sum
+      y = term - compensation[c];
+      sum = s[c] + y;
+      compensation[c] = (sum - s[c]) - y;
+      s[c] = sum;
+    }
+
+    return (true);
+  }
+
+  /**
+   * @brief Compares two rotation matrices.
+   * @param a First rotation matrix.
+   * @param b Second rotation matrix.
+   * @return True if all the elements of the two matrices are equal, to within round-off errors.
+   */
+  static bool sameRotation (const RotationMatrix& a, const RotationMatrix& b);
+};
+
+/**
+ * @brief The KernelCache class holds all the kernel tables built for a slip system.
+ * @details Tables are shared between all pairs of slip planes with the same offset and all dislocations with the same rotation matrix. They are built on first use and kept for the rest of the simulation, unless the elastic constants change.
+ */
+class KernelCache
+{
+protected:
+  /**
+   * @brief The tables built so far.
+   */
+  std::vector<KernelTable> tables;
+  /**
+   * @brief Shear modulus used for building the tables.
+   */
+  double mu;
+  /**
+   * @brief Poisson's ratio used for building the tables.
+   */
+  double nu;
+  /**
+   * @brief Maximum interpolation error, relative to the peak value of each kernel.
+   */
+  double tolerance;
+  /**
+   * @brief Flag indicating whether single precision copies of the tables are built.
+   */
+  bool singlePrecision;
+
+public:
+  /**
+   * @brief Default constructor.
+   */
+  KernelCache ();
+
+  /**
+   * @brief Set the tolerance for the interpolation error. Existing tables are discarded if the value changes.
+   * @param tolerance Maximum interpolation error, relative to the peak value of each kernel.
+   */
+  void setTolerance (double tolerance);
+  /**
+   * @brief Get the tolerance for the interpolation error.
+   * @return Maximum interpolation error, relative to the peak value of each kernel.
+   */
+  double getTolerance () const;
+  /**
+   * @brief Set whether single precision copies of the tables are to be built. Existing tables are discarded if the value changes.
+   * @param singlePrecision Flag indicating whether single precision copies of the tables are to be built.
+   */
+  void setSinglePrecision (bool singlePrecision);
+  /**
+   * @brief Get whether single precision copies of the tables are built.
+   * @return True if single precision copies of the tables are built.
+   */
+  bool getSinglePrecision () const;
+  /**
+   * @brief Find the table for the given offset and rotation matrix covering the range of separations provided. The table is built if it does not exist yet.
+   * @param offset Offset between the destination and source slip plane origins, in the slip system co-ordinate system.
+   * @param rotation Rotation matrix of the source dislocations.
+   * @param uMin Smallest separation to be covered.
+   * @param uMax Largest separation to be covered.
+   * @param mu Shear modulus (Pa).
+   * @param nu Poisson's ratio.
+   * @return Index of the table in the cache, -1 if no valid table could be built.
+   */
+  int findTable (Vector3d offset, RotationMatrix rotation, double uMin, double uMax, double mu, double nu);
+  /**
+   * @brief Get a pointer to the table at index i.
+   * @param i Index of the table.
+   * @return Pointer to the table, NULL if the index is invalid.
+   */
+  const KernelTable* getTable (int i) const;
+  /**
+   * @brief Get the number of tables in the cache.
+   * @return Number of tables in the cache.
+   */
+  int getNumTables () const;
+  /**
+   * @brief Discard all tables.
+   */
+  void clear ();
+};
+
+/**
+ * @brief The KernelSource struct holds the data of a dislocation needed for evaluating its tabulated stress field.
+ */
+struct KernelSource
+{
+  /**
+   * @brief Position of the dislocation along the slip direction, in the slip plane co-ordinate system.
+   */
+  double x;
+  /**
+   * @brief Product of the Burgers vector magnitude with the edge component of the local Burgers vector.
+   */
+  double bEdge;
+  /**
+   * @brief Product of the Burgers vector magnitude with the screw component of the local Burgers vector.
+   */
+  double bScrew;
+  /**
+   * @brief Character of the dislocation, used for choosing the interpolation kernel.
+   */
+  DislocationCharacter character;
+  /**
+   * @brief Index of the rotation matrix of the dislocation in the list kept by the slip system. -1 if the dislocation cannot be tabulated.
+   */
+  int rotationClass;
+  /**
+   * @brief Pointer to the dislocation.
+   */
+  Dislocation *dislocation;
+};
+
+#endif // KERNELTABLE_H
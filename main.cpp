@@ -39,7 +39,14 @@ int main (int argc, char* argv[])
         std::string filename;
         while (argc > 1) {
             filename = std::string(argv[--argc]);
-            simulateSingleGrain(filename);
+            if (argc > 1 && std::string(argv[argc-1]) == "--sweep") {
+                // Sweep file
+                simulateGrainSweep(filename);
+                argc--;
+            }
+            else {
+                simulateSingleGrain(filename);
+            }
             filename.clear();
         }
     }
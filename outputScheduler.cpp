@@ -0,0 +1,198 @@
+/**
+ * @file outputScheduler.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the member functions of the class OutputScheduler.
+ * @details This file defines the member functions of the class OutputScheduler, which decides at the end of each time step which statistics are to be written.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "outputScheduler.h"
+
+// Constructors
+/**
+ * @brief Default constructor. The scheduler has not started.
+ */
+OutputScheduler::OutputScheduler ()
+{
+    this->begin(0, 0.0, 0.0, 0, 0);
+    this->setBurstDetection(0.0, 0, 0, 1);
+    this->started = false;
+}
+
+/**
+ * @brief Get the wall-clock time elapsed since the beginning of the simulation.
+ * @return The wall-clock time, in seconds.
+ */
+double OutputScheduler::elapsed () const
+{
+    struct timeval now;
+
+    gettimeofday(&now, NULL);
+    return ( (double) (now.tv_sec - this->start.tv_sec) + 1.0e-06 * (double) (now.tv_usec - this->start.tv_usec) );
+}
+
+// Operations
+/**
+ * @brief Records the state at the beginning of the simulation.
+ * @param iteration Number of iterations carried out.
+ * @param time The simulated time.
+ * @param plasticStrain The equivalent plastic strain.
+ * @param nEmissions The total number of emissions since the beginning of the simulation.
+ * @param nAnnihilations The total number of annihilations since the beginning of the simulation.
+ */
+void OutputScheduler::begin (int iteration, double time, double plasticStrain, int nEmissions, int nAnnihilations)
+{
+    gettimeofday(&(this->start), NULL);
+
+    this->initial.iteration = iteration;
+    this->initial.time = time;
+    this->initial.wallClock = 0.0;
+    this->initial.plasticStrain = plasticStrain;
+    this->initial.strainRate = 0.0;
+    this->initial.nEmissions = 0;
+    this->initial.nAnnihilations = 0;
+    this->initial.burst = false;
+    this->initial.burstStart = false;
+
+    this->state = this->initial;
+    this->totalEmissions = nEmissions;
+    this->totalAnnihilations = nAnnihilations;
+    this->quietSteps = 0;
+    this->started = true;
+}
+
+/**
+ * @brief Records the state at the end of a time step.
+ * @param iteration Number of iterations carried out.
+ * @param time The simulated time.
+ * @param timeIncrement The duration of the time step.
+ * @param plasticStrain The equivalent plastic strain.
+ * @param nEmissions The total number of emissions since the beginning of the simulation.
+ * @param nAnnihilations The total number of annihilations since the beginning of the simulation.
+ */
+void OutputScheduler::update (int iteration, double time, double timeIncrement, double plasticStrain, int nEmissions, int nAnnihilations)
+{
+    if (timeIncrement > 0.0) {
+        this->state.strainRate = fabs(plasticStrain - this->state.plasticStrain) / timeIncrement;
+    }
+    else {
+        this->state.strainRate = 0.0;
+    }
+
+    this->state.iteration = iteration;
+    this->state.time = time;
+    this->state.wallClock = this->elapsed();
+    this->state.plasticStrain = plasticStrain;
+    this->state.nEmissions = nEmissions - this->totalEmissions;
+    this->state.nAnnihilations = nAnnihilations - this->totalAnnihilations;
+
+    this->totalEmissions = nEmissions;
+    this->totalAnnihilations = nAnnihilations;
+
+    // Detection of bursts
+    bool active = (this->burstStrainRate > 0.0 && this->state.strainRate >= this->burstStrainRate)
+               || (this->burstEmissions > 0 && this->state.nEmissions >= this->burstEmissions)
+               || (this->burstAnnihilations > 0 && this->state.nAnnihilations >= this->burstAnnihilations);
+
+    this->state.burstStart = false;
+    if (active) {
+        this->quietSteps = 0;
+        if (!this->state.burst) {
+            this->state.burst = true;
+            this->state.burstStart = true;
+        }
+    }
+    else if (this->state.burst) {
+        this->quietSteps++;
+        if (this->quietSteps >= this->burstQuietSteps) {
+            this->state.burst = false;
+        }
+    }
+}
+
+/**
+ * @brief Indicates whether a statistic is to be written at the end of the last time step.
+ * @param s Pointer to the statistic.
+ * @return True if the statistic is to be written.
+ */
+bool OutputScheduler::isDue (Statistics* s)
+{
+    return (s->isDue(this->state, this->initial));
+}
+
+/**
+ * @brief Sets the thresholds of the detection of bursts of plastic activity.
+ * @details A burst starts at the first step at which one of the quantities reaches its threshold, and ends after quietSteps consecutive steps below all of them. Thresholds that are zero or negative are not used; bursts are never detected if none is used.
+ * @param strainRate Equivalent plastic strain rate, in 1/s.
+ * @param nEmissions Number of emissions during a time step.
+ * @param nAnnihilations Number of annihilations during a time step.
+ * @param quietSteps Number of quiet steps that ends a burst.
+ */
+void OutputScheduler::setBurstDetection (double strainRate, int nEmissions, int nAnnihilations, int quietSteps)
+{
+    this->burstStrainRate = strainRate;
+    this->burstEmissions = nEmissions;
+    this->burstAnnihilations = nAnnihilations;
+    this->burstQuietSteps = (quietSteps > 0) ? quietSteps : 1;
+}
+
+// Access functions
+/**
+ * @brief Indicates whether OutputScheduler::begin has been called.
+ * @return True if the scheduler has started.
+ */
+bool OutputScheduler::isStarted () const
+{
+    return (this->started);
+}
+
+/**
+ * @brief Get the state at the end of the last time step.
+ * @return Reference to the state.
+ */
+const OutputState& OutputScheduler::getState () const
+{
+    return (this->state);
+}
+
+// Static functions
+/**
+ * @brief Calculates the equivalent strain \f$\sqrt{2/3\,\epsilon_{ij}\epsilon_{ij}}\f$ of a strain tensor.
+ * @param e The strain tensor.
+ * @return The equivalent strain.
+ */
+double OutputScheduler::equivalentStrain (const Strain& e)
+{
+    double sum = 0.0;
+    int i, j;
+
+    for (i=0; i<3; i++) {
+        for (j=0; j<3; j++) {
+            sum += e.getValue(i, j) * e.getValue(i, j);
+        }
+    }
+
+    return (sqrt(2.0 * sum / 3.0));
+}
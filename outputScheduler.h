@@ -0,0 +1,172 @@
+/**
+ * @file outputScheduler.h
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the class OutputScheduler.
+ * @details This file defines the class OutputScheduler, which decides at the end of each time step which statistics are to be written.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OUTPUTSCHEDULER_H
+#define OUTPUTSCHEDULER_H
+
+#include <math.h>
+#include <sys/time.h>
+
+#include "statistics.h"
+#include "strain.h"
+
+/**
+ * @brief The OutputScheduler class decides at the end of each time step which statistics are to be written.
+ * @details The quantities on which the triggers of the statistics depend (simulated and wall-clock time, plastic strain and its rate, emissions and annihilations during the step) are gathered once per time step into an OutputState by OutputScheduler::update, and every statistic is then checked against the same state by OutputScheduler::isDue. All outputs that are due at a step therefore describe the same state, and the quantities are calculated once, whatever the number of outputs.
+ * The scheduler also detects the bursts of plastic activity: a burst starts at the first step at which the strain rate, the number of emissions or the number of annihilations reaches its threshold, and ends after a number of quiet steps below all thresholds.
+ */
+class OutputScheduler
+{
+protected:
+    /**
+     * @brief The state at the beginning of the simulation.
+     */
+    OutputState initial;
+    /**
+     * @brief The state at the end of the last time step.
+     */
+    OutputState state;
+    /**
+     * @brief Total number of emissions at the end of the last time step.
+     */
+    int totalEmissions;
+    /**
+     * @brief Total number of annihilations at the end of the last time step.
+     */
+    int totalAnnihilations;
+    /**
+     * @brief Threshold of the strain rate that starts a burst. Zero or a negative value disables it.
+     */
+    double burstStrainRate;
+    /**
+     * @brief Number of emissions during a time step that starts a burst. Zero or a negative value disables it.
+     */
+    int burstEmissions;
+    /**
+     * @brief Number of annihilations during a time step that starts a burst. Zero or a negative value disables it.
+     */
+    int burstAnnihilations;
+    /**
+     * @brief Number of consecutive steps below all thresholds that ends a burst.
+     */
+    int burstQuietSteps;
+    /**
+     * @brief Number of consecutive steps below all thresholds since the last active step.
+     */
+    int quietSteps;
+    /**
+     * @brief Wall-clock time at the beginning of the simulation.
+     */
+    struct timeval start;
+    /**
+     * @brief Flag indicating whether OutputScheduler::begin has been called.
+     */
+    bool started;
+
+    /**
+     * @brief Get the wall-clock time elapsed since the beginning of the simulation.
+     * @return The wall-clock time, in seconds.
+     */
+    double elapsed () const;
+
+public:
+    // Constructors
+    /**
+     * @brief Default constructor. The scheduler has not started.
+     */
+    OutputScheduler ();
+
+    // Destructor
+    /**
+     * @brief Destructor for the class OutputScheduler.
+     */
+    virtual ~OutputScheduler ()
+    {
+
+    }
+
+    // Operations
+    /**
+     * @brief Records the state at the beginning of the simulation.
+     * @param iteration Number of iterations carried out.
+     * @param time The simulated time.
+     * @param plasticStrain The equivalent plastic strain.
+     * @param nEmissions The total number of emissions since the beginning of the simulation.
+     * @param nAnnihilations The total number of annihilations since the beginning of the simulation.
+     */
+    void begin (int iteration, double time, double plasticStrain, int nEmissions, int nAnnihilations);
+    /**
+     * @brief Records the state at the end of a time step.
+     * @param iteration Number of iterations carried out.
+     * @param time The simulated time.
+     * @param timeIncrement The duration of the time step.
+     * @param plasticStrain The equivalent plastic strain.
+     * @param nEmissions The total number of emissions since the beginning of the simulation.
+     * @param nAnnihilations The total number of annihilations since the beginning of the simulation.
+     */
+    void update (int iteration, double time, double timeIncrement, double plasticStrain, int nEmissions, int nAnnihilations);
+    /**
+     * @brief Indicates whether a statistic is to be written at the end of the last time step.
+     * @param s Pointer to the statistic.
+     * @return True if the statistic is to be written.
+     */
+    bool isDue (Statistics* s);
+    /**
+     * @brief Sets the thresholds of the detection of bursts of plastic activity.
+     * @details A burst starts at the first step at which one of the quantities reaches its threshold, and ends after quietSteps consecutive steps below all of them. Thresholds that are zero or negative are not used; bursts are never detected if none is used.
+     * @param strainRate Equivalent plastic strain rate, in 1/s.
+     * @param nEmissions Number of emissions during a time step.
+     * @param nAnnihilations Number of annihilations during a time step.
+     * @param quietSteps Number of quiet steps that ends a burst.
+     */
+    void setBurstDetection (double strainRate, int nEmissions, int nAnnihilations, int quietSteps);
+
+    // Access functions
+    /**
+     * @brief Indicates whether OutputScheduler::begin has been called.
+     * @return True if the scheduler has started.
+     */
+    bool isStarted () const;
+    /**
+     * @brief Get the state at the end of the last time step.
+     * @return Reference to the state.
+     */
+    const OutputState& getState () const;
+
+    // Static functions
+    /**
+     * @brief Calculates the equivalent strain \f$\sqrt{2/3\,\epsilon_{ij}\epsilon_{ij}}\f$ of a strain tensor.
+     * @param e The strain tensor.
+     * @return The equivalent strain.
+     */
+    static double equivalentStrain (const Strain& e);
+};
+
+#endif // OUTPUTSCHEDULER_H
@@ -30,6 +30,32 @@
 
 
 #include "parameter.h"
+#include "engineTuner.h"
+#include "slipPlaneDefaults.h"
+
+/**
+ * @brief Default constructor for the class Parameter.
+ * @details Sets the default values of the optional parameters.
+ */
+Parameter::Parameter ()
+{
+    this->tabulatedKernels = false;
+    this->kernelTolerance = KERNELTABLE_DEFAULT_TOLERANCE;
+    this->singlePrecisionKernels = false;
+    this->interactionCutoff = 0.0;
+    this->cutoffSkin = -1.0;
+    this->engineTuning = false;
+    this->engineTuningAccuracy = ENGINETUNER_DEFAULT_ACCURACY;
+    this->engineTuningInterval = ENGINETUNER_DEFAULT_INTERVAL;
+    this->freeSurfaces = false;
+    this->imageForceCutoff = -1.0;
+    this->branchIteration = 0;
+    this->flushInterval = TEXTWRITER_DEFAULT_FLUSH_INTERVAL;
+    this->burstStrainRate = 0.0;
+    this->burstEmissions = 0;
+    this->burstAnnihilations = 0;
+    this->burstQuietSteps = BURSTCAPTURE_DEFAULT_QUIET_STEPS;
+}
 
 /**
  * @brief Read parameters from file whose name is provided.
@@ -305,10 +331,301 @@ void Parameter::parseLineData (std::string line)
             // Read name
             ss >> v;
             this->grainStressField.addName(v);
+            // Optional parameters: resolution and interval of time between outputs
+            if ( ss >> v ) {
+                this->grainStressField.addParameter ( atof ( v.c_str() ) );
+                if ( ss >> v ) {
+                    this->grainStressField.addParameter ( atof ( v.c_str() ) );
+                }
+            }
+        }
+        return;
+    }
+
+    // Kernel tables
+    if (first=="tabulatedKernels") {
+        ss >> v;
+        this->tabulatedKernels = ( atoi(v.c_str()) == 1 );
+        if ( ss >> v ) {
+            // Optional tolerance
+            this->kernelTolerance = atof(v.c_str());
+        }
+        return;
+    }
+
+    // Kernel table precision
+    if (first=="kernelPrecision") {
+        ss >> v;
+        this->singlePrecisionKernels = (v=="single" || v=="Single");
+        return;
+    }
+
+    // Statistics kernel table precision
+    if (first=="statsKernelPrecision") {
+        ss >> v;
+        int write = atoi(v.c_str());
+        ss >> v;
+        this->kernelPrecision = Statistics ( (write==1), atof(v.c_str()));
+        if ( write ) {
+            // Read name
+            ss >> v;
+            this->kernelPrecision.addName(v);
+        }
+        return;
+    }
+
+    // Statistics plastic strain
+    if (first=="statsGrainPlasticStrain") {
+        ss >> v;
+        int write = atoi(v.c_str());
+        ss >> v;
+        this->grainPlasticStrain = Statistics ( (write==1), atof(v.c_str()));
+        if ( write ) {
+            // Read name
+            ss >> v;
+            this->grainPlasticStrain.addName(v);
+        }
+        return;
+    }
+
+    // Statistics slip plane dislocation densities
+    if (first=="statsSlipPlaneDensity") {
+        ss >> v;
+        int write = atoi(v.c_str());
+        ss >> v;
+        this->slipPlaneDensities = Statistics ( (write==1), atof(v.c_str()));
+        if ( write ) {
+            // Read name
+            ss >> v;
+            this->slipPlaneDensities.addName(v);
         }
         return;
     }
 
+    // Statistics pile-ups
+    if (first=="statsPileUps") {
+        ss >> v;
+        int write = atoi(v.c_str());
+        ss >> v;
+        this->pileUps = Statistics ( (write==1), atof(v.c_str()));
+        if ( write ) {
+            // Read name
+            ss >> v;
+            this->pileUps.addName(v);
+        }
+        return;
+    }
+
+    // Statistics GND density map
+    if (first=="statsGNDMap") {
+        ss >> v;
+        int write = atoi(v.c_str());
+        ss >> v;
+        this->gndMap = Statistics ( (write==1), atof(v.c_str()));
+        if ( write ) {
+            // Read name
+            ss >> v;
+            this->gndMap.addName(v);
+            // Read additional parameter: resolution
+            ss >> v;
+            this->gndMap.addParameter ( atof ( v.c_str() ) );
+        }
+        return;
+    }
+
+    // Statistics frames of the grain
+    if (first=="statsGrainFrames") {
+        ss >> v;
+        int write = atoi(v.c_str());
+        ss >> v;
+        this->grainFrames = Statistics ( (write==1), atof(v.c_str()));
+        if ( write ) {
+            // Read name
+            ss >> v;
+            this->grainFrames.addName(v);
+        }
+        return;
+    }
+
+    // Statistics frames written depending on the bursts
+    if (first=="statsBurstFrames") {
+        ss >> v;
+        int write = atoi(v.c_str());
+        ss >> v;
+        this->burstFrames = Statistics ( (write==1), atof(v.c_str()));
+        if ( write ) {
+            // Read name
+            ss >> v;
+            this->burstFrames.addName(v);
+            // Read additional parameters: dense interval and number of frames kept before a burst
+            while (ss >> v) {
+                this->burstFrames.addParameter ( atof ( v.c_str() ) );
+            }
+        }
+        return;
+    }
+
+    // Detection of bursts
+    if (first=="burstDetection") {
+        ss >> v;
+        this->burstStrainRate = atof(v.c_str());
+        ss >> v;
+        this->burstEmissions = atoi(v.c_str());
+        ss >> v;
+        this->burstAnnihilations = atoi(v.c_str());
+        if (ss >> v) {
+            this->burstQuietSteps = atoi(v.c_str());
+        }
+        return;
+    }
+
+    // Statistics VTK files
+    if (first=="statsVTK") {
+        ss >> v;
+        int write = atoi(v.c_str());
+        ss >> v;
+        this->vtkOutput = Statistics ( (write==1), atof(v.c_str()));
+        if ( write ) {
+            // Read name
+            ss >> v;
+            this->vtkOutput.addName(v);
+        }
+        return;
+    }
+
+    // Statistics emissions, annihilations and absorptions
+    if (first=="statsDefectEvents") {
+        ss >> v;
+        int write = atoi(v.c_str());
+        ss >> v;
+        this->defectEvents = Statistics ( (write==1), atof(v.c_str()));
+        if ( write ) {
+            // Read name
+            ss >> v;
+            this->defectEvents.addName(v);
+        }
+        return;
+    }
+
+    // Statistics live snapshots in shared memory
+    if (first=="statsLiveSnapshots") {
+        ss >> v;
+        int write = atoi(v.c_str());
+        ss >> v;
+        this->liveSnapshots = Statistics ( (write==1), atof(v.c_str()));
+        if ( write ) {
+            // Read name
+            ss >> v;
+            this->liveSnapshots.addName(v);
+            // Optional parameters: number of snapshots kept and number of defects per snapshot
+            if ( ss >> v ) {
+                this->liveSnapshots.addParameter ( atof ( v.c_str() ) );
+                if ( ss >> v ) {
+                    this->liveSnapshots.addParameter ( atof ( v.c_str() ) );
+                }
+            }
+        }
+        return;
+    }
+
+    // Cut-off radius for the interactions
+    if (first=="interactionCutoff") {
+        ss >> v;
+        this->interactionCutoff = atof(v.c_str());
+        if ( ss >> v ) {
+            // Optional skin distance
+            this->cutoffSkin = atof(v.c_str());
+        }
+        return;
+    }
+
+    // Selection of the methods calculating the stresses
+    if (first=="stressEngineTuning") {
+        ss >> v;
+        this->engineTuning = ( atoi(v.c_str()) == 1 );
+        if ( ss >> v ) {
+            // Optional accuracy budget
+            this->engineTuningAccuracy = atof(v.c_str());
+        }
+        if ( ss >> v ) {
+            // Optional interval
+            this->engineTuningInterval = atoi(v.c_str());
+        }
+        return;
+    }
+
+    // Free surfaces and the range of their image forces
+    if (first=="freeSurfaces") {
+        ss >> v;
+        this->freeSurfaces = (atoi(v.c_str()) == 1);
+        this->imageForceCutoff = -1.0;
+        if ( ss >> v ) {
+            // Optional cut-off distance of the image forces
+            this->imageForceCutoff = atof(v.c_str());
+            if ( this->freeSurfaces && this->imageForceCutoff <= 0.0 ) {
+                displayMessage("Warning: the cut-off distance of the image forces is not positive. The free surfaces exert no image force.");
+                this->imageForceCutoff = 0.0;
+            }
+        }
+        return;
+    }
+
+    // Triggers of the output of a statistic
+    if (first=="trigger") {
+        std::string name;
+        std::string type;
+        Statistics* s;
+        ss >> name >> type >> v;
+        s = this->findStatistics(name);
+        if (s == NULL) {
+            displayMessage("Error: trigger for unknown statistic " + name + ". The trigger must follow the line of the statistic.");
+            return;
+        }
+        if (type=="iterations") {
+            s->addTrigger(TRIGGER_ITERATIONS, atof(v.c_str()));
+        }
+        else if (type=="time") {
+            s->addTrigger(TRIGGER_TIME, atof(v.c_str()));
+        }
+        else if (type=="wallclock") {
+            s->addTrigger(TRIGGER_WALLCLOCK, atof(v.c_str()));
+        }
+        else if (type=="strain") {
+            s->addTrigger(TRIGGER_STRAIN, atof(v.c_str()));
+        }
+        else if (type=="emissions") {
+            s->addTrigger(TRIGGER_EMISSIONS, atof(v.c_str()));
+        }
+        else if (type=="avalanche") {
+            s->addTrigger(TRIGGER_AVALANCHE, atof(v.c_str()));
+        }
+        else {
+            displayMessage("Error: unknown trigger " + type + " for statistic " + name);
+        }
+        return;
+    }
+
+    // Branching into several continuations
+    if (first=="branch") {
+        ss >> v;
+        this->branchIteration = atoi(v.c_str());
+        ss >> this->branchFile;
+        return;
+    }
+
+    // Archive of the outputs written per time step
+    if (first=="archive") {
+        ss >> this->archiveFile;
+        return;
+    }
+
+    // Flush interval of the text files kept open
+    if (first=="flushInterval") {
+        ss >> v;
+        this->flushInterval = atof(v.c_str());
+        return;
+    }
+
     // File names
     if ( first=="structure" || first=="Structure" )
     {
@@ -319,3 +636,51 @@ void Parameter::parseLineData (std::string line)
 
 }
 
+/**
+ * @brief Finds a statistic by its name.
+ * @param name The name of the statistic, as given in the parameters file.
+ * @return Pointer to the statistic, NULL if no statistic that is written has this name.
+ */
+Statistics* Parameter::findStatistics (std::string name)
+{
+    Statistics* statistics[] = { &(this->dislocationPositions),
+                                 &(this->slipPlaneStressDistributions),
+                                 &(this->allDefectPositions),
+                                 &(this->slipSystemObjectPositions),
+                                 &(this->grainObjectPositions),
+                                 &(this->grainStressField),
+                                 &(this->kernelPrecision),
+                                 &(this->grainPlasticStrain),
+                                 &(this->slipPlaneDensities),
+                                 &(this->pileUps),
+                                 &(this->gndMap),
+                                 &(this->defectEvents),
+                                 &(this->grainFrames),
+                                 &(this->vtkOutput),
+                                 &(this->burstFrames),
+                                 &(this->liveSnapshots) };
+    int n = sizeof(statistics) / sizeof(statistics[0]);
+    int i;
+
+    for (i=0; i<n; i++) {
+        if (statistics[i]->write && statistics[i]->name == name) {
+            return (statistics[i]);
+        }
+    }
+
+    return (NULL);
+}
+
+/**
+ * @brief Gets the distance from a free surface within which the image force acts on the dislocations.
+ * @details If no distance was given with the free surfaces, the default distance is SLIPPLANE_DEFAULT_IMAGEFORCE_CUTOFF times the magnitude of the Burgers vector.
+ * @return The cut-off distance of the image forces, in metres.
+ */
+double Parameter::getImageForceCutoff () const
+{
+    if (this->imageForceCutoff < 0.0) {
+        return (SLIPPLANE_DEFAULT_IMAGEFORCE_CUTOFF * this->bmag);
+    }
+
+    return (this->imageForceCutoff);
+}
@@ -39,6 +39,9 @@
 
 #include "stress.h"
 #include "statistics.h"
+#include "kernelTable.h"
+#include "textWriter.h"
+#include "burstCapture.h"
 
 #include "tools.h"
 
@@ -185,9 +188,164 @@ public:
 
     /**
      * @brief Parameter indicating if the stress field along the grain boundary is to be written.
+     * @details The optional parameters are the number of points per grain boundary segment and the minimum interval of time between two outputs.
      */
     Statistics grainStressField;
 
+    // Kernel tables
+    /**
+     * @brief Flag indicating whether the stress field due to dislocations on other slip planes of the same slip system is interpolated from kernel tables.
+     */
+    bool tabulatedKernels;
+
+    /**
+     * @brief Maximum interpolation error of the kernel tables, relative to the peak value of each kernel.
+     */
+    double kernelTolerance;
+
+    /**
+     * @brief Flag indicating whether the kernel tables are interpolated in single precision. Positions and time integration remain in double precision.
+     */
+    bool singlePrecisionKernels;
+
+    /**
+     * @brief Indicator about writing the deviation of the tabulated stress field from the exact double precision stress field.
+     */
+    Statistics kernelPrecision;
+
+    /**
+     * @brief Indicator about writing the applied stress, the dislocation density and the plastic strain of the grain.
+     */
+    Statistics grainPlasticStrain;
+
+    /**
+     * @brief Indicator about writing the line density of dislocations on each slip plane.
+     */
+    Statistics slipPlaneDensities;
+
+    /**
+     * @brief Indicator about writing the pile-ups against the extremities of each slip plane.
+     */
+    Statistics pileUps;
+
+    /**
+     * @brief Indicator about writing the map of the density of geometrically necessary dislocations. The first parameter is the number of cells along each axis.
+     */
+    Statistics gndMap;
+
+    /**
+     * @brief Indicator about writing the numbers of emissions, annihilations and absorptions.
+     */
+    Statistics defectEvents;
+
+    /**
+     * @brief Indicator about writing frames with the complete state of the grain, in the format of the grain file, from which the stress fields can be calculated after the simulation.
+     */
+    Statistics grainFrames;
+
+    /**
+     * @brief Indicator about writing frames of the grain with a cadence that depends on the bursts of plastic activity. The frequency, or the triggers, give the baseline cadence. The optional parameters are the number of time steps between two frames during bursts and the number of frames kept in memory before a burst.
+     */
+    Statistics burstFrames;
+
+    // Detection of bursts
+    /**
+     * @brief Equivalent plastic strain rate, in 1/s, that starts a burst. Zero disables this criterion.
+     */
+    double burstStrainRate;
+
+    /**
+     * @brief Number of emissions during a time step that starts a burst. Zero disables this criterion.
+     */
+    int burstEmissions;
+
+    /**
+     * @brief Number of annihilations during a time step that starts a burst. Zero disables this criterion.
+     */
+    int burstAnnihilations;
+
+    /**
+     * @brief Number of consecutive time steps below all thresholds that ends a burst.
+     */
+    int burstQuietSteps;
+
+    /**
+     * @brief Indicator about writing the defects as a series of VTK files that can be read by ParaView. The name is that of the collection file, without the extension.
+     */
+    Statistics vtkOutput;
+
+    /**
+     * @brief Indicator about publishing live snapshots in shared memory. The name is that of the shared memory. The optional parameters are the number of snapshots kept and the number of defects that a snapshot can hold.
+     */
+    Statistics liveSnapshots;
+
+    // Cut-off radius
+    /**
+     * @brief Cut-off radius for the interactions between dislocations, in metres. Dislocations further apart interact through the net Burgers vectors of the cells of a cell list. A value of zero disables the cut-off.
+     */
+    double interactionCutoff;
+
+    /**
+     * @brief Skin distance of the cell list, in metres. A negative value selects the default, which is a fraction of the cut-off radius.
+     */
+    double cutoffSkin;
+
+    // Selection of the methods calculating the stresses
+    /**
+     * @brief Flag indicating whether the methods calculating the stresses are selected by timing them on sample time steps.
+     */
+    bool engineTuning;
+
+    /**
+     * @brief Largest deviation allowed for the methods selected, relative to the largest component of the exact stress field on a slip plane.
+     */
+    double engineTuningAccuracy;
+
+    /**
+     * @brief Number of time steps between two selections of the methods. Zero only selects at the first time step.
+     */
+    int engineTuningInterval;
+
+    // Free surfaces
+    /**
+     * @brief Flag indicating whether the extremities of the slip planes are free surfaces instead of grain boundaries.
+     */
+    bool freeSurfaces;
+
+    /**
+     * @brief Distance from a free surface within which the image force acts on the dislocations, in metres. A value of zero disables the image forces, and a negative value, when no distance is given, selects the default distance returned by Parameter::getImageForceCutoff.
+     */
+    double imageForceCutoff;
+
+    // Branched runs
+    /**
+     * @brief Iteration after which the run is branched into several continuations. A value of zero disables the branching.
+     */
+    int branchIteration;
+
+    /**
+     * @brief Name of the file, in the input directory, describing the continuations of a branched run in the format of a sweep file.
+     */
+    std::string branchFile;
+
+    // Output files
+    /**
+     * @brief Name of the archive, in the output directory, receiving the outputs that would otherwise be written to one file per time step. An empty name writes the individual files.
+     */
+    std::string archiveFile;
+
+    /**
+     * @brief Interval of wall-clock time, in seconds, after which the text files kept open between outputs are written. Zero writes every line, a negative value only writes full buffers.
+     */
+    double flushInterval;
+
+    // Constructor
+    /**
+     * @brief Default constructor for the class Parameter.
+     * @details Sets the default values of the optional parameters.
+     */
+    Parameter ();
+
     // Destructor
     /**
      * @brief Destructor for the class Parameter.
@@ -212,6 +370,20 @@ public:
      * @param line String with the text present in the line.
      */
     void parseLineData (std::string line);
+
+    /**
+     * @brief Finds a statistic by its name.
+     * @param name The name of the statistic, as given in the parameters file.
+     * @return Pointer to the statistic, NULL if no statistic that is written has this name.
+     */
+    Statistics* findStatistics (std::string name);
+
+    /**
+     * @brief Gets the distance from a free surface within which the image force acts on the dislocations.
+     * @details If no distance was given with the free surfaces, the default distance is SLIPPLANE_DEFAULT_IMAGEFORCE_CUTOFF times the magnitude of the Burgers vector.
+     * @return The cut-off distance of the image forces, in metres.
+     */
+    double getImageForceCutoff () const;
 };
 
 #endif
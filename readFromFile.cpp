@@ -462,6 +462,29 @@ bool readSlipSystem (std::string fileName, SlipSystem *s, double *currentTime, P
 bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *param)
 {
     std::ifstream fp ( fileName.c_str() );
+
+    if ( fp.is_open() )
+    {
+        bool success = readGrain ( fp, g, currentTime, param );
+        fp.close();
+        return (success);
+    }
+    else {
+        return (false);
+    }
+}
+
+/**
+ * @brief Read the grain from a stream.
+ * @details The stream contains the data in the same format as the grain file. This allows a grain to be built from memory, using a std::istringstream.
+ * @param fp The stream containing the data of the grain.
+ * @param g Pointer to the instance of the Grain class that will contain the data. Memory for this instance should be pre-allocated.
+ * @param currentTime Pointer to the variable holding the present time. Memory for this varibale should be pre-allocated.
+ * @param param Pointer to the instance of the Parameter class, containing the parameters for the simulation.
+ * @return Boolean flag indicating success or failure of the reading operation.
+ */
+bool readGrain (std::istream& fp, Grain *g, double *currentTime, Parameter *param)
+{
     std::string line;
 
     Dislocation* disl;
@@ -488,7 +511,7 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
      */
     CoordinateSystem* baseCoordinateSystem = new CoordinateSystem();
 
-    if ( fp.is_open() )
+    if ( fp.good() )
     {
         // Read the initial time
         do {
@@ -496,7 +519,6 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
                 getline (fp, line);
             }
             else {
-                fp.close();
                 return (false);
             }
         } while ( ignoreLine(line) );
@@ -508,7 +530,6 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
                 getline (fp, line);
             }
             else {
-                fp.close();
                 return (false);
             }
         } while ( ignoreLine(line) );
@@ -520,7 +541,6 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
                 getline (fp, line);
             }
             else {
-                fp.close();
                 return (false);
             }
         } while ( ignoreLine(line) );
@@ -533,7 +553,6 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
                     getline (fp, line);
                 }
                 else {
-                    fp.close();
                     return (false);
                 }
             } while ( ignoreLine(line) );
@@ -554,7 +573,6 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
                 getline (fp, line);
             }
             else {
-                fp.close();
                 return (false);
             }
         } while ( ignoreLine(line) );
@@ -574,7 +592,6 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
                     getline ( fp, line );
                 }
                 else {
-                    fp.close ();
                     return ( false );
                 }
             } while ( ignoreLine ( line ) );
@@ -586,7 +603,6 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
                     getline ( fp, line );
                 }
                 else {
-                    fp.close ();
                     return ( false );
                 }
             } while ( ignoreLine ( line ) );
@@ -607,7 +623,6 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
                     getline ( fp, line );
                 }
                 else {
-                    fp.close ();
                     return ( false );
                 }
             } while ( ignoreLine ( line ) );
@@ -623,7 +638,6 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
                     getline ( fp, line );
                 }
                 else {
-                    fp.close ();
                     return ( false );
                 }
             } while ( ignoreLine ( line ) );
@@ -640,7 +654,6 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
                         getline ( fp, line );
                     }
                     else {
-                        fp.close ();
                         return ( false );
                     }
                 } while ( ignoreLine ( line ) );
@@ -657,7 +670,6 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
                         getline ( fp, line );
                     }
                     else {
-                        fp.close ();
                         return ( false );
                     }
                 } while ( ignoreLine ( line ) );
@@ -668,7 +680,6 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
                         getline ( fp, line );
                     }
                     else {
-                        fp.close ();
                         return ( false );
                     }
                 } while ( ignoreLine ( line ) );
@@ -719,7 +730,6 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
                             getline ( fp, line );
                         }
                         else {
-                            fp.close ();
                             return ( false );
                         }
                     } while ( ignoreLine ( line ) );
@@ -733,7 +743,6 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
                                 getline ( fp, line );
                             }
                             else {
-                                fp.close ();
                                 return ( false );
                             }
                         } while ( ignoreLine ( line ) );
@@ -759,7 +768,6 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
                             getline ( fp, line );
                         }
                         else {
-                            fp.close ();
                             return ( false );
                         }
                     } while ( ignoreLine ( line ) );
@@ -774,7 +782,6 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
                                 getline ( fp, line );
                             }
                             else {
-                                fp.close ();
                                 return ( false );
                             }
                         } while ( ignoreLine ( line ) );
@@ -825,7 +832,6 @@ bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *
             g->insertSlipSystem(slipSystem);
         }
 
-        fp.close();
         return (true);
     }
     else {
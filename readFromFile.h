@@ -77,6 +77,17 @@ bool readSlipSystem (std::string fileName, SlipSystem *s, double *currentTime, P
  */
 bool readGrain (std::string fileName, Grain *g, double *currentTime, Parameter *param);
 
+/**
+ * @brief Read the grain from a stream.
+ * @details The stream contains the data in the same format as the grain file. This allows a grain to be built from memory, using a std::istringstream.
+ * @param fp The stream containing the data of the grain.
+ * @param g Pointer to the instance of the Grain class that will contain the data. Memory for this instance should be pre-allocated.
+ * @param currentTime Pointer to the variable holding the present time. Memory for this varibale should be pre-allocated.
+ * @param param Pointer to the instance of the Parameter class, containing the parameters for the simulation.
+ * @return Boolean flag indicating success or failure of the reading operation.
+ */
+bool readGrain (std::istream& fp, Grain *g, double *currentTime, Parameter *param);
+
 /**
  * @brief Reads 3 values from a string and returns them in a Vector3d.
  * @param s The string that is to be read from.
@@ -132,95 +132,455 @@ void simulateSingleGrain(std::string fileName)
 }
 
 /**
- * @brief This function handles the iterations in the simulation of dislocation motion in a single grain.
- * @param param Pointer to the instance of the Parameter class containing the simulation parameters.
- * @param grain Pointer to the instance of the Grain class containing all data for the grain.
- * @param currentTime The value of the current simulation time.
+ * @brief This function manages a parameter sweep over a single grain.
+ * @details The parameters file and the grain structure are read once. Each variant of the sweep is then simulated in a child process, which starts from a copy-on-write image of the grain and therefore needs neither to read the structure nor to copy it. The output of a variant is written in a sub-directory of the output directory, named after the prefix of the sweep and the index of the variant, and the parameter lines of each variant are listed in the file sweep.txt of the output directory. At most Sweep::nJobs variants are simulated at the same time.
+ * @param fileName String containing the name of the file describing the sweep.
  */
-void grain_iterate (Parameter* param, Grain* grain, double currentTime)
+void simulateGrainSweep (std::string fileName)
 {
-    double totalTime = currentTime;
-    int nIterations = 0;
+    std::string message;
 
-    std::vector<double> simulationTime;
-    std::vector<double> timeIncrement;
+    Sweep sweep;
+    Parameter param;
+    Parameter variant;
+    Grain *grain;
 
-    bool continueSimulation = true;
+    double currentTime;
 
-    std::string fileName;
-    std::string message;
+    if (!sweep.getSweep(fileName)) {
+        message = "Error: Unable to read sweep file " + fileName;
+        displayMessage ( message );
+        message.clear ();
+        return;
+    }
+
+    if (!param.getParameters(sweep.parameterFile)) {
+        message = "Error: Unable to read parameter file " + sweep.parameterFile;
+        displayMessage ( message );
+        message.clear ();
+        return;
+    }
+
+    // Read the grain once for all variants
+    grain = new Grain;
+    fileName = param.input_dir + "/" + param.dislocationStructureFile;
+    if (!readGrain(fileName, grain, &currentTime, &param)) {
+        message = "Error: Unable to read grain from file " + fileName;
+        displayMessage ( message );
+        message.clear ();
+        delete (grain);
+        grain = NULL;
+        return;
+    }
+    message = "Success: read file " + fileName;
+    displayMessage ( message );
+    message.clear ();
+
+    // List the variants
+    sweep.writeVariants(param.output_dir + "/sweep.txt", param.output_dir);
+
+    message = "Starting sweep of " + intToString(sweep.getNumVariants()) + " variants...";
+    displayMessage ( message );
+    message.clear ();
+
+    int nFailed;
+    int k = forkVariants(sweep, &nFailed);
+    if (k >= 0) {
+        // Child: simulate the variant on its own image of the grain
+        if (!applyVariant(sweep, k, param, &variant, grain)) {
+            exit(1);
+        }
+        grain_iterate(&variant, grain, currentTime);
+        // exit() does not delete the grain: its outputs are closed here so that the archive index is written
+        grain->closeOutputFiles();
+        delete (grain);
+        std::cout.flush();
+        exit(0);
+    }
+
+    message = "Sweep finished: " + intToString(sweep.getNumVariants() - nFailed) + " of " + intToString(sweep.getNumVariants()) + " variants succeeded";
+    displayMessage ( message );
+    message.clear ();
+
+    delete (grain);
+    grain = NULL;
+}
+
+/**
+ * @brief Forks one child process for each variant of a sweep.
+ * @details The parent process starts at most Sweep::nJobs children at the same time and waits for all of them to finish. Each child returns immediately with the index of its variant, holding a copy-on-write image of the memory of the parent. Output files kept open by the parent must be closed before, so that their buffers are not written twice. The OpenMP runtime does not survive a fork once the parent has run a parallel region, since the threads of its pool are not copied, so the children run their parallel regions with a single thread.
+ * @param sweep The sweep.
+ * @param nFailed Pointer to the variable receiving, in the parent process, the number of variants that could not be started or did not exit normally.
+ * @return In a child process, the index of its variant. In the parent process, -1 once all children have finished.
+ */
+int forkVariants (const Sweep& sweep, int* nFailed)
+{
+    int nVariants = sweep.getNumVariants();
+    int nRunning = 0;
+    int status;
+    int k;
+    pid_t pid;
+
+    *nFailed = 0;
+
+    for (k=0; k<nVariants; k++) {
+        // Wait for a job to finish
+        if (nRunning == sweep.nJobs) {
+            wait(&status);
+            nRunning--;
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                (*nFailed)++;
+            }
+        }
+
+        // Output written before the fork must not be repeated by the child
+        std::cout.flush();
+        TextWriter::closeAll();
+
+        pid = fork();
+        if (pid == 0) {
+#ifdef _OPENMP
+            // The thread pool of the parent is not copied: a team of several threads would wait for it forever
+            omp_set_num_threads(1);
+#endif
+            return (k);
+        }
+        else if (pid < 0) {
+            displayMessage ( "Error: Unable to start variant " + intToString(k) );
+            (*nFailed)++;
+        }
+        else {
+            nRunning++;
+        }
+    }
 
-    double limitingDistance = ( param->limitingDistance * param->bmag );
-    double reactionRadius = ( param->reactionRadius * param->bmag );
+    // Wait for the remaining jobs
+    while (nRunning > 0) {
+        wait(&status);
+        nRunning--;
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            (*nFailed)++;
+        }
+    }
+
+    return (-1);
+}
 
+/**
+ * @brief Sets the parameters of a variant of a sweep and prepares its output directory.
+ * @details The parameter lines of the variant are read on top of the base parameters, and the output directory is the sub-directory of the variant in the base output directory. If the distribution of the critical stresses of the dislocation sources changes, the sources of the grain are rescaled with Grain::rescaleDislocationSources.
+ * @param sweep The sweep.
+ * @param k Index of the variant.
+ * @param base The base parameters. They are passed by value, so that variant may point to the parameters they were copied from.
+ * @param variant Pointer to the instance of the Parameter class receiving the parameters of the variant.
+ * @param grain Pointer to the grain simulated with the variant.
+ * @return False if the output directory could not be created.
+ */
+bool applyVariant (const Sweep& sweep, int k, Parameter base, Parameter* variant, Grain* grain)
+{
+    std::vector<std::string> lines = sweep.getVariantLines(k);
+    int i;
+
+    *variant = base;
+    for (i=0; i<lines.size(); i++) {
+        variant->parseLineData(lines[i]);
+    }
+
+    variant->output_dir = sweep.getVariantDirectory(base.output_dir, k);
+    if (!createDirectory(variant->output_dir)) {
+        displayMessage ( "Error: Unable to create directory " + variant->output_dir );
+        return (false);
+    }
+
+    if (variant->tauCritical_mean != base.tauCritical_mean ||
+        variant->tauCritical_stdev != base.tauCritical_stdev ||
+        variant->tauCritical_time != base.tauCritical_time) {
+        grain->rescaleDislocationSources(base.tauCritical_mean, base.tauCritical_stdev,
+                                         variant->tauCritical_mean, variant->tauCritical_stdev,
+                                         variant->tauCritical_time);
+    }
+
+    return (true);
+}
+
+/**
+ * @brief Applies the parameters that are stored in the grain before the iterations start.
+ * @details These are the applied stress, the kernel tables, the cut-off radius of the interactions, the selection of the methods calculating the stresses, the free surfaces, the interval of the grain boundary stress probes, the defects receiving the stress and the cadence of the frames written during bursts.
+ * @param param Pointer to the instance of the Parameter class containing the simulation parameters.
+ * @param grain Pointer to the instance of the Grain class containing all data for the grain.
+ * @return The number of grain boundary stress probes per segment of the grain boundary.
+ */
+int grain_configure (Parameter* param, Grain* grain)
+{
     // Calculate the applied stress on the grain and it's slip systems
     grain->calculateGrainAppliedStress(param->appliedStress);
     grain->calculateSlipSystemAppliedStress();
 
-    displayMessage("Starting simulation...");
+    // Interpolate the interactions between parallel slip planes if requested
+    grain->setKernelTables(param->tabulatedKernels, param->kernelTolerance, param->singlePrecisionKernels);
 
-    // Start the simulation
-    while (continueSimulation) {
-        // Calculate the stresses on all slip defects
-        grain->calculateAllStresses(param->mu, param->nu);
-
-        // Calculate the forces and velocities of the dislocations
-        grain->calculateDislocationVelocities(param->B);
-
-        // Time increment
-        switch (param->timeStepType) {
-        case ADAPTIVE:
-            // This part is incomplete
-            timeIncrement = grain->calculateTimeIncrement(limitingDistance, param->limitingTimeStep);
-            break;
-        case FIXED:
-            grain->setSlipSystemTimeIncrements(param->limitingTimeStep);
-            grain->moveAllDislocations(limitingDistance, param->limitingTimeStep, param->mu, param->nu);
-            break;
-        }
+    // Truncate the interactions if requested
+    grain->setInteractionCutoff(param->interactionCutoff, param->cutoffSkin);
+
+    // Select the methods calculating the stresses on sample time steps if requested
+    grain->setStressEngineTuning(param->engineTuning, param->engineTuningAccuracy, param->engineTuningInterval,
+                                 param->kernelTolerance, param->singlePrecisionKernels, param->output_dir + "/stressEngines.txt");
+
+    // Free surfaces at the extremities of the slip planes if requested
+    grain->setFreeSurfaces(param->freeSurfaces, param->getImageForceCutoff());
+
+    // Grain boundary stress probes
+    int gbResolution = 100;
+    if (param->grainStressField.parameters.size() > 0) {
+        gbResolution = (int) param->grainStressField.parameters[0];
+    }
+    if (param->grainStressField.parameters.size() > 1) {
+        grain->setGrainBoundaryProbeInterval(param->grainStressField.parameters[1]);
+    }
+
+    // The VTK files carry the stress on every defect
+    grain->setStressOnAllDefects(param->vtkOutput.write);
+
+    // Frames written depending on the bursts
+    int denseInterval = 1;
+    int ringSize = BURSTCAPTURE_DEFAULT_RING_SIZE;
+    if (param->burstFrames.parameters.size() > 0) {
+        denseInterval = (int) param->burstFrames.parameters[0];
+    }
+    if (param->burstFrames.parameters.size() > 1) {
+        ringSize = (int) param->burstFrames.parameters[1];
+    }
+    grain->setBurstCapture(denseInterval, ringSize);
 
-        // Check dislocation sources for dipole emissions
-        grain->checkDislocationSources(param->limitingTimeStep, param->mu, param->nu, limitingDistance);
+    // Archive of the outputs written per time step
+    if (!param->archiveFile.empty()) {
+        if (!grain->openArchive(param->output_dir + "/" + param->archiveFile)) {
+            displayMessage("Error: Unable to open the archive " + param->output_dir + "/" + param->archiveFile);
+        }
+    }
 
-        // Check for local reactions
-        grain->checkGrainLocalReactions(reactionRadius);
+    return (gbResolution);
+}
 
-        // Increment counters
-        totalTime += param->limitingTimeStep;
-        simulationTime.push_back ( totalTime );
-        nIterations++;
+/**
+ * @brief Branches a run into the continuations described by the file Parameter::branchFile.
+ * @details The present state of the grain is the common starting point of all continuations. Each continuation is simulated in a child process, with its own copy-on-write image of the grain, and writes its output in a sub-directory of the output directory. The continuations are listed in the file branches.txt of the output directory. The parent process waits for all continuations to finish. If the file cannot be read, the run continues without branching.
+ * @param param Pointer to the instance of the Parameter class containing the simulation parameters. In a continuation, it receives the parameters of the continuation.
+ * @param grain Pointer to the instance of the Grain class containing all data for the grain.
+ * @return True if the present process continues the simulation, false in the parent process of the continuations.
+ */
+bool grain_branch (Parameter* param, Grain* grain)
+{
+    std::string message;
+    Sweep branches;
+    Parameter base = *param;
 
-        message = "Iteration " + intToString ( nIterations ) + "; Total time " + doubleToString ( totalTime );
+    std::string fileName = param->input_dir + "/" + param->branchFile;
+    if (!branches.getSweep(fileName, false)) {
+        message = "Error: Unable to read branch file " + fileName + ". The run continues without branching.";
         displayMessage ( message );
         message.clear ();
+        return (true);
+    }
 
-        // Write statistics
-        if (param->grainObjectPositions.ifWrite()) {
-            fileName = param->output_dir + "/" + param->grainObjectPositions.name + ".txt";
-            grain->writeAllDefects( fileName, totalTime );
-            fileName.clear ();
-        }
+    branches.writeVariants(param->output_dir + "/branches.txt", param->output_dir);
+
+    message = "Branching into " + intToString(branches.getNumVariants()) + " continuations...";
+    displayMessage ( message );
+    message.clear ();
 
-        if (param->grainStressField.ifWrite()) {
-            fileName = param->output_dir + "/" + param->grainStressField.name;
-            grain->writeGrainBoundaryStressField(fileName, totalTime, 100, param->mu, param->nu);
-            fileName.clear();
+    // Buffered output must be written once, by the parent
+    grain->closeOutputFiles();
+
+    int nFailed;
+    int k = forkVariants(branches, &nFailed);
+    if (k >= 0) {
+        // Continuation
+        if (!applyVariant(branches, k, base, param, grain)) {
+            exit(1);
         }
+        return (true);
+    }
+
+    message = "Branches finished: " + intToString(branches.getNumVariants() - nFailed) + " of " + intToString(branches.getNumVariants()) + " continuations succeeded";
+    displayMessage ( message );
+    message.clear ();
+
+    return (false);
+}
+
+/**
+ * @brief Advances the grain by one time step.
+ * @details The stresses, forces and velocities of the defects are calculated, the dislocations are moved, the dislocation sources are checked for dipole emissions and the local reactions are carried out. The simulation time is not updated.
+ * @param param Pointer to the instance of the Parameter class containing the simulation parameters.
+ * @param grain Pointer to the instance of the Grain class containing all data for the grain.
+ * @param limitingDistance The limiting distance between defects, in metres.
+ * @param reactionRadius The radius within which local reactions take place, in metres.
+ */
+void grain_step (Parameter* param, Grain* grain, double limitingDistance, double reactionRadius)
+{
+    std::vector<double> timeIncrement;
+
+    // Select the methods calculating the stresses on sample time steps
+    grain->tuneStressEngines(param->mu, param->nu);
+
+    // Calculate the stresses on all slip defects
+    grain->calculateAllStresses(param->mu, param->nu);
+
+    // Calculate the forces and velocities of the dislocations
+    grain->calculateDislocationVelocities(param->B, param->mu, param->nu);
+
+    // Time increment
+    switch (param->timeStepType) {
+    case ADAPTIVE:
+        // This part is incomplete
+        timeIncrement = grain->calculateTimeIncrement(limitingDistance, param->limitingTimeStep);
+        break;
+    case FIXED:
+        grain->setSlipSystemTimeIncrements(param->limitingTimeStep);
+        grain->moveAllDislocations(limitingDistance, param->limitingTimeStep, param->mu, param->nu);
+        break;
+    }
+
+    // Check dislocation sources for dipole emissions
+    grain->checkDislocationSources(param->limitingTimeStep, param->mu, param->nu, limitingDistance);
+
+    // Check for local reactions
+    grain->checkGrainLocalReactions(reactionRadius);
+}
+
+/**
+ * @brief Writes the statistics of the grain that are due at the present iteration.
+ * @details The output scheduler decides for each statistic whether it is due, from the state it recorded at the end of the time step, so this function should be called once per iteration after OutputScheduler::update.
+ * @param param Pointer to the instance of the Parameter class containing the simulation parameters.
+ * @param grain Pointer to the instance of the Grain class containing all data for the grain.
+ * @param scheduler Pointer to the output scheduler, which also provides the current simulation time.
+ * @param gbResolution The number of grain boundary stress probes per segment of the grain boundary.
+ */
+void grain_writeStatistics (Parameter* param, Grain* grain, OutputScheduler* scheduler, int gbResolution)
+{
+    std::string fileName;
+    double totalTime = scheduler->getState().time;
+
+    if (scheduler->isDue(&(param->grainObjectPositions))) {
+        fileName = param->output_dir + "/" + param->grainObjectPositions.name + ".txt";
+        grain->writeAllDefects( fileName, totalTime );
+        fileName.clear ();
+    }
+
+    if (scheduler->isDue(&(param->kernelPrecision))) {
+        fileName = param->output_dir + "/" + param->kernelPrecision.name + ".txt";
+        grain->writeKernelPrecision(fileName, totalTime, param->mu, param->nu);
+        fileName.clear();
+    }
+
+    if (scheduler->isDue(&(param->grainPlasticStrain))) {
+        fileName = param->output_dir + "/" + param->grainPlasticStrain.name + ".txt";
+        grain->writePlasticStrain(fileName, totalTime, param->appliedStress);
+        fileName.clear();
+    }
+
+    if (scheduler->isDue(&(param->slipPlaneDensities))) {
+        fileName = param->output_dir + "/" + param->slipPlaneDensities.name + ".txt";
+        grain->writeSlipPlaneDensities(fileName, totalTime);
+        fileName.clear();
+    }
+
+    if (scheduler->isDue(&(param->pileUps))) {
+        fileName = param->output_dir + "/" + param->pileUps.name + ".txt";
+        grain->writePileUps(fileName, totalTime);
+        fileName.clear();
+    }
 
-        // Check for stopping criterion
-        if ( param->stopAfterTime ) {
-            // The stopping criterion is time
-            continueSimulation = ( totalTime <= param->stopTime );
+    if (scheduler->isDue(&(param->gndMap))) {
+        fileName = param->output_dir + "/" + param->gndMap.name;
+        grain->writeGNDMap(fileName, totalTime, (int) param->gndMap.parameters[0]);
+        fileName.clear();
+    }
+
+    if (scheduler->isDue(&(param->defectEvents))) {
+        fileName = param->output_dir + "/" + param->defectEvents.name + ".txt";
+        grain->writeDefectEvents(fileName, totalTime);
+        fileName.clear();
+    }
+
+    if (scheduler->isDue(&(param->grainFrames))) {
+        fileName = param->output_dir + "/" + param->grainFrames.name;
+        grain->writeFrame(fileName, totalTime);
+        fileName.clear();
+    }
+
+    if (param->burstFrames.write) {
+        // Called at every step: the frames before a burst are kept in memory
+        fileName = param->output_dir + "/" + param->burstFrames.name;
+        grain->writeBurstFrame(fileName, totalTime, scheduler->isDue(&(param->burstFrames)), scheduler->getState().burst, scheduler->getState().burstStart);
+        fileName.clear();
+    }
+
+    if (scheduler->isDue(&(param->vtkOutput))) {
+        fileName = param->output_dir + "/" + param->vtkOutput.name;
+        grain->writeVTK(fileName, totalTime);
+        fileName.clear();
+    }
+
+    if (scheduler->isDue(&(param->grainStressField))) {
+        fileName = param->output_dir + "/" + param->grainStressField.name;
+        grain->writeGrainBoundaryStressField(fileName, totalTime, gbResolution, param->mu, param->nu);
+        fileName.clear();
+    }
+
+    if (scheduler->isDue(&(param->liveSnapshots))) {
+        int nSlots = SNAPSHOTRING_DEFAULT_SLOTS;
+        int maxDefects = SNAPSHOTRING_DEFAULT_MAX_DEFECTS;
+        if (param->liveSnapshots.parameters.size() > 0) {
+            nSlots = (int) param->liveSnapshots.parameters[0];
         }
-        else {
-            // The stopping criterion is iterations
-            continueSimulation = ( nIterations <= param->stopIterations );
+        if (param->liveSnapshots.parameters.size() > 1) {
+            maxDefects = (int) param->liveSnapshots.parameters[1];
         }
+        grain->writeLiveSnapshot(param->liveSnapshots.name, totalTime, nSlots, maxDefects);
+    }
+}
 
+/**
+ * @brief This function handles the iterations in the simulation of dislocation motion in a single grain.
+ * @param param Pointer to the instance of the Parameter class containing the simulation parameters.
+ * @param grain Pointer to the instance of the Grain class containing all data for the grain.
+ * @param currentTime The value of the current simulation time.
+ */
+void grain_iterate (Parameter* param, Grain* grain, double currentTime)
+{
+    GrainStepGenerator generator(param, grain, currentTime);
+    StepRecord record;
+
+    std::string message;
+
+    generator.setStatisticsOutput(true);
+
+    displayMessage("Starting simulation...");
+
+    // Start the simulation
+    while (generator.next(&record)) {
+        message = "Iteration " + intToString ( record.iteration ) + "; Total time " + doubleToString ( record.time );
+        displayMessage ( message );
+        message.clear ();
+
+        // Branch into several continuations
+        if (record.iteration == param->branchIteration) {
+            if (!grain_branch(param, grain)) {
+                // All continuations have finished
+                break;
+            }
+            // The quantities derived from the parameters follow those of the continuation
+            generator.reconfigure();
+        }
     }
 
     UniqueID* uid_instance = UniqueID::getInstance();
     std::string uniquesFileName = param->output_dir + "/uniquesFile.txt";
     uid_instance->writeDefects(uniquesFileName);
     uniquesFileName.clear();
+
+    // Write the files kept open
+    TextWriter::closeAll();
 }
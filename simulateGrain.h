@@ -32,9 +32,20 @@
 #define SIMULATEGRAIN_H
 
 #include <iostream>
+#include <fstream>
+
+// POSIX processes, used to run the variants of a sweep
+#include <unistd.h>
+#include <sys/wait.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "grain.h"
 #include "readFromFile.h"
+#include "sweep.h"
+#include "stepGenerator.h"
 
 /**
  * @brief This function manages the simulation of dislocation motion in a single grain. It is the point of entry into the simulation.
@@ -47,6 +58,72 @@ void simulateSingleGrain ();
  */
 void simulateSingleGrain(std::string fileName);
 
+/**
+ * @brief This function manages a parameter sweep over a single grain.
+ * @details The parameters file and the grain structure are read once. Each variant of the sweep is then simulated in a child process, which starts from a copy-on-write image of the grain and therefore needs neither to read the structure nor to copy it. The output of a variant is written in a sub-directory of the output directory, named after the prefix of the sweep and the index of the variant, and the parameter lines of each variant are listed in the file sweep.txt of the output directory. At most Sweep::nJobs variants are simulated at the same time.
+ * @param fileName String containing the name of the file describing the sweep.
+ */
+void simulateGrainSweep (std::string fileName);
+
+/**
+ * @brief Forks one child process for each variant of a sweep.
+ * @details The parent process starts at most Sweep::nJobs children at the same time and waits for all of them to finish. Each child returns immediately with the index of its variant, holding a copy-on-write image of the memory of the parent. Output files kept open by the parent must be closed before, so that their buffers are not written twice. The OpenMP runtime does not survive a fork once the parent has run a parallel region, since the threads of its pool are not copied, so the children run their parallel regions with a single thread.
+ * @param sweep The sweep.
+ * @param nFailed Pointer to the variable receiving, in the parent process, the number of variants that could not be started or did not exit normally.
+ * @return In a child process, the index of its variant. In the parent process, -1 once all children have finished.
+ */
+int forkVariants (const Sweep& sweep, int* nFailed);
+
+/**
+ * @brief Sets the parameters of a variant of a sweep and prepares its output directory.
+ * @details The parameter lines of the variant are read on top of the base parameters, and the output directory is the sub-directory of the variant in the base output directory. If the distribution of the critical stresses of the dislocation sources changes, the sources of the grain are rescaled with Grain::rescaleDislocationSources.
+ * @param sweep The sweep.
+ * @param k Index of the variant.
+ * @param base The base parameters. They are passed by value, so that variant may point to the parameters they were copied from.
+ * @param variant Pointer to the instance of the Parameter class receiving the parameters of the variant.
+ * @param grain Pointer to the grain simulated with the variant.
+ * @return False if the output directory could not be created.
+ */
+bool applyVariant (const Sweep& sweep, int k, Parameter base, Parameter* variant, Grain* grain);
+
+/**
+ * @brief Applies the parameters that are stored in the grain before the iterations start.
+ * @details These are the applied stress, the kernel tables, the cut-off radius of the interactions, the free surfaces and the interval of the grain boundary stress probes.
+ * @param param Pointer to the instance of the Parameter class containing the simulation parameters.
+ * @param grain Pointer to the instance of the Grain class containing all data for the grain.
+ * @return The number of grain boundary stress probes per segment of the grain boundary.
+ */
+int grain_configure (Parameter* param, Grain* grain);
+
+/**
+ * @brief Branches a run into the continuations described by the file Parameter::branchFile.
+ * @details The present state of the grain is the common starting point of all continuations. Each continuation is simulated in a child process, with its own copy-on-write image of the grain, and writes its output in a sub-directory of the output directory. The continuations are listed in the file branches.txt of the output directory. The parent process waits for all continuations to finish. If the file cannot be read, the run continues without branching.
+ * @param param Pointer to the instance of the Parameter class containing the simulation parameters. In a continuation, it receives the parameters of the continuation.
+ * @param grain Pointer to the instance of the Grain class containing all data for the grain.
+ * @return True if the present process continues the simulation, false in the parent process of the continuations.
+ */
+bool grain_branch (Parameter* param, Grain* grain);
+
+/**
+ * @brief Advances the grain by one time step.
+ * @details The stresses, forces and velocities of the defects are calculated, the dislocations are moved, the dislocation sources are checked for dipole emissions and the local reactions are carried out. The simulation time is not updated.
+ * @param param Pointer to the instance of the Parameter class containing the simulation parameters.
+ * @param grain Pointer to the instance of the Grain class containing all data for the grain.
+ * @param limitingDistance The limiting distance between defects, in metres.
+ * @param reactionRadius The radius within which local reactions take place, in metres.
+ */
+void grain_step (Parameter* param, Grain* grain, double limitingDistance, double reactionRadius);
+
+/**
+ * @brief Writes the statistics of the grain that are due at the present iteration.
+ * @details The output scheduler decides for each statistic whether it is due, from the state it recorded at the end of the time step, so this function should be called once per iteration after OutputScheduler::update.
+ * @param param Pointer to the instance of the Parameter class containing the simulation parameters.
+ * @param grain Pointer to the instance of the Grain class containing all data for the grain.
+ * @param scheduler Pointer to the output scheduler, which also provides the current simulation time.
+ * @param gbResolution The number of grain boundary stress probes per segment of the grain boundary.
+ */
+void grain_writeStatistics (Parameter* param, Grain* grain, OutputScheduler* scheduler, int gbResolution);
+
 /**
  * @brief This function handles the iterations in the simulation of dislocation motion in a single grain.
  * @param param Pointer to the instance of the Parameter class containing the simulation parameters.
@@ -95,115 +95,21 @@ void simulateSingleSlipPlane ()
  */
 void singleSlipPlane_iterate (Parameter *param, SlipPlane *slipPlane, double currentTime)
 {
-    double totalTime = currentTime;
-    int nIterations = 0;
+    SlipPlaneStepGenerator generator(param, slipPlane, currentTime);
+    StepRecord record;
 
-    std::vector<double> simulationTime;
-    std::vector<double> timeIncrement;
-
-    bool continueSimulation = true;
-
-    std::string fileName;
     std::string message;
 
-    double limitingDistance = ( param->limitingDistance * param->bmag );
-    double reactionRadius = ( param->reactionRadius * param->bmag );
-
-    // Calculate stresses in slip plane system.
-    slipPlane->calculateSlipPlaneAppliedStress(param->appliedStress);
+    generator.setStatisticsOutput(true);
 
     displayMessage ( "Starting simulation..." );
 
-    // Write statistics
-    if ( param->dislocationPositions.ifWrite() ) {
-        fileName = param->output_dir + "/" + param->dislocationPositions.name + doubleToString ( totalTime ) + ".txt";
-        slipPlane->writeSlipPlane ( fileName, totalTime );
-        fileName.clear ();
-    }
-
-    if ( param->slipPlaneStressDistributions.ifWrite() ) {
-        fileName = param->output_dir + "/" + param->slipPlaneStressDistributions.name + doubleToString ( totalTime ) + ".txt";
-        slipPlane->writeSlipPlaneStressDistribution ( fileName,
-                                                      param->slipPlaneStressDistributions.parameters[0],
-                                                      param );
-        fileName.clear ();
-    }
-
-    while ( continueSimulation ) {
-        // Calculate stresses on all defects
-        slipPlane->calculateDefectStresses ( param->mu, param->nu );
-
-        /*
-         * Treat the dislocations
-         */
-        // Calculate forces on dislocations
-        slipPlane->calculateDislocationForces ();
-        // Calculate dislocation velocities
-        slipPlane->calculateDislocationVelocities ( param->B );
-        switch (param->timeStepType) {
-        case ADAPTIVE:
-            // Calculate the time increment
-            timeIncrement = slipPlane->calculateTimeIncrement ( limitingDistance,
-                                                                param->limitingTimeStep );
-            // Displace the dislocations
-            slipPlane->moveDislocations ( timeIncrement );
-            break;
-
-        case FIXED:
-            slipPlane->setTimeIncrement(param->limitingTimeStep);
-            slipPlane->moveDislocationsToLocalEquilibrium( limitingDistance,
-                                                           param->limitingTimeStep,
-                                                           param->mu, param->nu );
-            break;
-        }
-
-        /*
-         * Treat the dislocation sources
-         */
-        slipPlane->checkDislocationSources(slipPlane->getTimeIncrement(),param->mu, param->nu,limitingDistance);
-
-        // Check for local reactions
-        slipPlane->checkLocalReactions(reactionRadius);
-
-        // Increment counters
-        totalTime += slipPlane->getTimeIncrement ();
-        simulationTime.push_back ( totalTime );
-        nIterations++;
-
-        message = "Iteration " + intToString ( nIterations ) + "; Total time " + doubleToString ( totalTime );
+    while ( generator.next(&record) ) {
+        message = "Iteration " + intToString ( record.iteration ) + "; Total time " + doubleToString ( record.time );
         displayMessage ( message );
         message.clear ();
-
-        // Write statistics
-        if ( param->dislocationPositions.ifWrite() ) {
-            fileName = param->output_dir + "/" + param->dislocationPositions.name + doubleToString ( totalTime ) + ".txt";
-            slipPlane->writeSlipPlane ( fileName, totalTime );
-            fileName.clear ();
-        }
-
-        if ( param->slipPlaneStressDistributions.ifWrite() ) {
-            fileName = param->output_dir + "/" + param->slipPlaneStressDistributions.name + doubleToString ( totalTime ) + ".txt";
-            slipPlane->writeSlipPlaneStressDistribution ( fileName,
-                                                          param->slipPlaneStressDistributions.parameters[0],
-                                                          param );
-            fileName.clear ();
-        }
-
-        if ( param->allDefectPositions.ifWrite() ) {
-            fileName = param->output_dir + "/" + param->allDefectPositions.name + ".txt";
-            slipPlane->writeAllDefects( fileName, totalTime );
-            fileName.clear();
-        }
-
-        // Check for stopping criterion
-        if ( param->stopAfterTime ) {
-            // The stopping criterion is time
-            continueSimulation = ( totalTime <= param->stopTime );
-        }
-        else {
-            // The stopping criterion is iterations
-            continueSimulation = ( nIterations <= param->stopIterations );
-        }
-
     }
+
+    // Write the files kept open
+    TextWriter::closeAll ();
 }
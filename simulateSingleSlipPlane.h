@@ -43,6 +43,7 @@
 #include "parameter.h"
 #include "tools.h"
 #include "readFromFile.h"
+#include "stepGenerator.h"
 
 /**
  * @brief This function manages the simulation for a single slip plane.
@@ -93,83 +93,27 @@ void simulateSingleSlipSystem ()
  */
 void singleSlipSystem_iterate (Parameter *param, SlipSystem *slipSystem, double currentTime)
 {
-    double totalTime = currentTime;
-    int nIterations = 0;
+    SlipSystemStepGenerator generator(param, slipSystem, currentTime);
+    StepRecord record;
 
-    std::vector<double> simulationTime;
-    std::vector<double> timeIncrement;
-
-    bool continueSimulation = true;
-
-    std::string fileName;
     std::string message;
 
-    double limitingDistance = ( param->limitingDistance * param->bmag );
-    double reactionRadius = ( param->reactionRadius * param->bmag );
-
-    // Calculate the applied stress in the slip system's co-ordinate systems
-    // as well as on each slip plane, in their local co-ordinate systems
-    slipSystem->calculateSlipSystemAppliedStress(param->appliedStress);
-    slipSystem->calculateSlipPlaneAppliedStress();
+    generator.setStatisticsOutput(true);
 
     displayMessage ( "Starting simulation..." );
 
     // Start the simulation
-    while (continueSimulation) {
-        // Calculate stresses on all defects
-        slipSystem->calculateAllStresses(param->mu, param->nu);
-
-        // Calculate dislocation velocities
-        slipSystem->calculateSlipPlaneDislocationForcesVelocities(param->B);
-
-        // Time increment
-        switch (param->timeStepType) {
-        case ADAPTIVE:
-            // This part is pending
-            timeIncrement = slipSystem->calculateTimeIncrement(limitingDistance, param->limitingTimeStep);
-            break;
-
-        case FIXED:
-            slipSystem->setTimeIncrement(param->limitingTimeStep);
-            slipSystem->moveSlipPlaneDislocations(limitingDistance, param->limitingTimeStep, param->mu, param->nu);
-            break;
-        }
-
-        // Check dislocation sources on all slip planes
-        slipSystem->checkSlipPlaneDislocationSources(param->limitingTimeStep, param->mu, param->nu, limitingDistance);
-
-        // Check local reactions on all slip planes
-        slipSystem->checkSlipPlaneLocalReactions(reactionRadius);
-
-        // Increment counters
-        totalTime += slipSystem->getTimeIncrement ();
-        simulationTime.push_back ( totalTime );
-        nIterations++;
-
-        message = "Iteration " + intToString ( nIterations ) + "; Total time " + doubleToString ( totalTime );
+    while (generator.next(&record)) {
+        message = "Iteration " + intToString ( record.iteration ) + "; Total time " + doubleToString ( record.time );
         displayMessage ( message );
         message.clear ();
-
-        // Write statistics
-        if (param->slipSystemObjectPositions.ifWrite()) {
-            fileName = param->output_dir + "/" + param->slipSystemObjectPositions.name + ".txt";
-            slipSystem->writeAllDefects( fileName, totalTime );
-            fileName.clear ();
-        }
-
-        // Check for stopping criterion
-        if ( param->stopAfterTime ) {
-            // The stopping criterion is time
-            continueSimulation = ( totalTime <= param->stopTime );
-        }
-        else {
-            // The stopping criterion is iterations
-            continueSimulation = ( nIterations <= param->stopIterations );
-        }
     }
 
     UniqueID* uid_instance = UniqueID::getInstance();
     std::string uniquesFileName = param->output_dir + "/uniquesFile.txt";
     uid_instance->writeDefects(uniquesFileName);
     uniquesFileName.clear();
+
+    // Write the files kept open
+    TextWriter::closeAll();
 }
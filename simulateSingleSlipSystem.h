@@ -41,6 +41,7 @@
 #include "parameter.h"
 #include "tools.h"
 #include "readFromFile.h"
+#include "stepGenerator.h"
 
 /**
  * @brief This function is the point of entry for simulating a single slip system.
@@ -0,0 +1,290 @@
+/**
+ * @file simulation.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the member functions of the class Simulation.
+ * @details This file defines the member functions of the class Simulation, through which the simulation of a single grain can be driven from another program.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "simulation.h"
+
+// Constructor
+/**
+ * @brief Default constructor. The parameters have their default values and there is no grain.
+ */
+Simulation::Simulation ()
+{
+    this->grain = NULL;
+    this->generator = NULL;
+    this->writeStatistics = false;
+}
+
+// Destructor
+/**
+ * @brief Destructor for the class Simulation. The grain is deleted and the output files kept open are written.
+ */
+Simulation::~Simulation ()
+{
+    TextWriter::closeAll();
+
+    if (this->generator != NULL) {
+        delete (this->generator);
+        this->generator = NULL;
+    }
+    if (this->grain != NULL) {
+        delete (this->grain);
+        this->grain = NULL;
+    }
+}
+
+/**
+ * @brief Replaces the grain.
+ * @param g Pointer to the new grain.
+ * @param currentTime The simulation time of the new grain.
+ */
+void Simulation::replaceGrain (Grain* g, double currentTime)
+{
+    if (this->generator != NULL) {
+        delete (this->generator);
+    }
+    if (this->grain != NULL && this->grain != g) {
+        delete (this->grain);
+    }
+    this->grain = g;
+    this->generator = new GrainStepGenerator(&(this->param), this->grain, currentTime);
+    this->generator->setStatisticsOutput(this->writeStatistics);
+}
+
+// Assignment functions
+/**
+ * @brief Reads the parameters from file.
+ * @param fileName Name of the parameters file.
+ * @return False if the file could not be read.
+ */
+bool Simulation::readParameters (std::string fileName)
+{
+    this->reconfigure();
+    return (this->param.getParameters(fileName));
+}
+
+/**
+ * @brief Sets a parameter from a line in the format of the parameters file.
+ * @details The parameters are applied to the grain again before the next step.
+ * @param line The line, for example "appliedStress 0 0 0 100e6 0 0".
+ */
+void Simulation::setParameter (std::string line)
+{
+    if ( !ignoreLine ( line ) ) {
+        this->param.parseLineData(line);
+        this->reconfigure();
+    }
+}
+
+/**
+ * @brief Reads the grain from file.
+ * @details The parameters must have been set before, since the critical stresses of the dislocation sources are drawn from them. The grain replaces any grain held before.
+ * @param fileName Name of the file containing the grain.
+ * @return False if the file could not be read.
+ */
+bool Simulation::readGrain (std::string fileName)
+{
+    std::ifstream fp ( fileName.c_str() );
+
+    if ( fp.is_open() )
+    {
+        bool success = this->readGrain(fp);
+        fp.close();
+        return (success);
+    }
+    else {
+        return (false);
+    }
+}
+
+/**
+ * @brief Reads the grain from a stream in the format of the grain file.
+ * @details The parameters must have been set before, since the critical stresses of the dislocation sources are drawn from them. The grain replaces any grain held before.
+ * @param in The stream.
+ * @return False if the grain could not be read.
+ */
+bool Simulation::readGrain (std::istream& in)
+{
+    Grain* g = new Grain;
+    double currentTime = 0.0;
+
+    if ( ::readGrain(in, g, &currentTime, &(this->param)) ) {
+        this->replaceGrain(g, currentTime);
+        return (true);
+    }
+    else {
+        delete (g);
+        g = NULL;
+        return (false);
+    }
+}
+
+/**
+ * @brief Builds the grain from a string in the format of the grain file.
+ * @details The parameters must have been set before, since the critical stresses of the dislocation sources are drawn from them. The grain replaces any grain held before.
+ * @param data The contents of the grain file.
+ * @return False if the grain could not be read.
+ */
+bool Simulation::setGrainData (std::string data)
+{
+    std::istringstream in(data);
+    return (this->readGrain(in));
+}
+
+/**
+ * @brief Hands a grain built by the calling program over to the simulation.
+ * @details The grain is deleted by the instance of this class. It replaces any grain held before.
+ * @param g Pointer to the grain.
+ * @param currentTime The simulation time of the grain.
+ */
+void Simulation::setGrain (Grain* g, double currentTime)
+{
+    this->replaceGrain(g, currentTime);
+}
+
+/**
+ * @brief Sets whether the statistics requested in the parameters are written after each step.
+ * @param write True to write the statistics in the output directory of the parameters.
+ */
+void Simulation::setStatisticsOutput (bool write)
+{
+    this->writeStatistics = write;
+    if (this->generator != NULL) {
+        this->generator->setStatisticsOutput(write);
+    }
+}
+
+/**
+ * @brief Indicates that the parameters have changed. They are applied to the grain again before the next step.
+ * @details This function must be called after the fields of the parameters returned by Simulation::getParameters have been changed. The other functions of this class that change the parameters call it themselves.
+ */
+void Simulation::reconfigure ()
+{
+    if (this->generator != NULL) {
+        this->generator->reconfigure();
+    }
+}
+
+// Access functions
+/**
+ * @brief Get a pointer to the parameters.
+ * @return Pointer to the parameters.
+ */
+Parameter* Simulation::getParameters ()
+{
+    return (&(this->param));
+}
+
+/**
+ * @brief Get a pointer to the grain.
+ * @return Pointer to the grain, NULL if there is none.
+ */
+Grain* Simulation::getGrain ()
+{
+    return (this->grain);
+}
+
+/**
+ * @brief Get the slip systems of the grain, without copying.
+ * @details The slip planes of a slip system are obtained with SlipSystem::getSlipPlanes and the dislocations of a slip plane with SlipPlane::getDislocationList, both without copying. The position of a dislocation is given by Defect::getPosition, and the stress acting on it at the last step by Defect::getTotalStress. The grain must exist.
+ * @return Reference to the vector container with pointers to the slip systems.
+ */
+const std::vector<SlipSystem*>& Simulation::getSlipSystems () const
+{
+    return (this->grain->getSlipSystems());
+}
+
+/**
+ * @brief Get the present simulation time.
+ * @return The simulation time.
+ */
+double Simulation::getTime () const
+{
+    if (this->generator == NULL) {
+        return (0.0);
+    }
+    return (this->generator->getTime());
+}
+
+/**
+ * @brief Get the number of iterations carried out.
+ * @return The number of iterations.
+ */
+int Simulation::getIteration () const
+{
+    if (this->generator == NULL) {
+        return (0);
+    }
+    return (this->generator->getIteration());
+}
+
+/**
+ * @brief Get the plastic strain accumulated in the grain.
+ * @return The plastic strain, expressed in the local co-ordinate system of the grain.
+ */
+Strain Simulation::getPlasticStrain ()
+{
+    if (this->grain == NULL) {
+        return (Strain());
+    }
+    return (this->grain->getPlasticStrain());
+}
+
+/**
+ * @brief Indicates whether the stopping criterion of the parameters has been reached.
+ * @return True if there is no grain, or if the simulation time or the number of iterations has exceeded its limit.
+ */
+bool Simulation::isFinished () const
+{
+    if (this->generator == NULL) {
+        return (true);
+    }
+    return (this->generator->isFinished());
+}
+
+// Operations
+/**
+ * @brief Advances the grain by n time steps, or until the stopping criterion of the parameters is reached.
+ * @param n Number of time steps.
+ * @return The number of time steps carried out, which is zero if there is no grain.
+ */
+int Simulation::step (int n)
+{
+    int i = 0;
+
+    if (this->generator == NULL) {
+        return (0);
+    }
+
+    while (i < n && this->generator->next(NULL)) {
+        i++;
+    }
+
+    return (i);
+}
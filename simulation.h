@@ -0,0 +1,198 @@
+/**
+ * @file simulation.h
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the class Simulation.
+ * @details This file defines the class Simulation, through which the simulation of a single grain can be driven from another program.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <sstream>
+
+#include "grain.h"
+#include "parameter.h"
+#include "readFromFile.h"
+#include "simulateGrain.h"
+#include "stepGenerator.h"
+
+/**
+ * @brief The Simulation class drives the simulation of a single grain from another program.
+ * @details The class holds the parameters and the grain, and advances the grain with a GrainStepGenerator, like the function grain_iterate. The grain can be read from file, built from a string in the format of the grain file, or built by the calling program and handed over. The slip systems, slip planes and defects of the grain, and thereby the positions of the dislocations and the stresses acting on them, are read through references to the containers of the grain, without copying. Statistics are only written if requested with Simulation::setStatisticsOutput. The parameters may be changed between calls to Simulation::step; they are applied to the grain again before the next step.
+ */
+class Simulation
+{
+protected:
+    /**
+     * @brief The simulation parameters.
+     */
+    Parameter param;
+    /**
+     * @brief Pointer to the grain. The grain belongs to the instance of this class.
+     */
+    Grain* grain;
+    /**
+     * @brief Pointer to the generator carrying out the time steps of the grain.
+     */
+    GrainStepGenerator* generator;
+    /**
+     * @brief Flag indicating whether the statistics are written after each step.
+     */
+    bool writeStatistics;
+
+    /**
+     * @brief Replaces the grain.
+     * @param g Pointer to the new grain.
+     * @param currentTime The simulation time of the new grain.
+     */
+    void replaceGrain (Grain* g, double currentTime);
+
+private:
+    /**
+     * @brief Copy constructor. Not implemented, since the grain cannot be copied.
+     */
+    Simulation (const Simulation&);
+    /**
+     * @brief Assignment operator. Not implemented, since the grain cannot be copied.
+     */
+    Simulation& operator= (const Simulation&);
+
+public:
+    // Constructors
+    /**
+     * @brief Default constructor. The parameters have their default values and there is no grain.
+     */
+    Simulation ();
+
+    // Destructor
+    /**
+     * @brief Destructor for the class Simulation. The grain is deleted and the output files kept open are written.
+     */
+    virtual ~Simulation ();
+
+    // Assignment functions
+    /**
+     * @brief Reads the parameters from file.
+     * @param fileName Name of the parameters file.
+     * @return False if the file could not be read.
+     */
+    bool readParameters (std::string fileName);
+    /**
+     * @brief Sets a parameter from a line in the format of the parameters file.
+     * @details The parameters are applied to the grain again before the next step.
+     * @param line The line, for example "appliedStress 0 0 0 100e6 0 0".
+     */
+    void setParameter (std::string line);
+    /**
+     * @brief Reads the grain from file.
+     * @details The parameters must have been set before, since the critical stresses of the dislocation sources are drawn from them. The grain replaces any grain held before.
+     * @param fileName Name of the file containing the grain.
+     * @return False if the file could not be read.
+     */
+    bool readGrain (std::string fileName);
+    /**
+     * @brief Reads the grain from a stream in the format of the grain file.
+     * @details The parameters must have been set before, since the critical stresses of the dislocation sources are drawn from them. The grain replaces any grain held before.
+     * @param in The stream.
+     * @return False if the grain could not be read.
+     */
+    bool readGrain (std::istream& in);
+    /**
+     * @brief Builds the grain from a string in the format of the grain file.
+     * @details The parameters must have been set before, since the critical stresses of the dislocation sources are drawn from them. The grain replaces any grain held before.
+     * @param data The contents of the grain file.
+     * @return False if the grain could not be read.
+     */
+    bool setGrainData (std::string data);
+    /**
+     * @brief Hands a grain built by the calling program over to the simulation.
+     * @details The grain is deleted by the instance of this class. It replaces any grain held before.
+     * @param g Pointer to the grain.
+     * @param currentTime The simulation time of the grain.
+     */
+    void setGrain (Grain* g, double currentTime);
+    /**
+     * @brief Sets whether the statistics requested in the parameters are written after each step.
+     * @param write True to write the statistics in the output directory of the parameters.
+     */
+    void setStatisticsOutput (bool write);
+    /**
+     * @brief Indicates that the parameters have changed. They are applied to the grain again before the next step.
+     * @details This function must be called after the fields of the parameters returned by Simulation::getParameters have been changed. The other functions of this class that change the parameters call it themselves.
+     */
+    void reconfigure ();
+
+    // Access functions
+    /**
+     * @brief Get a pointer to the parameters.
+     * @return Pointer to the parameters.
+     */
+    Parameter* getParameters ();
+    /**
+     * @brief Get a pointer to the grain.
+     * @return Pointer to the grain, NULL if there is none.
+     */
+    Grain* getGrain ();
+    /**
+     * @brief Get the slip systems of the grain, without copying.
+     * @details The slip planes of a slip system are obtained with SlipSystem::getSlipPlanes and the dislocations of a slip plane with SlipPlane::getDislocationList, both without copying. The position of a dislocation is given by Defect::getPosition, and the stress acting on it at the last step by Defect::getTotalStress. The grain must exist.
+     * @return Reference to the vector container with pointers to the slip systems.
+     */
+    const std::vector<SlipSystem*>& getSlipSystems () const;
+    /**
+     * @brief Get the present simulation time.
+     * @return The simulation time.
+     */
+    double getTime () const;
+    /**
+     * @brief Get the number of iterations carried out.
+     * @return The number of iterations.
+     */
+    int getIteration () const;
+    /**
+     * @brief Get the plastic strain accumulated in the grain.
+     * @return The plastic strain, expressed in the local co-ordinate system of the grain.
+     */
+    Strain getPlasticStrain ();
+    /**
+     * @brief Indicates whether the stopping criterion of the parameters has been reached.
+     * @return True if there is no grain, or if the simulation time or the number of iterations has exceeded its limit.
+     */
+    bool isFinished () const;
+
+    // Operations
+    /**
+     * @brief Advances the grain by n time steps, or until the stopping criterion of the parameters is reached.
+     * @param n Number of time steps.
+     * @return The number of time steps carried out, which is zero if there is no grain.
+     */
+    int step (int n);
+};
+
+#endif // SIMULATION_H
@@ -70,6 +70,17 @@ SlipPlane::SlipPlane ()
 
     // Time increment
     this->dt = 0;
+
+    // Event counters
+    this->nEmissions = 0;
+    this->nAnnihilations = 0;
+    this->nAbsorptions = 0;
+
+    // Image forces are disabled by default
+    this->imageForceCutoff = 0.0;
+
+    // Only the defects that use the stress receive it
+    this->stressOnAllDefects = false;
 }
 
 /**
@@ -95,6 +106,17 @@ SlipPlane::SlipPlane (Vector3d *ends, Vector3d pos, CoordinateSystem* base, std:
 
     // Time increment
     this->dt = 0;
+
+    // Event counters
+    this->nEmissions = 0;
+    this->nAnnihilations = 0;
+    this->nAbsorptions = 0;
+
+    // Image forces are disabled by default
+    this->imageForceCutoff = 0.0;
+
+    // Only the defects that use the stress receive it
+    this->stressOnAllDefects = false;
 }
 
 // Destructor
@@ -173,6 +195,36 @@ void SlipPlane::setExtremities (Vector3d *ends)
                                   this->getCoordinateSystem());
 }
 
+/**
+ * @brief Set the type of defect represented by the extremities of the slip plane.
+ * @details The extremities are grain boundaries when they are created. Setting them to FREESURFACE makes them absorb the dislocations reaching them and exert image forces on the dislocations close to them.
+ * @param t The type of defect of both extremities.
+ */
+void SlipPlane::setExtremityType (DefectType t)
+{
+    this->extremity0->setDefectType(t);
+    this->extremity1->setDefectType(t);
+}
+
+/**
+ * @brief Set the distance from a free surface extremity within which the image force acts on the dislocations.
+ * @param cutoff The cut-off distance. A value of zero or less disables the image forces.
+ */
+void SlipPlane::setImageForceCutoff (double cutoff)
+{
+    this->imageForceCutoff = cutoff;
+}
+
+/**
+ * @brief Set whether the total stress is calculated on all defects.
+ * @details By default, the total stress is only calculated on the mobile dislocations and on the dislocation sources, which are the only defects that use it. An output that needs the stress on the extremities or on the pinned dislocations should enable it.
+ * @param allDefects Flag indicating whether the total stress is calculated on all defects.
+ */
+void SlipPlane::setStressOnAllDefects (bool allDefects)
+{
+    this->stressOnAllDefects = allDefects;
+}
+
 /**
  * @brief Set the normal vector of the slip plane.
  * @param normal The normal vector of the slip plane.
@@ -356,9 +408,10 @@ bool SlipPlane::getDislocation (int i, Dislocation* d) const
 
 /**
  * @brief Get the entire vector container which holds the pointers to all the defects
- * @return The vector of the defects lying on the slip plane.
+ * @details The reference remains valid as long as the slip plane exists, but the contents change when the defect list is updated.
+ * @return Reference to the vector of the defects lying on the slip plane.
  */
-std::vector<Defect*> SlipPlane::getDefectList ()
+const std::vector<Defect*>& SlipPlane::getDefectList () const
 {
     return (this->defects);
 }
@@ -396,6 +449,52 @@ std::vector<Vector3d> SlipPlane::getAllDefectPositions_local ()
     return (defectPositions);
 }
 
+/**
+ * @brief Get the defects on which the total stress is calculated.
+ * @details These are the mobile dislocations and the dislocation sources, or all defects if SlipPlane::setStressOnAllDefects has been enabled.
+ * @return The vector of the defects on which the total stress is calculated.
+ */
+std::vector<Defect*> SlipPlane::getStressReceivers ()
+{
+    if (this->stressOnAllDefects) {
+        return (this->defects);
+    }
+
+    std::vector<Defect*> receivers;
+    receivers.reserve(this->dislocations.size() + this->dislocationSources.size());
+
+    std::vector<Dislocation*>::iterator disl_it;
+    std::vector<DislocationSource*>::iterator dSource_it;
+
+    for (disl_it=this->dislocations.begin(); disl_it!=this->dislocations.end(); disl_it++) {
+        if ((*disl_it)->isMobile()) {
+            receivers.push_back(*disl_it);
+        }
+    }
+    for (dSource_it=this->dislocationSources.begin(); dSource_it!=this->dislocationSources.end(); dSource_it++) {
+        receivers.push_back(*dSource_it);
+    }
+
+    return (receivers);
+}
+
+/**
+ * @brief Return the positions of the defects on which the total stress is calculated, expressed in the slip plane base co-ordinate system.
+ * @param receivers The defects, as returned by SlipPlane::getStressReceivers.
+ * @return STL vector container with the position vectors of the defects, expressed in the slip plane base co-ordinate system.
+ */
+std::vector<Vector3d> SlipPlane::getStressReceiverPositions_base (const std::vector<Defect*>& receivers)
+{
+    std::vector<Vector3d> positions (receivers.size(), Vector3d());
+    int i;
+
+    for (i=0; i<receivers.size(); i++) {
+        positions[i] = receivers[i]->getPosition();
+    }
+
+    return (this->coordinateSystem.vector_LocalToBase(positions));
+}
+
 /**
  * @brief Return the number of defects lying in the slip plane.
  * @return The number of defects lying in the slip plane.
@@ -407,9 +506,10 @@ int SlipPlane::getNumDefects () const
 
 /**
  * @brief Get the entire vector container which holds the dislocations lying on this slip plane.
- * @return The vector of dislocations lying on this slip plane.
+ * @details The reference remains valid as long as the slip plane exists, but the contents change when dislocations are inserted or removed.
+ * @return Reference to the vector of dislocations lying on this slip plane.
  */
-std::vector<Dislocation*> SlipPlane::getDislocationList ()
+const std::vector<Dislocation*>& SlipPlane::getDislocationList () const
 {
     return (this->dislocations);
 }
@@ -423,6 +523,43 @@ int SlipPlane::getNumDislocations () const
     return (this->dislocations.size());
 }
 
+/**
+ * @brief Get the plastic slip accumulated on the slip plane.
+ * @details The plastic slip is the sum over all displacements of the dislocations of the symmetric part of b \f$\otimes\f$ n multiplied by the glide distance. Divided by the area of the grain, it gives the plastic strain.
+ * @return The plastic slip, expressed in the local co-ordinate system.
+ */
+Strain SlipPlane::getPlasticSlip () const
+{
+    return (this->plasticSlip);
+}
+
+/**
+ * @brief Get the number of dislocation dipoles emitted on the slip plane since the beginning of the simulation.
+ * @return The number of emissions.
+ */
+int SlipPlane::getNumEmissions () const
+{
+    return (this->nEmissions);
+}
+
+/**
+ * @brief Get the number of pairs of dislocations annihilated on the slip plane since the beginning of the simulation.
+ * @return The number of annihilations.
+ */
+int SlipPlane::getNumAnnihilations () const
+{
+    return (this->nAnnihilations);
+}
+
+/**
+ * @brief Get the number of dislocations absorbed by the free surfaces of the slip plane since the beginning of the simulation.
+ * @return The number of absorptions.
+ */
+int SlipPlane::getNumAbsorptions () const
+{
+    return (this->nAbsorptions);
+}
+
 /**
  * @brief Get the dislocation source on the slip plane indicated by the index provided as argument.
  * @details The slip plane contains several dislocation sources that are stored in a vector container. This function returns the dislocation source in that vector that corresponds to the index provided as argument.
@@ -445,9 +582,10 @@ bool SlipPlane::getDislocationSource (int i, DislocationSource* dSource) const
 
 /**
  * @brief Get the entire vector container which holds the dislocation sources lying on this slip plane.
- * @return The vector of dislocation sources lying on this slip plane.
+ * @details The reference remains valid as long as the slip plane exists, but the contents change when dislocation sources are inserted or removed.
+ * @return Reference to the vector of dislocation sources lying on this slip plane.
  */
-std::vector<DislocationSource*> SlipPlane::getDislocationSourceList () const
+const std::vector<DislocationSource*>& SlipPlane::getDislocationSourceList () const
 {
     return (this->dislocationSources);
 }
@@ -643,31 +781,54 @@ void SlipPlane::calculateRotationMatrix ()
 
 // Treat defects
 /**
- * @brief This function calculates the total stress fields on all defects lying on the slip plane and stores the stress field tensors in the members Defect::totalStress and Defect::totalStresses.
+ * @brief This function calculates the total stress fields on the defects lying on the slip plane and stores the stress field tensors in the members Defect::totalStress and Defect::totalStresses.
+ * @details The mobile dislocations and the dislocation sources are treated together in a single pass, given by SlipPlane::calculateReceiverStresses. The extremities and the pinned dislocations are skipped unless SlipPlane::setStressOnAllDefects has been enabled.
  * @param mu Shear modulus of the material.
  * @param nu Poisson's ratio.
  */
 void SlipPlane::calculateDefectStresses (double mu, double nu)
 {
-    std::vector<Defect*>::iterator destinationDefect_it;
-    std::vector<Defect*>::iterator sourceDefect_it;
+    this->calculateReceiverStresses(this->getStressReceivers(), mu, nu);
+}
 
-    Defect *destinationDefect;
-    Defect *sourceDefect;
+/**
+ * @brief Calculates the total stress on each defect of a list, in a single pass over the dislocations of the slip plane.
+ * @details The defects are treated in groups of SLIPPLANE_RECEIVER_TILE, and the stress fields of all dislocations are superposed at all defects of a group before moving to the next group, so that the data of each dislocation is loaded once per group. The other defects have no stress field and are skipped. The applied stress is added to the result.
+ * @param receivers The defects on which the stress is calculated. They must lie on the slip plane.
+ * @param mu Shear modulus of the material.
+ * @param nu Poisson's ratio.
+ */
+void SlipPlane::calculateReceiverStresses (const std::vector<Defect*>& receivers, double mu, double nu)
+{
+    int nReceivers = receivers.size();
+    int nDisl = this->dislocations.size();
+    int tileStart, tileSize;
+    int i, j;
 
-    Stress s;
-    Vector3d p;
+    Dislocation* disl;
+
+    // Positions and stresses of the defects of a tile
+    Vector3d p[SLIPPLANE_RECEIVER_TILE];
+    Stress s[SLIPPLANE_RECEIVER_TILE];
 
-    for (destinationDefect_it=this->defects.begin(); destinationDefect_it!=this->defects.end(); destinationDefect_it++) {
-        s = this->appliedStress_local;
-        destinationDefect = *destinationDefect_it;
-        p = destinationDefect->getPosition();
-        for (sourceDefect_it=this->defects.begin(); sourceDefect_it!=this->defects.end(); sourceDefect_it++) {
-            sourceDefect = *sourceDefect_it;
-            // Superpose the stress fields of all other defects
-            s = s + sourceDefect->stressField(p, mu, nu);
+    for (tileStart=0; tileStart<nReceivers; tileStart+=SLIPPLANE_RECEIVER_TILE) {
+        tileSize = std::min(SLIPPLANE_RECEIVER_TILE, nReceivers-tileStart);
+        for (i=0; i<tileSize; i++) {
+            p[i] = receivers[tileStart+i]->getPosition();
+            s[i] = this->appliedStress_local;
+        }
+
+        // Superpose the stress field of each dislocation on the whole tile
+        for (j=0; j<nDisl; j++) {
+            disl = this->dislocations[j];
+            for (i=0; i<tileSize; i++) {
+                s[i] = s[i] + disl->stressField(p[i], mu, nu);
+            }
+        }
+
+        for (i=0; i<tileSize; i++) {
+            receivers[tileStart+i]->setTotalStress(s[i]);
         }
-        destinationDefect->setTotalStress(s);
     }
 }
 
@@ -732,39 +893,41 @@ std::vector<Defect*> SlipPlane::findDefectsBetweenPoints (Vector3d p0, Vector3d
  */
 void SlipPlane::calculateDislocationStresses (double mu, double nu)
 {
-    std::vector<Dislocation*>::iterator disl_it;  // Iterator for each dislocation
-    std::vector<Defect*>::iterator defect_it;   // Iterator for defects
-    Stress s;                                // Variable for stress
-
-    Dislocation* disl;
-    Defect* defect;
-
-    Vector3d p;                              // Position vector
-
-    for (disl_it=this->dislocations.begin(); disl_it!=this->dislocations.end(); disl_it++) {
-        s = this->appliedStress_local;
-        disl = *disl_it;
-        p = disl->getPosition();
-        for (defect_it = this->defects.begin(); defect_it!=this->defects.end(); defect_it++) {
-            defect = *defect_it;
-            // Superpose the stress fields of all other dislocations
-            s = s + defect->stressField(p, mu, nu);
-        }
-        disl->setTotalStress(s);
-    }
+    std::vector<Defect*> receivers (this->dislocations.begin(), this->dislocations.end());
+    this->calculateReceiverStresses(receivers, mu, nu);
 }
 
 /**
  * @brief This function calculates the Peach-Koehler force experienced by each dislocation and stores it in Dislocation::force and puts it at the end of std::vector<Vector3d> Dislocation::forces.
- * @details This function calculates the Peach-Koehler force experienced by each dislocation using the function Dislocation::forcePeachKoehler and the variable Stress Dislocation::totalStress.
+ * @details This function calculates the Peach-Koehler force experienced by each dislocation using the function Dislocation::forcePeachKoehler and the variable Stress Dislocation::totalStress. The dislocations lying within SlipPlane::imageForceCutoff of an extremity that is a free surface also experience the image force of that surface, given by Dislocation::imageForce.
+ * @param mu Shear modulus of the material.
+ * @param nu Poisson's ratio.
  */
-void SlipPlane::calculateDislocationForces ()
+void SlipPlane::calculateDislocationForces (double mu, double nu)
 {
     std::vector<Dislocation*>::iterator d;  // Iterator for dislocations
+    Dislocation* disl;
+    Vector3d force;
+
+    // Free surfaces exerting image forces
+    bool image0 = (this->imageForceCutoff > 0.0) && (this->extremity0->getDefectType() == FREESURFACE);
+    bool image1 = (this->imageForceCutoff > 0.0) && (this->extremity1->getDefectType() == FREESURFACE);
+    Vector3d surface0 = this->extremity0->getPosition();
+    Vector3d surface1 = this->extremity1->getPosition();
 
     for (d = this->dislocations.begin(); d!=this->dislocations.end(); d++)
     {
-        (*d)->setTotalForce ( (*d)->forcePeachKoehler((*d)->getTotalStress()) );
+        disl = *d;
+        force = disl->forcePeachKoehler(disl->getTotalStress());
+
+        if (image0 && (disl->getPosition() - surface0).magnitude() <= this->imageForceCutoff) {
+            force = force + disl->imageForce(surface0, mu, nu);
+        }
+        if (image1 && (disl->getPosition() - surface1).magnitude() <= this->imageForceCutoff) {
+            force = force + disl->imageForce(surface1, mu, nu);
+        }
+
+        disl->setTotalForce (force);
     }
 }
 
@@ -801,36 +964,140 @@ void SlipPlane::calculateDislocationVelocities (double B)
 }
 
 /**
- * @brief Displaces the dislocations according to their velocities and the time increment.
- * @details This function displaces the dislocations according to the velocities and time increment. If the time increment is smaller than the global time increment, the dislocation moves with this smaller value, effectively moving up to the limiting distance to the next defect and stopping there.
+ * @brief Displaces the dislocations according to their velocities and the time increment, without letting defects cross each other.
+ * @details Each dislocation sweeps the interval between its initial position and the position it would reach at the end of the time step, moving with its velocity for its own time increment if that is smaller than the global time increment. The sweep is replaced by a constant velocity over the global time increment, so that the end points are unchanged when nothing collides. Since the defects are sorted along the slip plane, two defects can only meet if neighbouring defects meet first, so only adjacent pairs whose swept intervals overlap are tested. The earliest contact among these pairs is resolved, the clock is advanced to it and the search is repeated until no contact remains within the time step. A dislocation meeting a dislocation of opposite sign, or a free surface, stops at the point of contact, so that SlipPlane::checkLocalReactions annihilates or absorbs it. All other contacts stop the defects moving toward each other at the minimum distance of approach. The defects and dislocations are finally put back in order with an insertion sort, which costs a single pass when the order is already correct.
  * @param timeIncrement STL vector containing the timeIncrements of all the dislocations.
+ * @param minDistance Minimum distance of approach between defects that do not react with each other.
  */
-void SlipPlane::moveDislocations (std::vector<double> timeIncrement)
+void SlipPlane::moveDislocations (std::vector<double> timeIncrement, double minDistance)
 {
-    std::vector<Dislocation*>::iterator d;
-    std::vector<double>::iterator t;
-    Vector3d p;
+    int nDefects = this->defects.size();
+    int i;
+    int count_disl;
+    Defect* def;
 
-    d = this->dislocations.begin();
-    t = timeIncrement.begin();
+    if (nDefects == 0 || this->dt <= 0.0) {
+        return;
+    }
 
-    while (d != this->dislocations.end())
-    {
-        p = (*d)->getPosition();
-        if (*t <= this->dt)
-        {
-            // Move the dislocation up to the defect and stop it there
-            p += (*d)->getVelocity() * (*t);
+    // Data of the swept intervals
+    std::vector<Dislocation*> dislocationAt(nDefects, NULL);    // Dislocation at each position of the defects vector
+    std::vector<double> tMove(nDefects, 0.0);   // Time for which each dislocation moves, as in the ideal step
+    std::vector<double> x0(nDefects, 0.0);      // Initial positions along the slip plane
+    std::vector<double> v(nDefects, 0.0);       // Velocities, spread over the global time increment
+    std::vector<double> tStop(nDefects, this->dt);  // Time at which each defect stops
+    std::vector<bool> stopped(nDefects, false);
+
+    count_disl = 0;
+    for (i=0; i<nDefects; i++) {
+        def = this->defects[i];
+        x0[i] = def->getPosition().getValue(0);
+        if (def->getDefectType() == DISLOCATION) {
+            dislocationAt[i] = this->dislocations[count_disl];
+            tMove[i] = std::min(timeIncrement[count_disl], this->dt);
+            v[i] = dislocationAt[i]->getVelocity().getValue(0) * tMove[i] / this->dt;
+            count_disl++;
         }
-        else
-        {
-            p += (*d)->getVelocity() * (this->dt);
+        if (v[i] == 0.0) {
+            stopped[i] = true;
         }
-        (*d)->setPosition(p);
+    }
 
-        d++;
-        t++;
+    // Resolve the contacts in chronological order
+    double t = 0.0;
+    double tContact, tPair, gap, closingSpeed, threshold;
+    int iContact;
+    bool reaction, reactionContact;
+    while (true) {
+        tContact = this->dt;
+        iContact = -1;
+        reactionContact = false;
+        for (i=0; i<nDefects-1; i++) {
+            closingSpeed = (stopped[i] ? 0.0 : v[i]) - (stopped[i+1] ? 0.0 : v[i+1]);
+            if (closingSpeed <= 0.0) {
+                // The pair is not closing in
+                continue;
+            }
+            gap = (x0[i+1] + v[i+1]*std::min(t, tStop[i+1])) - (x0[i] + v[i]*std::min(t, tStop[i]));
+            if (gap - (closingSpeed * (this->dt - t)) >= minDistance) {
+                // The swept intervals remain apart
+                continue;
+            }
+            reaction = this->reactsOnContact(this->defects[i], dislocationAt[i], this->defects[i+1], dislocationAt[i+1]);
+            threshold = reaction ? 0.0 : minDistance;
+            tPair = t + std::max(0.0, (gap - threshold) / closingSpeed);
+            if (tPair < tContact) {
+                tContact = tPair;
+                iContact = i;
+                reactionContact = reaction;
+            }
+        }
+
+        if (iContact == -1) {
+            // No more contacts within the time step
+            break;
+        }
+
+        // Advance the clock to the contact and stop the defects concerned, a defect already stopped keeping the time at which it stopped
+        t = tContact;
+        if (!stopped[iContact] && (reactionContact || v[iContact] > 0.0)) {
+            stopped[iContact] = true;
+            tStop[iContact] = t;
+        }
+        if (!stopped[iContact+1] && (reactionContact || v[iContact+1] < 0.0)) {
+            stopped[iContact+1] = true;
+            tStop[iContact+1] = t;
+        }
+    }
+
+    // Displace the dislocations
+    Vector3d p;
+    for (i=0; i<nDefects; i++) {
+        if (dislocationAt[i] == NULL) {
+            continue;
+        }
+        p = dislocationAt[i]->getPosition();
+        if (tStop[i] < this->dt) {
+            // The dislocation stopped at a contact
+            p += dislocationAt[i]->getVelocity() * (tMove[i] * tStop[i] / this->dt);
+        }
+        else {
+            p += dislocationAt[i]->getVelocity() * tMove[i];
+        }
+        this->accumulatePlasticSlip(dislocationAt[i], p.getValue(0) - x0[i]);
+        dislocationAt[i]->setPosition(p);
+    }
+
+    // Restore the order of the defects
+    this->insertionSortDefects();
+}
+
+/**
+ * @brief Indicates whether two adjacent defects react when they come into contact.
+ * @details Dislocations with opposite Burgers vectors annihilate each other, and a dislocation reaching a free surface is absorbed by it. The test on the Burgers vectors is the one used in SlipPlane::dislocation_dislocationInteraction.
+ * @param def0 Pointer to the first defect.
+ * @param disl0 Pointer to the first defect as a dislocation, NULL if it is not a dislocation.
+ * @param def1 Pointer to the second defect.
+ * @param disl1 Pointer to the second defect as a dislocation, NULL if it is not a dislocation.
+ * @return True if the defects react on contact.
+ */
+bool SlipPlane::reactsOnContact (Defect* def0, Dislocation* disl0, Defect* def1, Dislocation* disl1) const
+{
+    if (disl0 != NULL && disl1 != NULL) {
+        Vector3d bt0 = disl0->getBurgers() ^ disl0->getLineVector();
+        Vector3d bt1 = disl1->getBurgers() ^ disl1->getLineVector();
+        return ( (bt0+bt1).magnitude() < SMALL_NUMBER );
+    }
+
+    if (disl0 != NULL) {
+        return (def1->getDefectType() == FREESURFACE);
+    }
+
+    if (disl1 != NULL) {
+        return (def0->getDefectType() == FREESURFACE);
     }
+
+    return (false);
 }
 
 /**
@@ -960,11 +1227,45 @@ void SlipPlane::moveDislocationsToLocalEquilibrium(double minDistance, double dt
     }
 
     // Populate the new positions into the defects
+    count_disl = 0;
     for (pit=newPositions.begin(), dit = this->defects.begin(); pit != newPositions.end(); pit++, dit++) {
+        if ((*dit)->getDefectType() == DISLOCATION) {
+            // Account for the plastic slip
+            disl = this->dislocations[count_disl++];
+            this->accumulatePlasticSlip(disl, pit->getValue(0) - disl->getPosition().getValue(0));
+        }
         (*dit)->setPosition(*pit);
     }
 }
 
+/**
+ * @brief Adds the plastic slip produced by the glide of a dislocation to SlipPlane::plasticSlip.
+ * @details The Burgers vector, of magnitude b, and the line vector of the dislocation are expressed in the local co-ordinate system. The plane swept by the dislocation contains its line and the slip plane direction, so that its normal is n = t \f$\times\f$ x. The slip is the symmetric part of b \f$\otimes\f$ n multiplied by the glide distance.
+ * @param disl Pointer to the dislocation.
+ * @param distance Signed glide distance along the slip plane.
+ */
+void SlipPlane::accumulatePlasticSlip (Dislocation* disl, double distance)
+{
+    if (distance == 0.0) {
+        return;
+    }
+
+    Vector3d b = disl->getBurgers() * disl->getBurgersMagnitude();
+    Vector3d n = disl->getLineVector() ^ Vector3d::unitVector(0);
+    double principal[3];
+    double shear[3];
+
+    principal[0] = b.getValue(0) * n.getValue(0) * distance;
+    principal[1] = b.getValue(1) * n.getValue(1) * distance;
+    principal[2] = b.getValue(2) * n.getValue(2) * distance;
+
+    shear[0] = 0.5 * (b.getValue(0)*n.getValue(1) + b.getValue(1)*n.getValue(0)) * distance;
+    shear[1] = 0.5 * (b.getValue(0)*n.getValue(2) + b.getValue(2)*n.getValue(0)) * distance;
+    shear[2] = 0.5 * (b.getValue(1)*n.getValue(2) + b.getValue(2)*n.getValue(1)) * distance;
+
+    this->plasticSlip += Strain(principal, shear);
+}
+
 // Treat dislocation sources
 /**
  * @brief This function calculates the total stress field acting on each dislocation source lying in the slip plane by superposing contributions from all defects in the simulation, and stores it in the data members Defect::totalStress and Defect::totalStresses.
@@ -973,26 +1274,8 @@ void SlipPlane::moveDislocationsToLocalEquilibrium(double minDistance, double dt
  */
 void SlipPlane::calculateDislocationSourceStresses(double mu, double nu)
 {
-    std::vector<DislocationSource*>::iterator dSource_it;   // Iterator for each dislocation source
-    std::vector<Defect*>::iterator defect_it;               // Iterator for all defects
-    Stress s;                                               // Variable for stress
-
-    DislocationSource *dSource;
-    Defect *defect;
-
-    Vector3d p;                                             // Position vector
-
-    for (dSource_it=this->dislocationSources.begin(); dSource_it!=this->dislocationSources.end(); dSource_it++) {
-        s = this->appliedStress_local;
-        dSource = *dSource_it;
-        p = dSource->getPosition();
-        for (defect_it=this->defects.begin(); defect_it!=this->defects.end(); defect_it++) {
-            defect = *defect_it;
-            // Superpose the stress fields of all other defects
-            s = s + defect->stressField(p, mu, nu);
-        }
-        dSource->setTotalStress(s);
-    }
+    std::vector<Defect*> receivers (this->dislocationSources.begin(), this->dislocationSources.end());
+    this->calculateReceiverStresses(receivers, mu, nu);
 }
 
 /**
@@ -1076,10 +1359,15 @@ void SlipPlane::checkDislocationSources (double timeIncrement, double mu, double
             }
             defectsLyingInBetween.clear();
 
+            // The dipole is equivalent to two dislocations having glided away from the source
+            this->accumulatePlasticSlip(d0, d0->getPosition().getValue(0) - ps.getValue(0));
+            this->accumulatePlasticSlip(d1, d1->getPosition().getValue(0) - ps.getValue(0));
+
             // The new dislocations are created and placed on the slip plane
             // They should now be inserted into the slip plane list
             this->insertDislocation(d0);
             this->insertDislocation(d1);
+            this->nEmissions++;
             // Sort dislocations
             this->sortDislocations();
             // Update defects
@@ -1185,6 +1473,33 @@ void SlipPlane::sortDislocations ()
     std::sort (this->dislocations.begin(), this->dislocations.end(), Defect::compareDefectPositions);
 }
 
+/**
+ * @brief Restores the order of the defects and of the dislocations on the slip plane after a small displacement.
+ * @details An insertion sort is used on both vectors. Its cost is proportional to the number of defects plus the number of pairs out of order, so that a single pass suffices when the order has been preserved. The sort is stable, so that defects at the same position keep their order in both vectors.
+ */
+void SlipPlane::insertionSortDefects ()
+{
+    int i, j;
+
+    Defect* def;
+    for (i=1; i<(int)this->defects.size(); i++) {
+        def = this->defects[i];
+        for (j=i-1; j>=0 && Defect::compareDefectPositions(def, this->defects[j]); j--) {
+            this->defects[j+1] = this->defects[j];
+        }
+        this->defects[j+1] = def;
+    }
+
+    Dislocation* disl;
+    for (i=1; i<(int)this->dislocations.size(); i++) {
+        disl = this->dislocations[i];
+        for (j=i-1; j>=0 && Defect::compareDefectPositions(disl, this->dislocations[j]); j--) {
+            this->dislocations[j+1] = this->dislocations[j];
+        }
+        this->dislocations[j+1] = disl;
+    }
+}
+
 /**
  * @brief Sorts the dislocations on the slip plane in ascending order of distance from the first extremity.
  */
@@ -1207,7 +1522,7 @@ void SlipPlane::calculateSlipPlaneAppliedStress (Stress appliedStress)
 
 /**
  * @brief Calculate the total stress field due to all defects on this slip plane, at a position p.
- * @details All defects in the simulation have a stress field (some of them have zero stress fields). This function superposes the stress fields of all defects lying on the slip plane at a position p provided as argument. Both the position p and the stress field returned are expressed in the base co-ordinate system.
+ * @details All defects in the simulation have a stress field, but only the dislocations have a non-zero one. This function superposes the stress fields of all dislocations lying on the slip plane at a position p provided as argument. Both the position p and the stress field returned are expressed in the base co-ordinate system.
  * @param p Position vector, in the base co-ordinate system, of the point at which the stress field is to be calculated.
  * @param mu Shear modulus (Pa).
  * @param nu Poisson's ratio.
@@ -1219,11 +1534,11 @@ Stress SlipPlane::slipPlaneStressField (Vector3d p, double mu, double nu)
     Vector3d p_local = this->coordinateSystem.vector_BaseToLocal(p);
     // Stress
     Stress s;
-    // Iterator for defects
-    std::vector<Defect*>::iterator dit;
-    Defect *d;
+    // Iterator for dislocations, the other defects having no stress field
+    std::vector<Dislocation*>::iterator dit;
+    Dislocation *d;
 
-    for (dit=this->defects.begin(); dit!=this->defects.end(); dit++) {
+    for (dit=this->dislocations.begin(); dit!=this->dislocations.end(); dit++) {
         d = *dit;
         s += d->stressField(p_local, mu, nu);
     }
@@ -1231,6 +1546,34 @@ Stress SlipPlane::slipPlaneStressField (Vector3d p, double mu, double nu)
     return (this->coordinateSystem.stress_LocalToBase(s));
 }
 
+/**
+ * @brief Calculates the stress field, expressed in the local co-ordinate system, at points along the slip plane.
+ * @details The stress field of every dislocation on the slip plane is superposed to the applied stress at each point, in a single pass over the dislocations. The other defects have no stress field and are skipped. The points are independent of each other and are distributed over threads when OpenMP is available.
+ * @param points STL vector container with position vectors (Vector3d), expressed in the local co-ordinate system, of the points at which the stress field is to be calculated.
+ * @param appliedStress The externally applied stress, expressed in the local co-ordinate system.
+ * @param mu Shear modulus of the material in Pa.
+ * @param nu Poisson's ratio.
+ * @return STL vector container with the full stress tensor, expressed in the local co-ordinate system, at the points provided as input.
+ */
+std::vector<Stress> SlipPlane::calculateStressProfile (const std::vector<Vector3d>& points, Stress appliedStress, double mu, double nu)
+{
+    int nPoints = points.size();
+    int nDisl = this->dislocations.size();
+
+    // Initialize the vector for holding Stress values
+    std::vector<Stress> stressVector(nPoints, appliedStress);
+
+    int i, j;
+#pragma omp parallel for private(j)
+    for (i=0; i<nPoints; i++) {
+        for (j=0; j<nDisl; j++) {
+            stressVector[i] += this->dislocations[j]->stressField(points[i], mu, nu);
+        }
+    }
+
+    return (stressVector);
+}
+
 /**
  * @brief Returns a vector containing the stress values at different points along a slip plane.
  * @details The stress field (expressed in the global co-ordinate system) is calculated at points along the slip plane given as argument. This function only takes into account the dislocations present on itself for calculating the stress field.
@@ -1242,34 +1585,12 @@ Stress SlipPlane::slipPlaneStressField (Vector3d p, double mu, double nu)
  */
 std::vector<Stress> SlipPlane::getSlipPlaneStress_base (std::vector<Vector3d> points, Stress appliedStress, double mu, double nu)
 {
-    // Initialize the vector for holding Stress values
-    std::vector<Stress> stressVector(points.size(), Stress());
-    // Iterator for the stress
-    std::vector<Stress>::iterator s = stressVector.begin();
-
-    // Iterator for the points
-    std::vector<Vector3d>::iterator p = points.begin();
-
-    // Iterator for the defects
-    std::vector<Defect*>::iterator d = this->defects.begin();
-
-
-    // Temporary variable for stress
-    Stress sTemp;
+    std::vector<Stress> stressVector = this->calculateStressProfile(points, this->coordinateSystem.stress_BaseToLocal(appliedStress), mu, nu);
+    std::vector<Stress>::iterator s;
 
-    while (p != points.end())
-    {
-        sTemp = appliedStress;
-
-        while (d != this->defects.end())
-        {
-            sTemp += (*d)->stressField (*p, mu, nu);
-            d++;
-        }
-        *s = sTemp;
-
-        s++;
-        p++;
+    // Convert to the base co-ordinate system
+    for (s=stressVector.begin(); s!=stressVector.end(); s++) {
+        *s = this->coordinateSystem.stress_LocalToBase(*s);
     }
 
     return (stressVector);
@@ -1286,37 +1607,5 @@ std::vector<Stress> SlipPlane::getSlipPlaneStress_base (std::vector<Vector3d> po
  */
 std::vector<Stress> SlipPlane::getSlipPlaneStress_local (std::vector<Vector3d> points, Stress appliedStress, double mu, double nu)
 {
-    // Initialize the vector for holding Stress values
-    std::vector<Stress> stressVector(points.size(), Stress());
-    // Iterator for the stress
-    std::vector<Stress>::iterator s = stressVector.begin();
-
-    // Iterator for the points
-    std::vector<Vector3d>::iterator p = points.begin();
-
-    // Iterator for the defects
-    std::vector<Defect*>::iterator d = this->defects.begin();
-
-
-    // Temporary variable for stress
-    Stress sTemp;
-
-    while (p != points.end())
-    {
-        sTemp = appliedStress;
-
-        while (d != this->defects.end())
-        {
-            sTemp += (*d)->stressField (*p, mu, nu);
-            d++;
-        }
-
-        // Convert to local co-ordinate system
-        *s = this->coordinateSystem.stress_BaseToLocal(sTemp);
-
-        s++;
-        p++;
-    }
-
-    return (stressVector);
+    return (this->calculateStressProfile(points, this->coordinateSystem.stress_BaseToLocal(appliedStress), mu, nu));
 }
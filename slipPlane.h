@@ -49,6 +49,9 @@
 // Parameters
 #include "parameter.h"
 
+// Text output
+#include "textWriter.h"
+
 // Co-ordinate system
 #include "coordinatesystem.h"
 
@@ -127,6 +130,46 @@ protected:
    * @brief The slip plane's own co-ordinate system.
    */
   CoordinateSystem coordinateSystem;
+
+  /**
+   * @brief Plastic slip accumulated on the slip plane, expressed in the local co-ordinate system.
+   * @details Sum over all displacements of the dislocations of the symmetric part of b \f$\otimes\f$ n multiplied by the glide distance, where n is the normal to the plane swept by the dislocation. Divided by the area of the grain, it gives the plastic strain carried by the slip plane.
+   */
+  Strain plasticSlip;
+
+  /**
+   * @brief Number of dislocation dipoles emitted by the sources of the slip plane since the beginning of the simulation.
+   */
+  int nEmissions;
+
+  /**
+   * @brief Number of pairs of dislocations annihilated on the slip plane since the beginning of the simulation.
+   */
+  int nAnnihilations;
+
+  /**
+   * @brief Number of dislocations absorbed by the free surfaces of the slip plane since the beginning of the simulation.
+   */
+  int nAbsorptions;
+
+  /**
+   * @brief Distance from a free surface extremity within which the image force acts on the dislocations. A value of zero or less disables the image forces.
+   */
+  double imageForceCutoff;
+
+  /**
+   * @brief Flag indicating whether the total stress is calculated on all defects, instead of only on the mobile dislocations and the dislocation sources.
+   */
+  bool stressOnAllDefects;
+
+  /**
+   * @brief Calculates the total stress on each defect of a list, in a single pass over the dislocations of the slip plane.
+   * @details The defects are treated in groups of SLIPPLANE_RECEIVER_TILE, and the stress fields of all dislocations are superposed at all defects of a group before moving to the next group, so that the data of each dislocation is loaded once per group. The other defects have no stress field and are skipped. The applied stress is added to the result.
+   * @param receivers The defects on which the stress is calculated. They must lie on the slip plane.
+   * @param mu Shear modulus of the material.
+   * @param nu Poisson's ratio.
+   */
+  void calculateReceiverStresses (const std::vector<Defect*>& receivers, double mu, double nu);
   
 public:
   // Constructors
@@ -160,6 +203,26 @@ public:
    * @param ends Pointer to an array of type Vector3d, containing the position vectors of the extremities of the slip plane in consecutive locations.
    */
   void setExtremities (Vector3d *ends);
+
+  /**
+   * @brief Set the type of defect represented by the extremities of the slip plane.
+   * @details The extremities are grain boundaries when they are created. Setting them to FREESURFACE makes them absorb the dislocations reaching them and exert image forces on the dislocations close to them.
+   * @param t The type of defect of both extremities.
+   */
+  void setExtremityType (DefectType t);
+
+  /**
+   * @brief Set the distance from a free surface extremity within which the image force acts on the dislocations.
+   * @param cutoff The cut-off distance. A value of zero or less disables the image forces.
+   */
+  void setImageForceCutoff (double cutoff);
+
+  /**
+   * @brief Set whether the total stress is calculated on all defects.
+   * @details By default, the total stress is only calculated on the mobile dislocations and on the dislocation sources, which are the only defects that use it. An output that needs the stress on the extremities or on the pinned dislocations should enable it.
+   * @param allDefects Flag indicating whether the total stress is calculated on all defects.
+   */
+  void setStressOnAllDefects (bool allDefects);
   
   /**
    * @brief Set the normal vector of the slip plane.
@@ -262,9 +325,10 @@ public:
 
   /**
    * @brief Get the entire vector container which holds the pointers to all the defects
-   * @return The vector of the defects lying on the slip plane.
+   * @details The reference remains valid as long as the slip plane exists, but the contents change when the defect list is updated.
+   * @return Reference to the vector of the defects lying on the slip plane.
    */
-  std::vector<Defect*> getDefectList ();
+  const std::vector<Defect*>& getDefectList () const;
 
   /**
    * @brief Return the positions of all the defects, expressed in the slip plane base co-ordinate system.
@@ -278,6 +342,20 @@ public:
    */
   std::vector<Vector3d> getAllDefectPositions_local ();
 
+  /**
+   * @brief Get the defects on which the total stress is calculated.
+   * @details These are the mobile dislocations and the dislocation sources, or all defects if SlipPlane::setStressOnAllDefects has been enabled.
+   * @return The vector of the defects on which the total stress is calculated.
+   */
+  std::vector<Defect*> getStressReceivers ();
+
+  /**
+   * @brief Return the positions of the defects on which the total stress is calculated, expressed in the slip plane base co-ordinate system.
+   * @param receivers The defects, as returned by SlipPlane::getStressReceivers.
+   * @return STL vector container with the position vectors of the defects, expressed in the slip plane base co-ordinate system.
+   */
+  std::vector<Vector3d> getStressReceiverPositions_base (const std::vector<Defect*>& receivers);
+
   /**
    * @brief Return the number of defects lying in the slip plane.
    * @return The number of defects lying in the slip plane.
@@ -286,15 +364,41 @@ public:
   
   /**
    * @brief Get the entire vector container which holds the dislocations lying on this slip plane.
-   * @return The vector of dislocations lying on this slip plane.
+   * @details The reference remains valid as long as the slip plane exists, but the contents change when dislocations are inserted or removed.
+   * @return Reference to the vector of dislocations lying on this slip plane.
    */
-  std::vector<Dislocation*> getDislocationList ();
+  const std::vector<Dislocation*>& getDislocationList () const;
 
   /**
    * @brief Get the number of dislocations.
    * @return The number of dislocations on the slip plane.
    */
   int getNumDislocations () const;
+
+  /**
+   * @brief Get the plastic slip accumulated on the slip plane.
+   * @details The plastic slip is the sum over all displacements of the dislocations of the symmetric part of b \f$\otimes\f$ n multiplied by the glide distance. Divided by the area of the grain, it gives the plastic strain.
+   * @return The plastic slip, expressed in the local co-ordinate system.
+   */
+  Strain getPlasticSlip () const;
+
+  /**
+   * @brief Get the number of dislocation dipoles emitted on the slip plane since the beginning of the simulation.
+   * @return The number of emissions.
+   */
+  int getNumEmissions () const;
+
+  /**
+   * @brief Get the number of pairs of dislocations annihilated on the slip plane since the beginning of the simulation.
+   * @return The number of annihilations.
+   */
+  int getNumAnnihilations () const;
+
+  /**
+   * @brief Get the number of dislocations absorbed by the free surfaces of the slip plane since the beginning of the simulation.
+   * @return The number of absorptions.
+   */
+  int getNumAbsorptions () const;
   
   /**
    * @brief Get the dislocation source on the slip plane indicated by the index provided as argument.
@@ -313,9 +417,10 @@ public:
   
   /**
    * @brief Get the entire vector container which holds the dislocation sources lying on this slip plane.
-   * @return The vector of dislocation sources lying on this slip plane.
+   * @details The reference remains valid as long as the slip plane exists, but the contents change when dislocation sources are inserted or removed.
+   * @return Reference to the vector of dislocation sources lying on this slip plane.
    */
-  std::vector<DislocationSource *> getDislocationSourceList() const;
+  const std::vector<DislocationSource *>& getDislocationSourceList() const;
   
   /**
    * @brief Get the rotation matrix for this slip plane.
@@ -418,6 +523,12 @@ public:
    */
   void sortDislocations ();
 
+  /**
+   * @brief Restores the order of the defects and of the dislocations on the slip plane after a small displacement.
+   * @details An insertion sort is used on both vectors, so that a single pass suffices when the order has been preserved.
+   */
+  void insertionSortDefects ();
+
   /**
    * @brief Sorts the dislocations on the slip plane in ascending order of distance from the first extremity.
    */
@@ -426,7 +537,7 @@ public:
   // Stress field
   /**
    * @brief Calculate the total stress field due to all defects on this slip plane, at a position p.
-   * @details All defects in the simulation have a stress field (some of them have zero stress fields). This function superposes the stress fields of all defects lying on the slip plane at a position p provided as argument. Both the position p and the stress field returned are expressed in the base co-ordinate system.
+   * @details All defects in the simulation have a stress field, but only the dislocations have a non-zero one. This function superposes the stress fields of all dislocations lying on the slip plane at a position p provided as argument. Both the position p and the stress field returned are expressed in the base co-ordinate system.
    * @param p Position vector, in the base co-ordinate system, of the point at which the stress field is to be calculated.
    * @param mu Shear modulus (Pa).
    * @param nu Poisson's ratio.
@@ -436,7 +547,8 @@ public:
 
   // Treat defects
   /**
-   * @brief This function calculates the total stress fields on all defects lying on the slip plane and stores the stress field tensors in the members Defect::totalStress and Defect::totalStresses.
+   * @brief This function calculates the total stress fields on the defects lying on the slip plane and stores the stress field tensors in the members Defect::totalStress and Defect::totalStresses.
+   * @details The mobile dislocations and the dislocation sources are treated together in a single pass, given by SlipPlane::calculateReceiverStresses. The extremities and the pinned dislocations are skipped unless SlipPlane::setStressOnAllDefects has been enabled.
    * @param mu Shear modulus of the material.
    * @param nu Poisson's ratio.
    */
@@ -462,9 +574,11 @@ public:
 
   /**
    * @brief This function calculates the Peach-Koehler force experienced by each dislocation and stores it in Dislocation::force and puts it at the end of std::vector<Vector3d> Dislocation::forces.
-   * @details This function calculates the Peach-Koehler force experienced by each dislocation using the function Dislocation::forcePeachKoehler and the variable Stress Dislocation::totalStress.
+   * @details This function calculates the Peach-Koehler force experienced by each dislocation using the function Dislocation::forcePeachKoehler and the variable Stress Dislocation::totalStress. The dislocations lying within SlipPlane::imageForceCutoff of an extremity that is a free surface also experience the image force of that surface, given by Dislocation::imageForce.
+   * @param mu Shear modulus of the material.
+   * @param nu Poisson's ratio.
    */
-  void calculateDislocationForces ();
+  void calculateDislocationForces (double mu, double nu);
 
   /**
    * @brief Calculates the velocities of dislocations and stores them in the variable Vector3d Dislocation::velocity and also puts it at the end of std::vector<Vector3d> Dislocation::velocities.
@@ -474,11 +588,23 @@ public:
   void calculateDislocationVelocities (double B);
 
   /**
-   * @brief Displaces the dislocations according to their velocities and the time increment.
-   * @details This function displaces the dislocations according to the velocities and time increment. If the time increment is smaller than the global time increment, the dislocation moves with this smaller value, effectively moving up to the limiting distance to the next defect and stopping there.
+   * @brief Displaces the dislocations according to their velocities and the time increment, without letting defects cross each other.
+   * @details Each dislocation sweeps the interval between its initial position and the position it would reach at the end of the time step, moving with its velocity for its own time increment if that is smaller than the global time increment. Contacts between adjacent defects whose swept intervals overlap are resolved in chronological order. A dislocation meeting a dislocation of opposite sign, or a free surface, stops at the point of contact, so that SlipPlane::checkLocalReactions annihilates or absorbs it. All other contacts stop the defects moving toward each other at the minimum distance of approach. The order of the defects is then restored with SlipPlane::insertionSortDefects.
    * @param timeIncrement STL vector containing the timeIncrements of all the dislocations.
+   * @param minDistance Minimum distance of approach between defects that do not react with each other.
+   */
+  void moveDislocations (std::vector<double> timeIncrement, double minDistance);
+
+  /**
+   * @brief Indicates whether two adjacent defects react when they come into contact.
+   * @details Dislocations with opposite Burgers vectors annihilate each other, and a dislocation reaching a free surface is absorbed by it.
+   * @param def0 Pointer to the first defect.
+   * @param disl0 Pointer to the first defect as a dislocation, NULL if it is not a dislocation.
+   * @param def1 Pointer to the second defect.
+   * @param disl1 Pointer to the second defect as a dislocation, NULL if it is not a dislocation.
+   * @return True if the defects react on contact.
    */
-  void moveDislocations (std::vector<double> timeIncrement);
+  bool reactsOnContact (Defect* def0, Dislocation* disl0, Defect* def1, Dislocation* disl1) const;
 
   /**
    * @brief Function to move dislocations to local a equilibrium position.
@@ -490,6 +616,14 @@ public:
    */
   void moveDislocationsToLocalEquilibrium(double minDistance, double dtGlobal, double mu, double nu);
 
+  /**
+   * @brief Adds the plastic slip produced by the glide of a dislocation to SlipPlane::plasticSlip.
+   * @details The Burgers vector, of magnitude b, and the line vector of the dislocation are expressed in the local co-ordinate system. The plane swept by the dislocation contains its line and the slip plane direction, so that its normal is n = t \f$\times\f$ x. The slip is the symmetric part of b \f$\otimes\f$ n multiplied by the glide distance.
+   * @param disl Pointer to the dislocation.
+   * @param distance Signed glide distance along the slip plane.
+   */
+  void accumulatePlasticSlip (Dislocation* disl, double distance);
+
   // Treat dislocation sources
   /**
    * @brief This function calculates the total stress field acting on each dislocation source lying in the slip plane by superposing contributions from all defects in the simulation, and stores it in the data members Defect::totalStress and Defect::totalStresses.
@@ -585,6 +719,17 @@ public:
    */
   std::vector<Stress> getSlipPlaneStress_base (std::vector<Vector3d> points, Stress appliedStress, double mu, double nu);
 
+  /**
+   * @brief Calculates the stress field, expressed in the local co-ordinate system, at points along the slip plane.
+   * @details The stress field of every dislocation on the slip plane is superposed to the applied stress at each point, in a single pass over the dislocations. The points are distributed over threads when OpenMP is available.
+   * @param points STL vector container with position vectors (Vector3d), expressed in the local co-ordinate system, of the points at which the stress field is to be calculated.
+   * @param appliedStress The externally applied stress, expressed in the local co-ordinate system.
+   * @param mu Shear modulus of the material in Pa.
+   * @param nu Poisson's ratio.
+   * @return STL vector container with the full stress tensor, expressed in the local co-ordinate system, at the points provided as input.
+   */
+  std::vector<Stress> calculateStressProfile (const std::vector<Vector3d>& points, Stress appliedStress, double mu, double nu);
+
   /**
    * @brief Returns a vector containing the stress values at different points along a slip plane.
    * @details The stress field (expressed in the local co-ordinate system) is calculated at points along the slip plane given as argument. This function only takes into account the dislocations present on itself for calculating the stress field.
@@ -604,6 +749,13 @@ public:
    * @param totalTime The value of time at this point.
    */
   void writeSlipPlane (std::string filename, double totalTime);
+
+  /**
+   * @brief Writes the attributes of the slip plane and all defects lying on it to a text writer.
+   * @param fp The writer into which the attributes are to be written.
+   * @param totalTime The value of time at this point.
+   */
+  void writeSlipPlane (TextWriter& fp, double totalTime);
   
   /**
    * @brief Writes the stress distribution of stresses (in the slip plane's local co-ordinate system) along the slip plane with the given resolution.
@@ -614,6 +766,15 @@ public:
    */
   void writeSlipPlaneStressDistribution (std::string filename, int resolution, Parameter *param);
 
+  /**
+   * @brief Writes the stress distribution along the slip plane with the given resolution to a text writer.
+   * @details The rows are those of the file written by SlipPlane::writeSlipPlaneStressDistribution. Nothing is written if the resolution is smaller than 2.
+   * @param fp The writer into which the data is to be written.
+   * @param resolution The number of points at which the stress field is to be calculated.
+   * @param param Pointer to the instance of the parameter class which contains all the simulation parameters.
+   */
+  void writeSlipPlaneStressDistribution (TextWriter& fp, int resolution, Parameter *param);
+
   /**
    * @brief Writes out the current time and the positions of all difects lying on the slip plane.
    * @details This function writes out, in a row, the time and the positions of all defects along the slip plane x-axis at that time. The function will be called several times during a simulation, so the file must be opened in append mode and the function should insert a newline after each entry.
@@ -621,6 +782,21 @@ public:
    * @param t Value of time.
    */
   void writeAllDefects (std::string filename, double t);
+
+  /**
+   * @brief Get the length of the slip plane.
+   * @return The distance between the two extremities of the slip plane.
+   */
+  double getLength () const;
+
+  /**
+   * @brief Finds the pile-up of dislocations against the extremity whose index is provided as argument.
+   * @details The pile-up is the uninterrupted sequence of dislocations of the same sign starting next to the extremity. Its length is the distance from the extremity to the last dislocation of the sequence.
+   * @param n Index of the extremity. Possible values: 0, 1
+   * @param nDislocations Reference to the variable receiving the number of dislocations in the pile-up.
+   * @param length Reference to the variable receiving the length of the pile-up.
+   */
+  void findPileUp (int n, int& nDislocations, double& length);
 };
 
 #endif
@@ -108,4 +108,19 @@
  */
 #define MEAN_NUM_SLIPPLANES_PER_SLIPSYSTEM 10
 
+/**
+ * @brief Number of points of a stress profile along the slip plane that are evaluated together before being written to file.
+ */
+#define SLIPPLANE_STRESS_PROFILE_BLOCK 256
+
+/**
+ * @brief Number of defects whose stress is calculated together, so that the data of each dislocation is loaded once per group.
+ */
+#define SLIPPLANE_RECEIVER_TILE 64
+
+/**
+ * @brief Default distance from a free surface within which the image force acts on the dislocations, in units of the magnitude of the Burgers vector.
+ */
+#define SLIPPLANE_DEFAULT_IMAGEFORCE_CUTOFF 1000.0
+
 #endif
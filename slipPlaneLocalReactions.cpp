@@ -168,6 +168,7 @@ std::vector<Defect*>::iterator SlipPlane::absorbDislocation (std::vector<Defect*
     Dislocation* dislocation = *dislocation_iterator;
     delete (dislocation);
     this->dislocations.erase( dislocation_iterator );
+    this->nAbsorptions++;
     return ( this->defects.erase(disl) );
 }
 
@@ -205,6 +206,7 @@ std::vector<Defect*>::iterator SlipPlane::dislocation_dislocationInteraction (st
         delete (dislocation1);
         dislocation1 = NULL;
         this->dislocations.erase(dislocation0_iterator, dislocation1_iterator+1);
+        this->nAnnihilations++;
         return (this->defects.erase(d0,d1+1));
     }
     else {
@@ -39,11 +39,24 @@
  */
 void SlipPlane::writeSlipPlane (std::string filename, double totalTime)
 {
-    std::ofstream fp ( filename.c_str() );
-    if ( !fp.is_open() ) {
+    TextWriter fp;
+    if ( !fp.open ( filename, false ) ) {
         return;
     }
 
+    this->writeSlipPlane ( fp, totalTime );
+
+    // Close the file
+    fp.close ();
+}
+
+/**
+ * @brief Writes the attributes of the slip plane and all defects lying on it to a text writer.
+ * @param fp The writer into which the attributes are to be written.
+ * @param totalTime The value of time at this point.
+ */
+void SlipPlane::writeSlipPlane (TextWriter& fp, double totalTime)
+{
     int i, j, nDisl, nDislSources;
     Vector3d v;
     Dislocation *d;
@@ -51,7 +64,7 @@ void SlipPlane::writeSlipPlane (std::string filename, double totalTime)
 
     // Total time
     fp << "# Current time\n";
-    fp << totalTime << std::endl;
+    fp << totalTime << "\n";
 
     // Extremities
     fp << "# Extremities\n";
@@ -59,12 +72,12 @@ void SlipPlane::writeSlipPlane (std::string filename, double totalTime)
     for ( i=0; i<3; i++ ) {
         fp << v.getValue ( i ) << " ";
     }
-    fp << std::endl;
+    fp << "\n";
     v = this->getExtremity ( 1 );
     for ( i=0; i<3; i++ ) {
         fp << v.getValue ( i ) << " ";
     }
-    fp << std::endl;
+    fp << "\n";
 
     // Normal vector
     fp << "# Normal vector\n";
@@ -72,7 +85,7 @@ void SlipPlane::writeSlipPlane (std::string filename, double totalTime)
     for ( i=0; i<3; i++ ) {
         fp << v.getValue ( i ) << " ";
     }
-    fp << std::endl;
+    fp << "\n";
 
     // Position
     fp << "# Position\n";
@@ -80,12 +93,12 @@ void SlipPlane::writeSlipPlane (std::string filename, double totalTime)
     for ( i=0; i<3; i++ ) {
         fp << v.getValue ( i ) << " ";
     }
-    fp << std::endl;
+    fp << "\n";
 
     // Dislocations
     nDisl = this->getNumDislocations ();
-    fp << "# Number of dislocations" << std::endl << nDisl << std::endl;
-    fp << "# Dislocations" << std::endl << "# Position(3) BurgersVector(3) LineVector(3) BurgersMagnitude(1) Mobile(1)" << std::endl;
+    fp << "# Number of dislocations" << "\n" << nDisl << "\n";
+    fp << "# Dislocations" << "\n" << "# Position(3) BurgersVector(3) LineVector(3) BurgersMagnitude(1) Mobile(1)" << "\n";
     for ( i=0; i<nDisl; i++ ) {
         d = new Dislocation;
         if ( this->getDislocation ( i, d ) ) {
@@ -102,7 +115,7 @@ void SlipPlane::writeSlipPlane (std::string filename, double totalTime)
                 fp << v.getValue ( j ) << " ";
             }
             fp << d->getBurgersMagnitude () << " ";
-            fp << ( int ) d->isMobile () << std::endl;
+            fp << ( int ) d->isMobile () << "\n";
         }
         delete ( d );
         d = NULL;
@@ -110,8 +123,8 @@ void SlipPlane::writeSlipPlane (std::string filename, double totalTime)
 
     // Dislocation sources
     nDislSources = this->getNumDislocationSources ();
-    fp << "# Number of dislocation sources" << std::endl << nDislSources << std::endl;
-    fp << "# Dislocation sources" << std::endl << "# Position(3) BurgersVector(3) LineVector(3) BurgersMagnitude(1) Tau_nuc(1) t_nuc(1)" << std::endl;
+    fp << "# Number of dislocation sources" << "\n" << nDislSources << "\n";
+    fp << "# Dislocation sources" << "\n" << "# Position(3) BurgersVector(3) LineVector(3) BurgersMagnitude(1) Tau_nuc(1) t_nuc(1)" << "\n";
     for ( i=0; i<nDislSources; i++ ) {
         dSource = new DislocationSource;
         if ( this->getDislocationSource ( i, dSource ) ) {
@@ -129,61 +142,83 @@ void SlipPlane::writeSlipPlane (std::string filename, double totalTime)
             }
             fp << dSource->getBurgersMag () << " ";
             fp << dSource->getTauCritical () << " ";
-            fp << dSource->getTimeTillEmit () << std::endl;
+            fp << dSource->getTimeTillEmit () << "\n";
         }
         delete ( dSource );
         dSource = NULL;
     }
-
-    // Close the file
-    fp.close ();
 }
 
 /**
  * @brief Writes the stress distribution of stresses (in the slip plane's local co-ordinate system) along the slip plane with the given resolution.
- * @details This function writes out the distribution of stresses (in the slip plane's local co-ordinate system) along the slip plane, with the given resolution. The stress fields of all dislocations and the externally applied stress are all superposed points along the slip plane, and then the stress tensor at this point is transformed to the one in the slip plane's local co-ordinate system to obtain the final stress. The points where the stress is calculated are chosen according to the argument resolution, which provides the number of equally spaced points along the slip plane where the stress field is to be calculated. The output file contains the following information in each row: PointPosition(3) LocalStresses(s_xx s_yy s_zz s_xy s_xz s_yz) GlobalStresses(s_xx s_yy s_zz s_xy s_xz s_yz).
+ * @details This function writes out the distribution of stresses (in the slip plane's local co-ordinate system) along the slip plane, with the given resolution. The stress fields of all dislocations and the externally applied stress are all superposed points along the slip plane, and then the stress tensor at this point is transformed to the one in the slip plane's base co-ordinate system. Both tensors come from the same evaluation by SlipPlane::calculateStressProfile. The points where the stress is calculated are chosen according to the argument resolution, which provides the number of equally spaced points along the slip plane where the stress field is to be calculated. They are evaluated and written in blocks of SLIPPLANE_STRESS_PROFILE_BLOCK points. The output file contains the following information in each row: PointPosition(3) LocalStresses(s_xx s_yy s_zz s_xy s_xz s_yz) GlobalStresses(s_xx s_yy s_zz s_xy s_xz s_yz).
  * @param filename The name of the file into which the data is to be written.
  * @param resolution The number of points at which the stress field is to be calculated.
  * @param param Pointer to the instance of the parameter class which contains all the simulation parameters.
  */
 void SlipPlane::writeSlipPlaneStressDistribution (std::string filename, int resolution, Parameter *param)
 {
-    std::ofstream fp ( filename.c_str() );
-    if ( !fp.is_open() ) {
+    if ( resolution < 2 ) {
+        // At least both extremities are needed
+        return;
+    }
+
+    TextWriter fp;
+    if ( !fp.open ( filename, false ) ) {
+        return;
+    }
+
+    this->writeSlipPlaneStressDistribution ( fp, resolution, param );
+
+    fp.close ();
+}
+
+/**
+ * @brief Writes the stress distribution along the slip plane with the given resolution to a text writer.
+ * @details The rows are those of the file written by SlipPlane::writeSlipPlaneStressDistribution. Nothing is written if the resolution is smaller than 2.
+ * @param fp The writer into which the data is to be written.
+ * @param resolution The number of points at which the stress field is to be calculated.
+ * @param param Pointer to the instance of the parameter class which contains all the simulation parameters.
+ */
+void SlipPlane::writeSlipPlaneStressDistribution (TextWriter& fp, int resolution, Parameter *param)
+{
+    if ( resolution < 2 ) {
+        // At least both extremities are needed
         return;
     }
 
-    // Create the vector of points
-    std::vector<Vector3d> points;
     Vector3d p0 = this->getExtremity ( 0 );
     Vector3d p1 = this->getExtremity ( 1 );
     Vector3d segment = ( p1 - p0 ) * ( 1.0 / ( resolution - 1 ) );
-    Vector3d p;
-    int i, j;
 
-    p = p0;
-    for ( i=1; i<=resolution; i++ ) {
-        points.push_back ( p );
-        p += segment;
-    }
+    std::vector<Vector3d> points;
+    std::vector<Stress> stressLocal;
+    Stress stressGlobal;
+    int i, j, k;
 
-    std::vector<Stress> stressLocal  = this->getSlipPlaneStress_local  ( points, this->appliedStress_local, param->mu, param->nu );
-    std::vector<Stress> stressGlobal = this->getSlipPlaneStress_base ( points, this->appliedStress_base, param->mu, param->nu );
+    for ( i=0; i<resolution; i+=SLIPPLANE_STRESS_PROFILE_BLOCK ) {
+        // Create the block of points
+        points.clear ();
+        for ( k=i; k<resolution && k<i+SLIPPLANE_STRESS_PROFILE_BLOCK; k++ ) {
+            points.push_back ( p0 + ( segment * k ) );
+        }
+
+        stressLocal = this->calculateStressProfile ( points, this->appliedStress_local, param->mu, param->nu );
 
-    for ( i=0; i<resolution; i++ ) {
-        // Position
-        for ( j=0; j<3; j++ ) {
-            fp << points[i].getValue ( j ) << " ";
+        for ( k=0; k<(int)points.size(); k++ ) {
+            stressGlobal = this->coordinateSystem.stress_LocalToBase ( stressLocal[k] );
+            // Position
+            for ( j=0; j<3; j++ ) {
+                fp << points[k].getValue ( j ) << " ";
+            }
+            // Local stresses
+            fp << stressLocal[k].getValue(0,0) << " " << stressLocal[k].getValue(1,1) << " " << stressLocal[k].getValue(2,2) << " "
+               << stressLocal[k].getValue(0,1) << " " << stressLocal[k].getValue(0,2) << " " << stressLocal[k].getValue(1,2) << " ";
+            // Global stresses
+            fp << stressGlobal.getValue(0,0) << " " << stressGlobal.getValue(1,1) << " " << stressGlobal.getValue(2,2) << " "
+               << stressGlobal.getValue(0,1) << " " << stressGlobal.getValue(0,2) << " " << stressGlobal.getValue(1,2) << "\n";
         }
-        // Local stresses
-        fp << stressLocal[i].getValue(0,0) << " " << stressLocal[i].getValue(1,1) << " " << stressLocal[i].getValue(2,2) << " "
-           << stressLocal[i].getValue(0,1) << " " << stressLocal[i].getValue(0,2) << " " << stressLocal[i].getValue(1,2) << " ";
-        // Global stresses
-        fp << stressGlobal[i].getValue(0,0) << " " << stressGlobal[i].getValue(1,1) << " " << stressGlobal[i].getValue(2,2) << " "
-           << stressGlobal[i].getValue(0,1) << " " << stressGlobal[i].getValue(0,2) << " " << stressGlobal[i].getValue(1,2) << std::endl;
     }
-
-    fp.close ();
 }
 
 /**
@@ -194,20 +229,73 @@ void SlipPlane::writeSlipPlaneStressDistribution (std::string filename, int reso
  */
 void SlipPlane::writeAllDefects (std::string filename, double t)
 {
-    std::ofstream fp (filename.c_str(), std::ios_base::app);
+    TextWriter* fp = TextWriter::get(filename);
     int nDefects, i;
     Defect* def;
     Vector3d p;
 
-    if (fp.is_open()) {
+    if (fp != NULL) {
         nDefects = this->getNumDefects();
-        fp << t << " ";
+        *fp << t << " ";
         for (i=0; i<nDefects; i++) {
             def = this->defects.at(i);
             p = def->getPosition();
-            fp << p.getValue(0) << " ";
+            *fp << p.getValue(0) << " ";
+        }
+        fp->endLine();
+    }
+}
+
+/**
+ * @brief Get the length of the slip plane.
+ * @return The distance between the two extremities of the slip plane.
+ */
+double SlipPlane::getLength () const
+{
+    return ( (this->getExtremity(1) - this->getExtremity(0)).magnitude() );
+}
+
+/**
+ * @brief Finds the pile-up of dislocations against the extremity whose index is provided as argument.
+ * @details The pile-up is the uninterrupted sequence of dislocations of the same sign starting next to the extremity. Its length is the distance from the extremity to the last dislocation of the sequence.
+ * @param n Index of the extremity. Possible values: 0, 1
+ * @param nDislocations Reference to the variable receiving the number of dislocations in the pile-up.
+ * @param length Reference to the variable receiving the length of the pile-up.
+ */
+void SlipPlane::findPileUp (int n, int& nDislocations, double& length)
+{
+    int nDefects = this->defects.size();
+    int nDisl = this->dislocations.size();
+    int step = (n == 0) ? 1 : -1;   // Direction in which the defects are browsed
+    int i, k;
+
+    Vector3d pExtremity = this->getExtremity(n);
+    Dislocation* disl;
+    Vector3d bt, bt0;
+
+    nDislocations = 0;
+    length = 0.0;
+
+    // Browse the defects starting next to the extremity
+    i = (n == 0) ? 1 : (nDefects - 2);
+    k = 0;
+    while (i > 0 && i < nDefects-1) {
+        if (this->defects[i]->getDefectType() != DISLOCATION) {
+            // The pile-up is interrupted
+            break;
+        }
+        disl = (n == 0) ? this->dislocations[k] : this->dislocations[nDisl-1-k];
+        bt = disl->getBurgers() ^ disl->getLineVector();
+        if (nDislocations == 0) {
+            bt0 = bt;
+        }
+        else if ( (bt-bt0).magnitude() >= SMALL_NUMBER ) {
+            // Dislocation of another sign
+            break;
         }
-        fp << std::endl;
-        fp.close();
+        nDislocations++;
+        length = (disl->getPosition() - pExtremity).magnitude();
+        i += step;
+        k++;
     }
 }
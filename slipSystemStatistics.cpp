@@ -38,7 +38,7 @@
  */
 void SlipSystem::writeAllDefects (std::string fileName, double t)
 {
-    std::ofstream fp (fileName.c_str(), std::ios_base::app);
+    TextWriter* fp = TextWriter::get(fileName);
 
     std::vector<Vector3d> defectPositions;
     std::vector<Vector3d>::iterator defectPositions_it;
@@ -47,8 +47,8 @@ void SlipSystem::writeAllDefects (std::string fileName, double t)
     std::vector<SlipPlane*>::iterator slipPlane_it;
     SlipPlane* slipPlane;
 
-    if (fp.is_open()) {
-        fp << t << " ";
+    if (fp != NULL) {
+        *fp << t << " ";
         slipPlane_it=this->slipPlanes.begin ();
         while (slipPlane_it!=this->slipPlanes.end()) {
             slipPlane = *slipPlane_it;
@@ -56,12 +56,30 @@ void SlipSystem::writeAllDefects (std::string fileName, double t)
             defectPositions_it = defectPositions.begin();
             while (defectPositions_it!=defectPositions.end()) {
                 defectPosition = *defectPositions_it;
-                fp << defectPosition.getValue(0) << " " << defectPosition.getValue(1) << defectPosition.getValue(2) << " ";
+                *fp << defectPosition.getValue(0) << " " << defectPosition.getValue(1) << defectPosition.getValue(2) << " ";
                 defectPositions_it++;
             }
             slipPlane_it++;
         }
-        fp << std::endl;
+        fp->endLine();
+    }
+}
+
+/**
+ * @brief Writes out the current time and the relative deviation of the stress field obtained with the kernel tables from the exact double precision stress field.
+ * @details The deviation is calculated by SlipSystem::checkKernelPrecision. The file is opened in append mode and a newline is inserted after each entry.
+ * @param fileName Name of the file into which the data is to be written.
+ * @param t Value of time.
+ * @param mu Shear modulus (Pa).
+ * @param nu Poisson's ratio.
+ */
+void SlipSystem::writeKernelPrecision (std::string fileName, double t, double mu, double nu)
+{
+    std::ofstream fp (fileName.c_str(), std::ios_base::app);
+
+    if (fp.is_open()) {
+        this->prepareKernelTables(mu, nu);
+        fp << t << " " << this->checkKernelPrecision(mu, nu) << std::endl;
         fp.close();
     }
 }
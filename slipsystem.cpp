@@ -39,6 +39,8 @@ SlipSystem::SlipSystem()
     this->slipPlaneNormal = Vector3d(DEFAULT_SLIPPLANE_NORMALVECTOR_0,
                                      DEFAULT_SLIPPLANE_NORMALVECTOR_1,
                                      DEFAULT_SLIPPLANE_NORMALVECTOR_2);
+    this->useKernelTables = false;
+    this->kernelAxisTolerance = 0.0;
 }
 
 /**
@@ -64,6 +66,10 @@ SlipSystem::SlipSystem(Vector3d pos, Vector3d normal, Vector3d direction, Coordi
 
     // Refresh the rotation matrices of the slip planes
     this->setSlipPlaneCoordinateSystems();
+
+    // Kernel tables are off unless requested
+    this->useKernelTables = false;
+    this->kernelAxisTolerance = 0.0;
 }
 
 // Destructor
@@ -185,6 +191,49 @@ void SlipSystem::setTimeIncrement (double t)
     this->dt = t;
 }
 
+/**
+ * @brief Set whether the stress field due to dislocations on other slip planes is to be interpolated from kernel tables.
+ * @param useTables Flag indicating whether the kernel tables are to be used.
+ * @param tolerance Maximum interpolation error, relative to the peak value of each kernel.
+ * @param singlePrecision Flag indicating whether the interpolation is to be carried out in single precision.
+ */
+void SlipSystem::setKernelTables (bool useTables, double tolerance, bool singlePrecision)
+{
+    this->useKernelTables = useTables;
+    this->kernelCache.setTolerance(tolerance);
+    this->kernelCache.setSinglePrecision(singlePrecision);
+    this->kernelPairTables.clear();
+    this->tabulatedPlanes.clear();
+}
+
+/**
+ * @brief Set the slip planes on which the kernel tables are used, if they are used at all.
+ * @details The stress at the defects of the other slip planes is calculated exactly. SlipSystem::setKernelTables selects all slip planes again.
+ * @param tabulated Flags indicating, for each slip plane, whether the contributions of the other slip planes are interpolated. An empty vector selects all slip planes.
+ */
+void SlipSystem::setTabulatedSlipPlanes (const std::vector<bool>& tabulated)
+{
+    this->tabulatedPlanes = tabulated;
+}
+
+/**
+ * @brief Set whether the extremities of the slip planes are free surfaces.
+ * @details Free surfaces absorb the dislocations reaching them and exert image forces on the dislocations lying within the cut-off distance. Otherwise the extremities are grain boundaries.
+ * @param freeSurfaces Flag indicating whether the extremities are free surfaces.
+ * @param imageForceCutoff Distance from a free surface within which the image force acts on the dislocations. A value of zero or less disables the image forces.
+ */
+void SlipSystem::setFreeSurfaces (bool freeSurfaces, double imageForceCutoff)
+{
+    std::vector<SlipPlane*>::iterator slipPlanes_it;
+    SlipPlane *s;
+
+    for (slipPlanes_it=this->slipPlanes.begin(); slipPlanes_it!=this->slipPlanes.end(); slipPlanes_it++) {
+        s = *slipPlanes_it;
+        s->setExtremityType(freeSurfaces ? FREESURFACE : GRAINBOUNDARY);
+        s->setImageForceCutoff(imageForceCutoff);
+    }
+}
+
 // Access functions
 /**
  * @brief Gets the co-ordinate system of the slip system.
@@ -223,9 +272,10 @@ Vector3d SlipSystem::getDirection () const
 
 /**
  * @brief Get the vector container with pointers to all slip planes.
- * @return Vector container with pointers to all slip planes.
+ * @details The reference remains valid as long as the slip system exists, but the contents change when slip planes are inserted or removed.
+ * @return Reference to the vector container with pointers to all slip planes.
  */
-std::vector<SlipPlane*> SlipSystem::getSlipPlanes ()
+const std::vector<SlipPlane*>& SlipSystem::getSlipPlanes () const
 {
     return (this->slipPlanes);
 }
@@ -351,6 +401,93 @@ std::vector<Vector3d> SlipSystem::getAllDefectPositions_base ()
     return (this->coordinateSystem.vector_LocalToBase(this->getAllDefectPositions_local()));
 }
 
+/**
+ * @brief Returns whether the stress field due to dislocations on other slip planes is interpolated from kernel tables.
+ * @return True if the kernel tables are used.
+ */
+bool SlipSystem::usesKernelTables () const
+{
+    return (this->useKernelTables);
+}
+
+/**
+ * @brief Returns whether the stress at the defects of a slip plane is calculated with the kernel tables.
+ * @param i Index of the slip plane.
+ * @return True if the kernel tables are used and the slip plane is selected.
+ */
+bool SlipSystem::tabulatesSlipPlane (int i) const
+{
+    if (!this->useKernelTables) {
+        return (false);
+    }
+
+    if (i < 0 || i >= this->tabulatedPlanes.size()) {
+        return (true);
+    }
+
+    return (this->tabulatedPlanes[i]);
+}
+
+/**
+ * @brief Get the number of kernel tables built so far.
+ * @return Number of kernel tables in the cache.
+ */
+int SlipSystem::getNumKernelTables () const
+{
+    return (this->kernelCache.getNumTables());
+}
+
+/**
+ * @brief Get the plastic slip accumulated on all slip planes of the slip system.
+ * @details The plastic slip of each slip plane, given by SlipPlane::getPlasticSlip, is rotated into the co-ordinate system of the slip system and the contributions are summed up. Divided by the area of the grain, it gives the plastic strain carried by the slip system.
+ * @return The plastic slip, expressed in the slip system co-ordinate system.
+ */
+Strain SlipSystem::getPlasticSlip ()
+{
+    std::vector<SlipPlane*>::iterator sp_it;
+    SlipPlane* sp;
+
+    Strain slip;
+    for (sp_it=this->slipPlanes.begin(); sp_it!=this->slipPlanes.end(); sp_it++) {
+        sp = *sp_it;
+        slip += sp->getCoordinateSystem()->strain_LocalToBase(sp->getPlasticSlip());
+    }
+
+    return (slip);
+}
+
+/**
+ * @brief Get the number of dislocation dipoles emitted on all slip planes of the slip system since the beginning of the simulation.
+ * @return The number of emissions.
+ */
+int SlipSystem::getNumEmissions () const
+{
+    std::vector<SlipPlane*>::const_iterator sp_it;
+
+    int n = 0;
+    for (sp_it=this->slipPlanes.begin(); sp_it!=this->slipPlanes.end(); sp_it++) {
+        n += (*sp_it)->getNumEmissions();
+    }
+
+    return (n);
+}
+
+/**
+ * @brief Get the number of pairs of dislocations annihilated on all slip planes of the slip system since the beginning of the simulation.
+ * @return The number of annihilations.
+ */
+int SlipSystem::getNumAnnihilations () const
+{
+    std::vector<SlipPlane*>::const_iterator sp_it;
+
+    int n = 0;
+    for (sp_it=this->slipPlanes.begin(); sp_it!=this->slipPlanes.end(); sp_it++) {
+        n += (*sp_it)->getNumAnnihilations();
+    }
+
+    return (n);
+}
+
 // Sort functions
 /**
  * @brief Sort the slip planes in ascending order based on their positions.
@@ -395,7 +532,8 @@ void SlipSystem::calculateSlipPlaneAppliedStress ()
 }
 
 /**
- * @brief Calculate the total stresses experienced by all defects on all the slip planes.
+ * @brief Calculate the total stresses experienced by the defects on all the slip planes.
+ * @details Only the defects returned by SlipPlane::getStressReceivers receive the stress.
  * @param mu Shear modulus of the material (Pa).
  * @param nu Poisson's ratio.
  */
@@ -418,11 +556,28 @@ void SlipSystem::calculateAllStresses (double mu, double nu)
     std::vector<Defect *>::iterator defects_it;
     Defect *defect;
 
-    for (destination_slipPlane_it=this->slipPlanes.begin(); destination_slipPlane_it!=this->slipPlanes.end(); destination_slipPlane_it++) {
+    if (this->useKernelTables) {
+        // The contributions of the other slip planes are interpolated
+        this->prepareKernelTables(mu, nu);
+    }
+
+    int i = 0;
+    for (destination_slipPlane_it=this->slipPlanes.begin(); destination_slipPlane_it!=this->slipPlanes.end(); destination_slipPlane_it++, i++) {
         destination_slipPlane = *destination_slipPlane_it;
-        // Get all defects and their position vectors
-        defects = destination_slipPlane->getDefectList();
-        defectPositions = destination_slipPlane->getAllDefectPositions_base();
+        if (this->tabulatesSlipPlane(i)) {
+            defects = destination_slipPlane->getStressReceivers();
+            for (defects_it=defects.begin(); defects_it!=defects.end(); defects_it++) {
+                defect = *defects_it;
+                totalStress = this->appliedStress_local + this->slipSystemStressField_tabulated(i, defect->getPosition(), mu, nu);
+                totalStress_slipPlane = destination_slipPlane->getCoordinateSystem()->stress_BaseToLocal(totalStress);
+                totalStress_defect = defect->getCoordinateSystem()->stress_BaseToLocal(totalStress_slipPlane);
+                defect->setTotalStress(totalStress_defect);
+            }
+            continue;
+        }
+        // Get the defects that use the stress and their position vectors
+        defects = destination_slipPlane->getStressReceivers();
+        defectPositions = destination_slipPlane->getStressReceiverPositions_base(defects);
         for (defectPositions_it=defectPositions.begin(), defects_it=defects.begin();
              defectPositions_it!=defectPositions.end();
              defectPositions_it++, defects_it++) {
@@ -447,15 +602,17 @@ void SlipSystem::calculateAllStresses (double mu, double nu)
 /**
  * @brief Calculate the forces on all the dislocations on all the slip planes.
  * @param B The drag coefficient for the dislocations.
+ * @param mu Shear modulus of the material (Pa).
+ * @param nu Poisson's ratio.
  */
-void SlipSystem::calculateSlipPlaneDislocationForcesVelocities (double B)
+void SlipSystem::calculateSlipPlaneDislocationForcesVelocities (double B, double mu, double nu)
 {
     std::vector<SlipPlane*>::iterator slipPlanes_it;
     SlipPlane *s;
 
     for (slipPlanes_it=this->slipPlanes.begin(); slipPlanes_it!=this->slipPlanes.end(); slipPlanes_it++) {
         s = *slipPlanes_it;
-        s->calculateDislocationForces();
+        s->calculateDislocationForces(mu, nu);
         s->calculateDislocationVelocities(B);
     }
 }
@@ -483,6 +640,271 @@ Stress SlipSystem::slipSystemStressField (Vector3d p, double mu, double nu)
     return (this->coordinateSystem.stress_LocalToBase(s));
 }
 
+/**
+ * @brief Refreshes the dislocation data used with the kernel tables and builds the tables that are missing.
+ * @details This function must be called after the dislocations have moved and before SlipSystem::slipSystemStressField_tabulated is used.
+ * @param mu Shear modulus (Pa).
+ * @param nu Poisson's ratio.
+ */
+void SlipSystem::prepareKernelTables (double mu, double nu)
+{
+    int nPlanes = this->slipPlanes.size();
+    int i, j, c;
+    SlipPlane *source;
+    SlipPlane *destination;
+
+    if (this->kernelPairTables.size() != nPlanes*nPlanes) {
+        // The slip planes have changed: all pairs must be resolved again
+        this->kernelPairTables.assign(nPlanes*nPlanes, std::vector<int>());
+    }
+
+    // Only slip planes whose axes coincide with those of the slip system can be tabulated
+    RotationMatrix unit (Matrix33::unitMatrix());
+    RotationMatrix r;
+    this->kernelPlanes.assign(nPlanes, true);
+    for (i=0; i<nPlanes; i++) {
+        this->kernelPlanes[i] = KernelTable::sameRotation(this->slipPlanes[i]->getRotationMatrix(), unit);
+    }
+
+    // Smallest distance between slip planes
+    double spacing = 0.0;
+    double h;
+    Vector3d offset;
+    for (j=0; j<nPlanes; j++) {
+        for (i=0; i<nPlanes; i++) {
+            if (i != j) {
+                offset = this->slipPlanes[j]->getCoordinateSystem()->getOrigin() - this->slipPlanes[i]->getCoordinateSystem()->getOrigin();
+                h = sqrt((offset.getValue(1)*offset.getValue(1)) + (offset.getValue(2)*offset.getValue(2)));
+                if (spacing == 0.0 || h < spacing) {
+                    spacing = h;
+                }
+            }
+        }
+    }
+    this->kernelAxisTolerance = this->kernelCache.getTolerance() * spacing;
+
+    // Refresh the dislocation data
+    std::vector<Dislocation*> dislocations;
+    std::vector<Dislocation*>::iterator d_it;
+    Dislocation *d;
+    KernelSource ks;
+    Vector3d position;
+
+    this->kernelSources.assign(nPlanes, std::vector<KernelSource>());
+    for (i=0; i<nPlanes; i++) {
+        dislocations = this->slipPlanes[i]->getDislocationList();
+        for (d_it=dislocations.begin(); d_it!=dislocations.end(); d_it++) {
+            d = *d_it;
+            position = d->getPosition();
+            ks.x = position.getValue(0);
+            ks.bEdge = d->getBurgersMagnitude() * d->getBurgerLocal().getValue(0);
+            ks.bScrew = d->getBurgersMagnitude() * d->getBurgerLocal().getValue(2);
+            ks.dislocation = d;
+            ks.character = d->getCharacter();
+            ks.rotationClass = -1;
+            if (this->kernelPlanes[i] &&
+                fabs(position.getValue(1)) + fabs(position.getValue(2)) <= this->kernelAxisTolerance) {
+                // Find the rotation matrix among those already known
+                r = d->getCoordinateSystem()->getRotationMatrix();
+                for (c=0; c<this->kernelRotations.size(); c++) {
+                    if (KernelTable::sameRotation(this->kernelRotations[c], r)) {
+                        ks.rotationClass = c;
+                        break;
+                    }
+                }
+                if (ks.rotationClass < 0) {
+                    this->kernelRotations.push_back(r);
+                    ks.rotationClass = this->kernelRotations.size() - 1;
+                }
+            }
+            this->kernelSources[i].push_back(ks);
+        }
+    }
+
+    // Build the tables for the pairs of slip planes and rotation matrices that appeared since the last call
+    int nRotations = this->kernelRotations.size();
+    double xMin[2], xMax[2];
+    std::vector<int> *tables;
+    for (j=0; j<nPlanes; j++) {
+        destination = this->slipPlanes[j];
+        xMin[0] = std::min(destination->getExtremity(0).getValue(0), destination->getExtremity(1).getValue(0));
+        xMax[0] = std::max(destination->getExtremity(0).getValue(0), destination->getExtremity(1).getValue(0));
+        for (i=0; i<nPlanes; i++) {
+            tables = &(this->kernelPairTables[(j*nPlanes)+i]);
+            if (i==j || !this->kernelPlanes[i] || !this->kernelPlanes[j] || tables->size()==nRotations) {
+                continue;
+            }
+            source = this->slipPlanes[i];
+            xMin[1] = std::min(source->getExtremity(0).getValue(0), source->getExtremity(1).getValue(0));
+            xMax[1] = std::max(source->getExtremity(0).getValue(0), source->getExtremity(1).getValue(0));
+            offset = destination->getCoordinateSystem()->getOrigin() - source->getCoordinateSystem()->getOrigin();
+            for (c=tables->size(); c<nRotations; c++) {
+                tables->push_back(this->kernelCache.findTable(offset, this->kernelRotations[c],
+                                                              xMin[0]-xMax[1], xMax[0]-xMin[1],
+                                                              mu, nu));
+            }
+        }
+    }
+}
+
+/**
+ * @brief The total stress field due to all defects in the slip system at a point lying on one of its slip planes, using the kernel tables for the contributions of the other slip planes.
+ * @details The contribution of the slip plane containing the point is calculated exactly, as well as those of dislocations that cannot be tabulated. SlipSystem::prepareKernelTables must have been called before.
+ * @param i Index of the slip plane on which the point lies.
+ * @param p Position vector of the point, in the co-ordinate system of the slip plane i.
+ * @param mu Shear modulus (Pa).
+ * @param nu Poisson's ratio.
+ * @return Stress field, in the slip system co-ordinate system, due to all defects in this slip system.
+ */
+Stress SlipSystem::slipSystemStressField_tabulated (int i, Vector3d p, double mu, double nu)
+{
+    return (this->slipSystemStressField_tabulated(i, p, mu, nu, true));
+}
+
+/**
+ * @brief Overloaded function. The stress field due to the defects in the slip system at a point lying on one of its slip planes, using the kernel tables for the contributions of the other slip planes. The contribution of the slip plane containing the point may be left out.
+ * @param i Index of the slip plane on which the point lies.
+ * @param p Position vector of the point, in the co-ordinate system of the slip plane i.
+ * @param mu Shear modulus (Pa).
+ * @param nu Poisson's ratio.
+ * @param ownPlane Flag indicating whether the contribution of the slip plane i is to be included.
+ * @return Stress field, in the slip system co-ordinate system.
+ */
+Stress SlipSystem::slipSystemStressField_tabulated (int i, Vector3d p, double mu, double nu, bool ownPlane)
+{
+    int nPlanes = this->slipPlanes.size();
+    SlipPlane *destination = this->slipPlanes[i];
+    SlipPlane *source;
+    Vector3d p_base = destination->getCoordinateSystem()->vector_LocalToBase(p);
+    bool onAxis = (fabs(p.getValue(1)) + fabs(p.getValue(2)) <= this->kernelAxisTolerance);
+
+    std::vector<KernelSource>::iterator ks_it;
+    const KernelTable *table;
+    std::vector<int> *tables;
+    bool tabulated;
+    bool singlePrecision = this->kernelCache.getSinglePrecision();
+    double s[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    // Single precision sums and their compensations
+    float sSingle[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    float compensation[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    Stress stress;
+    int j;
+
+    for (j=0; j<nPlanes; j++) {
+        source = this->slipPlanes[j];
+        tables = &(this->kernelPairTables[(i*nPlanes)+j]);
+        if (j==i && !ownPlane) {
+            continue;
+        }
+        if (j==i || !onAxis || tables->empty()) {
+            // Exact evaluation for the whole slip plane
+            stress += source->slipPlaneStressField(p_base, mu, nu);
+            continue;
+        }
+        for (ks_it=this->kernelSources[j].begin(); ks_it!=this->kernelSources[j].end(); ks_it++) {
+            table = NULL;
+            if (ks_it->rotationClass >= 0 && ks_it->rotationClass < tables->size()) {
+                table = this->kernelCache.getTable(tables->at(ks_it->rotationClass));
+            }
+            if (table==NULL) {
+                tabulated = false;
+            }
+            else if (singlePrecision && table->isValidSingle()) {
+                switch (ks_it->character) {
+                case EDGE:
+                    tabulated = table->accumulate_single<EDGE>(p.getValue(0) - ks_it->x, (float) ks_it->bEdge, (float) ks_it->bScrew, sSingle, compensation);
+                    break;
+                case SCREW:
+                    tabulated = table->accumulate_single<SCREW>(p.getValue(0) - ks_it->x, (float) ks_it->bEdge, (float) ks_it->bScrew, sSingle, compensation);
+                    break;
+                default:
+                    tabulated = table->accumulate_single<MIXED>(p.getValue(0) - ks_it->x, (float) ks_it->bEdge, (float) ks_it->bScrew, sSingle, compensation);
+                    break;
+                }
+            }
+            else {
+                switch (ks_it->character) {
+                case EDGE:
+                    tabulated = table->accumulate_character<EDGE>(p.getValue(0) - ks_it->x, ks_it->bEdge, ks_it->bScrew, s);
+                    break;
+                case SCREW:
+                    tabulated = table->accumulate_character<SCREW>(p.getValue(0) - ks_it->x, ks_it->bEdge, ks_it->bScrew, s);
+                    break;
+                default:
+                    tabulated = table->accumulate_character<MIXED>(p.getValue(0) - ks_it->x, ks_it->bEdge, ks_it->bScrew, s);
+                    break;
+                }
+            }
+            if (!tabulated) {
+                // Exact evaluation for this dislocation
+                stress += source->getCoordinateSystem()->stress_LocalToBase(ks_it->dislocation->stressField(source->getCoordinateSystem()->vector_BaseToLocal(p_base), mu, nu));
+            }
+        }
+    }
+
+    for (j=0; j<6; j++) {
+        s[j] += ( (double) sSingle[j] - (double) compensation[j] );
+    }
+
+    double principalStresses[3] = {s[0], s[1], s[2]};
+    double shearStresses[3] = {s[3], s[4], s[5]};
+    stress += Stress(principalStresses, shearStresses);
+
+    return (stress);
+}
+
+/**
+ * @brief Compares the stress field obtained with the kernel tables with the exact double precision stress field, at the positions of all defects in the slip system.
+ * @details SlipSystem::prepareKernelTables must have been called before. Only the contribution of the other slip planes, which is the one that is interpolated, is compared. The deviation is normalized by the largest component of this contribution over all defects, so that defects lying in regions of vanishing stress do not dominate the result.
+ * @param mu Shear modulus (Pa).
+ * @param nu Poisson's ratio.
+ * @return Largest deviation of a stress component, relative to the largest component of the exact stress field due to the other slip planes. Zero if the kernel tables are not used.
+ */
+double SlipSystem::checkKernelPrecision (double mu, double nu)
+{
+    if (!this->useKernelTables) {
+        return (0.0);
+    }
+
+    std::vector<Defect*> defects;
+    std::vector<Defect*>::iterator defects_it;
+    Defect *defect;
+    Stress exact, tabulated;
+    Vector3d p_base;
+    double deviation = 0.0;
+    double magnitude = 0.0;
+    int i, j, k;
+
+    for (i=0; i<this->slipPlanes.size(); i++) {
+        defects = this->slipPlanes[i]->getDefectList();
+        for (defects_it=defects.begin(); defects_it!=defects.end(); defects_it++) {
+            defect = *defects_it;
+            p_base = this->slipPlanes[i]->getCoordinateSystem()->vector_LocalToBase(defect->getPosition());
+            // Exact contribution of the other slip planes
+            exact = Stress();
+            for (k=0; k<this->slipPlanes.size(); k++) {
+                if (k != i) {
+                    exact += this->slipPlanes[k]->slipPlaneStressField(p_base, mu, nu);
+                }
+            }
+            // Interpolated contribution of the other slip planes
+            tabulated = this->slipSystemStressField_tabulated(i, defect->getPosition(), mu, nu, false);
+            for (j=0; j<3; j++) {
+                for (k=0; k<3; k++) {
+                    deviation = std::max(deviation, fabs(tabulated.getValue(j,k) - exact.getValue(j,k)));
+                    magnitude = std::max(magnitude, fabs(exact.getValue(j,k)));
+                }
+            }
+        }
+    }
+
+    if (magnitude == 0.0) {
+        return (0.0);
+    }
+
+    return (deviation/magnitude);
+}
+
 // Time increment
 /**
  * @brief Calculates the ideal time increments of all the slip planes in the slip system.
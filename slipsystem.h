@@ -35,6 +35,7 @@
 
 #include "slipPlane.h"
 #include "standardSlipSystem.h"
+#include "kernelTable.h"
 
 #ifndef SLIPSYSTEM_DEFAULT_NUMBERPLANES
 /**
@@ -83,6 +84,40 @@ protected:
      */
     double dt;
 
+    // Kernel tables
+    /**
+     * @brief Flag indicating whether the stress field due to dislocations on other slip planes is interpolated from kernel tables.
+     */
+    bool useKernelTables;
+    /**
+     * @brief The cache holding the kernel tables for this slip system.
+     */
+    KernelCache kernelCache;
+    /**
+     * @brief Distinct rotation matrices of the dislocations in the slip system, used to share kernel tables between dislocations.
+     */
+    std::vector<RotationMatrix> kernelRotations;
+    /**
+     * @brief For each slip plane, the data of its dislocations needed for the kernel tables. Refreshed by prepareKernelTables.
+     */
+    std::vector< std::vector<KernelSource> > kernelSources;
+    /**
+     * @brief For each pair of slip planes (destination*numberOfPlanes + source), the index in the cache of the table for each rotation matrix. The value -1 indicates that no table is available.
+     */
+    std::vector< std::vector<int> > kernelPairTables;
+    /**
+     * @brief Flags indicating which slip planes have axes coinciding with those of the slip system, which is a requirement for using the kernel tables.
+     */
+    std::vector<bool> kernelPlanes;
+    /**
+     * @brief Flags indicating, for each destination slip plane, whether the contributions of the other slip planes are interpolated when the kernel tables are used. An empty vector selects all slip planes.
+     */
+    std::vector<bool> tabulatedPlanes;
+    /**
+     * @brief Largest distance from the slip plane axis for which a point is considered to lie on the slip plane when using the kernel tables.
+     */
+    double kernelAxisTolerance;
+
 public:
     /**
      * @brief Default constructor for the class SlipSystem.
@@ -150,6 +185,26 @@ public:
      * @param t The value of the time increment.
      */
     void setTimeIncrement (double t);
+    /**
+     * @brief Set whether the stress field due to dislocations on other slip planes is to be interpolated from kernel tables.
+     * @param useTables Flag indicating whether the kernel tables are to be used.
+     * @param tolerance Maximum interpolation error, relative to the peak value of each kernel.
+     * @param singlePrecision Flag indicating whether the interpolation is to be carried out in single precision.
+     */
+    void setKernelTables (bool useTables, double tolerance, bool singlePrecision);
+    /**
+     * @brief Set the slip planes on which the kernel tables are used, if they are used at all.
+     * @details The stress at the defects of the other slip planes is calculated exactly. SlipSystem::setKernelTables selects all slip planes again.
+     * @param tabulated Flags indicating, for each slip plane, whether the contributions of the other slip planes are interpolated. An empty vector selects all slip planes.
+     */
+    void setTabulatedSlipPlanes (const std::vector<bool>& tabulated);
+    /**
+     * @brief Set whether the extremities of the slip planes are free surfaces.
+     * @details Free surfaces absorb the dislocations reaching them and exert image forces on the dislocations lying within the cut-off distance. Otherwise the extremities are grain boundaries.
+     * @param freeSurfaces Flag indicating whether the extremities are free surfaces.
+     * @param imageForceCutoff Distance from a free surface within which the image force acts on the dislocations. A value of zero or less disables the image forces.
+     */
+    void setFreeSurfaces (bool freeSurfaces, double imageForceCutoff);
 
     // Access functions
     /**
@@ -174,9 +229,10 @@ public:
     Vector3d getDirection () const;
     /**
      * @brief Get the vector container with pointers to all slip planes.
-     * @return Vector container with pointers to all slip planes.
+     * @details The reference remains valid as long as the slip system exists, but the contents change when slip planes are inserted or removed.
+     * @return Reference to the vector container with pointers to all slip planes.
      */
-    std::vector<SlipPlane*> getSlipPlanes ();
+    const std::vector<SlipPlane*>& getSlipPlanes () const;
     /**
      * @brief Get a vector container with pointers to all defects in the slip system.
      * @return Vector container with pointers to all defects in the slip system.
@@ -218,6 +274,38 @@ public:
      * @return Vector container with the positions of all defects expressed in the base co-ordinate system.
      */
     std::vector<Vector3d> getAllDefectPositions_base ();
+    /**
+     * @brief Returns whether the stress field due to dislocations on other slip planes is interpolated from kernel tables.
+     * @return True if the kernel tables are used.
+     */
+    bool usesKernelTables () const;
+    /**
+     * @brief Returns whether the stress at the defects of a slip plane is calculated with the kernel tables.
+     * @param i Index of the slip plane.
+     * @return True if the kernel tables are used and the slip plane is selected.
+     */
+    bool tabulatesSlipPlane (int i) const;
+    /**
+     * @brief Get the number of kernel tables built so far.
+     * @return Number of kernel tables in the cache.
+     */
+    int getNumKernelTables () const;
+    /**
+     * @brief Get the plastic slip accumulated on all slip planes of the slip system.
+     * @details The plastic slip of each slip plane, given by SlipPlane::getPlasticSlip, is rotated into the co-ordinate system of the slip system and the contributions are summed up. Divided by the area of the grain, it gives the plastic strain carried by the slip system.
+     * @return The plastic slip, expressed in the slip system co-ordinate system.
+     */
+    Strain getPlasticSlip ();
+    /**
+     * @brief Get the number of dislocation dipoles emitted on all slip planes of the slip system since the beginning of the simulation.
+     * @return The number of emissions.
+     */
+    int getNumEmissions () const;
+    /**
+     * @brief Get the number of pairs of dislocations annihilated on all slip planes of the slip system since the beginning of the simulation.
+     * @return The number of annihilations.
+     */
+    int getNumAnnihilations () const;
 
     // Sort functions
     /**
@@ -242,7 +330,8 @@ public:
      */
     void calculateSlipPlaneAppliedStress ();
     /**
-     * @brief Calculate the total stresses experienced by all defects on all the slip planes.
+     * @brief Calculate the total stresses experienced by the defects on all the slip planes.
+     * @details Only the defects returned by SlipPlane::getStressReceivers receive the stress.
      * @param mu Shear modulus of the material (Pa).
      * @param nu Poisson's ratio.
      */
@@ -250,8 +339,10 @@ public:
     /**
      * @brief Calculate the forces on all the dislocations on all the slip planes.
      * @param B The drag coefficient for the dislocations.
+     * @param mu Shear modulus of the material (Pa).
+     * @param nu Poisson's ratio.
      */
-    void calculateSlipPlaneDislocationForcesVelocities (double B);
+    void calculateSlipPlaneDislocationForcesVelocities (double B, double mu, double nu);
 
     /**
      * @brief The total stress field due to all defects in the slip system at the position p.
@@ -262,6 +353,45 @@ public:
      */
     Stress slipSystemStressField (Vector3d p, double mu, double nu);
 
+    /**
+     * @brief Refreshes the dislocation data used with the kernel tables and builds the tables that are missing.
+     * @details This function must be called after the dislocations have moved and before SlipSystem::slipSystemStressField_tabulated is used.
+     * @param mu Shear modulus (Pa).
+     * @param nu Poisson's ratio.
+     */
+    void prepareKernelTables (double mu, double nu);
+
+    /**
+     * @brief The total stress field due to all defects in the slip system at a point lying on one of its slip planes, using the kernel tables for the contributions of the other slip planes.
+     * @details The contribution of the slip plane containing the point is calculated exactly, as well as those of dislocations that cannot be tabulated. SlipSystem::prepareKernelTables must have been called before.
+     * @param i Index of the slip plane on which the point lies.
+     * @param p Position vector of the point, in the co-ordinate system of the slip plane i.
+     * @param mu Shear modulus (Pa).
+     * @param nu Poisson's ratio.
+     * @return Stress field, in the slip system co-ordinate system, due to all defects in this slip system.
+     */
+    Stress slipSystemStressField_tabulated (int i, Vector3d p, double mu, double nu);
+
+    /**
+     * @brief Overloaded function. The stress field due to the defects in the slip system at a point lying on one of its slip planes, using the kernel tables for the contributions of the other slip planes. The contribution of the slip plane containing the point may be left out.
+     * @param i Index of the slip plane on which the point lies.
+     * @param p Position vector of the point, in the co-ordinate system of the slip plane i.
+     * @param mu Shear modulus (Pa).
+     * @param nu Poisson's ratio.
+     * @param ownPlane Flag indicating whether the contribution of the slip plane i is to be included.
+     * @return Stress field, in the slip system co-ordinate system.
+     */
+    Stress slipSystemStressField_tabulated (int i, Vector3d p, double mu, double nu, bool ownPlane);
+
+    /**
+     * @brief Compares the stress field obtained with the kernel tables with the exact double precision stress field, at the positions of all defects in the slip system.
+     * @details SlipSystem::prepareKernelTables must have been called before. Only the contribution of the other slip planes, which is the one that is interpolated, is compared. The deviation is normalized by the largest component of this contribution over all defects, so that defects lying in regions of vanishing stress do not dominate the result.
+     * @param mu Shear modulus (Pa).
+     * @param nu Poisson's ratio.
+     * @return Largest deviation of a stress component, relative to the largest component of the exact stress field due to the other slip planes. Zero if the kernel tables are not used.
+     */
+    double checkKernelPrecision (double mu, double nu);
+
     // Time increment
     /**
      * @brief Calculates the ideal time increments of all the slip planes in the slip system.
@@ -307,6 +437,16 @@ public:
      * @param t Value of time.
      */
     void writeAllDefects (std::string fileName, double t);
+
+    /**
+     * @brief Writes out the current time and the relative deviation of the stress field obtained with the kernel tables from the exact double precision stress field.
+     * @details The deviation is calculated by SlipSystem::checkKernelPrecision. The file is opened in append mode and a newline is inserted after each entry.
+     * @param fileName Name of the file into which the data is to be written.
+     * @param t Value of time.
+     * @param mu Shear modulus (Pa).
+     * @param nu Poisson's ratio.
+     */
+    void writeKernelPrecision (std::string fileName, double t, double mu, double nu);
 };
 
 #endif // SLIPSYSTEM_H
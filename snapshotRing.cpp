@@ -0,0 +1,479 @@
+/**
+ * @file snapshotRing.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the member functions of the class SnapshotRing.
+ * @details This file defines the member functions of the class SnapshotRing, which publishes the latest snapshots of a running simulation in POSIX shared memory, for viewers running in other processes.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "snapshotRing.h"
+
+// Constructors
+/**
+ * @brief Default constructor. The ring is closed.
+ */
+SnapshotRing::SnapshotRing ()
+{
+  this->memory = NULL;
+  this->size = 0;
+  this->writer = false;
+  this->currentSlot = NULL;
+}
+
+// Destructor
+/**
+ * @brief Destructor for the class SnapshotRing. The ring is closed.
+ */
+SnapshotRing::~SnapshotRing ()
+{
+  this->close();
+}
+
+/**
+ * @brief Get the header of the shared memory.
+ * @return Pointer to the header.
+ */
+SnapshotRingHeader* SnapshotRing::header () const
+{
+  return ((SnapshotRingHeader*) this->memory);
+}
+
+/**
+ * @brief Get the slot holding the snapshot with the given index.
+ * @param index Index of the snapshot.
+ * @return Pointer to the header of the slot.
+ */
+SnapshotSlotHeader* SnapshotRing::slot (long index) const
+{
+  SnapshotRingHeader* h = this->header();
+  long offset = (sizeof(SnapshotRingHeader) + 7) / 8 * 8;
+
+  offset += (index % h->nSlots) * h->slotSize;
+  return ((SnapshotSlotHeader*) (this->memory + offset));
+}
+
+/**
+ * @brief Get the positions stored in a slot.
+ * @param s Pointer to the header of the slot.
+ * @return Pointer to the co-ordinates of the defects, two per defect.
+ */
+double* SnapshotRing::slotPositions (SnapshotSlotHeader* s) const
+{
+  return ((double*) ((char*) s + sizeof(SnapshotSlotHeader)));
+}
+
+/**
+ * @brief Get the types stored in a slot.
+ * @param s Pointer to the header of the slot.
+ * @return Pointer to the types of the defects.
+ */
+int* SnapshotRing::slotTypes (SnapshotSlotHeader* s) const
+{
+  return ((int*) (this->slotPositions(s) + 2 * this->header()->maxDefects));
+}
+
+/**
+ * @brief Get the statistics of the slip planes stored in a slot.
+ * @param s Pointer to the header of the slot.
+ * @return Pointer to the statistics of the slip planes.
+ */
+SnapshotSlipPlane* SnapshotRing::slotSlipPlanes (SnapshotSlotHeader* s) const
+{
+  long typeBytes = ((long) this->header()->maxDefects * sizeof(int) + 7) / 8 * 8;
+  return ((SnapshotSlipPlane*) ((char*) this->slotTypes(s) + typeBytes));
+}
+
+/**
+ * @brief Calculates the size of a slot.
+ * @param maxDefects Number of defects that a slot can hold.
+ * @param maxSlipPlanes Number of slip planes that a slot can hold.
+ * @return The size of a slot, in bytes, a multiple of eight.
+ */
+long SnapshotRing::slotSize (int maxDefects, int maxSlipPlanes)
+{
+  long bytes = sizeof(SnapshotSlotHeader);
+
+  bytes += 2 * (long) maxDefects * sizeof(double);
+  bytes += ((long) maxDefects * sizeof(int) + 7) / 8 * 8;
+  bytes += (long) maxSlipPlanes * sizeof(SnapshotSlipPlane);
+
+  return ((bytes + 7) / 8 * 8);
+}
+
+/**
+ * @brief Creates and maps the shared memory object.
+ * @param shmName Name of the shared memory object, beginning with /.
+ * @param bytes Size of the shared memory, in bytes.
+ * @return False if the object exists already or could not be created.
+ */
+bool SnapshotRing::createMemory (std::string shmName, size_t bytes)
+{
+  int fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  void* p;
+
+  if (fd < 0) {
+    return (false);
+  }
+
+  if (ftruncate(fd, bytes) != 0) {
+    ::close(fd);
+    shm_unlink(shmName.c_str());
+    return (false);
+  }
+
+  p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED) {
+    shm_unlink(shmName.c_str());
+    return (false);
+  }
+
+  this->memory = (char*) p;
+  this->size = bytes;
+  this->name = shmName;
+  return (true);
+}
+
+// Operations
+/**
+ * @brief Creates the shared memory for writing.
+ * @details The shared memory object is called /name. If an object of that name belongs to a process that no longer runs, it is replaced. If it belongs to a running process, such as another variant of a sweep, the object /name_pid is created instead, where pid is the identifier of this process. The name that was used is given by SnapshotRing::getName.
+ * @param name Name of the ring, without the leading /.
+ * @param nSlots Number of snapshots kept.
+ * @param maxDefects Number of defects that a snapshot can hold.
+ * @param maxSlipPlanes Number of slip planes that a snapshot can hold.
+ * @return False if the shared memory could not be created.
+ */
+bool SnapshotRing::create (std::string name, int nSlots, int maxDefects, int maxSlipPlanes)
+{
+  SnapshotRingHeader* h;
+  SnapshotRing existing;
+  std::string shmName = "/" + name;
+  long bytesPerSlot = slotSize(maxDefects, maxSlipPlanes);
+  size_t bytes = (sizeof(SnapshotRingHeader) + 7) / 8 * 8 + nSlots * bytesPerSlot;
+
+  this->close();
+
+  if (nSlots <= 0 || maxDefects < 0 || maxSlipPlanes < 0) {
+    return (false);
+  }
+
+  if (!this->createMemory(shmName, bytes)) {
+    if (errno != EEXIST) {
+      return (false);
+    }
+    // Replace the ring left behind by a process that no longer runs
+    if (existing.attach(name) && kill((pid_t) existing.header()->writerPid, 0) != 0 && errno == ESRCH) {
+      existing.close();
+      shm_unlink(shmName.c_str());
+    }
+    else {
+      existing.close();
+      std::ostringstream pidName;
+      pidName << "/" << name << "_" << (long) getpid();
+      shmName = pidName.str();
+      shm_unlink(shmName.c_str());
+    }
+    if (!this->createMemory(shmName, bytes)) {
+      return (false);
+    }
+  }
+
+  memset(this->memory, 0, bytes);
+  h = this->header();
+  memcpy(h->magic, SNAPSHOTRING_MAGIC, 8);
+  h->version = SNAPSHOTRING_VERSION;
+  h->nSlots = nSlots;
+  h->maxDefects = maxDefects;
+  h->maxSlipPlanes = maxSlipPlanes;
+  h->slotSize = bytesPerSlot;
+  h->writerPid = (long) getpid();
+  h->nPublished = 0;
+  h->finished = 0;
+  __sync_synchronize();
+
+  this->writer = true;
+  return (true);
+}
+
+/**
+ * @brief Attaches to an existing ring for reading.
+ * @param name Name of the ring, without the leading /.
+ * @return False if the ring does not exist or has a different layout.
+ */
+bool SnapshotRing::attach (std::string name)
+{
+  std::string shmName = "/" + name;
+  struct stat st;
+  void* p;
+  int fd;
+
+  this->close();
+
+  fd = shm_open(shmName.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return (false);
+  }
+
+  if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(SnapshotRingHeader)) {
+    ::close(fd);
+    return (false);
+  }
+
+  p = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED) {
+    return (false);
+  }
+
+  this->memory = (char*) p;
+  this->size = st.st_size;
+  this->name = shmName;
+  this->writer = false;
+
+  if (memcmp(this->header()->magic, SNAPSHOTRING_MAGIC, 8) != 0 || this->header()->version != SNAPSHOTRING_VERSION) {
+    this->close();
+    return (false);
+  }
+
+  // The slots must lie within the mapping
+  if (this->header()->nSlots <= 0
+      || this->header()->slotSize < slotSize(this->header()->maxDefects, this->header()->maxSlipPlanes)
+      || (sizeof(SnapshotRingHeader) + 7) / 8 * 8 + this->header()->nSlots * this->header()->slotSize > this->size) {
+    this->close();
+    return (false);
+  }
+
+  return (true);
+}
+
+/**
+ * @brief Closes the ring. The writer marks the ring as finished and removes the shared memory object; readers that are attached keep their mapping.
+ */
+void SnapshotRing::close ()
+{
+  if (this->memory == NULL) {
+    return;
+  }
+
+  if (this->writer) {
+    this->header()->finished = 1;
+    __sync_synchronize();
+    shm_unlink(this->name.c_str());
+  }
+
+  munmap(this->memory, this->size);
+  this->memory = NULL;
+  this->size = 0;
+  this->writer = false;
+  this->currentSlot = NULL;
+  this->name.clear();
+}
+
+/**
+ * @brief Starts writing a new snapshot into the oldest slot.
+ * @param t Simulation time of the snapshot.
+ */
+void SnapshotRing::beginSnapshot (double t)
+{
+  SnapshotRingHeader* h = this->header();
+  SnapshotSlotHeader* s = this->slot(h->nPublished);
+
+  // Odd sequence: readers discard what they copy from now on
+  s->sequence++;
+  __sync_synchronize();
+
+  s->index = h->nPublished;
+  s->time = t;
+  s->nDefects = 0;
+  s->nDefectsTotal = 0;
+  s->nSlipPlanes = 0;
+
+  this->currentSlot = s;
+}
+
+/**
+ * @brief Adds a defect to the snapshot being written. Defects beyond the capacity of the slot are only counted.
+ * @param x First co-ordinate of the defect, in the base co-ordinate system.
+ * @param y Second co-ordinate of the defect, in the base co-ordinate system.
+ * @param type Type of the defect.
+ */
+void SnapshotRing::addDefect (double x, double y, int type)
+{
+  SnapshotSlotHeader* s = this->currentSlot;
+  int i = s->nDefects;
+
+  s->nDefectsTotal++;
+  if (i < this->header()->maxDefects) {
+    this->slotPositions(s)[2*i] = x;
+    this->slotPositions(s)[2*i+1] = y;
+    this->slotTypes(s)[i] = type;
+    s->nDefects++;
+  }
+}
+
+/**
+ * @brief Adds the statistics of a slip plane to the snapshot being written. Slip planes beyond the capacity of the slot are ignored.
+ * @param p The statistics of the slip plane.
+ */
+void SnapshotRing::addSlipPlane (const SnapshotSlipPlane& p)
+{
+  SnapshotSlotHeader* s = this->currentSlot;
+
+  if (s->nSlipPlanes < this->header()->maxSlipPlanes) {
+    this->slotSlipPlanes(s)[s->nSlipPlanes] = p;
+    s->nSlipPlanes++;
+  }
+}
+
+/**
+ * @brief Publishes the snapshot being written.
+ */
+void SnapshotRing::endSnapshot ()
+{
+  SnapshotRingHeader* h = this->header();
+
+  // Even sequence: the slot is consistent again
+  __sync_synchronize();
+  this->currentSlot->sequence++;
+  __sync_synchronize();
+
+  h->nPublished++;
+  __sync_synchronize();
+
+  this->currentSlot = NULL;
+}
+
+/**
+ * @brief Copies a snapshot.
+ * @details The copy is only kept if the slot was not written during the copy; otherwise the copy is attempted again, at most SNAPSHOTRING_READ_ATTEMPTS times.
+ * @param index Index of the snapshot.
+ * @param s Pointer to the Snapshot receiving the copy.
+ * @return False if the snapshot has been overwritten by a newer one, is not yet published, or could not be copied consistently.
+ */
+bool SnapshotRing::read (long index, Snapshot* s) const
+{
+  SnapshotRingHeader* h = this->header();
+  SnapshotSlotHeader* slotHeader;
+  unsigned long sequence0, sequence1;
+  int attempt;
+  int nDefects, nSlipPlanes;
+
+  if (index < 0 || index >= h->nPublished) {
+    return (false);
+  }
+
+  slotHeader = this->slot(index);
+
+  for (attempt=0; attempt<SNAPSHOTRING_READ_ATTEMPTS; attempt++) {
+    sequence0 = slotHeader->sequence;
+    __sync_synchronize();
+    if (sequence0 % 2 == 1) {
+      // The slot is being written
+      continue;
+    }
+
+    if (slotHeader->index != index) {
+      // The snapshot has been overwritten
+      return (false);
+    }
+
+    nDefects = slotHeader->nDefects;
+    nSlipPlanes = slotHeader->nSlipPlanes;
+    if (nDefects < 0 || nDefects > h->maxDefects || nSlipPlanes < 0 || nSlipPlanes > h->maxSlipPlanes) {
+      continue;
+    }
+
+    s->index = slotHeader->index;
+    s->time = slotHeader->time;
+    s->nDefectsTotal = slotHeader->nDefectsTotal;
+    s->positions.assign(this->slotPositions(slotHeader), this->slotPositions(slotHeader) + 2*nDefects);
+    s->types.assign(this->slotTypes(slotHeader), this->slotTypes(slotHeader) + nDefects);
+    s->slipPlanes.assign(this->slotSlipPlanes(slotHeader), this->slotSlipPlanes(slotHeader) + nSlipPlanes);
+
+    __sync_synchronize();
+    sequence1 = slotHeader->sequence;
+    if (sequence0 == sequence1) {
+      return (true);
+    }
+  }
+
+  return (false);
+}
+
+// Access functions
+/**
+ * @brief Indicates whether the ring is open.
+ * @return True if the shared memory is mapped.
+ */
+bool SnapshotRing::isOpen () const
+{
+  return (this->memory != NULL);
+}
+
+/**
+ * @brief Get the name of the shared memory object.
+ * @return The name, beginning with /.
+ */
+std::string SnapshotRing::getName () const
+{
+  return (this->name);
+}
+
+/**
+ * @brief Get the number of snapshots published so far.
+ * @return The number of snapshots.
+ */
+long SnapshotRing::getNumPublished () const
+{
+  if (this->memory == NULL) {
+    return (0);
+  }
+  return (this->header()->nPublished);
+}
+
+/**
+ * @brief Get the number of slots of the ring.
+ * @return The number of slots.
+ */
+int SnapshotRing::getNumSlots () const
+{
+  if (this->memory == NULL) {
+    return (0);
+  }
+  return (this->header()->nSlots);
+}
+
+/**
+ * @brief Indicates whether the writer has closed the ring.
+ * @return True once the writer has closed the ring.
+ */
+bool SnapshotRing::isFinished () const
+{
+  if (this->memory == NULL) {
+    return (true);
+  }
+  return (this->header()->finished != 0);
+}
@@ -0,0 +1,390 @@
+/**
+ * @file snapshotRing.h
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the class SnapshotRing.
+ * @details This file defines the class SnapshotRing, which publishes the latest snapshots of a running simulation in POSIX shared memory, for viewers running in other processes.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SNAPSHOTRING_H
+#define SNAPSHOTRING_H
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+
+// POSIX shared memory
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifndef SNAPSHOTRING_DEFAULT_SLOTS
+/**
+ * @brief Default number of snapshots kept in the ring.
+ */
+#define SNAPSHOTRING_DEFAULT_SLOTS 8
+#endif
+
+#ifndef SNAPSHOTRING_DEFAULT_MAX_DEFECTS
+/**
+ * @brief Default number of defects that a snapshot can hold. Further defects are counted but not stored.
+ */
+#define SNAPSHOTRING_DEFAULT_MAX_DEFECTS 4096
+#endif
+
+#ifndef SNAPSHOTRING_READ_ATTEMPTS
+/**
+ * @brief Number of attempts of a reader to obtain a consistent copy of a snapshot that is being written.
+ */
+#define SNAPSHOTRING_READ_ATTEMPTS 100
+#endif
+
+/**
+ * @brief Identifier written at the beginning of the shared memory.
+ */
+#define SNAPSHOTRING_MAGIC "DD2DRING"
+
+/**
+ * @brief Version of the layout of the shared memory.
+ */
+#define SNAPSHOTRING_VERSION 1
+
+/**
+ * @brief The SnapshotRingHeader struct is the header at the beginning of the shared memory.
+ */
+struct SnapshotRingHeader
+{
+  /**
+   * @brief The identifier SNAPSHOTRING_MAGIC.
+   */
+  char magic[8];
+  /**
+   * @brief The version of the layout, SNAPSHOTRING_VERSION.
+   */
+  int version;
+  /**
+   * @brief Number of slots of the ring.
+   */
+  int nSlots;
+  /**
+   * @brief Number of defects that a slot can hold.
+   */
+  int maxDefects;
+  /**
+   * @brief Number of slip planes that a slot can hold.
+   */
+  int maxSlipPlanes;
+  /**
+   * @brief Size of a slot, in bytes.
+   */
+  long slotSize;
+  /**
+   * @brief Process identifier of the writer.
+   */
+  long writerPid;
+  /**
+   * @brief Number of snapshots published so far. The latest snapshot has the index nPublished-1 and lies in the slot (nPublished-1) modulo nSlots.
+   */
+  volatile long nPublished;
+  /**
+   * @brief Non-zero once the writer has closed the ring.
+   */
+  volatile int finished;
+};
+
+/**
+ * @brief The SnapshotSlotHeader struct is the header of a slot of the ring. It is followed by the positions and types of the defects and by the statistics of the slip planes.
+ */
+struct SnapshotSlotHeader
+{
+  /**
+   * @brief Sequence counter of the seqlock. It is odd while the slot is being written.
+   */
+  volatile unsigned long sequence;
+  /**
+   * @brief Index of the snapshot held by the slot.
+   */
+  long index;
+  /**
+   * @brief Simulation time of the snapshot.
+   */
+  double time;
+  /**
+   * @brief Number of defects stored in the slot.
+   */
+  int nDefects;
+  /**
+   * @brief Number of defects in the grain, which exceeds nDefects if the slot was too small.
+   */
+  int nDefectsTotal;
+  /**
+   * @brief Number of slip planes stored in the slot.
+   */
+  int nSlipPlanes;
+  /**
+   * @brief Unused, for alignment.
+   */
+  int padding;
+};
+
+/**
+ * @brief The SnapshotSlipPlane struct holds the statistics of a slip plane in a snapshot.
+ */
+struct SnapshotSlipPlane
+{
+  /**
+   * @brief Index of the slip system to which the slip plane belongs.
+   */
+  int slipSystem;
+  /**
+   * @brief Number of dislocations on the slip plane.
+   */
+  int nDislocations;
+  /**
+   * @brief Number of dislocation sources on the slip plane.
+   */
+  int nDislocationSources;
+  /**
+   * @brief Number of dipoles emitted on the slip plane since the beginning of the simulation.
+   */
+  int nEmissions;
+  /**
+   * @brief Shear component of the plastic slip of the slip plane, between the slip direction and the normal (xz component in the local co-ordinate system of the slip plane).
+   */
+  double plasticSlip;
+};
+
+/**
+ * @brief The Snapshot struct is the copy of a snapshot obtained by a reader.
+ */
+struct Snapshot
+{
+  /**
+   * @brief Index of the snapshot.
+   */
+  long index;
+  /**
+   * @brief Simulation time of the snapshot.
+   */
+  double time;
+  /**
+   * @brief Number of defects in the grain, which may exceed the number of positions stored.
+   */
+  int nDefectsTotal;
+  /**
+   * @brief Co-ordinates of the defects in the base co-ordinate system, two per defect.
+   */
+  std::vector<double> positions;
+  /**
+   * @brief Types of the defects, as values of the enumeration DefectType.
+   */
+  std::vector<int> types;
+  /**
+   * @brief Statistics of the slip planes.
+   */
+  std::vector<SnapshotSlipPlane> slipPlanes;
+};
+
+/**
+ * @brief The SnapshotRing class publishes the latest snapshots of a simulation in POSIX shared memory.
+ * @details The shared memory holds a header followed by a ring of slots of fixed size, each holding one snapshot: the positions and types of the defects and the statistics of the slip planes. The writer never waits for the readers. Each slot is protected by a sequence lock: its counter is odd while the writer fills the slot, and a reader keeps its copy of a slot only if the counter was even and unchanged before and after copying. A reader therefore never sees a snapshot that is half written, and simply tries again, or moves on to a newer snapshot, if the writer got in the way. The same class is used by the writer, which creates the shared memory with SnapshotRing::create, and by the readers, which attach to it with SnapshotRing::attach.
+ */
+class SnapshotRing
+{
+protected:
+  /**
+   * @brief Name of the shared memory object.
+   */
+  std::string name;
+  /**
+   * @brief Pointer to the beginning of the mapped memory, NULL if the ring is closed.
+   */
+  char* memory;
+  /**
+   * @brief Size of the mapped memory, in bytes.
+   */
+  size_t size;
+  /**
+   * @brief Flag indicating whether this instance is the writer.
+   */
+  bool writer;
+  /**
+   * @brief Pointer to the slot being written between SnapshotRing::beginSnapshot and SnapshotRing::endSnapshot.
+   */
+  SnapshotSlotHeader* currentSlot;
+
+  /**
+   * @brief Get the header of the shared memory.
+   * @return Pointer to the header.
+   */
+  SnapshotRingHeader* header () const;
+  /**
+   * @brief Get the slot holding the snapshot with the given index.
+   * @param index Index of the snapshot.
+   * @return Pointer to the header of the slot.
+   */
+  SnapshotSlotHeader* slot (long index) const;
+  /**
+   * @brief Get the positions stored in a slot.
+   * @param s Pointer to the header of the slot.
+   * @return Pointer to the co-ordinates of the defects, two per defect.
+   */
+  double* slotPositions (SnapshotSlotHeader* s) const;
+  /**
+   * @brief Get the types stored in a slot.
+   * @param s Pointer to the header of the slot.
+   * @return Pointer to the types of the defects.
+   */
+  int* slotTypes (SnapshotSlotHeader* s) const;
+  /**
+   * @brief Get the statistics of the slip planes stored in a slot.
+   * @param s Pointer to the header of the slot.
+   * @return Pointer to the statistics of the slip planes.
+   */
+  SnapshotSlipPlane* slotSlipPlanes (SnapshotSlotHeader* s) const;
+  /**
+   * @brief Calculates the size of a slot.
+   * @param maxDefects Number of defects that a slot can hold.
+   * @param maxSlipPlanes Number of slip planes that a slot can hold.
+   * @return The size of a slot, in bytes, a multiple of eight.
+   */
+  static long slotSize (int maxDefects, int maxSlipPlanes);
+  /**
+   * @brief Creates and maps the shared memory object.
+   * @param shmName Name of the shared memory object, beginning with /.
+   * @param bytes Size of the shared memory, in bytes.
+   * @return False if the object exists already or could not be created.
+   */
+  bool createMemory (std::string shmName, size_t bytes);
+
+private:
+  /**
+   * @brief Copy constructor. Not implemented, since the mapping cannot be shared.
+   */
+  SnapshotRing (const SnapshotRing&);
+  /**
+   * @brief Assignment operator. Not implemented, since the mapping cannot be shared.
+   */
+  SnapshotRing& operator= (const SnapshotRing&);
+
+public:
+  // Constructors
+  /**
+   * @brief Default constructor. The ring is closed.
+   */
+  SnapshotRing ();
+
+  // Destructor
+  /**
+   * @brief Destructor for the class SnapshotRing. The ring is closed.
+   */
+  virtual ~SnapshotRing ();
+
+  // Operations
+  /**
+   * @brief Creates the shared memory for writing.
+   * @details The shared memory object is called /name. If an object of that name belongs to a process that no longer runs, it is replaced. If it belongs to a running process, such as another variant of a sweep, the object /name_pid is created instead, where pid is the identifier of this process. The name that was used is given by SnapshotRing::getName.
+   * @param name Name of the ring, without the leading /.
+   * @param nSlots Number of snapshots kept.
+   * @param maxDefects Number of defects that a snapshot can hold.
+   * @param maxSlipPlanes Number of slip planes that a snapshot can hold.
+   * @return False if the shared memory could not be created.
+   */
+  bool create (std::string name, int nSlots, int maxDefects, int maxSlipPlanes);
+  /**
+   * @brief Attaches to an existing ring for reading.
+   * @param name Name of the ring, without the leading /.
+   * @return False if the ring does not exist or has a different layout.
+   */
+  bool attach (std::string name);
+  /**
+   * @brief Closes the ring. The writer marks the ring as finished and removes the shared memory object; readers that are attached keep their mapping.
+   */
+  void close ();
+
+  /**
+   * @brief Starts writing a new snapshot into the oldest slot.
+   * @param t Simulation time of the snapshot.
+   */
+  void beginSnapshot (double t);
+  /**
+   * @brief Adds a defect to the snapshot being written. Defects beyond the capacity of the slot are only counted.
+   * @param x First co-ordinate of the defect, in the base co-ordinate system.
+   * @param y Second co-ordinate of the defect, in the base co-ordinate system.
+   * @param type Type of the defect.
+   */
+  void addDefect (double x, double y, int type);
+  /**
+   * @brief Adds the statistics of a slip plane to the snapshot being written. Slip planes beyond the capacity of the slot are ignored.
+   * @param p The statistics of the slip plane.
+   */
+  void addSlipPlane (const SnapshotSlipPlane& p);
+  /**
+   * @brief Publishes the snapshot being written.
+   */
+  void endSnapshot ();
+
+  /**
+   * @brief Copies a snapshot.
+   * @details The copy is only kept if the slot was not written during the copy; otherwise the copy is attempted again, at most SNAPSHOTRING_READ_ATTEMPTS times.
+   * @param index Index of the snapshot.
+   * @param s Pointer to the Snapshot receiving the copy.
+   * @return False if the snapshot has been overwritten by a newer one, is not yet published, or could not be copied consistently.
+   */
+  bool read (long index, Snapshot* s) const;
+
+  // Access functions
+  /**
+   * @brief Indicates whether the ring is open.
+   * @return True if the shared memory is mapped.
+   */
+  bool isOpen () const;
+  /**
+   * @brief Get the name of the shared memory object.
+   * @return The name, beginning with /.
+   */
+  std::string getName () const;
+  /**
+   * @brief Get the number of snapshots published so far.
+   * @return The number of snapshots.
+   */
+  long getNumPublished () const;
+  /**
+   * @brief Get the number of slots of the ring.
+   * @return The number of slots.
+   */
+  int getNumSlots () const;
+  /**
+   * @brief Indicates whether the writer has closed the ring.
+   * @return True once the writer has closed the ring.
+   */
+  bool isFinished () const;
+};
+
+#endif // SNAPSHOTRING_H
@@ -40,6 +40,7 @@ Statistics::Statistics ()
     this->write = false;
     this->frequency = 0;
     this->nIterationsSinceLastWrite = 0;
+    this->triggersStarted = false;
 }
 
 /**
@@ -52,10 +53,12 @@ Statistics::Statistics (bool w, int f)
   this->write = w;
   this->frequency = f;
   this->nIterationsSinceLastWrite = 0;
+  this->triggersStarted = false;
 }
 
 /**
  * @brief If the time to write the statistic has arrived.
+ * @details The counter of iterations is only incremented when the statistic is not written, so that the statistic is written every frequency+1 iterations.
  * @return True/false indicating if the statistic is to be written or not.
  */
 bool Statistics::ifWrite ()
@@ -79,6 +82,99 @@ bool Statistics::ifWrite ()
   }
 }
 
+/**
+ * @brief Indicates whether the statistic is to be written at the end of the present time step.
+ * @details Without triggers, the frequency is used through Statistics::ifWrite. Otherwise the statistic is due if one of its triggers fires, and the values of all its triggers are then reset. The quantities counted since the last output start from their values in the state initial, at the first call.
+ * @param state The state at the end of the present time step.
+ * @param initial The state at the beginning of the simulation.
+ * @return True if the statistic is to be written.
+ */
+bool Statistics::isDue (const OutputState& state, const OutputState& initial)
+{
+  std::vector<OutputTrigger>::iterator t_it;
+  bool due = false;
+  double value;
+
+  if (!this->write) {
+    return (false);
+  }
+
+  if (this->triggers.empty()) {
+    return (this->ifWrite());
+  }
+
+  if (!this->triggersStarted) {
+    for (t_it=this->triggers.begin(); t_it!=this->triggers.end(); t_it++) {
+      t_it->last = triggerValue(t_it->type, initial);
+    }
+    this->triggersStarted = true;
+  }
+
+  for (t_it=this->triggers.begin(); t_it!=this->triggers.end(); t_it++) {
+    value = triggerValue(t_it->type, state);
+    switch (t_it->type) {
+    case TRIGGER_EMISSIONS:
+    case TRIGGER_AVALANCHE:
+      // Rates during the last time step
+      due = due || ( value >= t_it->threshold );
+      break;
+    default:
+      // Increments since the last output
+      due = due || ( fabs(value - t_it->last) >= t_it->threshold * (1.0 - STATISTICS_TRIGGER_TOLERANCE) );
+      break;
+    }
+  }
+
+  if (due) {
+    for (t_it=this->triggers.begin(); t_it!=this->triggers.end(); t_it++) {
+      t_it->last = triggerValue(t_it->type, state);
+    }
+  }
+
+  return (due);
+}
+
+/**
+ * @brief Adds a trigger of the output.
+ * @param type The quantity that triggers the output.
+ * @param threshold The threshold of the quantity.
+ */
+void Statistics::addTrigger (TriggerType type, double threshold)
+{
+  OutputTrigger t;
+
+  t.type = type;
+  t.threshold = threshold;
+  t.last = 0.0;
+  this->triggers.push_back(t);
+  this->triggersStarted = false;
+}
+
+/**
+ * @brief Get the value of the quantity of a trigger in a state.
+ * @param type The quantity.
+ * @param state The state.
+ * @return The value of the quantity.
+ */
+double Statistics::triggerValue (TriggerType type, const OutputState& state)
+{
+  switch (type) {
+  case TRIGGER_ITERATIONS:
+    return ((double) state.iteration);
+  case TRIGGER_TIME:
+    return (state.time);
+  case TRIGGER_WALLCLOCK:
+    return (state.wallClock);
+  case TRIGGER_STRAIN:
+    return (state.plasticStrain);
+  case TRIGGER_EMISSIONS:
+    return ((double) state.nEmissions);
+  case TRIGGER_AVALANCHE:
+    return (state.strainRate);
+  }
+  return (0.0);
+}
+
 /**
  * @brief Adds a parameter to the vector parameters.
  * @param p The parameter to be added to the vector.
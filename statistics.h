@@ -34,9 +34,110 @@
 
 #include <vector>
 #include <string>
+#include <math.h>
+
+#ifndef STATISTICS_TRIGGER_TOLERANCE
+/**
+ * @brief Relative tolerance on the thresholds of the triggers counted since the last output, so that an interval that is a multiple of the time step is not missed by rounding.
+ */
+#define STATISTICS_TRIGGER_TOLERANCE 1.0e-09
+#endif
+
+/**
+ * @brief Enumerated type indicating the quantity that triggers the output of a statistic.
+ */
+enum TriggerType {
+    /**
+     * @brief Number of iterations since the last output.
+     */
+    TRIGGER_ITERATIONS = 0,
+    /**
+     * @brief Simulated time since the last output.
+     */
+    TRIGGER_TIME,
+    /**
+     * @brief Wall-clock time, in seconds, since the last output.
+     */
+    TRIGGER_WALLCLOCK,
+    /**
+     * @brief Increment of the equivalent plastic strain since the last output.
+     */
+    TRIGGER_STRAIN,
+    /**
+     * @brief Number of dipoles emitted during the last time step. The statistic is written at every step of an emission burst.
+     */
+    TRIGGER_EMISSIONS,
+    /**
+     * @brief Equivalent plastic strain rate during the last time step. The statistic is written at every step of an avalanche.
+     */
+    TRIGGER_AVALANCHE
+};
+
+/**
+ * @brief The OutputTrigger struct holds a condition for the output of a statistic.
+ */
+struct OutputTrigger
+{
+    /**
+     * @brief The quantity that is compared to the threshold.
+     */
+    TriggerType type;
+    /**
+     * @brief The threshold. The trigger fires when the quantity reaches it.
+     */
+    double threshold;
+    /**
+     * @brief The value of the quantity at the last output, for the quantities that are counted since the last output.
+     */
+    double last;
+};
+
+/**
+ * @brief The OutputState struct holds the quantities on which the triggers of the statistics are evaluated, at the end of a time step.
+ */
+struct OutputState
+{
+    /**
+     * @brief Number of iterations carried out.
+     */
+    int iteration;
+    /**
+     * @brief Simulated time.
+     */
+    double time;
+    /**
+     * @brief Wall-clock time since the beginning of the simulation, in seconds.
+     */
+    double wallClock;
+    /**
+     * @brief Equivalent plastic strain.
+     */
+    double plasticStrain;
+    /**
+     * @brief Equivalent plastic strain rate during the last time step.
+     */
+    double strainRate;
+    /**
+     * @brief Number of dipoles emitted during the last time step.
+     */
+    int nEmissions;
+    /**
+     * @brief Number of pairs of dislocations annihilated during the last time step.
+     */
+    int nAnnihilations;
+    /**
+     * @brief Flag indicating whether a burst of plastic activity is under way, as detected by the output scheduler.
+     */
+    bool burst;
+    /**
+     * @brief Flag indicating whether the burst started during the last time step.
+     */
+    bool burstStart;
+};
 
 /**
  * @brief Statistics class indicating a flag and frequency for writing statistics.
+ * @details Without triggers, a statistic is written according to its frequency, counted by Statistics::ifWrite. Triggers added with Statistics::addTrigger replace the frequency: the statistic is then written, by Statistics::isDue, at the end of every time step at which one of its triggers fires.
  */
 class Statistics
 {
@@ -61,6 +162,14 @@ public:
    * @brief String with the name of the statistic, also to be used as the the template for filenames.
    */
   std::string name;
+  /**
+   * @brief The triggers of the output. If there are none, the frequency is used.
+   */
+  std::vector<OutputTrigger> triggers;
+  /**
+   * @brief Flag indicating whether the values of the triggers at the last output have been set.
+   */
+  bool triggersStarted;
   
   // Constructors
   /**
@@ -88,9 +197,31 @@ public:
 
   /**
    * @brief If the time to write the statistic has arrived.
+   * @details The counter of iterations is only incremented when the statistic is not written, so that the statistic is written every frequency+1 iterations.
    * @return True/false indicating if the statistic is to be written or not.
    */
   bool ifWrite ();
+  /**
+   * @brief Indicates whether the statistic is to be written at the end of the present time step.
+   * @details Without triggers, the frequency is used through Statistics::ifWrite. Otherwise the statistic is due if one of its triggers fires, and the values of all its triggers are then reset. The quantities counted since the last output start from their values in the state initial, at the first call.
+   * @param state The state at the end of the present time step.
+   * @param initial The state at the beginning of the simulation.
+   * @return True if the statistic is to be written.
+   */
+  bool isDue (const OutputState& state, const OutputState& initial);
+  /**
+   * @brief Adds a trigger of the output.
+   * @param type The quantity that triggers the output.
+   * @param threshold The threshold of the quantity.
+   */
+  void addTrigger (TriggerType type, double threshold);
+  /**
+   * @brief Get the value of the quantity of a trigger in a state.
+   * @param type The quantity.
+   * @param state The state.
+   * @return The value of the quantity.
+   */
+  static double triggerValue (TriggerType type, const OutputState& state);
   /**
    * @brief Adds a parameter to the vector parameters.
    * @param p The parameter to be added to the vector.
@@ -0,0 +1,561 @@
+/**
+ * @file stepGenerator.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the member functions of the classes StepGenerator, GrainStepGenerator, SlipSystemStepGenerator and SlipPlaneStepGenerator.
+ * @details This file defines the member functions of the generators that carry out the iterations of a simulation one time step at a time, at the request of the calling program.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "stepGenerator.h"
+#include "simulateGrain.h"
+
+// StepGenerator
+/**
+ * @brief Constructor specifying the parameters and the initial time.
+ * @param param Pointer to the simulation parameters. They belong to the calling program.
+ * @param currentTime The simulation time at the beginning.
+ */
+StepGenerator::StepGenerator (Parameter* param, double currentTime)
+{
+    this->param = param;
+    this->totalTime = currentTime;
+    this->nIterations = 0;
+    this->limitingDistance = 0.0;
+    this->reactionRadius = 0.0;
+    this->started = false;
+    this->finished = false;
+    this->configured = false;
+    this->writeStatistics = false;
+}
+
+/**
+ * @brief Applies the parameters to the simulated object.
+ * @details The limiting distance and the reaction radius are calculated, the flush interval of the text outputs is set, and StepGenerator::applyParameters is called.
+ */
+void StepGenerator::configure ()
+{
+    this->limitingDistance = ( this->param->limitingDistance * this->param->bmag );
+    this->reactionRadius = ( this->param->reactionRadius * this->param->bmag );
+    TextWriter::setDefaultFlushInterval(this->param->flushInterval);
+    this->applyParameters();
+    this->configured = true;
+}
+
+/**
+ * @brief Indicates whether the stopping criterion of the parameters has been reached.
+ * @return True if the simulation time or the number of iterations has exceeded its limit.
+ */
+bool StepGenerator::stoppingCriterionReached () const
+{
+    if ( this->param->stopAfterTime ) {
+        // The stopping criterion is time
+        return ( this->totalTime > this->param->stopTime );
+    }
+    else {
+        // The stopping criterion is iterations
+        return ( this->nIterations > this->param->stopIterations );
+    }
+}
+
+/**
+ * @brief Records the initial state of the simulated object in the output scheduler.
+ */
+void StepGenerator::startScheduler ()
+{
+    double plasticStrain;
+    int nEmissions;
+    int nAnnihilations;
+
+    this->measure(&plasticStrain, &nEmissions, &nAnnihilations);
+    this->scheduler.setBurstDetection(this->param->burstStrainRate, this->param->burstEmissions, this->param->burstAnnihilations, this->param->burstQuietSteps);
+    this->scheduler.begin(this->nIterations, this->totalTime, plasticStrain, nEmissions, nAnnihilations);
+}
+
+/**
+ * @brief Measures the quantities on which the output triggers depend.
+ * @details The default implementation measures neither strain nor emissions nor annihilations, so that only the triggers on iterations, simulated time and wall-clock time apply.
+ * @param plasticStrain Pointer to the variable receiving the equivalent plastic strain.
+ * @param nEmissions Pointer to the variable receiving the total number of emissions.
+ * @param nAnnihilations Pointer to the variable receiving the total number of annihilations.
+ */
+void StepGenerator::measure (double* plasticStrain, int* nEmissions, int* nAnnihilations)
+{
+    *plasticStrain = 0.0;
+    *nEmissions = 0;
+    *nAnnihilations = 0;
+}
+
+/**
+ * @brief Called once before the first time step, after the parameters have been applied.
+ */
+void StepGenerator::begin ()
+{
+
+}
+
+/**
+ * @brief Sets whether the statistics requested in the parameters are written after each step.
+ * @param write True to write the statistics in the output directory of the parameters.
+ */
+void StepGenerator::setStatisticsOutput (bool write)
+{
+    this->writeStatistics = write;
+}
+
+/**
+ * @brief Indicates that the parameters have changed. They are applied again before the next time step.
+ */
+void StepGenerator::reconfigure ()
+{
+    this->configured = false;
+}
+
+/**
+ * @brief Get the present simulation time.
+ * @return The simulation time.
+ */
+double StepGenerator::getTime () const
+{
+    return (this->totalTime);
+}
+
+/**
+ * @brief Get the number of iterations carried out.
+ * @return The number of iterations.
+ */
+int StepGenerator::getIteration () const
+{
+    return (this->nIterations);
+}
+
+/**
+ * @brief Indicates whether the simulation has ended.
+ * @return True if the simulation was stopped or the stopping criterion of the parameters has been reached.
+ */
+bool StepGenerator::isFinished () const
+{
+    return ( this->finished || ( this->started && this->stoppingCriterionReached() ) );
+}
+
+/**
+ * @brief Carries out the next time step.
+ * @details The first time step is always carried out. Every further step is only carried out if the stopping criterion has not been reached, like the loops of the functions grain_iterate, singleSlipSystem_iterate and singleSlipPlane_iterate.
+ * @param record Pointer to the StepRecord receiving the description of the time step. It may be NULL.
+ * @return True if a time step was carried out, false once the simulation has ended.
+ */
+bool StepGenerator::next (StepRecord* record)
+{
+    double timeIncrement;
+    double plasticStrain;
+    int nEmissions;
+    int nAnnihilations;
+
+    if (this->isFinished()) {
+        this->finished = true;
+        return (false);
+    }
+
+    if (!this->configured) {
+        this->configure();
+    }
+
+    if (!this->started) {
+        if (this->writeStatistics) {
+            this->startScheduler();
+        }
+        this->begin();
+        this->started = true;
+    }
+
+    timeIncrement = this->advance();
+
+    // Increment counters
+    this->totalTime += timeIncrement;
+    this->nIterations++;
+
+    if (this->writeStatistics) {
+        if (!this->scheduler.isStarted()) {
+            this->startScheduler();
+        }
+        this->measure(&plasticStrain, &nEmissions, &nAnnihilations);
+        this->scheduler.update(this->nIterations, this->totalTime, timeIncrement, plasticStrain, nEmissions, nAnnihilations);
+        this->writeStepStatistics();
+    }
+
+    if (record != NULL) {
+        record->iteration = this->nIterations;
+        record->time = this->totalTime;
+        record->timeIncrement = timeIncrement;
+    }
+
+    return (true);
+}
+
+/**
+ * @brief Stops the simulation. No further time steps are carried out.
+ */
+void StepGenerator::stop ()
+{
+    this->finished = true;
+}
+
+// GrainStepGenerator
+/**
+ * @brief Constructor specifying the parameters, the grain and the initial time.
+ * @param param Pointer to the simulation parameters.
+ * @param grain Pointer to the grain.
+ * @param currentTime The simulation time at the beginning.
+ */
+GrainStepGenerator::GrainStepGenerator (Parameter* param, Grain* grain, double currentTime)
+    : StepGenerator (param, currentTime)
+{
+    this->grain = grain;
+    this->gbResolution = 100;
+}
+
+/**
+ * @brief Applies the parameters that are stored in the grain, with the function grain_configure.
+ */
+void GrainStepGenerator::applyParameters ()
+{
+    this->gbResolution = grain_configure(this->param, this->grain);
+}
+
+/**
+ * @brief Carries out one time step.
+ * @return The duration of the time step.
+ */
+double GrainStepGenerator::advance ()
+{
+    grain_step(this->param, this->grain, this->limitingDistance, this->reactionRadius);
+    return (this->param->limitingTimeStep);
+}
+
+/**
+ * @brief Writes the statistics that are due at the present iteration.
+ */
+void GrainStepGenerator::writeStepStatistics ()
+{
+    grain_writeStatistics(this->param, this->grain, &(this->scheduler), this->gbResolution);
+}
+
+/**
+ * @brief Measures the equivalent plastic strain of the grain and the total numbers of emissions and annihilations.
+ * @param plasticStrain Pointer to the variable receiving the equivalent plastic strain.
+ * @param nEmissions Pointer to the variable receiving the total number of emissions.
+ * @param nAnnihilations Pointer to the variable receiving the total number of annihilations.
+ */
+void GrainStepGenerator::measure (double* plasticStrain, int* nEmissions, int* nAnnihilations)
+{
+    *plasticStrain = OutputScheduler::equivalentStrain(this->grain->getPlasticStrain());
+    *nEmissions = this->grain->getNumEmissions();
+    *nAnnihilations = this->grain->getNumAnnihilations();
+}
+
+/**
+ * @brief Get a pointer to the grain.
+ * @return Pointer to the grain.
+ */
+Grain* GrainStepGenerator::getGrain ()
+{
+    return (this->grain);
+}
+
+// SlipSystemStepGenerator
+/**
+ * @brief Constructor specifying the parameters, the slip system and the initial time.
+ * @param param Pointer to the simulation parameters.
+ * @param slipSystem Pointer to the slip system.
+ * @param currentTime The simulation time at the beginning.
+ */
+SlipSystemStepGenerator::SlipSystemStepGenerator (Parameter* param, SlipSystem* slipSystem, double currentTime)
+    : StepGenerator (param, currentTime)
+{
+    this->slipSystem = slipSystem;
+}
+
+/**
+ * @brief Applies the parameters that are stored in the slip system.
+ * @details These are the applied stress on the slip system and its slip planes, the kernel tables and the free surfaces.
+ */
+void SlipSystemStepGenerator::applyParameters ()
+{
+    // Calculate the applied stress in the slip system's co-ordinate systems
+    // as well as on each slip plane, in their local co-ordinate systems
+    this->slipSystem->calculateSlipSystemAppliedStress(this->param->appliedStress);
+    this->slipSystem->calculateSlipPlaneAppliedStress();
+
+    // Interpolate the interactions between parallel slip planes if requested
+    this->slipSystem->setKernelTables(this->param->tabulatedKernels, this->param->kernelTolerance, this->param->singlePrecisionKernels);
+
+    // Free surfaces at the extremities of the slip planes if requested
+    this->slipSystem->setFreeSurfaces(this->param->freeSurfaces, this->param->getImageForceCutoff());
+}
+
+/**
+ * @brief Carries out one time step.
+ * @return The duration of the time step.
+ */
+double SlipSystemStepGenerator::advance ()
+{
+    std::vector<double> timeIncrement;
+
+    // Calculate stresses on all defects
+    this->slipSystem->calculateAllStresses(this->param->mu, this->param->nu);
+
+    // Calculate dislocation velocities
+    this->slipSystem->calculateSlipPlaneDislocationForcesVelocities(this->param->B, this->param->mu, this->param->nu);
+
+    // Time increment
+    switch (this->param->timeStepType) {
+    case ADAPTIVE:
+        // This part is pending
+        timeIncrement = this->slipSystem->calculateTimeIncrement(this->limitingDistance, this->param->limitingTimeStep);
+        break;
+
+    case FIXED:
+        this->slipSystem->setTimeIncrement(this->param->limitingTimeStep);
+        this->slipSystem->moveSlipPlaneDislocations(this->limitingDistance, this->param->limitingTimeStep, this->param->mu, this->param->nu);
+        break;
+    }
+
+    // Check dislocation sources on all slip planes
+    this->slipSystem->checkSlipPlaneDislocationSources(this->param->limitingTimeStep, this->param->mu, this->param->nu, this->limitingDistance);
+
+    // Check local reactions on all slip planes
+    this->slipSystem->checkSlipPlaneLocalReactions(this->reactionRadius);
+
+    return (this->slipSystem->getTimeIncrement());
+}
+
+/**
+ * @brief Measures the total numbers of emissions and annihilations of the slip system. The plastic strain is not measured.
+ * @param plasticStrain Pointer to the variable receiving the equivalent plastic strain.
+ * @param nEmissions Pointer to the variable receiving the total number of emissions.
+ * @param nAnnihilations Pointer to the variable receiving the total number of annihilations.
+ */
+void SlipSystemStepGenerator::measure (double* plasticStrain, int* nEmissions, int* nAnnihilations)
+{
+    *plasticStrain = 0.0;
+    *nEmissions = this->slipSystem->getNumEmissions();
+    *nAnnihilations = this->slipSystem->getNumAnnihilations();
+}
+
+/**
+ * @brief Writes the statistics that are due at the present iteration.
+ */
+void SlipSystemStepGenerator::writeStepStatistics ()
+{
+    std::string fileName;
+
+    if (this->scheduler.isDue(&(this->param->slipSystemObjectPositions))) {
+        fileName = this->param->output_dir + "/" + this->param->slipSystemObjectPositions.name + ".txt";
+        this->slipSystem->writeAllDefects( fileName, this->totalTime );
+        fileName.clear ();
+    }
+
+    if (this->scheduler.isDue(&(this->param->kernelPrecision))) {
+        fileName = this->param->output_dir + "/" + this->param->kernelPrecision.name + ".txt";
+        this->slipSystem->writeKernelPrecision( fileName, this->totalTime, this->param->mu, this->param->nu );
+        fileName.clear ();
+    }
+}
+
+/**
+ * @brief Get a pointer to the slip system.
+ * @return Pointer to the slip system.
+ */
+SlipSystem* SlipSystemStepGenerator::getSlipSystem ()
+{
+    return (this->slipSystem);
+}
+
+// SlipPlaneStepGenerator
+/**
+ * @brief Constructor specifying the parameters, the slip plane and the initial time.
+ * @param param Pointer to the simulation parameters.
+ * @param slipPlane Pointer to the slip plane.
+ * @param currentTime The simulation time at the beginning.
+ */
+SlipPlaneStepGenerator::SlipPlaneStepGenerator (Parameter* param, SlipPlane* slipPlane, double currentTime)
+    : StepGenerator (param, currentTime)
+{
+    this->slipPlane = slipPlane;
+}
+
+/**
+ * @brief Applies the parameters that are stored in the slip plane.
+ * @details These are the applied stress on the slip plane and the free surfaces.
+ */
+void SlipPlaneStepGenerator::applyParameters ()
+{
+    // Calculate stresses in slip plane system.
+    this->slipPlane->calculateSlipPlaneAppliedStress(this->param->appliedStress);
+
+    // Free surfaces at the extremities of the slip plane if requested
+    if (this->param->freeSurfaces) {
+        this->slipPlane->setExtremityType(FREESURFACE);
+        this->slipPlane->setImageForceCutoff(this->param->getImageForceCutoff());
+    }
+}
+
+/**
+ * @brief Opens the archive if it is requested and writes the statistics of the initial state that are due.
+ */
+void SlipPlaneStepGenerator::begin ()
+{
+    if (this->writeStatistics) {
+        if (!this->param->archiveFile.empty() && !this->archive.isOpen()) {
+            if (!this->archive.open(this->param->output_dir + "/" + this->param->archiveFile)) {
+                displayMessage("Error: Unable to open the archive " + this->param->output_dir + "/" + this->param->archiveFile);
+            }
+        }
+        this->writeSlipPlaneStatistics();
+    }
+}
+
+/**
+ * @brief Carries out one time step.
+ * @return The duration of the time step.
+ */
+double SlipPlaneStepGenerator::advance ()
+{
+    std::vector<double> timeIncrement;
+
+    // Calculate stresses on all defects
+    this->slipPlane->calculateDefectStresses ( this->param->mu, this->param->nu );
+
+    /*
+     * Treat the dislocations
+     */
+    // Calculate forces on dislocations
+    this->slipPlane->calculateDislocationForces ( this->param->mu, this->param->nu );
+    // Calculate dislocation velocities
+    this->slipPlane->calculateDislocationVelocities ( this->param->B );
+    switch (this->param->timeStepType) {
+    case ADAPTIVE:
+        // Calculate the time increment
+        timeIncrement = this->slipPlane->calculateTimeIncrement ( this->limitingDistance,
+                                                                  this->param->limitingTimeStep );
+        // Displace the dislocations
+        this->slipPlane->moveDislocations ( timeIncrement, this->limitingDistance );
+        break;
+
+    case FIXED:
+        this->slipPlane->setTimeIncrement(this->param->limitingTimeStep);
+        this->slipPlane->moveDislocationsToLocalEquilibrium( this->limitingDistance,
+                                                             this->param->limitingTimeStep,
+                                                             this->param->mu, this->param->nu );
+        break;
+    }
+
+    /*
+     * Treat the dislocation sources
+     */
+    this->slipPlane->checkDislocationSources(this->slipPlane->getTimeIncrement(), this->param->mu, this->param->nu, this->limitingDistance);
+
+    // Check for local reactions
+    this->slipPlane->checkLocalReactions(this->reactionRadius);
+
+    return (this->slipPlane->getTimeIncrement());
+}
+
+/**
+ * @brief Measures the total numbers of emissions and annihilations of the slip plane. The plastic strain is not measured.
+ * @param plasticStrain Pointer to the variable receiving the equivalent plastic strain.
+ * @param nEmissions Pointer to the variable receiving the total number of emissions.
+ * @param nAnnihilations Pointer to the variable receiving the total number of annihilations.
+ */
+void SlipPlaneStepGenerator::measure (double* plasticStrain, int* nEmissions, int* nAnnihilations)
+{
+    *plasticStrain = 0.0;
+    *nEmissions = this->slipPlane->getNumEmissions();
+    *nAnnihilations = this->slipPlane->getNumAnnihilations();
+}
+
+/**
+ * @brief Writes the dislocation positions and the stress distribution along the slip plane if they are due.
+ * @details Each output is written to its own file, named with the present time, or appended as a record of that name to the archive if it is open.
+ */
+void SlipPlaneStepGenerator::writeSlipPlaneStatistics ()
+{
+    std::string fileName;
+    TextWriter data;
+
+    if ( this->scheduler.isDue(&(this->param->dislocationPositions)) ) {
+        fileName = this->param->dislocationPositions.name + doubleToString ( this->totalTime ) + ".txt";
+        if ( this->archive.isOpen() ) {
+            data.clear ();
+            this->slipPlane->writeSlipPlane ( data, this->totalTime );
+            this->archive.addRecord ( fileName, this->totalTime, data.str() );
+        }
+        else {
+            this->slipPlane->writeSlipPlane ( this->param->output_dir + "/" + fileName, this->totalTime );
+        }
+        fileName.clear ();
+    }
+
+    if ( this->scheduler.isDue(&(this->param->slipPlaneStressDistributions)) ) {
+        fileName = this->param->slipPlaneStressDistributions.name + doubleToString ( this->totalTime ) + ".txt";
+        if ( this->archive.isOpen() ) {
+            data.clear ();
+            this->slipPlane->writeSlipPlaneStressDistribution ( data,
+                                                                this->param->slipPlaneStressDistributions.parameters[0],
+                                                                this->param );
+            this->archive.addRecord ( fileName, this->totalTime, data.str() );
+        }
+        else {
+            this->slipPlane->writeSlipPlaneStressDistribution ( this->param->output_dir + "/" + fileName,
+                                                                this->param->slipPlaneStressDistributions.parameters[0],
+                                                                this->param );
+        }
+        fileName.clear ();
+    }
+}
+
+/**
+ * @brief Writes the statistics that are due at the present iteration.
+ */
+void SlipPlaneStepGenerator::writeStepStatistics ()
+{
+    std::string fileName;
+
+    this->writeSlipPlaneStatistics();
+
+    if ( this->scheduler.isDue(&(this->param->allDefectPositions)) ) {
+        fileName = this->param->output_dir + "/" + this->param->allDefectPositions.name + ".txt";
+        this->slipPlane->writeAllDefects( fileName, this->totalTime );
+        fileName.clear();
+    }
+}
+
+/**
+ * @brief Get a pointer to the slip plane.
+ * @return Pointer to the slip plane.
+ */
+SlipPlane* SlipPlaneStepGenerator::getSlipPlane ()
+{
+    return (this->slipPlane);
+}
@@ -0,0 +1,392 @@
+/**
+ * @file stepGenerator.h
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the classes StepGenerator, GrainStepGenerator, SlipSystemStepGenerator and SlipPlaneStepGenerator.
+ * @details This file defines the generators that carry out the iterations of a simulation one time step at a time, at the request of the calling program.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef STEPGENERATOR_H
+#define STEPGENERATOR_H
+
+#include <string>
+#include <vector>
+
+#include "grain.h"
+#include "slipsystem.h"
+#include "slipPlane.h"
+#include "parameter.h"
+#include "outputScheduler.h"
+#include "timeSeriesArchive.h"
+#include "tools.h"
+
+/**
+ * @brief The StepRecord struct describes the time step that was just carried out by a generator.
+ */
+struct StepRecord
+{
+    /**
+     * @brief Number of iterations carried out, including this one.
+     */
+    int iteration;
+    /**
+     * @brief Simulation time at the end of the time step.
+     */
+    double time;
+    /**
+     * @brief Duration of the time step.
+     */
+    double timeIncrement;
+};
+
+/**
+ * @brief The StepGenerator class carries out the iterations of a simulation one time step at a time.
+ * @details Each call to StepGenerator::next carries out one time step and fills a StepRecord, until the stopping criterion of the parameters is reached. The calling program thereby pulls the time steps one by one, and can read the state of the simulated object or change the parameters between two steps; after a change, StepGenerator::reconfigure applies the parameters again before the next step. The simulation may be stopped at any time with StepGenerator::stop, or by simply not asking for further steps. The statistics requested in the parameters are only written if StepGenerator::setStatisticsOutput was called, and nothing is printed, so that a step costs no more than the calculations themselves. When they are written, the state of the simulated object is measured once per step by an OutputScheduler, which then decides for every statistic whether its triggers have fired. The derived classes carry out the time steps of a grain, a slip system and a slip plane.
+ */
+class StepGenerator
+{
+protected:
+    /**
+     * @brief Pointer to the simulation parameters.
+     */
+    Parameter* param;
+    /**
+     * @brief The present simulation time.
+     */
+    double totalTime;
+    /**
+     * @brief Number of iterations carried out.
+     */
+    int nIterations;
+    /**
+     * @brief The limiting distance between defects, in metres.
+     */
+    double limitingDistance;
+    /**
+     * @brief The radius within which local reactions take place, in metres.
+     */
+    double reactionRadius;
+    /**
+     * @brief Flag indicating whether the first time step has been requested.
+     */
+    bool started;
+    /**
+     * @brief Flag indicating whether the simulation has been stopped.
+     */
+    bool finished;
+    /**
+     * @brief Flag indicating whether the parameters have been applied since they last changed.
+     */
+    bool configured;
+    /**
+     * @brief Flag indicating whether the statistics are written after each step.
+     */
+    bool writeStatistics;
+    /**
+     * @brief Decides which statistics are written after each step.
+     */
+    OutputScheduler scheduler;
+
+    /**
+     * @brief Applies the parameters to the simulated object.
+     * @details The limiting distance and the reaction radius are calculated, the flush interval of the text outputs is set, and StepGenerator::applyParameters is called.
+     */
+    void configure ();
+    /**
+     * @brief Indicates whether the stopping criterion of the parameters has been reached.
+     * @return True if the simulation time or the number of iterations has exceeded its limit.
+     */
+    bool stoppingCriterionReached () const;
+    /**
+     * @brief Records the initial state of the simulated object in the output scheduler.
+     */
+    void startScheduler ();
+
+    /**
+     * @brief Applies the parameters that are stored in the simulated object.
+     */
+    virtual void applyParameters () = 0;
+    /**
+     * @brief Measures the quantities on which the output triggers depend.
+     * @details The default implementation measures neither strain nor emissions nor annihilations, so that only the triggers on iterations, simulated time and wall-clock time apply.
+     * @param plasticStrain Pointer to the variable receiving the equivalent plastic strain.
+     * @param nEmissions Pointer to the variable receiving the total number of emissions.
+     * @param nAnnihilations Pointer to the variable receiving the total number of annihilations.
+     */
+    virtual void measure (double* plasticStrain, int* nEmissions, int* nAnnihilations);
+    /**
+     * @brief Called once before the first time step, after the parameters have been applied.
+     */
+    virtual void begin ();
+    /**
+     * @brief Carries out one time step.
+     * @return The duration of the time step.
+     */
+    virtual double advance () = 0;
+    /**
+     * @brief Writes the statistics that are due at the present iteration, according to the output scheduler.
+     */
+    virtual void writeStepStatistics () = 0;
+
+public:
+    // Constructors
+    /**
+     * @brief Constructor specifying the parameters and the initial time.
+     * @param param Pointer to the simulation parameters. They belong to the calling program.
+     * @param currentTime The simulation time at the beginning.
+     */
+    StepGenerator (Parameter* param, double currentTime);
+
+    // Destructor
+    /**
+     * @brief Destructor for the class StepGenerator.
+     */
+    virtual ~StepGenerator ()
+    {
+
+    }
+
+    // Assignment functions
+    /**
+     * @brief Sets whether the statistics requested in the parameters are written after each step.
+     * @param write True to write the statistics in the output directory of the parameters.
+     */
+    void setStatisticsOutput (bool write);
+    /**
+     * @brief Indicates that the parameters have changed. They are applied again before the next time step.
+     */
+    void reconfigure ();
+
+    // Access functions
+    /**
+     * @brief Get the present simulation time.
+     * @return The simulation time.
+     */
+    double getTime () const;
+    /**
+     * @brief Get the number of iterations carried out.
+     * @return The number of iterations.
+     */
+    int getIteration () const;
+    /**
+     * @brief Indicates whether the simulation has ended.
+     * @return True if the simulation was stopped or the stopping criterion of the parameters has been reached.
+     */
+    bool isFinished () const;
+
+    // Operations
+    /**
+     * @brief Carries out the next time step.
+     * @details The first time step is always carried out. Every further step is only carried out if the stopping criterion has not been reached, like the loops of the functions grain_iterate, singleSlipSystem_iterate and singleSlipPlane_iterate.
+     * @param record Pointer to the StepRecord receiving the description of the time step. It may be NULL.
+     * @return True if a time step was carried out, false once the simulation has ended.
+     */
+    bool next (StepRecord* record);
+    /**
+     * @brief Stops the simulation. No further time steps are carried out.
+     */
+    void stop ();
+};
+
+/**
+ * @brief The GrainStepGenerator class carries out the time steps of the simulation of a grain.
+ * @details A time step is carried out by the function grain_step and the statistics are written by grain_writeStatistics.
+ */
+class GrainStepGenerator : public StepGenerator
+{
+protected:
+    /**
+     * @brief Pointer to the grain. The grain belongs to the calling program.
+     */
+    Grain* grain;
+    /**
+     * @brief The number of grain boundary stress probes per segment of the grain boundary.
+     */
+    int gbResolution;
+
+    /**
+     * @brief Applies the parameters that are stored in the grain, with the function grain_configure.
+     */
+    virtual void applyParameters ();
+    /**
+     * @brief Carries out one time step.
+     * @return The duration of the time step.
+     */
+    virtual double advance ();
+    /**
+     * @brief Measures the equivalent plastic strain of the grain and the total numbers of emissions and annihilations.
+     * @param plasticStrain Pointer to the variable receiving the equivalent plastic strain.
+     * @param nEmissions Pointer to the variable receiving the total number of emissions.
+     * @param nAnnihilations Pointer to the variable receiving the total number of annihilations.
+     */
+    virtual void measure (double* plasticStrain, int* nEmissions, int* nAnnihilations);
+    /**
+     * @brief Writes the statistics that are due at the present iteration.
+     */
+    virtual void writeStepStatistics ();
+
+public:
+    // Constructors
+    /**
+     * @brief Constructor specifying the parameters, the grain and the initial time.
+     * @param param Pointer to the simulation parameters.
+     * @param grain Pointer to the grain.
+     * @param currentTime The simulation time at the beginning.
+     */
+    GrainStepGenerator (Parameter* param, Grain* grain, double currentTime);
+
+    // Access functions
+    /**
+     * @brief Get a pointer to the grain.
+     * @return Pointer to the grain.
+     */
+    Grain* getGrain ();
+};
+
+/**
+ * @brief The SlipSystemStepGenerator class carries out the time steps of the simulation of a single slip system.
+ */
+class SlipSystemStepGenerator : public StepGenerator
+{
+protected:
+    /**
+     * @brief Pointer to the slip system. The slip system belongs to the calling program.
+     */
+    SlipSystem* slipSystem;
+
+    /**
+     * @brief Applies the parameters that are stored in the slip system.
+     * @details These are the applied stress on the slip system and its slip planes, the kernel tables and the free surfaces.
+     */
+    virtual void applyParameters ();
+    /**
+     * @brief Carries out one time step.
+     * @return The duration of the time step.
+     */
+    virtual double advance ();
+    /**
+     * @brief Measures the total numbers of emissions and annihilations of the slip system. The plastic strain is not measured.
+     * @param plasticStrain Pointer to the variable receiving the equivalent plastic strain.
+     * @param nEmissions Pointer to the variable receiving the total number of emissions.
+     * @param nAnnihilations Pointer to the variable receiving the total number of annihilations.
+     */
+    virtual void measure (double* plasticStrain, int* nEmissions, int* nAnnihilations);
+    /**
+     * @brief Writes the statistics that are due at the present iteration.
+     */
+    virtual void writeStepStatistics ();
+
+public:
+    // Constructors
+    /**
+     * @brief Constructor specifying the parameters, the slip system and the initial time.
+     * @param param Pointer to the simulation parameters.
+     * @param slipSystem Pointer to the slip system.
+     * @param currentTime The simulation time at the beginning.
+     */
+    SlipSystemStepGenerator (Parameter* param, SlipSystem* slipSystem, double currentTime);
+
+    // Access functions
+    /**
+     * @brief Get a pointer to the slip system.
+     * @return Pointer to the slip system.
+     */
+    SlipSystem* getSlipSystem ();
+};
+
+/**
+ * @brief The SlipPlaneStepGenerator class carries out the time steps of the simulation of a single slip plane.
+ */
+class SlipPlaneStepGenerator : public StepGenerator
+{
+protected:
+    /**
+     * @brief Pointer to the slip plane. The slip plane belongs to the calling program.
+     */
+    SlipPlane* slipPlane;
+    /**
+     * @brief Archive receiving the dislocation positions and the stress distributions, if Parameter::archiveFile is given.
+     */
+    TimeSeriesArchive archive;
+
+    /**
+     * @brief Applies the parameters that are stored in the slip plane.
+     * @details These are the applied stress on the slip plane and the free surfaces.
+     */
+    virtual void applyParameters ();
+    /**
+     * @brief Opens the archive if it is requested and writes the statistics of the initial state that are due.
+     */
+    virtual void begin ();
+    /**
+     * @brief Carries out one time step.
+     * @return The duration of the time step.
+     */
+    virtual double advance ();
+    /**
+     * @brief Measures the total numbers of emissions and annihilations of the slip plane. The plastic strain is not measured.
+     * @param plasticStrain Pointer to the variable receiving the equivalent plastic strain.
+     * @param nEmissions Pointer to the variable receiving the total number of emissions.
+     * @param nAnnihilations Pointer to the variable receiving the total number of annihilations.
+     */
+    virtual void measure (double* plasticStrain, int* nEmissions, int* nAnnihilations);
+    /**
+     * @brief Writes the statistics that are due at the present iteration.
+     */
+    virtual void writeStepStatistics ();
+    /**
+     * @brief Writes the dislocation positions and the stress distribution along the slip plane if they are due.
+     * @details Each output is written to its own file, named with the present time, or appended as a record of that name to the archive if it is open.
+     */
+    void writeSlipPlaneStatistics ();
+
+public:
+    // Constructors
+    /**
+     * @brief Constructor specifying the parameters, the slip plane and the initial time.
+     * @param param Pointer to the simulation parameters.
+     * @param slipPlane Pointer to the slip plane.
+     * @param currentTime The simulation time at the beginning.
+     */
+    SlipPlaneStepGenerator (Parameter* param, SlipPlane* slipPlane, double currentTime);
+
+    // Destructor
+    /**
+     * @brief Destructor for the class SlipPlaneStepGenerator. The archive is closed, which writes its index.
+     */
+    virtual ~SlipPlaneStepGenerator ()
+    {
+        this->archive.close();
+    }
+
+    // Access functions
+    /**
+     * @brief Get a pointer to the slip plane.
+     * @return Pointer to the slip plane.
+     */
+    SlipPlane* getSlipPlane ();
+};
+
+#endif // STEPGENERATOR_H
@@ -267,8 +267,8 @@ Strain Strain::rotate (RotationMatrix alpha)
 
   // Rotate the strain matrix
   Matrix33 m = alpha * ((*this) * alphaT);
-  double *principalStrain = new double[3];
-  double *shearStrain = new double[3];
+  double principalStrain[3];
+  double shearStrain[3];
   int i;
 
   for (i=0; i<3; i++)
@@ -280,8 +280,5 @@ Strain Strain::rotate (RotationMatrix alpha)
   shearStrain[2] = m.getValue(1,2);
   Strain sNew = Strain (principalStrain, shearStrain);
 
-  delete (principalStrain); principalStrain = NULL;
-  delete (shearStrain);     shearStrain = NULL;
-
   return (sNew);
 }
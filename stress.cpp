@@ -267,8 +267,8 @@ Stress Stress::rotate (RotationMatrix alpha)
 
   // Rotate the stress matrix
   Matrix33 m = alpha * ((*this) * alphaT);
-  double *principalStress = new double[3];
-  double *shearStress = new double[3];
+  double principalStress[3];
+  double shearStress[3];
   int i;
 
   for (i=0; i<3; i++)
@@ -280,8 +280,5 @@ Stress Stress::rotate (RotationMatrix alpha)
   shearStress[2] = m.getValue(1,2);
   Stress sNew = Stress (principalStress, shearStress);
 
-  delete (principalStress); principalStress = NULL;
-  delete (shearStress);     shearStress = NULL;
-
   return (sNew);
 }
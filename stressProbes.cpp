@@ -0,0 +1,340 @@
+/**
+ * @file stressProbes.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the member functions of the class StressProbes.
+ * @details This file defines the member functions of the class StressProbes used to sample the stress field of the dislocations of a grain at fixed points.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "stressProbes.h"
+
+// Constructors
+/**
+ * @brief Default constructor. No probes are set.
+ */
+StressProbes::StressProbes ()
+{
+    this->resolution = 0;
+    this->interval = 0.0;
+    this->lastTime = 0.0;
+    this->written = false;
+}
+
+// Destructor
+/**
+ * @brief Destructor for the class StressProbes. The output file is closed.
+ */
+StressProbes::~StressProbes ()
+{
+    if (this->fp.is_open()) {
+        this->fp.close();
+    }
+}
+
+// Assignment functions
+/**
+ * @brief Places the probes along the grain boundary and calculates their positions in all co-ordinate systems.
+ * @details Each segment of the grain boundary, between consecutive grain boundary points, receives resolution equally spaced probes, the last of which lies on the end point of the segment.
+ * @param gbPoints The grain boundary points, expressed in the base co-ordinate system of the grain.
+ * @param resolution The number of probes per segment.
+ * @param grainSystem Pointer to the grain co-ordinate system.
+ * @param slipSystems The slip systems of the grain.
+ */
+void StressProbes::setGrainBoundaryProbes (std::vector<Vector3d> gbPoints, int resolution, CoordinateSystem* grainSystem, std::vector<SlipSystem*> slipSystems)
+{
+    std::vector<Vector3d> points;
+
+    if (resolution > 0 && !gbPoints.empty()) {
+        // Points along the segments of the grain boundary
+        int nPoints = gbPoints.size();
+        int i, j;
+        Vector3d p0, p1, r;
+
+        p0 = gbPoints.back();
+        for (i=0; i<nPoints; i++) {
+            p1 = gbPoints[i];
+            r = (p1-p0) * (1.0/resolution);
+            for (j=1; j<=resolution; j++) {
+                points.push_back(p0 + (r*j));
+            }
+            p0 = p1;
+        }
+    }
+
+    this->setProbes(points, grainSystem, slipSystems);
+    this->resolution = resolution;
+}
+
+/**
+ * @brief Places the probes at the given points and calculates their positions in all co-ordinate systems.
+ * @param points The positions of the probes, expressed in the base co-ordinate system of the grain.
+ * @param grainSystem Pointer to the grain co-ordinate system.
+ * @param slipSystems The slip systems of the grain.
+ */
+void StressProbes::setProbes (std::vector<Vector3d> points, CoordinateSystem* grainSystem, std::vector<SlipSystem*> slipSystems)
+{
+    this->points_base = points;
+    this->points_grain.clear();
+    this->points_slipPlane.clear();
+    this->nSlipPlanes.clear();
+    this->resolution = 0;
+
+    // Positions in the grain and slip plane co-ordinate systems
+    std::vector<SlipSystem*>::iterator s_it;
+    CoordinateSystem* sSystem;
+    std::vector<SlipPlane*> slipPlanes;
+    std::vector<SlipPlane*>::iterator sp_it;
+    Vector3d p_grain, p_slipSystem;
+    int nPoints = this->points_base.size();
+    int i;
+
+    for (s_it=slipSystems.begin(); s_it!=slipSystems.end(); s_it++) {
+        this->nSlipPlanes.push_back((*s_it)->getSlipPlanes().size());
+    }
+
+    for (i=0; i<nPoints; i++) {
+        p_grain = grainSystem->vector_BaseToLocal(this->points_base[i]);
+        this->points_grain.push_back(p_grain);
+        for (s_it=slipSystems.begin(); s_it!=slipSystems.end(); s_it++) {
+            sSystem = (*s_it)->getCoordinateSystem();
+            p_slipSystem = sSystem->vector_BaseToLocal(p_grain);
+            slipPlanes = (*s_it)->getSlipPlanes();
+            for (sp_it=slipPlanes.begin(); sp_it!=slipPlanes.end(); sp_it++) {
+                this->points_slipPlane.push_back((*sp_it)->getCoordinateSystem()->vector_BaseToLocal(p_slipSystem));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Sets the minimum interval of time between two outputs.
+ * @param interval The interval of time. A value of zero writes every output that is requested.
+ */
+void StressProbes::setInterval (double interval)
+{
+    this->interval = interval;
+}
+
+// Access functions
+/**
+ * @brief Get the number of probes.
+ * @return The number of probes.
+ */
+int StressProbes::getNumProbes () const
+{
+    return (this->points_base.size());
+}
+
+/**
+ * @brief Get the positions of the probes.
+ * @return STL vector container with the positions of the probes, in the base co-ordinate system of the grain.
+ */
+const std::vector<Vector3d>& StressProbes::getPoints () const
+{
+    return (this->points_base);
+}
+
+/**
+ * @brief Get the number of points per segment of the grain boundary.
+ * @return The number of points per segment.
+ */
+int StressProbes::getResolution () const
+{
+    return (this->resolution);
+}
+
+/**
+ * @brief Indicates whether the output file is open.
+ * @return True if the output file is open.
+ */
+bool StressProbes::isOpen () const
+{
+    return (this->fp.is_open());
+}
+
+// Operations
+/**
+ * @brief Opens the output file and writes the positions of the probes.
+ * @details The stress field is written to fileName.txt and the positions of the probes, expressed in the base co-ordinate system of the grain, to fileName_points.txt.
+ * @param fileName Name of the files, without the extension.
+ * @return True if the files could be opened.
+ */
+bool StressProbes::open (std::string fileName)
+{
+    if (this->fp.is_open()) {
+        this->fp.close();
+    }
+
+    std::string pointsFileName = fileName + "_points.txt";
+    std::ofstream fpPoints (pointsFileName.c_str());
+    if (!fpPoints.is_open()) {
+        return (false);
+    }
+
+    std::vector<Vector3d>::iterator p_it;
+    for (p_it=this->points_base.begin(); p_it!=this->points_base.end(); p_it++) {
+        fpPoints << p_it->getValue(0) << " " << p_it->getValue(1) << std::endl;
+    }
+    fpPoints.close();
+
+    std::string stressFileName = fileName + ".txt";
+    this->fp.open(stressFileName.c_str(), std::ios_base::app);
+    this->written = false;
+
+    return (this->fp.is_open());
+}
+
+/**
+ * @brief Closes the output file. It is opened again at the next output.
+ */
+void StressProbes::close ()
+{
+    if (this->fp.is_open()) {
+        this->fp.close();
+    }
+}
+
+/**
+ * @brief Indicates whether the interval of time since the last output has elapsed.
+ * @param t The current value of time.
+ * @return True if an output is due.
+ */
+bool StressProbes::ifWrite (double t) const
+{
+    if (!this->written) {
+        return (true);
+    }
+
+    return ( (t - this->lastTime) >= this->interval );
+}
+
+/**
+ * @brief Calculates the stress field at all probes.
+ * @details If the cell list is enabled, it is used for the stress field and must have been updated after the dislocations last moved. Otherwise the stress fields of all dislocations are added exactly. The probes are distributed over threads when OpenMP is available.
+ * @param slipSystems The slip systems of the grain.
+ * @param grainSystem Pointer to the grain co-ordinate system.
+ * @param cellList Pointer to the cell list of the grain.
+ * @param mu Shear modulus (Pa).
+ * @param nu Poisson's ratio.
+ * @param stress Pointer to the vector receiving the stress tensor at each probe, expressed in the base co-ordinate system of the grain.
+ * @return False if the slip systems or slip planes have changed since the probes were set.
+ */
+bool StressProbes::calculate (std::vector<SlipSystem*> slipSystems, CoordinateSystem* grainSystem, const CellList* cellList, double mu, double nu, std::vector<Stress>* stress) const
+{
+    int nProbes = this->points_base.size();
+    int nSystems = slipSystems.size();
+    int i, j, k, m, n;
+
+    // The slip planes, their co-ordinate systems and their dislocations are collected once for all probes
+    std::vector<CoordinateSystem*> slipSystemCS;
+    std::vector<CoordinateSystem*> slipPlaneCS;
+    std::vector< std::vector<Dislocation*> > dislocations;
+    std::vector<SlipPlane*> slipPlanes;
+    std::vector<SlipPlane*>::iterator sp_it;
+
+    if (nSystems != (int)this->nSlipPlanes.size()) {
+        // The slip systems have changed since the probes were set
+        return (false);
+    }
+
+    for (j=0; j<nSystems; j++) {
+        slipSystemCS.push_back(slipSystems[j]->getCoordinateSystem());
+        slipPlanes = slipSystems[j]->getSlipPlanes();
+        if ((int)slipPlanes.size() != this->nSlipPlanes[j]) {
+            // The slip planes have changed since the probes were set
+            return (false);
+        }
+        for (sp_it=slipPlanes.begin(); sp_it!=slipPlanes.end(); sp_it++) {
+            slipPlaneCS.push_back((*sp_it)->getCoordinateSystem());
+            dislocations.push_back((*sp_it)->getDislocationList());
+        }
+    }
+    int nPlanes = slipPlaneCS.size();
+
+    stress->assign(nProbes, Stress());
+
+#pragma omp parallel for private(j, k, m, n)
+    for (i=0; i<nProbes; i++) {
+        Stress s_grain;
+        if (cellList->isEnabled()) {
+            s_grain = cellList->stressField(this->points_grain[i], mu, nu);
+        }
+        else {
+            k = 0;
+            for (j=0; j<nSystems; j++) {
+                Stress s_slipSystem;
+                for (m=0; m<this->nSlipPlanes[j]; m++, k++) {
+                    Stress s_slipPlane;
+                    const Vector3d& p = this->points_slipPlane[(i*nPlanes)+k];
+                    for (n=0; n<(int)dislocations[k].size(); n++) {
+                        s_slipPlane += dislocations[k][n]->stressField(p, mu, nu);
+                    }
+                    s_slipSystem += slipPlaneCS[k]->stress_LocalToBase(s_slipPlane);
+                }
+                s_grain += slipSystemCS[j]->stress_LocalToBase(s_slipSystem);
+            }
+        }
+        (*stress)[i] = grainSystem->stress_LocalToBase(s_grain);
+    }
+
+    return (true);
+}
+
+/**
+ * @brief Calculates the stress field at all probes and writes it as one row of the output file.
+ * @details The row contains the time and the six components xx yy zz xy xz yz of the stress tensor at each probe, expressed in the base co-ordinate system of the grain, as calculated by StressProbes::calculate.
+ * @param t The current value of time.
+ * @param slipSystems The slip systems of the grain.
+ * @param grainSystem Pointer to the grain co-ordinate system.
+ * @param cellList Pointer to the cell list of the grain.
+ * @param mu Shear modulus (Pa).
+ * @param nu Poisson's ratio.
+ */
+void StressProbes::write (double t, std::vector<SlipSystem*> slipSystems, CoordinateSystem* grainSystem, const CellList* cellList, double mu, double nu)
+{
+    if (!this->fp.is_open()) {
+        return;
+    }
+
+    std::vector<Stress> stress;
+    int nProbes = this->points_base.size();
+    int i;
+
+    if (!this->calculate(slipSystems, grainSystem, cellList, mu, nu, &stress)) {
+        return;
+    }
+
+    this->fp << t;
+    for (i=0; i<nProbes; i++) {
+        this->fp << " " << stress[i].getPrincipalStress(0) << " " << stress[i].getPrincipalStress(1) << " " << stress[i].getPrincipalStress(2)
+                 << " " << stress[i].getShearStress(0) << " " << stress[i].getShearStress(1) << " " << stress[i].getShearStress(2);
+    }
+    this->fp << "\n";
+    this->fp.flush();
+
+    this->lastTime = t;
+    this->written = true;
+}
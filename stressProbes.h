@@ -0,0 +1,187 @@
+/**
+ * @file stressProbes.h
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the class StressProbes.
+ * @details This file defines the class StressProbes used to sample the stress field of the dislocations of a grain at fixed points.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef STRESSPROBES_H
+#define STRESSPROBES_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+
+#include "slipsystem.h"
+#include "cellList.h"
+
+/**
+ * @brief The StressProbes class samples the stress field of the dislocations of a grain at fixed points and writes it to a single file.
+ * @details The probe points are fixed in the grain. Their positions in the co-ordinate systems of the grain and of every slip plane are calculated once, when the probes are set, so that only the stress fields of the dislocations and the rotations of the stress tensors remain to be calculated at each output. The probes are evaluated in parallel when OpenMP is available. Each output is one row of the file, which remains open for the whole simulation. Outputs are spaced by a minimum interval of time, independent of the time step.
+ */
+class StressProbes
+{
+protected:
+  /**
+   * @brief Positions of the probes, in the base co-ordinate system of the grain.
+   */
+  std::vector<Vector3d> points_base;
+  /**
+   * @brief Positions of the probes, in the grain co-ordinate system.
+   */
+  std::vector<Vector3d> points_grain;
+  /**
+   * @brief Positions of the probes in the co-ordinate systems of all slip planes. The positions of the i-th probe are stored consecutively, in the order of the slip planes.
+   */
+  std::vector<Vector3d> points_slipPlane;
+  /**
+   * @brief Number of slip planes in each slip system, when the probes were set.
+   */
+  std::vector<int> nSlipPlanes;
+  /**
+   * @brief Number of points per segment of the grain boundary.
+   */
+  int resolution;
+  /**
+   * @brief Minimum interval of time between two outputs.
+   */
+  double interval;
+  /**
+   * @brief Time of the last output.
+   */
+  double lastTime;
+  /**
+   * @brief Flag indicating whether an output has been written.
+   */
+  bool written;
+  /**
+   * @brief The output file.
+   */
+  std::ofstream fp;
+
+public:
+  // Constructors
+  /**
+   * @brief Default constructor. No probes are set.
+   */
+  StressProbes ();
+
+  // Destructor
+  /**
+   * @brief Destructor for the class StressProbes. The output file is closed.
+   */
+  virtual ~StressProbes ();
+
+  // Assignment functions
+  /**
+   * @brief Places the probes along the grain boundary and calculates their positions in all co-ordinate systems.
+   * @details Each segment of the grain boundary, between consecutive grain boundary points, receives resolution equally spaced probes, the last of which lies on the end point of the segment.
+   * @param gbPoints The grain boundary points, expressed in the base co-ordinate system of the grain.
+   * @param resolution The number of probes per segment.
+   * @param grainSystem Pointer to the grain co-ordinate system.
+   * @param slipSystems The slip systems of the grain.
+   */
+  void setGrainBoundaryProbes (std::vector<Vector3d> gbPoints, int resolution, CoordinateSystem* grainSystem, std::vector<SlipSystem*> slipSystems);
+  /**
+   * @brief Places the probes at the given points and calculates their positions in all co-ordinate systems.
+   * @param points The positions of the probes, expressed in the base co-ordinate system of the grain.
+   * @param grainSystem Pointer to the grain co-ordinate system.
+   * @param slipSystems The slip systems of the grain.
+   */
+  void setProbes (std::vector<Vector3d> points, CoordinateSystem* grainSystem, std::vector<SlipSystem*> slipSystems);
+  /**
+   * @brief Sets the minimum interval of time between two outputs.
+   * @param interval The interval of time. A value of zero writes every output that is requested.
+   */
+  void setInterval (double interval);
+
+  // Access functions
+  /**
+   * @brief Get the number of probes.
+   * @return The number of probes.
+   */
+  int getNumProbes () const;
+  /**
+   * @brief Get the positions of the probes.
+   * @return STL vector container with the positions of the probes, in the base co-ordinate system of the grain.
+   */
+  const std::vector<Vector3d>& getPoints () const;
+  /**
+   * @brief Get the number of points per segment of the grain boundary.
+   * @return The number of points per segment.
+   */
+  int getResolution () const;
+  /**
+   * @brief Indicates whether the output file is open.
+   * @return True if the output file is open.
+   */
+  bool isOpen () const;
+
+  // Operations
+  /**
+   * @brief Opens the output file and writes the positions of the probes.
+   * @details The stress field is written to fileName.txt and the positions of the probes, expressed in the base co-ordinate system of the grain, to fileName_points.txt.
+   * @param fileName Name of the files, without the extension.
+   * @return True if the files could be opened.
+   */
+  bool open (std::string fileName);
+  /**
+   * @brief Closes the output file. It is opened again at the next output.
+   */
+  void close ();
+  /**
+   * @brief Indicates whether the interval of time since the last output has elapsed.
+   * @param t The current value of time.
+   * @return True if an output is due.
+   */
+  bool ifWrite (double t) const;
+  /**
+   * @brief Calculates the stress field at all probes.
+   * @details If the cell list is enabled, it is used for the stress field and must have been updated after the dislocations last moved. Otherwise the stress fields of all dislocations are added exactly. The probes are distributed over threads when OpenMP is available.
+   * @param slipSystems The slip systems of the grain.
+   * @param grainSystem Pointer to the grain co-ordinate system.
+   * @param cellList Pointer to the cell list of the grain.
+   * @param mu Shear modulus (Pa).
+   * @param nu Poisson's ratio.
+   * @param stress Pointer to the vector receiving the stress tensor at each probe, expressed in the base co-ordinate system of the grain.
+   * @return False if the slip systems or slip planes have changed since the probes were set.
+   */
+  bool calculate (std::vector<SlipSystem*> slipSystems, CoordinateSystem* grainSystem, const CellList* cellList, double mu, double nu, std::vector<Stress>* stress) const;
+  /**
+   * @brief Calculates the stress field at all probes and writes it as one row of the output file.
+   * @details The row contains the time and the six components xx yy zz xy xz yz of the stress tensor at each probe, expressed in the base co-ordinate system of the grain, as calculated by StressProbes::calculate.
+   * @param t The current value of time.
+   * @param slipSystems The slip systems of the grain.
+   * @param grainSystem Pointer to the grain co-ordinate system.
+   * @param cellList Pointer to the cell list of the grain.
+   * @param mu Shear modulus (Pa).
+   * @param nu Poisson's ratio.
+   */
+  void write (double t, std::vector<SlipSystem*> slipSystems, CoordinateSystem* grainSystem, const CellList* cellList, double mu, double nu);
+};
+
+#endif // STRESSPROBES_H
@@ -0,0 +1,243 @@
+/**
+ * @file sweep.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the member functions of the class Sweep.
+ * @details This file defines the member functions of the class Sweep holding the description of a parameter sweep, in which the same grain is simulated with several sets of parameters.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sweep.h"
+
+// Constructor
+/**
+ * @brief Default constructor. The sweep has no axes and one job.
+ */
+Sweep::Sweep ()
+{
+    this->nJobs = 1;
+    this->variantName = SWEEP_DEFAULT_VARIANT_NAME;
+}
+
+// Functions
+/**
+ * @brief Read the sweep from the file whose name is provided.
+ * @param fileName Name of the file describing the sweep.
+ * @param needParameters Flag indicating whether the file must name a parameters file. The continuations of a branched run take their parameters from the run itself.
+ * @return True if the file was read, names a parameters file if needed and only varies parameters that do not change the structure of the grain.
+ */
+bool Sweep::getSweep (std::string fileName, bool needParameters)
+{
+    std::ifstream fp (fileName.c_str());
+    std::string line;
+    bool success = true;
+
+    if (!fp.is_open()) {
+        return (false);
+    }
+
+    while (fp.good()) {
+        getline (fp, line);
+        if ( !ignoreLine ( line ) ) {
+            success = this->parseLineData(line) && success;
+        }
+    }
+    fp.close();
+
+    return (success && !(needParameters && this->parameterFile.empty()));
+}
+
+/**
+ * @brief Reads the data from the line and stores it into the appropriate variable.
+ * @param line String with the text present in the line.
+ * @return False if the line varies a parameter that cannot be varied.
+ */
+bool Sweep::parseLineData (std::string line)
+{
+    std::stringstream ss(line);
+    std::string first;
+    std::string key;
+    std::string v;
+    int axis;
+
+    ss >> first;
+
+    // Parameters file shared by all variants
+    if (first=="parameters") {
+        ss >> this->parameterFile;
+        return (true);
+    }
+
+    // Number of variants simulated at the same time
+    if (first=="jobs") {
+        ss >> v;
+        this->nJobs = atoi(v.c_str());
+        if (this->nJobs < 1) {
+            this->nJobs = 1;
+        }
+        return (true);
+    }
+
+    // Prefix of the output directories
+    if (first=="name") {
+        ss >> this->variantName;
+        return (true);
+    }
+
+    if (first!="vary" && first!="range") {
+        displayMessage("Warning: unknown sweep entry " + first);
+        return (true);
+    }
+
+    ss >> key;
+    if (!Sweep::isVariable(key)) {
+        displayMessage("Error: the parameter " + key + " cannot be varied in a sweep");
+        return (false);
+    }
+
+    // Find the axis of the key, or create it
+    for (axis=0; axis<this->keys.size(); axis++) {
+        if (this->keys[axis] == key) {
+            break;
+        }
+    }
+    if (axis == this->keys.size()) {
+        this->keys.push_back(key);
+        this->values.push_back(std::vector<std::string>());
+    }
+
+    if (first=="vary") {
+        // The value is the rest of the line
+        getline(ss, v);
+        v.erase(0, v.find_first_not_of(" \t"));
+        this->values[axis].push_back(v);
+        return (true);
+    }
+
+    // Evenly spaced values
+    double start, end;
+    int n, i;
+    ss >> start >> end >> n;
+    for (i=0; i<n; i++) {
+        std::ostringstream value;
+        value.precision(15);
+        if (n == 1) {
+            value << start;
+        }
+        else {
+            value << start + (end - start) * ((double) i / (double) (n-1));
+        }
+        this->values[axis].push_back(value.str());
+    }
+    return (true);
+}
+
+/**
+ * @brief Get the number of variants of the sweep.
+ * @return The number of combinations of the values of all axes.
+ */
+int Sweep::getNumVariants () const
+{
+    int n = 1;
+    int axis;
+
+    for (axis=0; axis<this->values.size(); axis++) {
+        n *= this->values[axis].size();
+    }
+
+    return (n);
+}
+
+/**
+ * @brief Get the parameter lines defining a variant.
+ * @details The values of the last axis change fastest with the index of the variant.
+ * @param k Index of the variant.
+ * @return STL vector container with one line "<key> <value>" for each axis.
+ */
+std::vector<std::string> Sweep::getVariantLines (int k) const
+{
+    std::vector<std::string> lines (this->keys.size());
+    int axis;
+    int n;
+
+    for (axis=this->keys.size()-1; axis>=0; axis--) {
+        n = this->values[axis].size();
+        lines[axis] = this->keys[axis] + " " + this->values[axis][k % n];
+        k /= n;
+    }
+
+    return (lines);
+}
+
+/**
+ * @brief Get the output directory of a variant.
+ * @param outputDir The output directory of the sweep.
+ * @param k Index of the variant.
+ * @return The name of the sub-directory of outputDir holding the output of the variant.
+ */
+std::string Sweep::getVariantDirectory (std::string outputDir, int k) const
+{
+    return (outputDir + "/" + this->variantName + "_" + intToString(k));
+}
+
+/**
+ * @brief Writes the list of the variants, one per line, with their output directory followed by their parameter lines separated by tabs.
+ * @param fileName Name of the file.
+ * @param outputDir The output directory of the sweep.
+ * @return True if the file could be written.
+ */
+bool Sweep::writeVariants (std::string fileName, std::string outputDir) const
+{
+    std::ofstream fp (fileName.c_str());
+    std::vector<std::string> lines;
+    int k, i;
+
+    if (!fp.is_open()) {
+        return (false);
+    }
+
+    for (k=0; k<this->getNumVariants(); k++) {
+        lines = this->getVariantLines(k);
+        fp << this->getVariantDirectory(outputDir, k);
+        for (i=0; i<lines.size(); i++) {
+            fp << "\t" << lines[i];
+        }
+        fp << std::endl;
+    }
+    fp.close();
+
+    return (true);
+}
+
+/**
+ * @brief Indicates whether a parameter can be varied once the grain has been read.
+ * @param key Key of the parameter in the parameters file.
+ * @return False for the parameters that define the grain or its input files.
+ */
+bool Sweep::isVariable (std::string key)
+{
+    return ( key!="structure" && key!="Structure" &&
+             key!="input" && key!="Input" &&
+             key!="output" && key!="Output" );
+}
@@ -0,0 +1,158 @@
+/**
+ * @file sweep.h
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the class Sweep.
+ * @details This file defines the class Sweep holding the description of a parameter sweep, in which the same grain is simulated with several sets of parameters.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <stdlib.h>
+
+#include "tools.h"
+
+#ifndef SWEEP_DEFAULT_VARIANT_NAME
+/**
+ * @brief Default prefix of the output directories of the variants of a sweep.
+ */
+#define SWEEP_DEFAULT_VARIANT_NAME "variant"
+#endif
+
+/**
+ * @brief The Sweep class holds the description of a parameter sweep.
+ * @details A sweep starts from a parameters file and varies some of its entries. Each varied entry is an axis with a list of values, and the variants of the sweep are all combinations of the values of the axes. The sweep file contains the following lines, in any order:
+ * - parameters <file>: the parameters file shared by all variants.
+ * - jobs <n>: the number of variants simulated at the same time (default 1).
+ * - name <prefix>: the prefix of the output directories of the variants.
+ * - vary <key> <value>: adds a value to the axis of the key. The value is the rest of the line, so that a line "vary appliedStress 0 0 0 1e8 0 0" adds a complete stress tensor.
+ * - range <key> <start> <end> <n>: adds n values evenly spaced between start and end, both included, to the axis of the key.
+ *
+ * The keys are those of the parameters file. A variant is obtained by reading the line "<key> <value>" of each axis after the parameters file, so that any entry that does not change the structure of the grain can be varied.
+ */
+class Sweep
+{
+public:
+    /**
+     * @brief Name of the parameters file shared by all variants.
+     */
+    std::string parameterFile;
+
+    /**
+     * @brief Number of variants simulated at the same time.
+     */
+    int nJobs;
+
+    /**
+     * @brief Prefix of the output directories of the variants.
+     */
+    std::string variantName;
+
+    /**
+     * @brief Keys of the parameters that are varied, one for each axis of the sweep.
+     */
+    std::vector<std::string> keys;
+
+    /**
+     * @brief Values taken by the parameters along each axis of the sweep.
+     */
+    std::vector< std::vector<std::string> > values;
+
+    // Constructor
+    /**
+     * @brief Default constructor. The sweep has no axes and one job.
+     */
+    Sweep ();
+
+    // Destructor
+    /**
+     * @brief Destructor for the class Sweep.
+     * @details The destructor is declared as virtual in order to avoid conflicts with derived class destructors.
+     */
+    virtual ~Sweep ()
+    {
+
+    }
+
+    // Functions
+    /**
+     * @brief Read the sweep from the file whose name is provided.
+     * @param fileName Name of the file describing the sweep.
+     * @param needParameters Flag indicating whether the file must name a parameters file. The continuations of a branched run take their parameters from the run itself.
+     * @return True if the file was read, names a parameters file if needed and only varies parameters that do not change the structure of the grain.
+     */
+    bool getSweep (std::string fileName, bool needParameters = true);
+
+    /**
+     * @brief Reads the data from the line and stores it into the appropriate variable.
+     * @param line String with the text present in the line.
+     * @return False if the line varies a parameter that cannot be varied.
+     */
+    bool parseLineData (std::string line);
+
+    /**
+     * @brief Get the number of variants of the sweep.
+     * @return The number of combinations of the values of all axes.
+     */
+    int getNumVariants () const;
+
+    /**
+     * @brief Get the parameter lines defining a variant.
+     * @details The values of the last axis change fastest with the index of the variant.
+     * @param k Index of the variant.
+     * @return STL vector container with one line "<key> <value>" for each axis.
+     */
+    std::vector<std::string> getVariantLines (int k) const;
+
+    /**
+     * @brief Get the output directory of a variant.
+     * @param outputDir The output directory of the sweep.
+     * @param k Index of the variant.
+     * @return The name of the sub-directory of outputDir holding the output of the variant.
+     */
+    std::string getVariantDirectory (std::string outputDir, int k) const;
+
+    /**
+     * @brief Writes the list of the variants, one per line, with their output directory followed by their parameter lines separated by tabs.
+     * @param fileName Name of the file.
+     * @param outputDir The output directory of the sweep.
+     * @return True if the file could be written.
+     */
+    bool writeVariants (std::string fileName, std::string outputDir) const;
+
+    /**
+     * @brief Indicates whether a parameter can be varied once the grain has been read.
+     * @param key Key of the parameter in the parameters file.
+     * @return False for the parameters that define the grain or its input files.
+     */
+    static bool isVariable (std::string key);
+};
+
+#endif // SWEEP_H
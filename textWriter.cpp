@@ -0,0 +1,392 @@
+/**
+ * @file textWriter.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the member functions of the class TextWriter.
+ * @details This file defines the member functions of the class TextWriter, which writes the text outputs of the simulation through large buffers, with a fast formatting of the numbers.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "textWriter.h"
+
+std::map<std::string, TextWriter*> TextWriter::pool;
+double TextWriter::defaultFlushInterval = TEXTWRITER_DEFAULT_FLUSH_INTERVAL;
+
+// Constructors
+/**
+ * @brief Default constructor. The text is accumulated in memory until a file is opened.
+ */
+TextWriter::TextWriter ()
+{
+  this->fp = NULL;
+  this->used = 0;
+  this->flushInterval = TextWriter::defaultFlushInterval;
+  gettimeofday ( &(this->lastFlush), NULL );
+}
+
+/**
+ * @brief Makes room for n more characters in the buffer.
+ * @param n Number of characters.
+ */
+void TextWriter::reserve (size_t n)
+{
+  if ( this->used + n <= this->buffer.size() ) {
+    return;
+  }
+
+  if ( this->fp != NULL ) {
+    // Write the full buffer
+    this->flush ();
+    if ( n <= this->buffer.size() ) {
+      return;
+    }
+  }
+
+  // Text kept in memory, or longer than the buffer
+  size_t size = this->buffer.size() > 0 ? this->buffer.size() : 256;
+  while ( size < this->used + n ) {
+    size *= 2;
+  }
+  this->buffer.resize ( size );
+}
+
+/**
+ * @brief Appends characters to the buffer.
+ * @param s The characters.
+ * @param n Number of characters.
+ */
+void TextWriter::append (const char* s, size_t n)
+{
+  this->reserve ( n );
+  memcpy ( &(this->buffer[this->used]), s, n );
+  this->used += n;
+}
+
+// Operations
+/**
+ * @brief Opens a file.
+ * @param fileName Name of the file.
+ * @param append True to append to the file, false to replace it.
+ * @return True if the file could be opened.
+ */
+bool TextWriter::open (std::string fileName, bool append)
+{
+  this->close ();
+
+  this->fp = fopen ( fileName.c_str(), append ? "ab" : "wb" );
+  if ( this->fp == NULL ) {
+    return ( false );
+  }
+  // The writer has its own buffer
+  setvbuf ( this->fp, NULL, _IONBF, 0 );
+
+  this->fileName = fileName;
+  this->used = 0;
+  this->buffer.resize ( TEXTWRITER_BUFFER_SIZE );
+  gettimeofday ( &(this->lastFlush), NULL );
+  return ( true );
+}
+
+/**
+ * @brief Writes the buffer and closes the file.
+ */
+void TextWriter::close ()
+{
+  if ( this->fp == NULL ) {
+    return;
+  }
+
+  this->flush ();
+  fclose ( this->fp );
+  this->fp = NULL;
+  this->used = 0;
+  std::vector<char>().swap ( this->buffer );
+}
+
+/**
+ * @brief Writes the buffer to the file.
+ */
+void TextWriter::flush ()
+{
+  if ( this->fp == NULL ) {
+    return;
+  }
+
+  if ( this->used > 0 ) {
+    fwrite ( &(this->buffer[0]), 1, this->used, this->fp );
+    this->used = 0;
+  }
+  gettimeofday ( &(this->lastFlush), NULL );
+}
+
+/**
+ * @brief Ends a line. The buffer is written if the flush interval has elapsed since the last write.
+ */
+void TextWriter::endLine ()
+{
+  struct timeval now;
+
+  this->append ( "\n", 1 );
+
+  if ( this->fp == NULL || this->flushInterval < 0.0 ) {
+    return;
+  }
+
+  if ( this->flushInterval == 0.0 ) {
+    this->flush ();
+    return;
+  }
+
+  gettimeofday ( &now, NULL );
+  if ( (double) ( now.tv_sec - this->lastFlush.tv_sec ) + 1.0e-06 * (double) ( now.tv_usec - this->lastFlush.tv_usec ) >= this->flushInterval ) {
+    this->flush ();
+  }
+}
+
+/**
+ * @brief Empties the buffer without writing it.
+ */
+void TextWriter::clear ()
+{
+  this->used = 0;
+}
+
+/**
+ * @brief Writes a floating point number.
+ * @param v The number.
+ * @return Reference to this writer.
+ */
+TextWriter& TextWriter::operator<< (double v)
+{
+  this->reserve ( TEXTWRITER_NUMBER_CHARS );
+  this->used += TextWriter::formatDouble ( v, &(this->buffer[this->used]) );
+  return ( *this );
+}
+
+/**
+ * @brief Writes an integer.
+ * @param v The integer.
+ * @return Reference to this writer.
+ */
+TextWriter& TextWriter::operator<< (int v)
+{
+  return ( *this << (long) v );
+}
+
+/**
+ * @brief Writes an integer.
+ * @param v The integer.
+ * @return Reference to this writer.
+ */
+TextWriter& TextWriter::operator<< (long v)
+{
+  char digits[TEXTWRITER_NUMBER_CHARS];
+  unsigned long u = ( v < 0 ) ? ( 0UL - (unsigned long) v ) : (unsigned long) v;
+  int n = 0;
+  int i;
+
+  // Digits from the last one
+  do {
+    digits[n++] = '0' + (char) ( u % 10 );
+    u /= 10;
+  } while ( u > 0 );
+  if ( v < 0 ) {
+    digits[n++] = '-';
+  }
+
+  this->reserve ( n );
+  for ( i=n-1; i>=0; i-- ) {
+    this->buffer[this->used++] = digits[i];
+  }
+  return ( *this );
+}
+
+/**
+ * @brief Writes a character.
+ * @param c The character.
+ * @return Reference to this writer.
+ */
+TextWriter& TextWriter::operator<< (char c)
+{
+  this->append ( &c, 1 );
+  return ( *this );
+}
+
+/**
+ * @brief Writes a character string.
+ * @param s The string.
+ * @return Reference to this writer.
+ */
+TextWriter& TextWriter::operator<< (const char* s)
+{
+  this->append ( s, strlen ( s ) );
+  return ( *this );
+}
+
+/**
+ * @brief Writes a string.
+ * @param s The string.
+ * @return Reference to this writer.
+ */
+TextWriter& TextWriter::operator<< (const std::string& s)
+{
+  this->append ( s.data(), s.size() );
+  return ( *this );
+}
+
+// Assignment functions
+/**
+ * @brief Sets the interval of wall-clock time after which the buffer is written at the end of a line.
+ * @param interval The interval, in seconds. Zero writes every line, a negative value only writes full buffers.
+ */
+void TextWriter::setFlushInterval (double interval)
+{
+  this->flushInterval = interval;
+}
+
+// Access functions
+/**
+ * @brief Indicates whether a file is open.
+ * @return True if a file is open.
+ */
+bool TextWriter::isOpen () const
+{
+  return ( this->fp != NULL );
+}
+
+/**
+ * @brief Get the name of the file.
+ * @return The name of the file.
+ */
+std::string TextWriter::getFileName () const
+{
+  return ( this->fileName );
+}
+
+/**
+ * @brief Get the text in the buffer, which is all the text written if no file is open.
+ * @return The text.
+ */
+std::string TextWriter::str () const
+{
+  if ( this->used == 0 ) {
+    return ( std::string () );
+  }
+  return ( std::string ( &(this->buffer[0]), this->used ) );
+}
+
+// Static functions
+/**
+ * @brief Formats a floating point number in the shortest form that reads back to the same value.
+ * @param v The number.
+ * @param s Array of at least TEXTWRITER_NUMBER_CHARS characters receiving the text, which is not terminated.
+ * @return Number of characters written.
+ */
+int TextWriter::formatDouble (double v, char* s)
+{
+#ifdef TEXTWRITER_TO_CHARS
+  std::to_chars_result r = std::to_chars ( s, s + TEXTWRITER_NUMBER_CHARS, v );
+  return ( r.ptr - s );
+#else
+  char text[TEXTWRITER_NUMBER_CHARS];
+  int n = snprintf ( text, TEXTWRITER_NUMBER_CHARS, "%.15g", v );
+  if ( strtod ( text, NULL ) != v ) {
+    // 15 digits do not always suffice
+    n = snprintf ( text, TEXTWRITER_NUMBER_CHARS, "%.17g", v );
+  }
+  memcpy ( s, text, n );
+  return ( n );
+#endif
+}
+
+/**
+ * @brief Get the writer of a file that is kept open between outputs, the file being opened in append mode at the first call.
+ * @param fileName Name of the file.
+ * @return Pointer to the writer, NULL if the file could not be opened. The writer belongs to the pool.
+ */
+TextWriter* TextWriter::get (std::string fileName)
+{
+  static bool exitHandler = false;
+  std::map<std::string, TextWriter*>::iterator w_it;
+  TextWriter* w;
+
+  w_it = TextWriter::pool.find ( fileName );
+  if ( w_it != TextWriter::pool.end() ) {
+    return ( w_it->second );
+  }
+
+  w = new TextWriter;
+  if ( !w->open ( fileName, true ) ) {
+    delete ( w );
+    return ( NULL );
+  }
+
+  if ( !exitHandler ) {
+    // The buffers are written when the program ends
+    atexit ( TextWriter::closeAll );
+    exitHandler = true;
+  }
+
+  TextWriter::pool[fileName] = w;
+  return ( w );
+}
+
+/**
+ * @brief Writes the buffers of all files kept open.
+ */
+void TextWriter::flushAll ()
+{
+  std::map<std::string, TextWriter*>::iterator w_it;
+
+  for ( w_it=TextWriter::pool.begin(); w_it!=TextWriter::pool.end(); w_it++ ) {
+    w_it->second->flush ();
+  }
+}
+
+/**
+ * @brief Closes all files kept open. They are opened again, in append mode, at the next call to TextWriter::get.
+ */
+void TextWriter::closeAll ()
+{
+  std::map<std::string, TextWriter*>::iterator w_it;
+
+  for ( w_it=TextWriter::pool.begin(); w_it!=TextWriter::pool.end(); w_it++ ) {
+    delete ( w_it->second );
+  }
+  TextWriter::pool.clear ();
+}
+
+/**
+ * @brief Sets the flush interval of the files kept open, including those already open.
+ * @param interval The interval, in seconds. Zero writes every line, a negative value only writes full buffers.
+ */
+void TextWriter::setDefaultFlushInterval (double interval)
+{
+  std::map<std::string, TextWriter*>::iterator w_it;
+
+  TextWriter::defaultFlushInterval = interval;
+  for ( w_it=TextWriter::pool.begin(); w_it!=TextWriter::pool.end(); w_it++ ) {
+    w_it->second->setFlushInterval ( interval );
+  }
+}
@@ -0,0 +1,273 @@
+/**
+ * @file textWriter.h
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the class TextWriter.
+ * @details This file defines the class TextWriter, which writes the text outputs of the simulation through large buffers, with a fast formatting of the numbers.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TEXTWRITER_H
+#define TEXTWRITER_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+// Shortest round-trip formatting of floating point numbers
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+/**
+ * @brief Defined if std::to_chars can format floating point numbers. Otherwise they are formatted by snprintf.
+ */
+#define TEXTWRITER_TO_CHARS
+#endif
+
+#ifndef TEXTWRITER_BUFFER_SIZE
+/**
+ * @brief Size, in bytes, of the buffer of a text writer.
+ */
+#define TEXTWRITER_BUFFER_SIZE 1048576
+#endif
+
+#ifndef TEXTWRITER_DEFAULT_FLUSH_INTERVAL
+/**
+ * @brief Default interval of wall-clock time, in seconds, after which the buffer of a file kept open is written at the end of a line.
+ */
+#define TEXTWRITER_DEFAULT_FLUSH_INTERVAL 1.0
+#endif
+
+/**
+ * @brief Largest number of characters of a formatted number.
+ */
+#define TEXTWRITER_NUMBER_CHARS 32
+
+/**
+ * @brief The TextWriter class writes text files through a large buffer.
+ * @details Numbers are formatted without the streams of the standard library: floating point numbers are written in the shortest form that reads back to the same value (with std::to_chars, or snprintf with 15 or 17 significant digits if it is not available), so that the files are parsed as before while carrying the full precision. The text is accumulated in a buffer of TEXTWRITER_BUFFER_SIZE bytes, which is written when it is full, when the file is closed, and at the end of a line once the flush interval has elapsed since the last write; an interval of zero writes every line and a negative interval only writes full buffers. A writer that is not opened accumulates the whole text in memory, for instance for a record of an archive.
+ * Files that receive a line at every output, such as the defect positions, are kept open between outputs by the pool of writers returned by TextWriter::get. The pool is closed by TextWriter::closeAll, which must be called before the process is forked and is called at the exit of the program.
+ */
+class TextWriter
+{
+protected:
+  /**
+   * @brief The open file, NULL if the writer accumulates the text in memory.
+   */
+  FILE* fp;
+  /**
+   * @brief Name of the file.
+   */
+  std::string fileName;
+  /**
+   * @brief The buffer.
+   */
+  std::vector<char> buffer;
+  /**
+   * @brief Number of characters in the buffer.
+   */
+  size_t used;
+  /**
+   * @brief Interval of wall-clock time, in seconds, after which the buffer is written at the end of a line.
+   */
+  double flushInterval;
+  /**
+   * @brief Wall-clock time of the last write of the buffer.
+   */
+  struct timeval lastFlush;
+
+  /**
+   * @brief The writers of the files that are kept open, by file name.
+   */
+  static std::map<std::string, TextWriter*> pool;
+  /**
+   * @brief Flush interval of the writers created from now on.
+   */
+  static double defaultFlushInterval;
+
+  /**
+   * @brief Makes room for n more characters in the buffer.
+   * @param n Number of characters.
+   */
+  void reserve (size_t n);
+  /**
+   * @brief Appends characters to the buffer.
+   * @param s The characters.
+   * @param n Number of characters.
+   */
+  void append (const char* s, size_t n);
+
+private:
+  /**
+   * @brief Copy constructor. Writers cannot be copied.
+   * @param w The writer.
+   */
+  TextWriter (const TextWriter& w);
+  /**
+   * @brief Assignment operator. Writers cannot be copied.
+   * @param w The writer.
+   * @return Reference to this writer.
+   */
+  TextWriter& operator= (const TextWriter& w);
+
+public:
+  // Constructors
+  /**
+   * @brief Default constructor. The text is accumulated in memory until a file is opened.
+   */
+  TextWriter ();
+
+  // Destructor
+  /**
+   * @brief Destructor for the class TextWriter. The file is closed, which writes the buffer.
+   */
+  virtual ~TextWriter ()
+  {
+    this->close ();
+  }
+
+  // Operations
+  /**
+   * @brief Opens a file.
+   * @param fileName Name of the file.
+   * @param append True to append to the file, false to replace it.
+   * @return True if the file could be opened.
+   */
+  bool open (std::string fileName, bool append);
+  /**
+   * @brief Writes the buffer and closes the file.
+   */
+  void close ();
+  /**
+   * @brief Writes the buffer to the file.
+   */
+  void flush ();
+  /**
+   * @brief Ends a line. The buffer is written if the flush interval has elapsed since the last write.
+   */
+  void endLine ();
+  /**
+   * @brief Empties the buffer without writing it.
+   */
+  void clear ();
+
+  /**
+   * @brief Writes a floating point number.
+   * @param v The number.
+   * @return Reference to this writer.
+   */
+  TextWriter& operator<< (double v);
+  /**
+   * @brief Writes an integer.
+   * @param v The integer.
+   * @return Reference to this writer.
+   */
+  TextWriter& operator<< (int v);
+  /**
+   * @brief Writes an integer.
+   * @param v The integer.
+   * @return Reference to this writer.
+   */
+  TextWriter& operator<< (long v);
+  /**
+   * @brief Writes a character.
+   * @param c The character.
+   * @return Reference to this writer.
+   */
+  TextWriter& operator<< (char c);
+  /**
+   * @brief Writes a character string.
+   * @param s The string.
+   * @return Reference to this writer.
+   */
+  TextWriter& operator<< (const char* s);
+  /**
+   * @brief Writes a string.
+   * @param s The string.
+   * @return Reference to this writer.
+   */
+  TextWriter& operator<< (const std::string& s);
+
+  // Assignment functions
+  /**
+   * @brief Sets the interval of wall-clock time after which the buffer is written at the end of a line.
+   * @param interval The interval, in seconds. Zero writes every line, a negative value only writes full buffers.
+   */
+  void setFlushInterval (double interval);
+
+  // Access functions
+  /**
+   * @brief Indicates whether a file is open.
+   * @return True if a file is open.
+   */
+  bool isOpen () const;
+  /**
+   * @brief Get the name of the file.
+   * @return The name of the file.
+   */
+  std::string getFileName () const;
+  /**
+   * @brief Get the text in the buffer, which is all the text written if no file is open.
+   * @return The text.
+   */
+  std::string str () const;
+
+  // Static functions
+  /**
+   * @brief Formats a floating point number in the shortest form that reads back to the same value.
+   * @param v The number.
+   * @param s Array of at least TEXTWRITER_NUMBER_CHARS characters receiving the text, which is not terminated.
+   * @return Number of characters written.
+   */
+  static int formatDouble (double v, char* s);
+  /**
+   * @brief Get the writer of a file that is kept open between outputs, the file being opened in append mode at the first call.
+   * @param fileName Name of the file.
+   * @return Pointer to the writer, NULL if the file could not be opened. The writer belongs to the pool.
+   */
+  static TextWriter* get (std::string fileName);
+  /**
+   * @brief Writes the buffers of all files kept open.
+   */
+  static void flushAll ();
+  /**
+   * @brief Closes all files kept open. They are opened again, in append mode, at the next call to TextWriter::get.
+   */
+  static void closeAll ();
+  /**
+   * @brief Sets the flush interval of the files kept open, including those already open.
+   * @param interval The interval, in seconds. Zero writes every line, a negative value only writes full buffers.
+   */
+  static void setDefaultFlushInterval (double interval);
+};
+
+#endif // TEXTWRITER_H
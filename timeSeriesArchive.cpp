@@ -0,0 +1,420 @@
+/**
+ * @file timeSeriesArchive.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the member functions of the class TimeSeriesArchive.
+ * @details This file defines the member functions of the class TimeSeriesArchive, which gathers the outputs that would otherwise be written to one text file per time step into a single file.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "timeSeriesArchive.h"
+
+// Constructors
+/**
+ * @brief Default constructor. The archive is closed.
+ */
+TimeSeriesArchive::TimeSeriesArchive ()
+{
+  this->fp = NULL;
+  this->writing = false;
+  this->indexed = false;
+  this->end = 0;
+}
+
+/**
+ * @brief Reads the index at the end of the file.
+ * @return True if the index was found and is consistent with the file.
+ */
+bool TimeSeriesArchive::readIndex ()
+{
+  ArchiveFileHeader header;
+  ArchiveFooter footer;
+  ArchiveIndexEntry entry;
+  ArchiveRecord record;
+  std::vector<char> name;
+  long long size;
+  long long i;
+
+  this->records.clear ();
+
+  fseeko ( this->fp, 0, SEEK_END );
+  size = ftello ( this->fp );
+  if ( size < (long long) ( sizeof(ArchiveFileHeader) + sizeof(ArchiveFooter) ) ) {
+    return ( false );
+  }
+
+  // File header
+  fseeko ( this->fp, 0, SEEK_SET );
+  if ( fread ( &header, sizeof(ArchiveFileHeader), 1, this->fp ) != 1
+       || memcmp ( header.magic, TIMESERIESARCHIVE_MAGIC, 8 ) != 0 ) {
+    return ( false );
+  }
+
+  // Footer
+  fseeko ( this->fp, size - sizeof(ArchiveFooter), SEEK_SET );
+  if ( fread ( &footer, sizeof(ArchiveFooter), 1, this->fp ) != 1
+       || memcmp ( footer.magic, TIMESERIESARCHIVE_INDEX_MAGIC, 8 ) != 0
+       || footer.indexOffset < (long long) sizeof(ArchiveFileHeader)
+       || footer.indexOffset > size - (long long) sizeof(ArchiveFooter)
+       || footer.nRecords < 0 ) {
+    return ( false );
+  }
+
+  // Index
+  fseeko ( this->fp, footer.indexOffset, SEEK_SET );
+  for ( i=0; i<footer.nRecords; i++ ) {
+    if ( fread ( &entry, sizeof(ArchiveIndexEntry), 1, this->fp ) != 1
+         || entry.nameLength < 0 || entry.dataLength < 0
+         || entry.offset < (long long) sizeof(ArchiveFileHeader)
+         || entry.offset + (long long) sizeof(ArchiveRecordHeader) + entry.nameLength + entry.dataLength > footer.indexOffset ) {
+      this->records.clear ();
+      return ( false );
+    }
+    name.resize ( entry.nameLength + 1, 0 );
+    if ( entry.nameLength > 0 && fread ( &name[0], 1, entry.nameLength, this->fp ) != (size_t) entry.nameLength ) {
+      this->records.clear ();
+      return ( false );
+    }
+    record.name = std::string ( &name[0], entry.nameLength );
+    record.time = entry.time;
+    record.offset = entry.offset;
+    record.dataLength = entry.dataLength;
+    this->records.push_back ( record );
+  }
+
+  this->end = footer.indexOffset;
+  this->indexed = true;
+  return ( true );
+}
+
+/**
+ * @brief Finds the records by following their headers from the beginning of the file. Reading stops at the first incomplete record.
+ * @return True if at least the file header was found.
+ */
+bool TimeSeriesArchive::scanRecords ()
+{
+  ArchiveFileHeader header;
+  ArchiveRecordHeader recordHeader;
+  ArchiveRecord record;
+  std::vector<char> name;
+  long long size;
+  long long position;
+
+  this->records.clear ();
+
+  fseeko ( this->fp, 0, SEEK_END );
+  size = ftello ( this->fp );
+
+  fseeko ( this->fp, 0, SEEK_SET );
+  if ( fread ( &header, sizeof(ArchiveFileHeader), 1, this->fp ) != 1
+       || memcmp ( header.magic, TIMESERIESARCHIVE_MAGIC, 8 ) != 0 ) {
+    return ( false );
+  }
+
+  position = sizeof(ArchiveFileHeader);
+  while ( position + (long long) sizeof(ArchiveRecordHeader) <= size ) {
+    fseeko ( this->fp, position, SEEK_SET );
+    if ( fread ( &recordHeader, sizeof(ArchiveRecordHeader), 1, this->fp ) != 1
+         || memcmp ( recordHeader.magic, TIMESERIESARCHIVE_RECORD_MAGIC, 4 ) != 0
+         || recordHeader.nameLength < 0 || recordHeader.dataLength < 0
+         || position + (long long) sizeof(ArchiveRecordHeader) + recordHeader.nameLength + recordHeader.dataLength > size ) {
+      // Incomplete record, or the index of an archive that was closed
+      break;
+    }
+    name.resize ( recordHeader.nameLength + 1, 0 );
+    if ( recordHeader.nameLength > 0 && fread ( &name[0], 1, recordHeader.nameLength, this->fp ) != (size_t) recordHeader.nameLength ) {
+      break;
+    }
+    record.name = std::string ( &name[0], recordHeader.nameLength );
+    record.time = recordHeader.time;
+    record.offset = position;
+    record.dataLength = recordHeader.dataLength;
+    this->records.push_back ( record );
+
+    position += sizeof(ArchiveRecordHeader) + recordHeader.nameLength + recordHeader.dataLength;
+  }
+
+  this->end = position;
+  this->indexed = false;
+  return ( true );
+}
+
+/**
+ * @brief Appends the index and the footer after the last record.
+ */
+void TimeSeriesArchive::writeIndex ()
+{
+  std::vector<ArchiveRecord>::iterator r_it;
+  ArchiveIndexEntry entry;
+  ArchiveFooter footer;
+
+  fseeko ( this->fp, this->end, SEEK_SET );
+
+  for ( r_it=this->records.begin(); r_it!=this->records.end(); r_it++ ) {
+    memset ( &entry, 0, sizeof(ArchiveIndexEntry) );
+    entry.offset = r_it->offset;
+    entry.time = r_it->time;
+    entry.dataLength = r_it->dataLength;
+    entry.nameLength = r_it->name.size ();
+    fwrite ( &entry, sizeof(ArchiveIndexEntry), 1, this->fp );
+    fwrite ( r_it->name.data(), 1, r_it->name.size(), this->fp );
+  }
+
+  memset ( &footer, 0, sizeof(ArchiveFooter) );
+  footer.indexOffset = this->end;
+  footer.nRecords = this->records.size ();
+  memcpy ( footer.magic, TIMESERIESARCHIVE_INDEX_MAGIC, 8 );
+  fwrite ( &footer, sizeof(ArchiveFooter), 1, this->fp );
+  fflush ( this->fp );
+}
+
+/**
+ * @brief Opens the file and finds its records.
+ * @param fileName Name of the file.
+ * @param mode Mode of fopen.
+ * @return True if the file is an archive.
+ */
+bool TimeSeriesArchive::load (std::string fileName, const char* mode)
+{
+  this->fp = fopen ( fileName.c_str(), mode );
+  if ( this->fp == NULL ) {
+    return ( false );
+  }
+
+  if ( !this->readIndex () && !this->scanRecords () ) {
+    fclose ( this->fp );
+    this->fp = NULL;
+    return ( false );
+  }
+
+  this->fileName = fileName;
+  return ( true );
+}
+
+// Operations
+/**
+ * @brief Opens an archive for writing. A new archive is created if the file does not exist, otherwise the records are appended to those already present.
+ * @param fileName Name of the file.
+ * @return True if the archive could be opened.
+ */
+bool TimeSeriesArchive::open (std::string fileName)
+{
+  ArchiveFileHeader header;
+  bool exists = false;
+  FILE* f;
+
+  this->close ();
+
+  f = fopen ( fileName.c_str(), "rb" );
+  if ( f != NULL ) {
+    fseeko ( f, 0, SEEK_END );
+    exists = ( ftello ( f ) > 0 );
+    fclose ( f );
+  }
+
+  if ( exists ) {
+    // Continue the archive: the new records replace its index
+    if ( !this->load ( fileName, "r+b" ) ) {
+      return ( false );
+    }
+    fflush ( this->fp );
+    if ( ftruncate ( fileno ( this->fp ), this->end ) != 0 ) {
+      fclose ( this->fp );
+      this->fp = NULL;
+      return ( false );
+    }
+  }
+  else {
+    this->fp = fopen ( fileName.c_str(), "w+b" );
+    if ( this->fp == NULL ) {
+      return ( false );
+    }
+    memset ( &header, 0, sizeof(ArchiveFileHeader) );
+    memcpy ( header.magic, TIMESERIESARCHIVE_MAGIC, 8 );
+    header.version = 1;
+    fwrite ( &header, sizeof(ArchiveFileHeader), 1, this->fp );
+    this->fileName = fileName;
+    this->records.clear ();
+    this->indexed = false;
+    this->end = sizeof(ArchiveFileHeader);
+  }
+
+  this->writing = true;
+  return ( true );
+}
+
+/**
+ * @brief Opens an archive for reading.
+ * @param fileName Name of the file.
+ * @return True if the file is an archive.
+ */
+bool TimeSeriesArchive::openForReading (std::string fileName)
+{
+  this->close ();
+  return ( this->load ( fileName, "rb" ) );
+}
+
+/**
+ * @brief Appends a record to an archive open for writing.
+ * @param name Name of the record, which is the name of the legacy text file without its directory.
+ * @param t Simulation time of the record.
+ * @param data Contents of the record.
+ * @return True if the record was written.
+ */
+bool TimeSeriesArchive::addRecord (std::string name, double t, const std::string& data)
+{
+  ArchiveRecordHeader header;
+  ArchiveRecord record;
+
+  if ( this->fp == NULL || !this->writing ) {
+    return ( false );
+  }
+
+  memset ( &header, 0, sizeof(ArchiveRecordHeader) );
+  memcpy ( header.magic, TIMESERIESARCHIVE_RECORD_MAGIC, 4 );
+  header.nameLength = name.size ();
+  header.time = t;
+  header.dataLength = data.size ();
+
+  fseeko ( this->fp, this->end, SEEK_SET );
+  if ( fwrite ( &header, sizeof(ArchiveRecordHeader), 1, this->fp ) != 1
+       || fwrite ( name.data(), 1, name.size(), this->fp ) != name.size()
+       || fwrite ( data.data(), 1, data.size(), this->fp ) != data.size() ) {
+    return ( false );
+  }
+
+  record.name = name;
+  record.time = t;
+  record.offset = this->end;
+  record.dataLength = data.size ();
+  this->records.push_back ( record );
+
+  this->end += sizeof(ArchiveRecordHeader) + name.size() + data.size();
+  return ( true );
+}
+
+/**
+ * @brief Closes the archive. The index is written if the archive was open for writing.
+ */
+void TimeSeriesArchive::close ()
+{
+  if ( this->fp == NULL ) {
+    return;
+  }
+
+  if ( this->writing ) {
+    this->writeIndex ();
+  }
+
+  fclose ( this->fp );
+  this->fp = NULL;
+  this->writing = false;
+  this->records.clear ();
+}
+
+/**
+ * @brief Reads the data of a record of the archive.
+ * @param i Index of the record.
+ * @param data Pointer to the string receiving the data.
+ * @return True if the data was read.
+ */
+bool TimeSeriesArchive::readRecord (int i, std::string* data)
+{
+  const ArchiveRecord& record = this->records[i];
+
+  if ( this->fp == NULL ) {
+    return ( false );
+  }
+
+  data->resize ( record.dataLength );
+  if ( record.dataLength == 0 ) {
+    return ( true );
+  }
+
+  fseeko ( this->fp, record.offset + sizeof(ArchiveRecordHeader) + record.name.size(), SEEK_SET );
+  return ( fread ( &(*data)[0], 1, record.dataLength, this->fp ) == (size_t) record.dataLength );
+}
+
+// Access functions
+/**
+ * @brief Indicates whether the archive is open.
+ * @return True if the archive is open.
+ */
+bool TimeSeriesArchive::isOpen () const
+{
+  return ( this->fp != NULL );
+}
+
+/**
+ * @brief Get the name of the file.
+ * @return The name of the file.
+ */
+std::string TimeSeriesArchive::getFileName () const
+{
+  return ( this->fileName );
+}
+
+/**
+ * @brief Indicates whether the index was found when the archive was opened. If not, the records were found from their headers.
+ * @return True if the index was found.
+ */
+bool TimeSeriesArchive::isIndexed () const
+{
+  return ( this->indexed );
+}
+
+/**
+ * @brief Get the number of records.
+ * @return The number of records.
+ */
+int TimeSeriesArchive::getNumRecords () const
+{
+  return ( this->records.size () );
+}
+
+/**
+ * @brief Get the description of a record.
+ * @param i Index of the record.
+ * @return The description of the record.
+ */
+const ArchiveRecord& TimeSeriesArchive::getRecord (int i) const
+{
+  return ( this->records[i] );
+}
+
+// Static functions
+/**
+ * @brief Get the name of a file without its directory.
+ * @param fileName The name of the file.
+ * @return The characters after the last /.
+ */
+std::string TimeSeriesArchive::baseName (std::string fileName)
+{
+  size_t slash = fileName.find_last_of ( '/' );
+
+  if ( slash == std::string::npos ) {
+    return ( fileName );
+  }
+  return ( fileName.substr ( slash + 1 ) );
+}
@@ -0,0 +1,307 @@
+/**
+ * @file timeSeriesArchive.h
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the class TimeSeriesArchive.
+ * @details This file defines the class TimeSeriesArchive, which gathers the outputs that would otherwise be written to one text file per time step into a single file.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TIMESERIESARCHIVE_H
+#define TIMESERIESARCHIVE_H
+
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+/**
+ * @brief Identifier at the beginning of an archive.
+ */
+#define TIMESERIESARCHIVE_MAGIC "DD2DTSA1"
+
+/**
+ * @brief Identifier at the end of an archive whose index was written.
+ */
+#define TIMESERIESARCHIVE_INDEX_MAGIC "DD2DIDX1"
+
+/**
+ * @brief Identifier at the beginning of each record.
+ */
+#define TIMESERIESARCHIVE_RECORD_MAGIC "REC1"
+
+/**
+ * @brief The ArchiveFileHeader struct is written at the beginning of an archive.
+ */
+struct ArchiveFileHeader
+{
+  /**
+   * @brief The identifier TIMESERIESARCHIVE_MAGIC, without the terminating null character.
+   */
+  char magic[8];
+  /**
+   * @brief Version of the format.
+   */
+  int version;
+  /**
+   * @brief Reserved for later use.
+   */
+  int reserved;
+};
+
+/**
+ * @brief The ArchiveRecordHeader struct precedes the name and the data of each record.
+ */
+struct ArchiveRecordHeader
+{
+  /**
+   * @brief The identifier TIMESERIESARCHIVE_RECORD_MAGIC, without the terminating null character.
+   */
+  char magic[4];
+  /**
+   * @brief Number of characters of the name of the record.
+   */
+  int nameLength;
+  /**
+   * @brief Simulation time of the record.
+   */
+  double time;
+  /**
+   * @brief Number of bytes of the data of the record.
+   */
+  long long dataLength;
+};
+
+/**
+ * @brief The ArchiveIndexEntry struct describes a record in the index at the end of an archive. It is followed by the name of the record.
+ */
+struct ArchiveIndexEntry
+{
+  /**
+   * @brief Position of the record header in the file.
+   */
+  long long offset;
+  /**
+   * @brief Simulation time of the record.
+   */
+  double time;
+  /**
+   * @brief Number of bytes of the data of the record.
+   */
+  long long dataLength;
+  /**
+   * @brief Number of characters of the name of the record.
+   */
+  int nameLength;
+  /**
+   * @brief Reserved for later use.
+   */
+  int reserved;
+};
+
+/**
+ * @brief The ArchiveFooter struct is written at the very end of an archive, after the index.
+ */
+struct ArchiveFooter
+{
+  /**
+   * @brief Position of the index in the file.
+   */
+  long long indexOffset;
+  /**
+   * @brief Number of records in the index.
+   */
+  long long nRecords;
+  /**
+   * @brief The identifier TIMESERIESARCHIVE_INDEX_MAGIC, without the terminating null character.
+   */
+  char magic[8];
+};
+
+/**
+ * @brief The ArchiveRecord struct holds the description of a record of an archive.
+ */
+struct ArchiveRecord
+{
+  /**
+   * @brief Name of the record, which is the name of the legacy text file without its directory.
+   */
+  std::string name;
+  /**
+   * @brief Simulation time of the record.
+   */
+  double time;
+  /**
+   * @brief Position of the record header in the file.
+   */
+  long long offset;
+  /**
+   * @brief Number of bytes of the data of the record.
+   */
+  long long dataLength;
+};
+
+/**
+ * @brief The TimeSeriesArchive class writes a series of outputs into one append-only file.
+ * @details Each output that would be written to its own text file, typically one file per time step, is appended to the archive as a record: a header with the simulation time and the lengths, the name of the text file and its contents. When the archive is closed, an index of all records is appended, followed by a footer giving the position of the index, so that a reader finds any record without reading the others. An archive that was not closed, because the simulation was interrupted, is still readable: the records are then found by following their headers from the beginning of the file. Opening an existing archive for writing continues it, the new records replacing its index. The tool in the folder tools (tools/archiveExtract.pro) lists the records and writes them back as the original text files.
+ */
+class TimeSeriesArchive
+{
+protected:
+  /**
+   * @brief The open file, NULL if the archive is closed.
+   */
+  FILE* fp;
+  /**
+   * @brief Name of the file.
+   */
+  std::string fileName;
+  /**
+   * @brief Flag indicating whether the archive is open for writing.
+   */
+  bool writing;
+  /**
+   * @brief Flag indicating whether the index was found when the archive was opened.
+   */
+  bool indexed;
+  /**
+   * @brief Position of the end of the last record.
+   */
+  long long end;
+  /**
+   * @brief The records of the archive.
+   */
+  std::vector<ArchiveRecord> records;
+
+  /**
+   * @brief Reads the index at the end of the file.
+   * @return True if the index was found and is consistent with the file.
+   */
+  bool readIndex ();
+  /**
+   * @brief Finds the records by following their headers from the beginning of the file. Reading stops at the first incomplete record.
+   * @return True if at least the file header was found.
+   */
+  bool scanRecords ();
+  /**
+   * @brief Appends the index and the footer after the last record.
+   */
+  void writeIndex ();
+  /**
+   * @brief Opens the file and finds its records.
+   * @param fileName Name of the file.
+   * @param mode Mode of fopen.
+   * @return True if the file is an archive.
+   */
+  bool load (std::string fileName, const char* mode);
+
+public:
+  // Constructors
+  /**
+   * @brief Default constructor. The archive is closed.
+   */
+  TimeSeriesArchive ();
+
+  // Destructor
+  /**
+   * @brief Destructor for the class TimeSeriesArchive. The archive is closed, which writes its index.
+   */
+  virtual ~TimeSeriesArchive ()
+  {
+    this->close ();
+  }
+
+  // Operations
+  /**
+   * @brief Opens an archive for writing. A new archive is created if the file does not exist, otherwise the records are appended to those already present.
+   * @param fileName Name of the file.
+   * @return True if the archive could be opened.
+   */
+  bool open (std::string fileName);
+  /**
+   * @brief Opens an archive for reading.
+   * @param fileName Name of the file.
+   * @return True if the file is an archive.
+   */
+  bool openForReading (std::string fileName);
+  /**
+   * @brief Appends a record to an archive open for writing.
+   * @param name Name of the record, which is the name of the legacy text file without its directory.
+   * @param t Simulation time of the record.
+   * @param data Contents of the record.
+   * @return True if the record was written.
+   */
+  bool addRecord (std::string name, double t, const std::string& data);
+  /**
+   * @brief Closes the archive. The index is written if the archive was open for writing.
+   */
+  void close ();
+  /**
+   * @brief Reads the data of a record of the archive.
+   * @param i Index of the record.
+   * @param data Pointer to the string receiving the data.
+   * @return True if the data was read.
+   */
+  bool readRecord (int i, std::string* data);
+
+  // Access functions
+  /**
+   * @brief Indicates whether the archive is open.
+   * @return True if the archive is open.
+   */
+  bool isOpen () const;
+  /**
+   * @brief Get the name of the file.
+   * @return The name of the file.
+   */
+  std::string getFileName () const;
+  /**
+   * @brief Indicates whether the index was found when the archive was opened. If not, the records were found from their headers.
+   * @return True if the index was found.
+   */
+  bool isIndexed () const;
+  /**
+   * @brief Get the number of records.
+   * @return The number of records.
+   */
+  int getNumRecords () const;
+  /**
+   * @brief Get the description of a record.
+   * @param i Index of the record.
+   * @return The description of the record.
+   */
+  const ArchiveRecord& getRecord (int i) const;
+
+  // Static functions
+  /**
+   * @brief Get the name of a file without its directory.
+   * @param fileName The name of the file.
+   * @return The characters after the last /.
+   */
+  static std::string baseName (std::string fileName);
+};
+
+#endif // TIMESERIESARCHIVE_H
@@ -214,6 +214,21 @@ std::string doubleToString (double i)
     return ( ss.str() );
 }
 
+/**
+ * @brief Creates a directory.
+ * @details The directory is created with the permissions rwxr-xr-x. Its parent directory must exist.
+ * @param dirName Name of the directory.
+ * @return True if the directory was created or already exists, false otherwise.
+ */
+bool createDirectory (std::string dirName)
+{
+    if (mkdir(dirName.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) == 0) {
+        return (true);
+    }
+
+    return (errno == EEXIST);
+}
+
 /**
  * @brief Function to get a vector container filled with a Gaussian distribution of doubles with the given mean and standard deviation.
  * @param n Number of doubles required.
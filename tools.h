@@ -39,6 +39,10 @@
 #include <string>
 #include <sstream>
 
+// POSIX directory creation
+#include <sys/stat.h>
+#include <errno.h>
+
 // GNU Scientific Library files
 #include <gsl/gsl_rng.h>
 #include <gsl/gsl_randist.h>
@@ -122,6 +126,14 @@ std::string intToString (int i);
  */
 std::string doubleToString (double i);
 
+/**
+ * @brief Creates a directory.
+ * @details The directory is created with the permissions rwxr-xr-x. Its parent directory must exist.
+ * @param dirName Name of the directory.
+ * @return True if the directory was created or already exists, false otherwise.
+ */
+bool createDirectory (std::string dirName);
+
 /**
  * @brief SGN function to return the sign of a number.
  * @param v The value whose sign is to be found.
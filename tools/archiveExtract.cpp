@@ -0,0 +1,141 @@
+/**
+ * @file archiveExtract.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Tool extracting the records of an archive of outputs.
+ * @details This file defines a program that lists the records of an archive written by the class TimeSeriesArchive and writes them back as the text files that the simulation would have written without the archive.
+ *
+ * Usage: archiveExtract <archive> [-list] [-output <directory>] [-name <prefix>] [-from <time>] [-to <time>]
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <set>
+#include <stdlib.h>
+
+#include "../timeSeriesArchive.h"
+
+/**
+ * @brief Point of entry of the extraction tool.
+ * @param argc Number of arguments.
+ * @param argv Arguments: the name of the archive, followed by the options.
+ * @return Zero on success.
+ */
+int main (int argc, char* argv[])
+{
+    TimeSeriesArchive archive;
+    std::string fileName;
+    std::string directory = ".";
+    std::string prefix;
+    std::string data;
+    std::set<std::string> written;
+    bool list = false;
+    bool from = false;
+    bool to = false;
+    double t0 = 0.0;
+    double t1 = 0.0;
+    int nWritten = 0;
+    int i;
+
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <archive> [-list] [-output <directory>] [-name <prefix>] [-from <time>] [-to <time>]" << std::endl;
+        return (1);
+    }
+
+    fileName = std::string(argv[1]);
+    for (i=2; i<argc; i++) {
+        if (std::string(argv[i]) == "-list") {
+            list = true;
+        }
+        else if (std::string(argv[i]) == "-output" && i+1 < argc) {
+            directory = std::string(argv[++i]);
+        }
+        else if (std::string(argv[i]) == "-name" && i+1 < argc) {
+            prefix = std::string(argv[++i]);
+        }
+        else if (std::string(argv[i]) == "-from" && i+1 < argc) {
+            from = true;
+            t0 = atof(argv[++i]);
+        }
+        else if (std::string(argv[i]) == "-to" && i+1 < argc) {
+            to = true;
+            t1 = atof(argv[++i]);
+        }
+    }
+
+    if (!archive.openForReading(fileName)) {
+        std::cerr << "Unable to read the archive " << fileName << std::endl;
+        return (1);
+    }
+
+    if (!archive.isIndexed()) {
+        std::cerr << "The archive " << fileName << " has no index: the records were found from their headers" << std::endl;
+    }
+
+    for (i=0; i<archive.getNumRecords(); i++) {
+        const ArchiveRecord& record = archive.getRecord(i);
+
+        // Selection
+        if (record.name.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        if ((from && record.time < t0) || (to && record.time > t1)) {
+            continue;
+        }
+
+        if (list) {
+            std::cout << record.time << " " << record.dataLength << " " << record.name << std::endl;
+            continue;
+        }
+
+        if (!archive.readRecord(i, &data)) {
+            std::cerr << "Unable to read the record " << record.name << std::endl;
+            continue;
+        }
+
+        // Records with the same name are appended to the same file, as the simulation does
+        std::ios_base::openmode mode = std::ios_base::out | std::ios_base::binary;
+        if (written.count(record.name) > 0) {
+            mode |= std::ios_base::app;
+        }
+        std::ofstream fp ((directory + "/" + record.name).c_str(), mode);
+        if (!fp.is_open()) {
+            std::cerr << "Unable to write the file " << directory << "/" << record.name << std::endl;
+            continue;
+        }
+        fp.write(data.data(), data.size());
+        fp.close();
+
+        written.insert(record.name);
+        nWritten++;
+    }
+
+    if (!list) {
+        std::cout << nWritten << " records written to " << written.size() << " files in " << directory << std::endl;
+    }
+
+    return (0);
+}
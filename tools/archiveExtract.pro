@@ -0,0 +1,11 @@
+# Extraction of the text files stored in an archive of outputs (archive)
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= qt
+
+SOURCES += archiveExtract.cpp \
+    ../timeSeriesArchive.cpp
+
+HEADERS += \
+    ../timeSeriesArchive.h
@@ -0,0 +1,129 @@
+/**
+ * @file contactTest.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Check of the resolution of the contacts between defects moving along a slip plane.
+ * @details This file defines a program that places three dislocations on a slip plane, moves them with SlipPlane::moveDislocations and compares their final positions with those calculated by hand. In both cases a dislocation is stopped by a first contact and is then caught by another dislocation: it must stay where the first contact stopped it.
+ *
+ * Usage: contactTest
+ *
+ * The program returns zero if all cases give the expected positions.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <math.h>
+
+#include "../slipPlane.h"
+
+/**
+ * @brief Length unit of the cases, in metres.
+ */
+#define CONTACT_LENGTH 1.0e-9
+
+/**
+ * @brief Time increment of the cases, in seconds.
+ */
+#define CONTACT_TIMESTEP 10.0e-9
+
+/**
+ * @brief Minimum distance of approach between defects that do not react, in units of CONTACT_LENGTH.
+ */
+#define CONTACT_MINDISTANCE 5.0
+
+/**
+ * @brief Moves three dislocations over one time step and compares their final positions with the expected ones.
+ * @param name Name of the case.
+ * @param x Initial positions, in units of CONTACT_LENGTH.
+ * @param sign Signs of the Burgers vectors.
+ * @param v Velocities, in metres per second.
+ * @param expected Expected final positions, in units of CONTACT_LENGTH.
+ * @return True if the final positions are those expected.
+ */
+bool runCase (std::string name, double* x, double* sign, double* v, double* expected)
+{
+    Vector3d ends[2];
+    ends[0] = Vector3d(-1000.0*CONTACT_LENGTH, 0.0, 0.0);
+    ends[1] = Vector3d( 1000.0*CONTACT_LENGTH, 0.0, 0.0);
+    std::vector<Dislocation*> noDislocations;
+    std::vector<DislocationSource*> noSources;
+    SlipPlane* slipPlane = new SlipPlane(ends, Vector3d(0.0, 0.0, 0.0), NULL, noDislocations, noSources);
+
+    std::vector<Dislocation*> dislocations;
+    Dislocation* d;
+    int i;
+    for (i=0; i<3; i++) {
+        d = new Dislocation(Vector3d(sign[i], 0.0, 0.0), Vector3d::unitVector(2), Vector3d(x[i]*CONTACT_LENGTH, 0.0, 0.0), slipPlane->getCoordinateSystem(), 2.5e-10, true);
+        d->setVelocity(Vector3d(v[i], 0.0, 0.0));
+        dislocations.push_back(d);
+        slipPlane->insertDislocation(d);
+    }
+    slipPlane->updateDefects();
+    slipPlane->setTimeIncrement(CONTACT_TIMESTEP);
+
+    std::vector<double> timeIncrement(3, CONTACT_TIMESTEP);
+    slipPlane->moveDislocations(timeIncrement, CONTACT_MINDISTANCE*CONTACT_LENGTH);
+
+    bool success = true;
+    double position;
+    for (i=0; i<3; i++) {
+        position = dislocations[i]->getPosition().getValue(0) / CONTACT_LENGTH;
+        if (fabs(position - expected[i]) > 1.0e-6) {
+            std::cout << name << ": dislocation " << i << " at " << position << " instead of " << expected[i] << std::endl;
+            success = false;
+        }
+    }
+    std::cout << name << (success ? ": passed" : ": FAILED") << std::endl;
+
+    // The slip plane deletes its dislocations
+    delete (slipPlane);
+    return (success);
+}
+
+/**
+ * @brief Point of entry of the check.
+ * @return Zero if all cases give the expected positions.
+ */
+int main ()
+{
+    bool success = true;
+
+    // The middle dislocation stops behind its immobile neighbour, then a dislocation of opposite sign reaches it
+    double x0[3] = {0.0, 10.0, 20.0};
+    double sign0[3] = {-1.0, 1.0, 1.0};
+    double v0[3] = {3.0, 2.0, 0.0};
+    double expected0[3] = {15.0, 15.0, 20.0};
+    success = runCase("Clamp, then reaction", x0, sign0, v0, expected0) && success;
+
+    // The middle dislocation stops where it meets a dislocation of opposite sign, then a dislocation of the same sign approaches it
+    double x1[3] = {0.0, 10.0, 30.0};
+    double sign1[3] = {-1.0, 1.0, 1.0};
+    double v1[3] = {4.0, 1.0, -2.0};
+    double expected1[3] = {40.0/3.0, 40.0/3.0, 55.0/3.0};
+    success = runCase("Reaction, then clamp", x1, sign1, v1, expected1) && success;
+
+    return (success ? 0 : 1);
+}
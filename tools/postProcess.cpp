@@ -0,0 +1,673 @@
+/**
+ * @file postProcess.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Post-processing of the outputs of the simulation.
+ * @details This file defines a program that reads the text outputs of the simulation, either as files or as records of an archive (parameter archive), and writes the derived data plotted by the Matlab functions of the folder plotTools as tables, in CSV or binary format. The files are mapped in memory and parsed by several threads.
+ *
+ * Usage: postProcess <command> <files or archives...> [-name <prefix>] [-columns <n>] [-output <prefix>] [-binary] [-threads <n>]
+ *
+ * The commands are:
+ * - trajectory: files of defect positions (statsGrainObjects, statsSlipSystemObjects, statsAllDefects), with the time and n co-ordinates per defect in each row (-columns, 2 by default, 1 for a slip plane). The tables <prefix>_positions (time, defect, co-ordinates) and <prefix>_counts (time, number of defects) are written, as with plotDefects.m and plotSlipPlane.m.
+ * - slipplane: files of the slip plane (statsDislocationPositions). The tables <prefix>_positions (time, dislocation, x, y, z, distance from the first dislocation) and <prefix>_counts (time, numbers of dislocations and of dislocation sources) are written, as with findDislocationPositions.m.
+ * - stress: stress distributions along the slip plane (statsSlipPlaneStress). The table <prefix>_stress (time, distance from the first point, six local and six global stress components) is written, as with plotStresses.m.
+ *
+ * The binary tables start with the characters DD2DTAB1, followed by the number of columns and a reserved integer (32 bit), the number of rows (64 bit), the length of the names of the columns (32 bit) and the names separated by commas, and then the values (64 bit floating point) row by row.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Memory mapped files
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "../textWriter.h"
+#include "../timeSeriesArchive.h"
+
+/**
+ * @brief The Document struct holds the text of an output file or of a record of an archive.
+ */
+struct Document
+{
+    /**
+     * @brief Name of the file or of the record.
+     */
+    std::string name;
+    /**
+     * @brief Time of the output, from the record or the name of the file.
+     */
+    double time;
+    /**
+     * @brief Memory mapping of a file, NULL for a record.
+     */
+    char* map;
+    /**
+     * @brief Number of characters.
+     */
+    size_t size;
+    /**
+     * @brief Text of a record.
+     */
+    std::string storage;
+};
+
+/**
+ * @brief The Table struct holds a table of values with named columns.
+ */
+struct Table
+{
+    /**
+     * @brief Names of the columns.
+     */
+    std::vector<std::string> columns;
+    /**
+     * @brief Values, row by row.
+     */
+    std::vector<double> values;
+};
+
+/**
+ * @brief Get the text of a document.
+ * @param d The document.
+ * @return Pointer to the first character.
+ */
+const char* documentText (const Document& d)
+{
+    if (d.map != NULL) {
+        return (d.map);
+    }
+    return (d.storage.data());
+}
+
+/**
+ * @brief Finds the time in the name of an output file, such as spDisl1e-09.txt.
+ * @param fileName Name of the file.
+ * @return The time, or zero if the name does not end with a number.
+ */
+double timeFromName (std::string fileName)
+{
+    std::string name = TimeSeriesArchive::baseName(fileName);
+    size_t dot = name.rfind(".txt");
+    char* end;
+    double t;
+    size_t i;
+
+    if (dot != std::string::npos) {
+        name = name.substr(0, dot);
+    }
+
+    // The longest suffix that is a number
+    for (i=0; i<name.size(); i++) {
+        t = strtod(name.c_str() + i, &end);
+        if (end != name.c_str() + i && *end == '\0') {
+            return (t);
+        }
+    }
+    return (0.0);
+}
+
+/**
+ * @brief Reads the documents given on the command line. Each argument is an archive, whose records starting with the prefix are read, or a text file, which is mapped in memory.
+ * @param names Names of the files and archives.
+ * @param prefix Prefix of the names of the records read from the archives.
+ * @param documents Pointer to the vector receiving the documents, sorted by time.
+ * @return True if all files could be read.
+ */
+bool readDocuments (const std::vector<std::string>& names, std::string prefix, std::vector<Document>* documents)
+{
+    TimeSeriesArchive archive;
+    Document d;
+    struct stat s;
+    int fd;
+    int i, j;
+
+    for (i=0; i<names.size(); i++) {
+        if (archive.openForReading(names[i])) {
+            for (j=0; j<archive.getNumRecords(); j++) {
+                const ArchiveRecord& r = archive.getRecord(j);
+                if (r.name.compare(0, prefix.size(), prefix) != 0) {
+                    continue;
+                }
+                d.name = r.name;
+                d.time = r.time;
+                d.map = NULL;
+                if (!archive.readRecord(j, &(d.storage))) {
+                    std::cerr << "Unable to read the record " << r.name << " of " << names[i] << std::endl;
+                    return (false);
+                }
+                d.size = d.storage.size();
+                documents->push_back(d);
+            }
+            archive.close();
+            continue;
+        }
+
+        fd = open(names[i].c_str(), O_RDONLY);
+        if (fd < 0 || fstat(fd, &s) != 0) {
+            std::cerr << "Unable to read the file " << names[i] << std::endl;
+            return (false);
+        }
+        d.name = names[i];
+        d.time = timeFromName(names[i]);
+        d.storage.clear();
+        d.size = s.st_size;
+        d.map = NULL;
+        if (d.size > 0) {
+            void* m = mmap(NULL, d.size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m == MAP_FAILED) {
+                close(fd);
+                std::cerr << "Unable to map the file " << names[i] << std::endl;
+                return (false);
+            }
+            madvise(m, d.size, MADV_SEQUENTIAL);
+            d.map = (char*) m;
+        }
+        close(fd);
+        documents->push_back(d);
+    }
+
+    return (true);
+}
+
+/**
+ * @brief Releases the memory mappings of the documents.
+ * @param documents The documents.
+ */
+void releaseDocuments (std::vector<Document>* documents)
+{
+    int i;
+
+    for (i=0; i<documents->size(); i++) {
+        if ((*documents)[i].map != NULL) {
+            munmap((*documents)[i].map, (*documents)[i].size);
+            (*documents)[i].map = NULL;
+        }
+    }
+    documents->clear();
+}
+
+/**
+ * @brief Orders documents by time.
+ * @param a First document.
+ * @param b Second document.
+ * @return True if the first document comes before the second.
+ */
+bool earlierDocument (const Document& a, const Document& b)
+{
+    return (a.time < b.time);
+}
+
+/**
+ * @brief Finds the beginning of each line of a text.
+ * @param text The text.
+ * @param size Number of characters.
+ * @param lines Pointer to the vector receiving the offset of the beginning of each line that is not empty.
+ */
+void findLines (const char* text, size_t size, std::vector<size_t>* lines)
+{
+    const char* p = text;
+    const char* end = text + size;
+    const char* newline;
+
+    while (p < end) {
+        newline = (const char*) memchr(p, '\n', end - p);
+        if (newline == NULL) {
+            newline = end;
+        }
+        if (newline > p) {
+            lines->push_back(p - text);
+        }
+        p = newline + 1;
+    }
+}
+
+/**
+ * @brief Reads the numbers of a line, which ends with a newline or at the end of the text.
+ * @param line Pointer to the beginning of the line.
+ * @param end Pointer to the end of the text.
+ * @param numbers Pointer to the vector receiving the numbers.
+ */
+void parseLine (const char* line, const char* end, std::vector<double>* numbers)
+{
+    const char* newline = (const char*) memchr(line, '\n', end - line);
+    std::string copy;
+    const char* p;
+    char* next;
+    double v;
+
+    numbers->clear();
+    if (newline == NULL) {
+        // The last line is not terminated: strtod must not read beyond it
+        copy = std::string(line, end - line);
+        line = copy.c_str();
+        newline = line + copy.size();
+    }
+
+    p = line;
+    while (p < newline) {
+        v = strtod(p, &next);
+        if (next == p) {
+            // Not a number: skip the character
+            p++;
+            continue;
+        }
+        numbers->push_back(v);
+        p = next;
+    }
+}
+
+/**
+ * @brief Appends a row to a table.
+ * @param t The table.
+ * @param row The values of the row, one per column.
+ */
+void addRow (Table* t, const double* row)
+{
+    t->values.insert(t->values.end(), row, row + t->columns.size());
+}
+
+/**
+ * @brief Appends the rows of a table to another table with the same columns.
+ * @param t The table receiving the rows.
+ * @param part The table whose rows are appended.
+ */
+void appendTable (Table* t, const Table& part)
+{
+    t->values.insert(t->values.end(), part.values.begin(), part.values.end());
+}
+
+/**
+ * @brief Writes a table.
+ * @param t The table.
+ * @param fileName Name of the file, without the extension .csv or .bin.
+ * @param binary True to write the binary format, false to write CSV.
+ * @return True if the file was written.
+ */
+bool writeTable (const Table& t, std::string fileName, bool binary)
+{
+    long long nColumns = t.columns.size();
+    long long nRows = (nColumns > 0) ? t.values.size() / nColumns : 0;
+    std::string names;
+    long long i;
+    int j;
+
+    for (j=0; j<nColumns; j++) {
+        names += (j > 0 ? "," : "") + t.columns[j];
+    }
+
+    if (binary) {
+        FILE* fp = fopen((fileName + ".bin").c_str(), "wb");
+        int header[2];
+        int length = names.size();
+        if (fp == NULL) {
+            return (false);
+        }
+        fwrite("DD2DTAB1", 1, 8, fp);
+        header[0] = nColumns;
+        header[1] = 0;
+        fwrite(header, sizeof(int), 2, fp);
+        fwrite(&nRows, sizeof(long long), 1, fp);
+        fwrite(&length, sizeof(int), 1, fp);
+        fwrite(names.data(), 1, names.size(), fp);
+        if (!t.values.empty()) {
+            fwrite(&(t.values[0]), sizeof(double), t.values.size(), fp);
+        }
+        fclose(fp);
+        std::cout << fileName << ".bin: " << nRows << " rows" << std::endl;
+        return (true);
+    }
+
+    TextWriter fp;
+    if (!fp.open(fileName + ".csv", false)) {
+        return (false);
+    }
+    fp << names;
+    fp.endLine();
+    for (i=0; i<nRows; i++) {
+        for (j=0; j<nColumns; j++) {
+            if (j > 0) {
+                fp << ',';
+            }
+            fp << t.values[i*nColumns+j];
+        }
+        fp.endLine();
+    }
+    fp.close();
+    std::cout << fileName << ".csv: " << nRows << " rows" << std::endl;
+    return (true);
+}
+
+/**
+ * @brief Reads the files of defect positions, with the time and nColumns co-ordinates per defect in each row.
+ * @param documents The files.
+ * @param nColumns Number of co-ordinates per defect.
+ * @param positions Pointer to the table receiving the time, the index of the defect and its co-ordinates.
+ * @param counts Pointer to the table receiving the time and the number of defects.
+ */
+void processTrajectory (const std::vector<Document>& documents, int nColumns, Table* positions, Table* counts)
+{
+    std::vector<size_t> lines;
+    std::vector<Table> linePositions;
+    std::vector<double> countRows;
+    const char* text;
+    long i;
+    int d, k;
+
+    positions->columns.push_back("time");
+    positions->columns.push_back("defect");
+    positions->columns.push_back("x");
+    if (nColumns > 1) {
+        positions->columns.push_back("y");
+    }
+    for (k=2; k<nColumns; k++) {
+        positions->columns.push_back("x" + std::string(1, '0' + k));
+    }
+    counts->columns.push_back("time");
+    counts->columns.push_back("defects");
+
+    for (d=0; d<documents.size(); d++) {
+        text = documentText(documents[d]);
+        lines.clear();
+        findLines(text, documents[d].size, &lines);
+        linePositions.assign(lines.size(), Table());
+        countRows.assign(2 * lines.size(), 0.0);
+
+        // Each row is read by one thread
+        #pragma omp parallel for schedule(dynamic, 64)
+        for (i=0; i<(long) lines.size(); i++) {
+            std::vector<double> numbers;
+            std::vector<double> row(nColumns + 2);
+            int n, j;
+
+            parseLine(text + lines[i], text + documents[d].size, &numbers);
+            if (numbers.empty()) {
+                continue;
+            }
+            n = (numbers.size() - 1) / nColumns;
+            linePositions[i].columns = positions->columns;
+            linePositions[i].values.reserve(n * (nColumns + 2));
+            row[0] = numbers[0];
+            for (j=0; j<n; j++) {
+                row[1] = j;
+                std::copy(numbers.begin() + 1 + j*nColumns, numbers.begin() + 1 + (j+1)*nColumns, row.begin() + 2);
+                addRow(&(linePositions[i]), &(row[0]));
+            }
+            countRows[2*i] = numbers[0];
+            countRows[2*i+1] = n;
+        }
+
+        for (i=0; i<(long) lines.size(); i++) {
+            if (!linePositions[i].columns.empty()) {
+                appendTable(positions, linePositions[i]);
+                addRow(counts, &(countRows[2*i]));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Reads the files of the slip plane written by SlipPlane::writeSlipPlane.
+ * @param documents The files, sorted by time.
+ * @param positions Pointer to the table receiving the time, the index of the dislocation, its position and its distance from the first dislocation.
+ * @param counts Pointer to the table receiving the time and the numbers of dislocations and of dislocation sources.
+ */
+void processSlipPlanes (const std::vector<Document>& documents, Table* positions, Table* counts)
+{
+    std::vector<Table> documentPositions(documents.size());
+    std::vector<double> countRows(3 * documents.size(), 0.0);
+    long d;
+
+    positions->columns.push_back("time");
+    positions->columns.push_back("dislocation");
+    positions->columns.push_back("x");
+    positions->columns.push_back("y");
+    positions->columns.push_back("z");
+    positions->columns.push_back("distance");
+    counts->columns.push_back("time");
+    counts->columns.push_back("dislocations");
+    counts->columns.push_back("sources");
+
+    // Each file is read by one thread
+    #pragma omp parallel for schedule(dynamic)
+    for (d=0; d<(long) documents.size(); d++) {
+        const char* text = documentText(documents[d]);
+        const char* end = text + documents[d].size;
+        std::vector<size_t> lines;
+        std::vector<double> numbers;
+        std::string section;
+        double row[6];
+        double t = documents[d].time;
+        double x0[3] = {0.0, 0.0, 0.0};
+        int nDislocations = 0;
+        int nSources = 0;
+        int nRead = 0;
+        int i;
+
+        documentPositions[d].columns = positions->columns;
+        findLines(text, documents[d].size, &lines);
+        for (i=0; i<lines.size(); i++) {
+            const char* line = text + lines[i];
+            if (line[0] == '#') {
+                // Section title; the description of the columns does not start a new section
+                if (strncmp(line, "# Position(3)", 13) != 0) {
+                    section = std::string(line, (const char*) memchr(line, '\n', end - line) ? (const char*) memchr(line, '\n', end - line) : end);
+                }
+                continue;
+            }
+            parseLine(line, end, &numbers);
+            if (numbers.empty()) {
+                continue;
+            }
+            if (section == "# Current time") {
+                t = numbers[0];
+            }
+            else if (section == "# Number of dislocations") {
+                nDislocations = (int) numbers[0];
+            }
+            else if (section == "# Number of dislocation sources") {
+                nSources = (int) numbers[0];
+            }
+            else if (section == "# Dislocations" && numbers.size() >= 3) {
+                if (nRead == 0) {
+                    x0[0] = numbers[0];
+                    x0[1] = numbers[1];
+                    x0[2] = numbers[2];
+                }
+                row[0] = t;
+                row[1] = nRead;
+                row[2] = numbers[0];
+                row[3] = numbers[1];
+                row[4] = numbers[2];
+                row[5] = sqrt((numbers[0]-x0[0])*(numbers[0]-x0[0]) + (numbers[1]-x0[1])*(numbers[1]-x0[1]) + (numbers[2]-x0[2])*(numbers[2]-x0[2]));
+                addRow(&(documentPositions[d]), row);
+                nRead++;
+            }
+        }
+
+        countRows[3*d] = t;
+        countRows[3*d+1] = nDislocations;
+        countRows[3*d+2] = nSources;
+    }
+
+    for (d=0; d<(long) documents.size(); d++) {
+        appendTable(positions, documentPositions[d]);
+        addRow(counts, &(countRows[3*d]));
+    }
+}
+
+/**
+ * @brief Reads the stress distributions along the slip plane written by SlipPlane::writeSlipPlaneStressDistribution.
+ * @param documents The files, sorted by time.
+ * @param stress Pointer to the table receiving the time, the distance from the first point and the local and global stress components.
+ */
+void processStress (const std::vector<Document>& documents, Table* stress)
+{
+    std::vector<Table> documentStress(documents.size());
+    const char* names[] = { "time", "distance",
+                            "local_xx", "local_yy", "local_zz", "local_xy", "local_xz", "local_yz",
+                            "global_xx", "global_yy", "global_zz", "global_xy", "global_xz", "global_yz" };
+    long d;
+    int k;
+
+    for (k=0; k<14; k++) {
+        stress->columns.push_back(names[k]);
+    }
+
+    // Each file is read by one thread
+    #pragma omp parallel for schedule(dynamic)
+    for (d=0; d<(long) documents.size(); d++) {
+        const char* text = documentText(documents[d]);
+        const char* end = text + documents[d].size;
+        std::vector<size_t> lines;
+        std::vector<double> numbers;
+        double row[14];
+        double p0[3] = {0.0, 0.0, 0.0};
+        int i, j;
+
+        documentStress[d].columns = stress->columns;
+        findLines(text, documents[d].size, &lines);
+        for (i=0; i<lines.size(); i++) {
+            parseLine(text + lines[i], end, &numbers);
+            if (numbers.size() < 15) {
+                continue;
+            }
+            if (documentStress[d].values.empty()) {
+                p0[0] = numbers[0];
+                p0[1] = numbers[1];
+                p0[2] = numbers[2];
+            }
+            row[0] = documents[d].time;
+            row[1] = sqrt((numbers[0]-p0[0])*(numbers[0]-p0[0]) + (numbers[1]-p0[1])*(numbers[1]-p0[1]) + (numbers[2]-p0[2])*(numbers[2]-p0[2]));
+            for (j=0; j<12; j++) {
+                row[2+j] = numbers[3+j];
+            }
+            addRow(&(documentStress[d]), row);
+        }
+    }
+
+    for (d=0; d<(long) documents.size(); d++) {
+        appendTable(stress, documentStress[d]);
+    }
+}
+
+/**
+ * @brief Point of entry of the post-processing tool.
+ * @param argc Number of arguments.
+ * @param argv Arguments: the command and the files, followed by the options.
+ * @return Zero on success.
+ */
+int main (int argc, char* argv[])
+{
+    std::vector<std::string> names;
+    std::vector<Document> documents;
+    std::string command;
+    std::string prefix;
+    std::string output = "postProcess";
+    bool binary = false;
+    int nColumns = 2;
+    int i;
+
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <trajectory|slipplane|stress> <files or archives...> [-name <prefix>] [-columns <n>] [-output <prefix>] [-binary] [-threads <n>]" << std::endl;
+        return (1);
+    }
+
+    command = std::string(argv[1]);
+    for (i=2; i<argc; i++) {
+        std::string a(argv[i]);
+        if (a == "-name" && i+1 < argc) {
+            prefix = std::string(argv[++i]);
+        }
+        else if (a == "-columns" && i+1 < argc) {
+            nColumns = atoi(argv[++i]);
+        }
+        else if (a == "-output" && i+1 < argc) {
+            output = std::string(argv[++i]);
+        }
+        else if (a == "-binary") {
+            binary = true;
+        }
+        else if (a == "-threads" && i+1 < argc) {
+#ifdef _OPENMP
+            omp_set_num_threads(atoi(argv[++i]));
+#else
+            i++;
+#endif
+        }
+        else {
+            names.push_back(a);
+        }
+    }
+
+    if (nColumns < 1) {
+        std::cerr << "The number of co-ordinates per defect must be positive" << std::endl;
+        return (1);
+    }
+
+    if (!readDocuments(names, prefix, &documents)) {
+        releaseDocuments(&documents);
+        return (1);
+    }
+    std::stable_sort(documents.begin(), documents.end(), earlierDocument);
+
+    if (command == "trajectory") {
+        Table positions, counts;
+        processTrajectory(documents, nColumns, &positions, &counts);
+        writeTable(positions, output + "_positions", binary);
+        writeTable(counts, output + "_counts", binary);
+    }
+    else if (command == "slipplane") {
+        Table positions, counts;
+        processSlipPlanes(documents, &positions, &counts);
+        writeTable(positions, output + "_positions", binary);
+        writeTable(counts, output + "_counts", binary);
+    }
+    else if (command == "stress") {
+        Table stress;
+        processStress(documents, &stress);
+        writeTable(stress, output + "_stress", binary);
+    }
+    else {
+        std::cerr << "Unknown command " << command << std::endl;
+        releaseDocuments(&documents);
+        return (1);
+    }
+
+    releaseDocuments(&documents);
+    return (0);
+}
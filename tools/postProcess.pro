@@ -0,0 +1,16 @@
+# Post-processing of the outputs into tables for plotting, in place of the Matlab parsers of plotTools
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= qt
+
+QMAKE_CXXFLAGS += -fopenmp
+LIBS += -fopenmp
+
+SOURCES += postProcess.cpp \
+    ../textWriter.cpp \
+    ../timeSeriesArchive.cpp
+
+HEADERS += \
+    ../textWriter.h \
+    ../timeSeriesArchive.h
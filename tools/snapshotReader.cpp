@@ -0,0 +1,147 @@
+/**
+ * @file snapshotReader.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Reader of the live snapshots published by a running simulation.
+ * @details This program attaches to the shared memory of the live snapshots of a simulation (parameter statsLiveSnapshots) and prints the latest snapshot, or follows the snapshots as they are published until the simulation ends. It is meant for testing and as an example for viewers.
+ *
+ * Usage: snapshotReader <name> [-follow <milliseconds>] [-positions]
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <string>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "../snapshotRing.h"
+
+/**
+ * @brief Prints a snapshot.
+ * @param s The snapshot.
+ * @param positions Flag indicating whether the positions of the defects are printed.
+ */
+void printSnapshot (const Snapshot& s, bool positions)
+{
+    int i;
+    int nDislocations = 0;
+
+    for (i=0; i<s.slipPlanes.size(); i++) {
+        nDislocations += s.slipPlanes[i].nDislocations;
+    }
+
+    std::cout << "snapshot " << s.index << " time " << s.time
+              << " defects " << s.types.size() << "/" << s.nDefectsTotal
+              << " dislocations " << nDislocations << std::endl;
+
+    for (i=0; i<s.slipPlanes.size(); i++) {
+        std::cout << "  plane " << i << " system " << s.slipPlanes[i].slipSystem
+                  << " dislocations " << s.slipPlanes[i].nDislocations
+                  << " sources " << s.slipPlanes[i].nDislocationSources
+                  << " emissions " << s.slipPlanes[i].nEmissions
+                  << " slip " << s.slipPlanes[i].plasticSlip << std::endl;
+    }
+
+    if (positions) {
+        for (i=0; i<s.types.size(); i++) {
+            std::cout << "  " << s.positions[2*i] << " " << s.positions[2*i+1] << " " << s.types[i] << std::endl;
+        }
+    }
+}
+
+/**
+ * @brief Point of entry of the reader.
+ * @param argc Number of arguments.
+ * @param argv Arguments: the name of the shared memory, followed by the options.
+ * @return Zero on success.
+ */
+int main (int argc, char* argv[])
+{
+    SnapshotRing ring;
+    Snapshot s;
+    std::string name;
+    bool positions = false;
+    int interval = -1;
+    long next, latest;
+    int i;
+
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <name> [-follow <milliseconds>] [-positions]" << std::endl;
+        return (1);
+    }
+
+    name = std::string(argv[1]);
+    for (i=2; i<argc; i++) {
+        if (std::string(argv[i]) == "-follow" && i+1 < argc) {
+            interval = atoi(argv[++i]);
+        }
+        else if (std::string(argv[i]) == "-positions") {
+            positions = true;
+        }
+    }
+
+    if (!ring.attach(name)) {
+        std::cerr << "Unable to attach to the shared memory /" << name << std::endl;
+        return (1);
+    }
+
+    std::cout << "ring " << ring.getName() << " slots " << ring.getNumSlots()
+              << " published " << ring.getNumPublished() << std::endl;
+
+    if (interval < 0) {
+        // Latest snapshot only
+        latest = ring.getNumPublished() - 1;
+        if (latest >= 0 && ring.read(latest, &s)) {
+            printSnapshot(s, positions);
+        }
+        return (0);
+    }
+
+    // Follow the snapshots until the writer closes the ring
+    next = ring.getNumPublished() - 1;
+    if (next < 0) {
+        next = 0;
+    }
+    while (true) {
+        bool finished = ring.isFinished();
+        latest = ring.getNumPublished();
+        if (latest - next > ring.getNumSlots()) {
+            // The reader fell behind: skip the snapshots that have been overwritten
+            std::cout << "skipped " << (latest - ring.getNumSlots() - next) << " snapshots" << std::endl;
+            next = latest - ring.getNumSlots();
+        }
+        while (next < latest) {
+            if (ring.read(next, &s)) {
+                printSnapshot(s, positions);
+            }
+            next++;
+        }
+        if (finished) {
+            break;
+        }
+        usleep(1000 * interval);
+    }
+
+    return (0);
+}
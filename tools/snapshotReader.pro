@@ -0,0 +1,13 @@
+# Reader of the live snapshots published in shared memory (statsLiveSnapshots)
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= qt
+
+LIBS += -lrt
+
+SOURCES += snapshotReader.cpp \
+    ../snapshotRing.cpp
+
+HEADERS += \
+    ../snapshotRing.h
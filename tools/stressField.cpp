@@ -0,0 +1,350 @@
+/**
+ * @file stressField.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Calculation of the stress field of saved frames of a grain.
+ * @details This file defines a program that reads frames of a grain written during a simulation (statsGrainFrames), either as files or as records of an archive, and calculates the stress field of their dislocations along a line, on a grid or along the grain boundary. The stress fields are thus only calculated after the simulation, for the frames that are of interest. The frames are distributed over threads when there are enough of them, and otherwise the points of each frame.
+ *
+ * Usage: stressField <parameters file> <frames or archives...> [-name <prefix>] [-from <t>] [-to <t>] [-line <x0> <y0> <x1> <y1> <n>] [-grid <x0> <y0> <x1> <y1> <nx> <ny>] [-boundary <resolution>] [-output <prefix>] [-archive <file>] [-threads <n>]
+ *
+ * The shear modulus, Poisson's ratio and the cut-off radius of the interactions are read from the parameters file. For each frame, the file <prefix><t>.txt, or a record of that name in the archive given with -archive, receives one row per point with its co-ordinates and the six components xx yy zz xy xz yz of the stress tensor, in the base co-ordinate system, as written by Grain::writeStressField.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "../grain.h"
+#include "../parameter.h"
+#include "../readFromFile.h"
+#include "../stressProbes.h"
+#include "../cellList.h"
+#include "../textWriter.h"
+#include "../timeSeriesArchive.h"
+
+/**
+ * @brief The Frame struct locates a saved frame of the grain.
+ */
+struct Frame
+{
+    /**
+     * @brief Name of the file or of the record.
+     */
+    std::string name;
+    /**
+     * @brief Time of the frame, from the record or the name of the file.
+     */
+    double time;
+    /**
+     * @brief Index of the archive holding the frame, -1 for a file.
+     */
+    int archive;
+    /**
+     * @brief Index of the record in the archive.
+     */
+    int record;
+};
+
+/**
+ * @brief Finds the time in the name of a frame file, such as frame1e-09.txt.
+ * @param fileName Name of the file.
+ * @return The time, or zero if the name does not end with a number.
+ */
+double timeFromName (std::string fileName)
+{
+    std::string name = TimeSeriesArchive::baseName(fileName);
+    size_t dot = name.rfind(".txt");
+    char* end;
+    double t;
+    size_t i;
+
+    if (dot != std::string::npos) {
+        name = name.substr(0, dot);
+    }
+
+    // The longest suffix that is a number
+    for (i=0; i<name.size(); i++) {
+        t = strtod(name.c_str() + i, &end);
+        if (end != name.c_str() + i && *end == '\0') {
+            return (t);
+        }
+    }
+    return (0.0);
+}
+
+/**
+ * @brief Reads the text of a frame.
+ * @param f The frame.
+ * @param archives The archives given on the command line.
+ * @param data Pointer to the string receiving the text.
+ * @return True if the frame could be read.
+ */
+bool readFrame (const Frame& f, std::vector<TimeSeriesArchive*>& archives, std::string* data)
+{
+    if (f.archive >= 0) {
+        return (archives[f.archive]->readRecord(f.record, data));
+    }
+
+    std::ifstream fp(f.name.c_str());
+    if (!fp.is_open()) {
+        return (false);
+    }
+    std::stringstream ss;
+    ss << fp.rdbuf();
+    *data = ss.str();
+    return (true);
+}
+
+/**
+ * @brief Point of entry of the stress field tool.
+ * @param argc Number of arguments.
+ * @param argv Arguments: the parameters file and the frames, followed by the options.
+ * @return Zero on success.
+ */
+int main (int argc, char* argv[])
+{
+    Parameter param;
+    std::vector<std::string> names;
+    std::vector<TimeSeriesArchive*> archives;
+    std::vector<Frame> frames;
+    std::vector<Vector3d> points;
+    std::string prefix;
+    std::string output = "stressField";
+    std::string archiveName;
+    TimeSeriesArchive outputArchive;
+    double from = -1.0;
+    double to = -1.0;
+    int boundaryResolution = 0;
+    int nThreads = 1;
+    int i, j;
+
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <parameters file> <frames or archives...> [-name <prefix>] [-from <t>] [-to <t>] [-line <x0> <y0> <x1> <y1> <n>] [-grid <x0> <y0> <x1> <y1> <nx> <ny>] [-boundary <resolution>] [-output <prefix>] [-archive <file>] [-threads <n>]" << std::endl;
+        return (1);
+    }
+
+    if (!param.getParameters(std::string(argv[1]))) {
+        std::cerr << "Unable to read the parameters file " << argv[1] << std::endl;
+        return (1);
+    }
+
+    for (i=2; i<argc; i++) {
+        std::string a(argv[i]);
+        if (a == "-name" && i+1 < argc) {
+            prefix = std::string(argv[++i]);
+        }
+        else if (a == "-from" && i+1 < argc) {
+            from = atof(argv[++i]);
+        }
+        else if (a == "-to" && i+1 < argc) {
+            to = atof(argv[++i]);
+        }
+        else if (a == "-line" && i+5 < argc) {
+            // Points spaced as in Grain::writeStressField, the first one after p0
+            Vector3d p0(atof(argv[i+1]), atof(argv[i+2]), 0.0);
+            Vector3d p1(atof(argv[i+3]), atof(argv[i+4]), 0.0);
+            int n = atoi(argv[i+5]);
+            for (j=1; j<=n; j++) {
+                points.push_back(p0 + ((p1-p0)*((double) j/n)));
+            }
+            i += 5;
+        }
+        else if (a == "-grid" && i+6 < argc) {
+            double x0 = atof(argv[i+1]);
+            double y0 = atof(argv[i+2]);
+            double x1 = atof(argv[i+3]);
+            double y1 = atof(argv[i+4]);
+            int nx = atoi(argv[i+5]);
+            int ny = atoi(argv[i+6]);
+            int k;
+            for (j=0; j<ny; j++) {
+                for (k=0; k<nx; k++) {
+                    points.push_back(Vector3d(x0 + (nx > 1 ? (x1-x0)*k/(nx-1) : 0.0), y0 + (ny > 1 ? (y1-y0)*j/(ny-1) : 0.0), 0.0));
+                }
+            }
+            i += 6;
+        }
+        else if (a == "-boundary" && i+1 < argc) {
+            boundaryResolution = atoi(argv[++i]);
+        }
+        else if (a == "-output" && i+1 < argc) {
+            output = std::string(argv[++i]);
+        }
+        else if (a == "-archive" && i+1 < argc) {
+            archiveName = std::string(argv[++i]);
+        }
+        else if (a == "-threads" && i+1 < argc) {
+            nThreads = atoi(argv[++i]);
+#ifdef _OPENMP
+            omp_set_num_threads(nThreads);
+#endif
+        }
+        else {
+            names.push_back(a);
+        }
+    }
+
+    if (points.empty() && boundaryResolution <= 0) {
+        std::cerr << "No points: give -line, -grid or -boundary" << std::endl;
+        return (1);
+    }
+
+    // List the frames
+    for (i=0; i<names.size(); i++) {
+        TimeSeriesArchive* archive = new TimeSeriesArchive;
+        Frame f;
+        if (archive->openForReading(names[i])) {
+            for (j=0; j<archive->getNumRecords(); j++) {
+                const ArchiveRecord& r = archive->getRecord(j);
+                if (r.name.compare(0, prefix.size(), prefix) == 0) {
+                    f.name = r.name;
+                    f.time = r.time;
+                    f.archive = archives.size();
+                    f.record = j;
+                    frames.push_back(f);
+                }
+            }
+            archives.push_back(archive);
+        }
+        else {
+            delete (archive);
+            f.name = names[i];
+            f.time = timeFromName(names[i]);
+            f.archive = -1;
+            f.record = -1;
+            frames.push_back(f);
+        }
+    }
+
+    // Select the frames within the range of time
+    std::vector<Frame> selected;
+    for (i=0; i<frames.size(); i++) {
+        if ((from < 0.0 || frames[i].time >= from) && (to < 0.0 || frames[i].time <= to)) {
+            selected.push_back(frames[i]);
+        }
+    }
+    int nFrames = selected.size();
+
+    if (!archiveName.empty() && !outputArchive.open(archiveName)) {
+        std::cerr << "Unable to open the archive " << archiveName << std::endl;
+        return (1);
+    }
+
+#ifdef _OPENMP
+    nThreads = omp_get_max_threads();
+#endif
+    int nFailed = 0;
+
+    // Frames are distributed over the threads if there are enough of them, the points otherwise
+#pragma omp parallel for schedule(dynamic) reduction(+:nFailed) if (nFrames >= nThreads)
+    for (i=0; i<nFrames; i++) {
+        std::string data;
+        bool read;
+        Grain* grain = new Grain;
+        double t;
+
+        // The archives, the parameters and the random number generator of readGrain are shared
+#pragma omp critical (stressField_read)
+        {
+            read = readFrame(selected[i], archives, &data);
+            if (read) {
+                std::istringstream in(data);
+                read = readGrain(in, grain, &t, &param);
+            }
+        }
+
+        if (!read) {
+#pragma omp critical (stressField_message)
+            std::cerr << "Unable to read the frame " << selected[i].name << std::endl;
+            delete (grain);
+            nFailed++;
+            continue;
+        }
+
+        std::vector<SlipSystem*> slipSystems = grain->getSlipSystems();
+        CoordinateSystem* grainSystem = grain->getCoordinateSystem();
+        StressProbes probes;
+        CellList cellList;
+        std::vector<Stress> stress;
+
+        if (boundaryResolution > 0) {
+            probes.setGrainBoundaryProbes(grain->getGBPoints_base(), boundaryResolution, grainSystem, slipSystems);
+        }
+        else {
+            probes.setProbes(points, grainSystem, slipSystems);
+        }
+
+        if (param.interactionCutoff > 0.0) {
+            cellList.setCutoff(param.interactionCutoff, param.cutoffSkin);
+            cellList.update(slipSystems, grainSystem, grainSystem->vector_BaseToLocal_noTranslate(Vector3d::unitVector(2)));
+        }
+
+        probes.calculate(slipSystems, grainSystem, &cellList, param.mu, param.nu, &stress);
+
+        const std::vector<Vector3d>& p = probes.getPoints();
+        TextWriter fp;
+        std::string outFileName = output + doubleToString(t) + ".txt";
+        int k;
+
+        if (archiveName.empty() && !fp.open(outFileName, false)) {
+#pragma omp critical (stressField_message)
+            std::cerr << "Unable to write the file " << outFileName << std::endl;
+            delete (grain);
+            nFailed++;
+            continue;
+        }
+
+        for (k=0; k<stress.size(); k++) {
+            fp << p[k].getValue(0) << " " << p[k].getValue(1) << " " << stress[k].getPrincipalStress(0) << " " << stress[k].getPrincipalStress(1) << " " << stress[k].getPrincipalStress(2) << " " << stress[k].getShearStress(0) << " " << stress[k].getShearStress(1) << " " << stress[k].getShearStress(2);
+            fp.endLine();
+        }
+
+        if (archiveName.empty()) {
+            fp.close();
+        }
+        else {
+#pragma omp critical (stressField_archive)
+            outputArchive.addRecord(TimeSeriesArchive::baseName(outFileName), t, fp.str());
+        }
+
+        delete (grain);
+    }
+
+    outputArchive.close();
+    for (i=0; i<archives.size(); i++) {
+        archives[i]->close();
+        delete (archives[i]);
+    }
+
+    std::cout << (nFrames - nFailed) << " frames" << std::endl;
+    return ((nFailed > 0) ? 1 : 0);
+}
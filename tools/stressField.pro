@@ -0,0 +1,12 @@
+# Stress fields of the frames of a grain (statsGrainFrames), calculated after the simulation.
+# Links the library libdd2d.a built by dd2d_library.pro in the parent folder.
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= qt
+
+QMAKE_CXXFLAGS += -fopenmp
+INCLUDEPATH += ..
+LIBS += -L.. -ldd2d -L/usr/lib -lgsl -lgslcblas -lm -lrt -fopenmp
+
+SOURCES += stressField.cpp
@@ -126,8 +126,8 @@ DefectType UniqueID::getDefectType(int uid)
  */
 void UniqueID::writeDefects(std::string filename)
 {
-    std::ofstream fp (filename.c_str());
-    if ( !fp.is_open() ) {
+    TextWriter fp;
+    if ( !fp.open(filename, false) ) {
         return;
     }
 
@@ -154,7 +154,7 @@ void UniqueID::writeDefects(std::string filename)
             }
             break;
         }
-        fp << std::endl;
+        fp << "\n";
     }
 
     fp.close();
@@ -36,6 +36,7 @@
 #include <fstream>
 
 #include "defectType.h"
+#include "textWriter.h"
 
 /**
  * @brief The UniqueID singleton class to handle unique identification for all objects in the simulation.
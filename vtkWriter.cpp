@@ -0,0 +1,342 @@
+/**
+ * @file vtkWriter.cpp
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the member functions of the class VtkWriter.
+ * @details This file defines the member functions of the class VtkWriter, which writes the defects of a grain as a series of VTK files with binary data that can be read by ParaView.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "vtkWriter.h"
+#include "textWriter.h"
+
+/**
+ * @brief Name of the byte order of the machine, as written in the VTK files.
+ * @return LittleEndian or BigEndian.
+ */
+static const char* vtkByteOrder ()
+{
+  unsigned int one = 1;
+  return ( ( *( (unsigned char*) &one ) == 1 ) ? "LittleEndian" : "BigEndian" );
+}
+
+/**
+ * @brief Removes the directories from a file name, the files of a collection being referred to from the folder of the collection.
+ * @param fileName Name of the file.
+ * @return The name of the file without its directories.
+ */
+static std::string vtkBaseName (std::string fileName)
+{
+  size_t slash = fileName.rfind ( '/' );
+  return ( ( slash == std::string::npos ) ? fileName : fileName.substr ( slash + 1 ) );
+}
+
+// Constructors
+/**
+ * @brief Default constructor. The writer is not open.
+ */
+VtkWriter::VtkWriter ()
+{
+  this->collection = NULL;
+  this->footerOffset = 0;
+  this->nFrames = 0;
+  this->boundaryWritten = false;
+}
+
+// Destructor
+/**
+ * @brief Destructor for the class VtkWriter. The collection file is closed.
+ */
+VtkWriter::~VtkWriter ()
+{
+  this->close ();
+}
+
+// Operations
+/**
+ * @brief Creates the collection file <fileName>.pvd. An existing collection is replaced.
+ * @param fileName Name of the files, without the extension.
+ * @return True if the file could be created.
+ */
+bool VtkWriter::open (std::string fileName)
+{
+  this->close ();
+
+  this->collection = fopen ( ( fileName + ".pvd" ).c_str(), "wb" );
+  if ( this->collection == NULL ) {
+    return ( false );
+  }
+
+  this->fileName = fileName;
+  this->nFrames = 0;
+  this->boundaryWritten = false;
+
+  fprintf ( this->collection, "<?xml version=\"1.0\"?>\n<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"%s\">\n<Collection>\n", vtkByteOrder() );
+  this->footerOffset = ftell ( this->collection );
+  this->writeFooter ();
+  return ( true );
+}
+
+/**
+ * @brief Closes the collection file.
+ */
+void VtkWriter::close ()
+{
+  if ( this->collection != NULL ) {
+    fclose ( this->collection );
+    this->collection = NULL;
+  }
+}
+
+/**
+ * @brief Writes the closing tags of the collection file and makes it readable.
+ */
+void VtkWriter::writeFooter ()
+{
+  fseek ( this->collection, this->footerOffset, SEEK_SET );
+  fputs ( "</Collection>\n</VTKFile>\n", this->collection );
+  fflush ( this->collection );
+}
+
+/**
+ * @brief Writes the grain boundary as a polygon to <fileName>_boundary.vtu, listed with every output written from now on.
+ * @param points The points of the grain boundary, in order.
+ * @return True if the file was written.
+ */
+bool VtkWriter::writeBoundary (const std::vector<Vector3d>& points)
+{
+  std::vector<double> p;
+  std::vector<long long> connectivity;
+  std::vector<long long> offsets;
+  std::vector<unsigned char> cellTypes;
+  std::vector<VtkArray> pointData;
+  int i;
+
+  if ( this->collection == NULL ) {
+    return ( false );
+  }
+
+  for ( i=0; i<points.size(); i++ ) {
+    p.push_back ( points[i].getValue(0) );
+    p.push_back ( points[i].getValue(1) );
+    p.push_back ( points[i].getValue(2) );
+    connectivity.push_back ( i );
+  }
+  offsets.push_back ( connectivity.size() );
+  cellTypes.push_back ( VTKWRITER_POLYGON );
+
+  this->boundaryWritten = VtkWriter::writeUnstructuredGrid ( this->fileName + "_boundary.vtu", p, connectivity, offsets, cellTypes, pointData );
+  return ( this->boundaryWritten );
+}
+
+/**
+ * @brief Writes an output to <fileName>_<n>.vtu and adds it to the collection.
+ * @details Each defect is a point carrying its type, the index of its slip plane, its Burgers vector and the stress tensor acting on it.
+ * @param t The value of time.
+ * @param points The co-ordinates of the defects, three per defect.
+ * @param types The type of each defect, as a DefectType.
+ * @param slipPlanes The index of the slip plane of each defect, counted over all slip systems.
+ * @param burgers The Burgers vector of each defect, multiplied by its magnitude, three components per defect. It is zero for defects other than dislocations.
+ * @param stress The stress tensor acting on each defect, six components xx yy zz xy xz yz per defect.
+ * @return True if the file was written.
+ */
+bool VtkWriter::writeFrame (double t, const std::vector<double>& points, const std::vector<int>& types, const std::vector<int>& slipPlanes, const std::vector<double>& burgers, const std::vector<double>& stress)
+{
+  if ( this->collection == NULL ) {
+    return ( false );
+  }
+
+  long long nPoints = types.size();
+  std::vector<long long> connectivity ( nPoints );
+  std::vector<long long> offsets ( nPoints );
+  std::vector<unsigned char> cellTypes ( nPoints, VTKWRITER_VERTEX );
+  std::vector<VtkArray> pointData;
+  VtkArray a;
+  long long i;
+
+  // One vertex per defect
+  for ( i=0; i<nPoints; i++ ) {
+    connectivity[i] = i;
+    offsets[i] = i + 1;
+  }
+
+  a.name = "type";
+  a.type = "Int32";
+  a.nComponents = 1;
+  a.data = types.empty() ? NULL : &(types[0]);
+  a.size = types.size() * sizeof(int);
+  pointData.push_back ( a );
+
+  a.name = "slipPlane";
+  a.data = slipPlanes.empty() ? NULL : &(slipPlanes[0]);
+  a.size = slipPlanes.size() * sizeof(int);
+  pointData.push_back ( a );
+
+  a.name = "burgers";
+  a.type = "Float64";
+  a.nComponents = 3;
+  a.data = burgers.empty() ? NULL : &(burgers[0]);
+  a.size = burgers.size() * sizeof(double);
+  pointData.push_back ( a );
+
+  a.name = "stress";
+  a.nComponents = 6;
+  a.data = stress.empty() ? NULL : &(stress[0]);
+  a.size = stress.size() * sizeof(double);
+  pointData.push_back ( a );
+
+  char n[16];
+  snprintf ( n, sizeof(n), "_%d.vtu", this->nFrames );
+  std::string frameFileName = this->fileName + n;
+  if ( !VtkWriter::writeUnstructuredGrid ( frameFileName, points, connectivity, offsets, cellTypes, pointData ) ) {
+    return ( false );
+  }
+
+  // Add the output to the collection, in place of the closing tags
+  char time[TEXTWRITER_NUMBER_CHARS+1];
+  time[TextWriter::formatDouble ( t, time )] = '\0';
+
+  fseek ( this->collection, this->footerOffset, SEEK_SET );
+  fprintf ( this->collection, "<DataSet timestep=\"%s\" part=\"0\" file=\"%s\"/>\n", time, vtkBaseName ( frameFileName ).c_str() );
+  if ( this->boundaryWritten ) {
+    fprintf ( this->collection, "<DataSet timestep=\"%s\" part=\"1\" file=\"%s\"/>\n", time, vtkBaseName ( this->fileName + "_boundary.vtu" ).c_str() );
+  }
+  this->footerOffset = ftell ( this->collection );
+  this->writeFooter ();
+
+  this->nFrames++;
+  return ( true );
+}
+
+/**
+ * @brief Writes an unstructured grid with its data appended in raw binary form.
+ * @param fileName Name of the file.
+ * @param points The co-ordinates of the points, three per point.
+ * @param connectivity The indices of the points of all cells, one cell after the other.
+ * @param offsets The index in connectivity of the end of each cell.
+ * @param cellTypes The VTK type of each cell.
+ * @param pointData The arrays attached to the points.
+ * @return True if the file was written.
+ */
+bool VtkWriter::writeUnstructuredGrid (std::string fileName, const std::vector<double>& points, const std::vector<long long>& connectivity, const std::vector<long long>& offsets, const std::vector<unsigned char>& cellTypes, const std::vector<VtkArray>& pointData)
+{
+  FILE* fp = fopen ( fileName.c_str(), "wb" );
+  if ( fp == NULL ) {
+    return ( false );
+  }
+
+  // The blocks of the appended data, each preceded by its size in bytes
+  std::vector<VtkArray> blocks;
+  VtkArray a;
+  unsigned long long offset = 0;
+  unsigned long long size;
+  int i;
+
+  a.name = "Points";
+  a.type = "Float64";
+  a.nComponents = 3;
+  a.data = points.empty() ? NULL : &(points[0]);
+  a.size = points.size() * sizeof(double);
+  blocks.push_back ( a );
+
+  a.name = "connectivity";
+  a.type = "Int64";
+  a.nComponents = 1;
+  a.data = connectivity.empty() ? NULL : &(connectivity[0]);
+  a.size = connectivity.size() * sizeof(long long);
+  blocks.push_back ( a );
+
+  a.name = "offsets";
+  a.data = offsets.empty() ? NULL : &(offsets[0]);
+  a.size = offsets.size() * sizeof(long long);
+  blocks.push_back ( a );
+
+  a.name = "types";
+  a.type = "UInt8";
+  a.data = cellTypes.empty() ? NULL : &(cellTypes[0]);
+  a.size = cellTypes.size();
+  blocks.push_back ( a );
+
+  blocks.insert ( blocks.end(), pointData.begin(), pointData.end() );
+
+  // Header
+  fprintf ( fp, "<?xml version=\"1.0\"?>\n<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\">\n<UnstructuredGrid>\n", vtkByteOrder() );
+  fprintf ( fp, "<Piece NumberOfPoints=\"%llu\" NumberOfCells=\"%llu\">\n", (unsigned long long) ( points.size() / 3 ), (unsigned long long) cellTypes.size() );
+  for ( i=0; i<blocks.size(); i++ ) {
+    if ( i == 0 ) {
+      fputs ( "<Points>\n", fp );
+    }
+    else if ( i == 1 ) {
+      fputs ( "<Cells>\n", fp );
+    }
+    else if ( i == 4 ) {
+      fputs ( "<PointData>\n", fp );
+    }
+    fprintf ( fp, "<DataArray type=\"%s\" Name=\"%s\" NumberOfComponents=\"%d\" format=\"appended\" offset=\"%llu\"/>\n", blocks[i].type.c_str(), blocks[i].name.c_str(), blocks[i].nComponents, offset );
+    offset += sizeof(unsigned long long) + blocks[i].size;
+    if ( i == 0 ) {
+      fputs ( "</Points>\n", fp );
+    }
+    else if ( i == 3 ) {
+      fputs ( "</Cells>\n", fp );
+    }
+  }
+  if ( blocks.size() > 4 ) {
+    fputs ( "</PointData>\n", fp );
+  }
+  fputs ( "</Piece>\n</UnstructuredGrid>\n<AppendedData encoding=\"raw\">\n_", fp );
+
+  // Binary data
+  for ( i=0; i<blocks.size(); i++ ) {
+    size = blocks[i].size;
+    fwrite ( &size, sizeof(unsigned long long), 1, fp );
+    if ( size > 0 ) {
+      fwrite ( blocks[i].data, 1, size, fp );
+    }
+  }
+
+  fputs ( "\n</AppendedData>\n</VTKFile>\n", fp );
+  bool success = ( ferror ( fp ) == 0 );
+  fclose ( fp );
+  return ( success );
+}
+
+// Access functions
+/**
+ * @brief Indicates whether the collection file is open.
+ * @return True if the collection file is open.
+ */
+bool VtkWriter::isOpen () const
+{
+  return ( this->collection != NULL );
+}
+
+/**
+ * @brief Get the number of outputs written.
+ * @return The number of outputs.
+ */
+int VtkWriter::getNumFrames () const
+{
+  return ( this->nFrames );
+}
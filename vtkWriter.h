@@ -0,0 +1,177 @@
+/**
+ * @file vtkWriter.h
+ * @author Adhish Majumdar
+ * @version 0.0
+ * @date 17/10/2026
+ * @brief Definition of the class VtkWriter.
+ * @details This file defines the class VtkWriter, which writes the defects of a grain as a series of VTK files with binary data that can be read by ParaView.
+ */
+
+/*
+    DD2D-Matryoshka approach.
+    A set of classes defining the behaviour of crystalline defects,
+    with the final goal of carrying out dislocation dynamics simulations
+    in two dimensions.
+    Copyright (C) 2013  Adhish Majumdar
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef VTKWRITER_H
+#define VTKWRITER_H
+
+#include <string>
+#include <vector>
+#include <stdio.h>
+
+#include "vector3d.h"
+
+/**
+ * @brief Type of the cells of the VTK files for single points.
+ */
+#define VTKWRITER_VERTEX 1
+
+/**
+ * @brief Type of the cells of the VTK files for polygons.
+ */
+#define VTKWRITER_POLYGON 7
+
+/**
+ * @brief The VtkArray struct describes an array of values attached to the points or cells of a VTK file.
+ */
+struct VtkArray
+{
+  /**
+   * @brief Name of the array.
+   */
+  std::string name;
+  /**
+   * @brief VTK name of the type of the values: Float64, Int32, Int64 or UInt8.
+   */
+  std::string type;
+  /**
+   * @brief Number of components per point or cell.
+   */
+  int nComponents;
+  /**
+   * @brief Pointer to the values.
+   */
+  const void* data;
+  /**
+   * @brief Size in bytes of the values.
+   */
+  size_t size;
+};
+
+/**
+ * @brief The VtkWriter class writes the defects of a grain as a series of VTK unstructured grids, one file per output, with the data appended in raw binary form.
+ * @details Each output is written to the file <name>_<n>.vtu as soon as it is received, so that the trajectory is never held in memory, and is listed with its time in the collection <name>.pvd, which ParaView reads as a time series. The collection is completed after each output, so that it remains readable if the simulation is interrupted. The grain boundary is written once to <name>_boundary.vtu as a polygon and listed as a second part of every output.
+ */
+class VtkWriter
+{
+protected:
+  /**
+   * @brief Name of the files, without the extension.
+   */
+  std::string fileName;
+  /**
+   * @brief The collection file, NULL if the writer is not open.
+   */
+  FILE* collection;
+  /**
+   * @brief Position in the collection file of its closing tags, which are overwritten by the next output.
+   */
+  long footerOffset;
+  /**
+   * @brief Number of outputs written.
+   */
+  int nFrames;
+  /**
+   * @brief Flag indicating whether the grain boundary has been written.
+   */
+  bool boundaryWritten;
+
+  /**
+   * @brief Writes an unstructured grid with its data appended in raw binary form.
+   * @param fileName Name of the file.
+   * @param points The co-ordinates of the points, three per point.
+   * @param connectivity The indices of the points of all cells, one cell after the other.
+   * @param offsets The index in connectivity of the end of each cell.
+   * @param cellTypes The VTK type of each cell.
+   * @param pointData The arrays attached to the points.
+   * @return True if the file was written.
+   */
+  static bool writeUnstructuredGrid (std::string fileName, const std::vector<double>& points, const std::vector<long long>& connectivity, const std::vector<long long>& offsets, const std::vector<unsigned char>& cellTypes, const std::vector<VtkArray>& pointData);
+  /**
+   * @brief Writes the closing tags of the collection file and makes it readable.
+   */
+  void writeFooter ();
+
+public:
+  // Constructors
+  /**
+   * @brief Default constructor. The writer is not open.
+   */
+  VtkWriter ();
+
+  // Destructor
+  /**
+   * @brief Destructor for the class VtkWriter. The collection file is closed.
+   */
+  virtual ~VtkWriter ();
+
+  // Operations
+  /**
+   * @brief Creates the collection file <fileName>.pvd. An existing collection is replaced.
+   * @param fileName Name of the files, without the extension.
+   * @return True if the file could be created.
+   */
+  bool open (std::string fileName);
+  /**
+   * @brief Closes the collection file.
+   */
+  void close ();
+  /**
+   * @brief Writes the grain boundary as a polygon to <fileName>_boundary.vtu, listed with every output written from now on.
+   * @param points The points of the grain boundary, in order.
+   * @return True if the file was written.
+   */
+  bool writeBoundary (const std::vector<Vector3d>& points);
+  /**
+   * @brief Writes an output to <fileName>_<n>.vtu and adds it to the collection.
+   * @details Each defect is a point carrying its type, the index of its slip plane, its Burgers vector and the stress tensor acting on it.
+   * @param t The value of time.
+   * @param points The co-ordinates of the defects, three per defect.
+   * @param types The type of each defect, as a DefectType.
+   * @param slipPlanes The index of the slip plane of each defect, counted over all slip systems.
+   * @param burgers The Burgers vector of each defect, multiplied by its magnitude, three components per defect. It is zero for defects other than dislocations.
+   * @param stress The stress tensor acting on each defect, six components xx yy zz xy xz yz per defect.
+   * @return True if the file was written.
+   */
+  bool writeFrame (double t, const std::vector<double>& points, const std::vector<int>& types, const std::vector<int>& slipPlanes, const std::vector<double>& burgers, const std::vector<double>& stress);
+
+  // Access functions
+  /**
+   * @brief Indicates whether the collection file is open.
+   * @return True if the collection file is open.
+   */
+  bool isOpen () const;
+  /**
+   * @brief Get the number of outputs written.
+   * @return The number of outputs.
+   */
+  int getNumFrames () const;
+};
+
+#endif // VTKWRITER_H